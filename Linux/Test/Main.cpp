@@ -0,0 +1,16 @@
+﻿
+# include <Siv3D.hpp>
+# include <Siv3DEngine.hpp>
+# define CATCH_CONFIG_RUNNER
+// 新しい glibc では MINSIGSTKSZ が定数でないため、Catch2 v2.5.0 のシグナルハンドラを無効にする
+# define CATCH_CONFIG_NO_POSIX_SIGNALS
+# include <ThirdParty/Catch2/catch.hpp>
+
+// libSiv3D の main() の代わりに Catch2 のテストを実行する
+// エンジンの部品は作成するが、System::init() は呼ばないのでウィンドウは作成されない
+int main(int argc, char* argv[])
+{
+	s3d::Siv3DEngine engine;
+
+	return Catch::Session().run(argc, argv);
+}
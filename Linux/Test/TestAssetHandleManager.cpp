@@ -0,0 +1,297 @@
+﻿
+# include <thread>
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <AssetHandleManager/AssetHandleManager.hpp>
+
+namespace
+{
+	struct TestAsset
+	{
+		uint32 id = 0;
+	};
+
+	using TestAssetID = AssetIDWrapper<AssetHandle<TestAsset>>;
+
+	using TestAssetManager = AssetHandleManager<TestAssetID, TestAsset>;
+
+	// AssetHandleManager の ID の下位 20 ビットはスロットの位置
+	constexpr uint32 IndexBits = 20;
+
+	constexpr uint32 IndexMask = ((1u << IndexBits) - 1);
+
+	constexpr uint32 MaxGeneration = (TestAssetID::InvalidID >> IndexBits);
+
+	TestAssetID AddAsset(TestAssetManager& manager)
+	{
+		auto asset = std::make_unique<TestAsset>();
+
+		TestAsset* const pAsset = asset.get();
+
+		const TestAssetID id = manager.add(std::move(asset));
+
+		pAsset->id = id.value();
+
+		return id;
+	}
+
+	void InitNullAsset(TestAssetManager& manager)
+	{
+		manager.setNullData(std::make_unique<TestAsset>(TestAsset{ TestAssetID::NullAssetID }));
+	}
+
+	// 以前の実装（ミューテックス + HashTable）の読み出し処理。ベンチマークの比較用
+	class MutexHashTableManager
+	{
+	private:
+
+		HashTable<TestAssetID, std::unique_ptr<TestAsset>> m_data;
+
+		std::mutex m_mutex;
+
+	public:
+
+		void add(const TestAssetID id)
+		{
+			m_data.emplace(id, std::make_unique<TestAsset>(TestAsset{ id.value() }));
+		}
+
+		TestAsset* operator [](const TestAssetID id)
+		{
+			std::lock_guard lock(m_mutex);
+
+			return m_data[id].get();
+		}
+	};
+
+	template <class Manager>
+	uint64 LookupFromThreads(Manager& manager, const Array<TestAssetID>& ids, const size_t numThreads, const size_t lookupsPerThread)
+	{
+		std::atomic<uint64> total = 0;
+
+		Array<std::thread> threads;
+
+		for (size_t t = 0; t < numThreads; ++t)
+		{
+			threads.emplace_back([&, t]()
+			{
+				uint64 sum = 0;
+
+				for (size_t i = 0; i < lookupsPerThread; ++i)
+				{
+					sum += manager[ids[(i + t * 7) % ids.size()]]->id;
+				}
+
+				total += sum;
+			});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		return total;
+	}
+}
+
+TEST_CASE("AssetHandleManager.Lookup")
+{
+	TestAssetManager manager(U"TestAsset");
+
+	InitNullAsset(manager);
+
+	SECTION("NullAssetID and InvalidID")
+	{
+		REQUIRE(manager[TestAssetID::NullAsset()]->id == TestAssetID::NullAssetID);
+		REQUIRE(manager[TestAssetID::InvalidValue()]->id == TestAssetID::NullAssetID);
+	}
+
+	SECTION("live IDs")
+	{
+		Array<TestAssetID> ids;
+
+		for (int32 i = 0; i < 3000; ++i)
+		{
+			ids.push_back(AddAsset(manager));
+		}
+
+		for (const auto& id : ids)
+		{
+			REQUIRE(!id.isNullAsset());
+			REQUIRE(manager[id]->id == id.value());
+		}
+	}
+
+	SECTION("stale IDs")
+	{
+		const TestAssetID a = AddAsset(manager);
+
+		manager.erase(a);
+
+		REQUIRE(manager[a]->id == TestAssetID::NullAssetID);
+
+		// 同じスロットが再利用されても、古い ID は新しいアセットを指さない
+		const TestAssetID b = AddAsset(manager);
+
+		REQUIRE((a.value() & IndexMask) == (b.value() & IndexMask));
+		REQUIRE(a.value() != b.value());
+		REQUIRE(manager[a]->id == TestAssetID::NullAssetID);
+		REQUIRE(manager[b]->id == b.value());
+	}
+
+	SECTION("IDs beyond the allocated slots")
+	{
+		const TestAssetID a = AddAsset(manager);
+
+		REQUIRE(manager[TestAssetID(a.value() + 1)]->id == TestAssetID::NullAssetID);
+		REQUIRE(manager[TestAssetID(IndexMask)]->id == TestAssetID::NullAssetID);
+	}
+
+	SECTION("erasing NullAssetID does nothing")
+	{
+		manager.erase(TestAssetID::NullAsset());
+
+		REQUIRE(manager[TestAssetID::NullAsset()]->id == TestAssetID::NullAssetID);
+	}
+
+	manager.destroy();
+}
+
+TEST_CASE("AssetHandleManager.GenerationWraparound")
+{
+	TestAssetManager manager(U"TestAsset");
+
+	InitNullAsset(manager);
+
+	// 1 つのスロットを世代の上限まで使い回す
+	Array<TestAssetID> ids;
+
+	for (uint32 i = 0; i < MaxGeneration; ++i)
+	{
+		const TestAssetID id = AddAsset(manager);
+
+		REQUIRE(id.value() != TestAssetID::InvalidID);
+		REQUIRE(manager[id]->id == id.value());
+
+		if (!ids.isEmpty())
+		{
+			REQUIRE((id.value() & IndexMask) == (ids.front().value() & IndexMask));
+			REQUIRE((id.value() >> IndexBits) == ((ids.back().value() >> IndexBits) + 1));
+		}
+
+		ids.push_back(id);
+
+		manager.erase(id);
+	}
+
+	// 世代を使い切ったスロットは再利用されない
+	const TestAssetID next = AddAsset(manager);
+
+	REQUIRE((next.value() & IndexMask) != (ids.front().value() & IndexMask));
+	REQUIRE(manager[next]->id == next.value());
+
+	for (const auto& id : ids)
+	{
+		REQUIRE(manager[id]->id == TestAssetID::NullAssetID);
+	}
+
+	manager.destroy();
+}
+
+TEST_CASE("AssetHandleManager.ConcurrentLookup")
+{
+	TestAssetManager manager(U"TestAsset");
+
+	InitNullAsset(manager);
+
+	Array<TestAssetID> ids;
+
+	for (int32 i = 0; i < 256; ++i)
+	{
+		ids.push_back(AddAsset(manager));
+	}
+
+	std::atomic<bool> done = false;
+
+	std::atomic<size_t> mismatches = 0;
+
+	// 読み出しは、別のスレッドで追加と削除が行われていても、ヌルデータか要求した ID のデータを返す
+	Array<std::thread> readers;
+
+	for (int32 t = 0; t < 4; ++t)
+	{
+		readers.emplace_back([&]()
+		{
+			while (!done)
+			{
+				for (const auto& id : ids)
+				{
+					const uint32 result = manager[id]->id;
+
+					if ((result != id.value()) && (result != TestAssetID::NullAssetID))
+					{
+						++mismatches;
+					}
+				}
+			}
+		});
+	}
+
+	for (int32 i = 0; i < 20000; ++i)
+	{
+		const TestAssetID id = AddAsset(manager);
+
+		manager.erase(id);
+	}
+
+	done = true;
+
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	REQUIRE(mismatches == 0);
+
+	manager.destroy();
+}
+
+// 既定では実行しない。Siv3D_Test "[benchmark]" で実行する
+TEST_CASE("AssetHandleManager.Benchmark", "[.][benchmark]")
+{
+	constexpr size_t NumAssets = 1000;
+	constexpr size_t NumThreads = 8;
+	constexpr size_t LookupsPerThread = (10'000'000 / NumThreads);
+
+	TestAssetManager manager(U"TestAsset");
+
+	InitNullAsset(manager);
+
+	MutexHashTableManager reference;
+
+	Array<TestAssetID> ids;
+
+	for (size_t i = 0; i < NumAssets; ++i)
+	{
+		ids.push_back(AddAsset(manager));
+
+		reference.add(ids.back());
+	}
+
+	uint64 expected = 0, result = 0;
+
+	BENCHMARK("10M lookups on 8 threads: mutex + HashTable")
+	{
+		expected = LookupFromThreads(reference, ids, NumThreads, LookupsPerThread);
+	}
+
+	BENCHMARK("10M lookups on 8 threads: slot map")
+	{
+		result = LookupFromThreads(manager, ids, NumThreads, LookupsPerThread);
+	}
+
+	REQUIRE(result == expected);
+
+	manager.destroy();
+}
@@ -0,0 +1,176 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Audio/AL/AudioMixer_AL.hpp>
+
+// init() を呼ばない AudioMixer_AL は合成スレッドを持たないので、mix() を直接呼んで検証する
+namespace
+{
+	// frames 分だけ一定の値を出力するボイス
+	class ConstantVoice : public AudioVoice_AL
+	{
+	private:
+
+		Array<float> m_source;
+
+		float m_gain = 1.0f;
+
+		size_t m_remainingFrames = 0;
+
+		std::atomic<bool> m_removed = false;
+
+	public:
+
+		ConstantVoice(const float value, const size_t frames, const float gain = 1.0f)
+			: m_source(AudioMixer_AL::BufferFrames * 2, value)
+			, m_gain(gain)
+			, m_remainingFrames(frames) {}
+
+		bool mixTo(float* dst, const size_t frames, uint32) override
+		{
+			const size_t mixFrames = Min(frames, m_remainingFrames);
+
+			AudioMixer_AL::MixStereo(dst, m_source.data(), mixFrames, m_gain, m_gain);
+
+			m_remainingFrames -= mixFrames;
+
+			return (m_remainingFrames != 0);
+		}
+
+		bool isFinished() const override
+		{
+			return (m_remainingFrames == 0);
+		}
+
+		void onRemoved() override
+		{
+			m_removed = true;
+		}
+
+		[[nodiscard]] bool removed() const
+		{
+			return m_removed;
+		}
+	};
+
+	void AddVoice(AudioMixer_AL& mixer, const std::shared_ptr<AudioVoice_AL>& voice)
+	{
+		std::lock_guard lock(mixer.getMutex());
+
+		mixer.addVoice(voice);
+	}
+}
+
+TEST_CASE("AudioMixer_AL.Mix")
+{
+	constexpr size_t Frames = AudioMixer_AL::BufferFrames;
+
+	AudioMixer_AL mixer;
+
+	Array<float> buffer(Frames * 2, -1.0f);
+
+	SECTION("voices are summed")
+	{
+		AddVoice(mixer, std::make_shared<ConstantVoice>(0.25f, Frames * 4));
+		AddVoice(mixer, std::make_shared<ConstantVoice>(0.5f, Frames * 4));
+
+		mixer.mix(buffer.data(), Frames);
+
+		REQUIRE(buffer.all([](const float s) { return (s == 0.75f); }));
+		REQUIRE(mixer.num_voices() == 2);
+	}
+
+	SECTION("finished voices are removed")
+	{
+		const auto voice = std::make_shared<ConstantVoice>(0.5f, Frames / 2);
+
+		AddVoice(mixer, voice);
+
+		mixer.mix(buffer.data(), Frames);
+
+		REQUIRE(buffer[Frames - 1] == 0.5f);
+		REQUIRE(buffer[Frames] == 0.0f);
+		REQUIRE(mixer.num_voices() == 0);
+		REQUIRE(voice->removed());
+	}
+
+	SECTION("a voice is added only once")
+	{
+		const auto voice = std::make_shared<ConstantVoice>(0.5f, Frames);
+
+		AddVoice(mixer, voice);
+		AddVoice(mixer, voice);
+
+		REQUIRE(mixer.num_voices() == 1);
+	}
+
+	SECTION("MixStereo applies the left and right gains")
+	{
+		// SIMD で処理されない端数のフレームも含む
+		const Array<float> src = { 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f };
+
+		Array<float> dst(src.size(), 1.0f);
+
+		AudioMixer_AL::MixStereo(dst.data(), src.data(), 3, 0.5f, 2.0f);
+
+		REQUIRE(dst == Array<float>{ 1.5f, 3.0f, 2.0f, 5.0f, 2.5f, 7.0f });
+	}
+}
+
+TEST_CASE("AudioMixer_AL.MixWhileThreadRunning")
+{
+	constexpr size_t Frames = AudioMixer_AL::BufferFrames;
+
+	// ヌルデバイスの合成スレッドと並行して mix() を呼ぶ
+	AudioMixer_AL mixer;
+
+	mixer.init(false);
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		AddVoice(mixer, std::make_shared<ConstantVoice>(0.125f, std::numeric_limits<size_t>::max()));
+	}
+
+	Array<float> buffer(Frames * 2);
+
+	bool allMixed = true;
+
+	for (size_t i = 0; i < 200; ++i)
+	{
+		mixer.mix(buffer.data(), Frames);
+
+		allMixed &= buffer.all([](const float s) { return (s == 1.0f); });
+	}
+
+	REQUIRE(allMixed);
+	REQUIRE(mixer.num_voices() == 8);
+}
+
+TEST_CASE("AudioMixer_AL.Benchmark")
+{
+	constexpr size_t Frames = AudioMixer_AL::BufferFrames;
+
+	// 効果音 200 個を同時に再生する場合の、1 秒分 (約 43 バッファ) の合成時間
+	constexpr size_t NumVoices = 200;
+
+	constexpr size_t NumBuffers = (AudioMixer_AL::SamplingRate / Frames) + 1;
+
+	AudioMixer_AL mixer;
+
+	for (size_t i = 0; i < NumVoices; ++i)
+	{
+		AddVoice(mixer, std::make_shared<ConstantVoice>(0.001f, std::numeric_limits<size_t>::max(), 0.5f));
+	}
+
+	Array<float> buffer(Frames * 2);
+
+	BENCHMARK("mix 200 voices for 1 second")
+	{
+		for (size_t i = 0; i < NumBuffers; ++i)
+		{
+			mixer.mix(buffer.data(), Frames);
+		}
+	}
+
+	REQUIRE(buffer[0] == Approx(NumVoices * 0.001f * 0.5f));
+}
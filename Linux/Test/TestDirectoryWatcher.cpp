@@ -0,0 +1,165 @@
+﻿
+# include <chrono>
+# include <fstream>
+# include <thread>
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+namespace
+{
+	using Change = std::pair<FilePath, FileAction>;
+
+	// DirectoryWatcherDetail::LatencySec と同じ値
+	constexpr int32 LatencyMillisec = 250;
+
+	// 変更が LatencySec の後に届くまでの許容時間
+	constexpr int32 MaxDeliveryMillisec = 1000;
+
+	void WriteFile(const FilePath& path, const char* text)
+	{
+		std::ofstream(path.narrow(), std::ios::app) << text;
+	}
+
+	// expectedCount 個の変更が届くまで待ち、その後に届いた余分な変更も集める
+	Array<Change> WaitForChanges(const DirectoryWatcher& watcher, const size_t expectedCount, int32* pLatencyMillisec = nullptr)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		const auto start = Clock::now();
+
+		Array<Change> changes;
+
+		while ((changes.size() < expectedCount)
+			&& ((Clock::now() - start) < std::chrono::milliseconds(MaxDeliveryMillisec * 3)))
+		{
+			changes.append(watcher.retrieveChanges());
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if (pLatencyMillisec)
+		{
+			*pLatencyMillisec = static_cast<int32>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(LatencyMillisec * 2));
+
+		changes.append(watcher.retrieveChanges());
+
+		return changes;
+	}
+}
+
+TEST_CASE("DirectoryWatcher")
+{
+	const FilePath directory = FileSystem::UniqueFilePath() + U'/';
+
+	REQUIRE(FileSystem::CreateDirectories(directory));
+
+	const FilePath existingFile = directory + U"existing.txt";
+
+	WriteFile(existingFile, "0");
+
+	{
+		const DirectoryWatcher watcher(directory);
+
+		REQUIRE(watcher.isOpened());
+
+		SECTION("create")
+		{
+			const FilePath path = directory + U"a.txt";
+
+			WriteFile(path, "a");
+
+			int32 latency = 0;
+
+			const auto changes = WaitForChanges(watcher, 1, &latency);
+
+			REQUIRE(changes.size() == 1);
+			REQUIRE(changes.includes(Change{ path, FileAction::Added }));
+			REQUIRE(latency >= LatencyMillisec);
+			REQUIRE(latency < MaxDeliveryMillisec);
+		}
+
+		SECTION("modify")
+		{
+			// 連続した書き込みは 1 つの Modified にまとめられる
+			for (int32 i = 0; i < 50; ++i)
+			{
+				WriteFile(existingFile, "b");
+			}
+
+			int32 latency = 0;
+
+			const auto changes = WaitForChanges(watcher, 1, &latency);
+
+			REQUIRE(changes.size() == 1);
+			REQUIRE(changes.includes(Change{ existingFile, FileAction::Modified }));
+			REQUIRE(latency < MaxDeliveryMillisec);
+		}
+
+		SECTION("rename")
+		{
+			const FilePath path = directory + U"renamed.txt";
+
+			REQUIRE(FileSystem::Rename(existingFile, path));
+
+			const auto changes = WaitForChanges(watcher, 2);
+
+			REQUIRE(changes.size() == 2);
+			REQUIRE(changes.includes(Change{ existingFile, FileAction::Removed }));
+			REQUIRE(changes.includes(Change{ path, FileAction::Added }));
+		}
+
+		SECTION("Added + Removed is cancelled")
+		{
+			const FilePath path = directory + U"temp.swp";
+
+			WriteFile(path, "c");
+
+			REQUIRE(FileSystem::Remove(path));
+
+			REQUIRE(WaitForChanges(watcher, 0).isEmpty());
+		}
+
+		SECTION("Removed + Added becomes Modified")
+		{
+			REQUIRE(FileSystem::Remove(existingFile));
+
+			WriteFile(existingFile, "d");
+
+			const auto changes = WaitForChanges(watcher, 1);
+
+			REQUIRE(changes.size() == 1);
+			REQUIRE(changes.includes(Change{ existingFile, FileAction::Modified }));
+		}
+
+		SECTION("new subdirectories are watched recursively")
+		{
+			const FilePath subDirectory = directory + U"new/";
+			const FilePath deepDirectory = subDirectory + U"deep/";
+			const FilePath path = deepDirectory + U"e.txt";
+
+			REQUIRE(FileSystem::CreateDirectories(deepDirectory));
+
+			WriteFile(path, "e");
+
+			const auto changes = WaitForChanges(watcher, 3);
+
+			REQUIRE(changes.size() == 3);
+			REQUIRE(changes.includes(Change{ directory + U"new", FileAction::Added }));
+			REQUIRE(changes.includes(Change{ subDirectory + U"deep", FileAction::Added }));
+			REQUIRE(changes.includes(Change{ path, FileAction::Added }));
+
+			// 後から作られたディレクトリ内の変更も通知される
+			WriteFile(path, "f");
+
+			const auto modified = WaitForChanges(watcher, 1);
+
+			REQUIRE(modified.size() == 1);
+			REQUIRE(modified.includes(Change{ path, FileAction::Modified }));
+		}
+	}
+
+	FileSystem::Remove(directory);
+}
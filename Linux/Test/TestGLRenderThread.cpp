@@ -0,0 +1,148 @@
+﻿# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Graphics/GL/GLRenderThread.hpp>
+
+namespace
+{
+	// GL を使わずに時間を消費する（メインスレッドのゲームロジックと記録の代わり）
+	// CPU が 1 つの環境でも描画スレッドが動けるよう、待つ間は yield する
+	void Spin(const std::chrono::microseconds duration)
+	{
+		const auto end = std::chrono::steady_clock::now() + duration;
+
+		while (std::chrono::steady_clock::now() < end)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	constexpr size_t NumFrames = 30;
+
+	constexpr size_t UploadsPerFrame = 4;
+
+	constexpr std::chrono::microseconds RecordTime{ 4000 };
+
+	constexpr std::chrono::microseconds SubmitTime{ 4000 };
+
+	// フレームの最初に動的テクスチャを更新し、記録してから描画スレッドに渡す、を NumFrames 回繰り返す
+	// waitForUploads が true のときは、各更新で描画スレッドの完了を待つ（GL を呼ぶ前に描画スレッドを待っていた以前の方式）
+	std::chrono::microseconds RunFrames(const bool waitForUploads)
+	{
+		size_t uploads = 0;
+
+		GLRenderThread renderThread(nullptr, []() { std::this_thread::sleep_for(SubmitTime); });
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (size_t frame = 0; frame < NumFrames; ++frame)
+		{
+			for (size_t i = 0; i < UploadsPerFrame; ++i)
+			{
+				if (waitForUploads)
+				{
+					renderThread.invoke([&uploads]() { ++uploads; });
+				}
+				else
+				{
+					renderThread.post([&uploads]() { ++uploads; });
+				}
+			}
+
+			Spin(RecordTime);
+
+			renderThread.wait();
+
+			renderThread.kick();
+		}
+
+		renderThread.wait();
+
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		renderThread.invoke([]() {});
+
+		REQUIRE(uploads == (NumFrames * UploadsPerFrame));
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+	}
+}
+
+TEST_CASE("GLRenderThread.CommandOrder")
+{
+	Array<String> log;
+
+	GLRenderThread renderThread(nullptr, [&log]() { log << U"frame"; });
+
+	SECTION("posted commands and frames run in the order they were queued")
+	{
+		renderThread.post([&log]() { log << U"upload 1"; });
+
+		renderThread.kick();
+
+		renderThread.post([&log]() { log << U"upload 2"; });
+
+		renderThread.invoke([&log]() { log << U"create"; });
+
+		REQUIRE(log == Array<String>{ U"upload 1", U"frame", U"upload 2", U"create" });
+	}
+
+	SECTION("commands run on the render thread")
+	{
+		bool onRenderThread = false;
+
+		renderThread.invoke([&]() { onRenderThread = renderThread.isRenderThread(); });
+
+		REQUIRE(onRenderThread);
+		REQUIRE_FALSE(renderThread.isRenderThread());
+	}
+
+	SECTION("exceptions are rethrown on the main thread")
+	{
+		REQUIRE_THROWS_AS(renderThread.invoke([]() { throw std::runtime_error("invoke"); }), std::runtime_error);
+
+		renderThread.post([]() { throw std::runtime_error("post"); });
+
+		// post() した処理の例外は、次の wait() で受け取る
+		renderThread.invoke([]() {});
+
+		REQUIRE_THROWS_AS(renderThread.wait(), std::runtime_error);
+		REQUIRE_NOTHROW(renderThread.wait());
+	}
+}
+
+TEST_CASE("GLRenderThread.DrainOnDestruction")
+{
+	size_t count = 0;
+
+	{
+		GLRenderThread renderThread(nullptr, []() {});
+
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			renderThread.post([&count]() { ++count; });
+		}
+	}
+
+	REQUIRE(count == 1000);
+}
+
+TEST_CASE("GLRenderThread.FrameTime")
+{
+	std::chrono::microseconds waiting{ 0 }, queued{ 0 };
+
+	BENCHMARK("30 frames, uploads wait for the render thread (old)")
+	{
+		waiting = RunFrames(true);
+	}
+
+	BENCHMARK("30 frames, uploads queued to the render thread (new)")
+	{
+		queued = RunFrames(false);
+	}
+
+	// 待つ場合は記録と発行が重ならず、1 フレームに RecordTime + SubmitTime かかる
+	REQUIRE(waiting >= (RecordTime + SubmitTime) * NumFrames);
+
+	// キューに積む場合は記録と発行が重なる
+	REQUIRE(queued < waiting * 4 / 5);
+}
@@ -0,0 +1,156 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Logger/LogQueue.hpp>
+
+namespace
+{
+	// LogQueue::Capacity と同じ値
+	constexpr size_t QueueCapacity = 8192;
+
+	constexpr size_t MaxRecordsPerProducer = 1'000'000;
+
+	// timeStamp にスレッドの番号と追加した順番を入れる
+	LogRecord MakeRecord(const size_t producer, const size_t index)
+	{
+		LogRecord record;
+		record.timeStamp = static_cast<int64>(producer * MaxRecordsPerProducer + index);
+		record.desc = static_cast<LogDescription>(producer % 2);
+		record.text = U"Log record";
+		return record;
+	}
+
+	// 書き込みスレッドと同じ手順で、count 個のレコードを取り出す
+	Array<LogRecord> Consume(LogQueue& queue, const size_t count)
+	{
+		Array<LogRecord> records;
+
+		LogRecord record;
+
+		while (records.size() < count)
+		{
+			if (queue.pop(record))
+			{
+				records.push_back(std::move(record));
+			}
+			else
+			{
+				queue.wait(std::chrono::milliseconds(10));
+			}
+		}
+
+		return records;
+	}
+}
+
+TEST_CASE("LogQueue.MultipleProducers")
+{
+	constexpr size_t NumProducers = 8;
+
+	// 1 つのスレッドだけでキューが満杯になる数
+	constexpr size_t RecordsPerProducer = (QueueCapacity * 2);
+
+	LogQueue queue;
+
+	Array<std::thread> producers;
+
+	for (size_t producer = 0; producer < NumProducers; ++producer)
+	{
+		producers.emplace_back([&queue, producer]()
+		{
+			for (size_t i = 0; i < RecordsPerProducer; ++i)
+			{
+				queue.push(MakeRecord(producer, i));
+			}
+		});
+	}
+
+	const Array<LogRecord> records = Consume(queue, NumProducers * RecordsPerProducer);
+
+	for (auto& producer : producers)
+	{
+		producer.join();
+	}
+
+	LogRecord extra;
+
+	REQUIRE_FALSE(queue.pop(extra));
+
+	// 各スレッドのレコードは、追加された順にちょうど 1 回ずつ取り出される
+	Array<size_t> nextIndex(NumProducers, 0);
+
+	bool inOrder = true;
+
+	for (const auto& record : records)
+	{
+		const size_t producer = (static_cast<size_t>(record.timeStamp) / MaxRecordsPerProducer);
+		const size_t index = (static_cast<size_t>(record.timeStamp) % MaxRecordsPerProducer);
+
+		inOrder &= (index == nextIndex[producer]);
+		inOrder &= (record.desc == static_cast<LogDescription>(producer % 2));
+		inOrder &= (record.text == U"Log record");
+
+		nextIndex[producer] = (index + 1);
+	}
+
+	REQUIRE(inOrder);
+	REQUIRE(nextIndex.all([](const size_t n) { return (n == RecordsPerProducer); }));
+}
+
+TEST_CASE("LogQueue.Wait")
+{
+	LogQueue queue;
+
+	SECTION("a push wakes the waiting writer")
+	{
+		std::thread producer([&queue]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+			queue.push(MakeRecord(0, 0));
+		});
+
+		const auto start = std::chrono::steady_clock::now();
+
+		LogRecord record;
+
+		while (!queue.pop(record))
+		{
+			queue.wait(std::chrono::seconds(10));
+		}
+
+		const auto elapsed = (std::chrono::steady_clock::now() - start);
+
+		producer.join();
+
+		REQUIRE(elapsed < std::chrono::seconds(5));
+	}
+
+	SECTION("close() releases a producer blocked on a full queue")
+	{
+		for (size_t i = 0; i < QueueCapacity; ++i)
+		{
+			queue.push(MakeRecord(0, i));
+		}
+
+		std::atomic<bool> returned = false;
+
+		std::thread producer([&]()
+		{
+			queue.push(MakeRecord(0, QueueCapacity));
+
+			returned = true;
+		});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		REQUIRE_FALSE(returned);
+
+		queue.close();
+
+		producer.join();
+
+		REQUIRE(returned);
+		REQUIRE(queue.isClosed());
+	}
+}
@@ -0,0 +1,396 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Renderer2D/Vertex2DBuilder.hpp>
+# include <Renderer2D/GL/GLSpriteBatch.hpp>
+# include <Renderer2D/GL/GLRenderer2DCommand.hpp>
+# include <Renderer2D/SortedDrawRecorder.hpp>
+# include <ParticleSystem2D/ParticleBuffer2D.hpp>
+
+// GL コンテキストを使わずに、CRenderer2D_GL と同じ手順で 1 フレームを記録する
+namespace
+{
+	struct RecordedFrame
+	{
+		GLRenderer2DCommand commands;
+
+		GLSpriteBatch batches;
+	};
+
+	void AddRects(RecordedFrame& frame, const size_t count)
+	{
+		const BufferCreator bufferCreator(frame.batches, frame.commands);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const FloatRect rect(static_cast<float>(i % 100), static_cast<float>(i / 100), 1.0f, 1.0f);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildRect(bufferCreator, rect, Float4(1.0f, 1.0f, 1.0f, 1.0f)))
+			{
+				frame.commands.pushPS(0);
+				frame.commands.pushDraw(indexCount);
+			}
+		}
+	}
+
+	// CRenderer2D_GL::addParticles() と同じ手順で、1 つのシステムの粒子を記録する
+	void AddParticles(RecordedFrame& frame, const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table)
+	{
+		const BufferCreator bufferCreator(frame.batches, frame.commands);
+
+		if (const uint16 indexCount = Vertex2DBuilder::BuildParticles(bufferCreator, particles, 0, particles.size(), table))
+		{
+			frame.commands.pushPS(0);
+			frame.commands.pushDraw(indexCount);
+		}
+	}
+
+	// 2 つのピクセルシェーダを交互に使って、描画順に依存しない矩形を記録する
+	void AddInterleavedRects(RecordedFrame& frame, SortedDrawRecorder* sortedDraws, const size_t count)
+	{
+		const BufferCreator bufferCreator = sortedDraws
+			? BufferCreator(*sortedDraws, frame.commands) : BufferCreator(frame.batches, frame.commands);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const FloatRect rect(static_cast<float>(i % 100), static_cast<float>(i / 100), 1.0f, 1.0f);
+			const size_t psIndex = (i % 2);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildRect(bufferCreator, rect, Float4(1.0f, 1.0f, 1.0f, 1.0f)))
+			{
+				if (sortedDraws)
+				{
+					sortedDraws->commit(psIndex, indexCount);
+				}
+				else
+				{
+					frame.commands.pushPS(psIndex);
+					frame.commands.pushDraw(indexCount);
+				}
+			}
+		}
+
+		if (sortedDraws)
+		{
+			sortedDraws->flush(frame.batches, frame.commands);
+		}
+	}
+
+	using BufferCreatorFunc = std::function<std::tuple<Vertex2D*, Vertex2D::IndexType*, Vertex2D::IndexType>(Vertex2D::IndexType, Vertex2D::IndexType)>;
+
+	// BufferCreator 導入前の Vertex2DBuilder::BuildRect() と同じく、std::function を値で受け取る
+	[[gnu::noinline]] uint16 BuildRectWithFunction(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color)
+	{
+		constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
+		constexpr Vertex2D::IndexType RectIndexTable[6] = { 0, 1, 2, 2, 1, 3 };
+		auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+		if (!pVertex)
+		{
+			return 0;
+		}
+
+		pVertex[0].set(rect.left, rect.top, color);
+		pVertex[1].set(rect.right, rect.top, color);
+		pVertex[2].set(rect.left, rect.bottom, color);
+		pVertex[3].set(rect.right, rect.bottom, color);
+
+		for (Vertex2D::IndexType i = 0; i < indexSize; ++i)
+		{
+			*pIndex++ = (indexOffset + RectIndexTable[i]);
+		}
+
+		return indexSize;
+	}
+
+	size_t CountCommands(const GLRenderer2DCommand& commands, const RendererCommand command)
+	{
+		return commands.getList().count_if([=](const auto& c) { return c.first == command; });
+	}
+}
+
+TEST_CASE("GLRenderer2D.Recording")
+{
+	RecordedFrame frame;
+
+	SECTION("small frame fits in one batch")
+	{
+		AddRects(frame, 100);
+
+		frame.commands.flush();
+
+		REQUIRE(frame.batches.num_batches() == 1);
+
+		const BatchData batch = frame.batches.getBatch(0);
+
+		REQUIRE(batch.vertexSize == 400);
+		REQUIRE(batch.indexSize == 600);
+		REQUIRE(batch.pVertex[4].pos == Float2(1.0f, 0.0f));
+	}
+
+	SECTION("large frame is split into batches")
+	{
+		// 1 バッチの頂点数の上限 (65535) を超える
+		constexpr size_t NumRects = 40000;
+
+		AddRects(frame, NumRects);
+
+		frame.commands.flush();
+
+		const size_t numBatches = frame.batches.num_batches();
+
+		REQUIRE(numBatches == 3);
+
+		// 最初のバッチの UpdateBuffers は reset() が記録する
+		REQUIRE(CountCommands(frame.commands, RendererCommand::UpdateBuffers) == numBatches);
+
+		size_t totalVertices = 0, totalIndices = 0;
+
+		for (size_t i = 0; i < numBatches; ++i)
+		{
+			const BatchData batch = frame.batches.getBatch(i);
+
+			REQUIRE(batch.vertexSize <= GLSpriteBatch::VertexBufferSize);
+
+			totalVertices += batch.vertexSize;
+			totalIndices += batch.indexSize;
+		}
+
+		REQUIRE(totalVertices == NumRects * 4);
+		REQUIRE(totalIndices == NumRects * 6);
+
+		// 各バッチは記録された順に並んでいる
+		const BatchData second = frame.batches.getBatch(1);
+
+		REQUIRE(second.pVertex == (frame.batches.getBatch(0).pVertex + frame.batches.getBatch(0).vertexSize));
+	}
+}
+
+TEST_CASE("GLRenderer2D.DoubleBufferedFrames")
+{
+	// CRenderer2D_GL::endRecording() と同じ手順で、記録用と発行用のフレームを入れ替える
+	std::array<RecordedFrame, 2> frames;
+
+	RecordedFrame* recording = &frames[0];
+	RecordedFrame* submitting = &frames[1];
+
+	const Float4 colorMul(0.5f, 0.25f, 1.0f, 1.0f);
+	const Rect scissorRect(10, 20, 30, 40);
+
+	recording->commands.pushColorMul(colorMul);
+	recording->commands.pushScissorRect(scissorRect);
+	recording->commands.pushLocalTransform(Mat3x2::Scale(2.0));
+
+	AddRects(*recording, 10);
+
+	recording->commands.flush();
+
+	std::swap(recording, submitting);
+
+	recording->commands.reset(submitting->commands);
+	recording->batches.reset();
+
+	SECTION("the next frame inherits the last state")
+	{
+		REQUIRE(recording->commands.getCurrentColorMul() == colorMul);
+		REQUIRE(recording->commands.getColorMul(0) == colorMul);
+		REQUIRE(recording->commands.getCurrentScissorRect() == scissorRect);
+		REQUIRE(recording->commands.getCurrentLocalTransform() == Mat3x2::Scale(2.0));
+		REQUIRE(recording->commands.getCurrentMaxScaling() == Approx(2.0f));
+	}
+
+	SECTION("recording the next frame leaves the submitted frame intact")
+	{
+		const auto submittedCommands = submitting->commands.getList();
+
+		const BatchData submittedBatch = submitting->batches.getBatch(0);
+
+		const Array<Vertex2D> submittedVertices(submittedBatch.pVertex, submittedBatch.pVertex + submittedBatch.vertexSize);
+
+		AddRects(*recording, 1000);
+
+		recording->commands.pushColorMul(Float4(0.0f, 0.0f, 0.0f, 1.0f));
+
+		recording->commands.flush();
+
+		const bool commandsUnchanged = (submitting->commands.getList() == submittedCommands);
+
+		REQUIRE(commandsUnchanged);
+		REQUIRE(submitting->commands.getCurrentColorMul() == colorMul);
+		REQUIRE(submitting->batches.getBatch(0).vertexSize == 40);
+		REQUIRE(std::equal(submittedVertices.begin(), submittedVertices.end(), submitting->batches.getBatch(0).pVertex,
+			[](const Vertex2D& a, const Vertex2D& b) { return (a.pos == b.pos) && (a.color == b.color); }));
+		REQUIRE(recording->batches.getBatch(0).vertexSize == 4000);
+	}
+}
+
+TEST_CASE("GLRenderer2D.ParticleSystemBatching")
+{
+	// ParticleSystem2D::DrawAll() は、状態が同じシステムを続けて記録する
+	RecordedFrame frame;
+
+	const ParticleLifeTimeTable2D table;
+
+	std::array<ParticleBuffer2D, 3> systems;
+
+	for (auto& particles : systems)
+	{
+		for (size_t i = 0; i < 50; ++i)
+		{
+			Particle2D particle;
+			particle.position = Float2(static_cast<float>(i), 0.0f);
+			particle.velocity = Float2(0.0f, 0.0f);
+			particle.startColor = Float4(1.0f, 1.0f, 1.0f, 1.0f);
+			particle.startSize = 4.0f;
+			particle.rotation = 0.0f;
+			particle.startAngularVelocity = 0.0f;
+			particle.startLifeTime = 1.0f;
+			particle.remainingLifeTime = 0.5f;
+
+			particles.push_back(particle);
+		}
+	}
+
+	SECTION("systems with the same state are merged into one draw call")
+	{
+		for (const auto& particles : systems)
+		{
+			AddParticles(frame, particles, table);
+		}
+
+		frame.commands.flush();
+
+		REQUIRE(CountCommands(frame.commands, RendererCommand::Draw) == 1);
+		REQUIRE(frame.commands.getDraw(0).indexCount == (3 * 50 * 6));
+		REQUIRE(frame.batches.num_batches() == 1);
+	}
+
+	SECTION("a state change between systems starts a new draw call")
+	{
+		AddParticles(frame, systems[0], table);
+
+		frame.commands.pushBlendState(BlendState::Additive);
+
+		AddParticles(frame, systems[1], table);
+		AddParticles(frame, systems[2], table);
+
+		frame.commands.flush();
+
+		REQUIRE(CountCommands(frame.commands, RendererCommand::Draw) == 2);
+		REQUIRE(frame.commands.getDraw(1).indexCount == (2 * 50 * 6));
+	}
+}
+
+TEST_CASE("GLRenderer2D.SortedDraws")
+{
+	constexpr size_t NumRects = 1000;
+
+	SECTION("unsorted draws issue one draw call per shader change")
+	{
+		RecordedFrame frame;
+
+		AddInterleavedRects(frame, nullptr, NumRects);
+
+		frame.commands.flush();
+
+		REQUIRE(CountCommands(frame.commands, RendererCommand::Draw) == NumRects);
+	}
+
+	SECTION("sorted draws issue one draw call per shader")
+	{
+		RecordedFrame frame;
+
+		SortedDrawRecorder sortedDraws;
+
+		AddInterleavedRects(frame, &sortedDraws, NumRects);
+
+		REQUIRE(sortedDraws.isEmpty());
+
+		frame.commands.flush();
+
+		REQUIRE(CountCommands(frame.commands, RendererCommand::Draw) == 2);
+		REQUIRE(frame.commands.getDraw(0).indexCount == (NumRects / 2 * 6));
+		REQUIRE(frame.commands.getDraw(1).indexCount == (NumRects / 2 * 6));
+
+		// 偶数番目の矩形が先にまとめて書き出される
+		const BatchData batch = frame.batches.getBatch(0);
+
+		REQUIRE(batch.vertexSize == (NumRects * 4));
+		REQUIRE(batch.pVertex[4].pos == Float2(2.0f, 0.0f));
+		REQUIRE(batch.pIndex[6] == 4);
+		REQUIRE(batch.pIndex[NumRects / 2 * 6] == (NumRects / 2 * 4));
+	}
+
+	SECTION("the recorder is reused for the next frame")
+	{
+		SortedDrawRecorder sortedDraws;
+
+		for (size_t n = 0; n < 3; ++n)
+		{
+			RecordedFrame frame;
+
+			AddInterleavedRects(frame, &sortedDraws, (NumRects >> n));
+
+			frame.commands.flush();
+
+			REQUIRE(CountCommands(frame.commands, RendererCommand::Draw) == 2);
+			REQUIRE(frame.batches.getBatch(0).vertexSize == ((NumRects >> n) * 4));
+		}
+	}
+}
+
+TEST_CASE("GLRenderer2D.BufferCreatorBenchmark")
+{
+	// 1 フレームに 100,000 個の矩形を記録する
+	constexpr size_t NumRects = 100000;
+
+	RecordedFrame frame;
+
+	const Float4 color(1.0f, 1.0f, 1.0f, 1.0f);
+
+	size_t indexCountOld = 0, indexCountNew = 0;
+
+	// 配列の確保を測定に含めないよう、先に 1 フレーム記録しておく
+	AddRects(frame, NumRects);
+
+	BENCHMARK("100000 rects through std::function (old)")
+	{
+		frame.commands.reset();
+		frame.batches.reset();
+
+		// CRenderer2D_GL が以前保持していた、this をキャプチャするラムダ
+		const BufferCreatorFunc bufferCreator = [&frame](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+		{
+			return frame.batches.getBuffer(vertexSize, indexSize, frame.commands);
+		};
+
+		indexCountOld = 0;
+
+		for (size_t i = 0; i < NumRects; ++i)
+		{
+			const FloatRect rect(static_cast<float>(i % 100), static_cast<float>(i / 100), 1.0f, 1.0f);
+
+			indexCountOld += BuildRectWithFunction(bufferCreator, rect, color);
+		}
+	}
+
+	BENCHMARK("100000 rects through BufferCreator (new)")
+	{
+		frame.commands.reset();
+		frame.batches.reset();
+
+		const BufferCreator bufferCreator(frame.batches, frame.commands);
+
+		indexCountNew = 0;
+
+		for (size_t i = 0; i < NumRects; ++i)
+		{
+			const FloatRect rect(static_cast<float>(i % 100), static_cast<float>(i / 100), 1.0f, 1.0f);
+
+			indexCountNew += Vertex2DBuilder::BuildRect(bufferCreator, rect, color);
+		}
+	}
+
+	REQUIRE(indexCountOld == (NumRects * 6));
+	REQUIRE(indexCountNew == indexCountOld);
+}
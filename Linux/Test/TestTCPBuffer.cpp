@@ -0,0 +1,313 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Network/TCPBuffer.hpp>
+
+namespace
+{
+	// I/O スレッドと同じ手順で、受信したデータを書き込む。書き込めた大きさを返す
+	size_t Receive(detail::TCPReceiveBuffer& buffer, const Byte* data, const size_t size)
+	{
+		std::array<std::pair<Byte*, size_t>, 2> regions;
+
+		if (buffer.prepare(regions) != detail::TCPReceiveBuffer::PrepareResult::OK)
+		{
+			return 0;
+		}
+
+		size_t written = 0;
+
+		for (const auto& region : regions)
+		{
+			const size_t n = Min(region.second, (size - written));
+
+			std::memcpy(region.first, data + written, n);
+
+			written += n;
+		}
+
+		buffer.commit(written);
+
+		return written;
+	}
+
+	// 書き込めなくなるまで Receive() を繰り返す
+	size_t ReceiveAll(detail::TCPReceiveBuffer& buffer, const Byte* data, const size_t size)
+	{
+		size_t written = 0;
+
+		while (written < size)
+		{
+			const size_t n = Receive(buffer, data + written, (size - written));
+
+			if (n == 0)
+			{
+				break;
+			}
+
+			written += n;
+		}
+
+		return written;
+	}
+
+	Array<Byte> Concat(const Array<Array<Byte>>& chunks)
+	{
+		Array<Byte> bytes;
+
+		for (const auto& chunk : chunks)
+		{
+			bytes.append(chunk);
+		}
+
+		return bytes;
+	}
+
+	Array<Byte> MakeMessage(const Array<Byte>& payload)
+	{
+		detail::TCPSendQueue queue;
+
+		queue.pushMessage(payload.data(), payload.size());
+
+		return Concat(queue.beginSend());
+	}
+
+	Array<Byte> MakePayload(const size_t size, const uint8 seed)
+	{
+		Array<Byte> payload(size);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			payload[i] = static_cast<Byte>(seed + i);
+		}
+
+		return payload;
+	}
+
+	bool Equal(const ByteArrayView view, const Array<Byte>& bytes)
+	{
+		return (view.size() == bytes.size()) && std::equal(view.begin(), view.end(), bytes.begin());
+	}
+}
+
+TEST_CASE("TCPBuffer.SendQueue")
+{
+	detail::TCPSendQueue queue;
+
+	SECTION("only the first push starts sending")
+	{
+		const Array<Byte> a = MakePayload(10, 0), b = MakePayload(20, 100);
+
+		REQUIRE(queue.push(a.data(), a.size()));
+		REQUIRE_FALSE(queue.push(b.data(), b.size()));
+
+		// 小さなデータは 1 つのチャンクにまとめられる
+		const Array<Array<Byte>>& sending = queue.beginSend();
+
+		REQUIRE(sending.size() == 1);
+		REQUIRE(Concat(sending) == Array<Byte>(a).append(b));
+
+		REQUIRE_FALSE(queue.endSend());
+		REQUIRE(queue.push(a.data(), a.size()));
+	}
+
+	SECTION("data queued while sending is sent next")
+	{
+		const Array<Byte> a = MakePayload(10, 0), b = MakePayload(20, 100);
+
+		queue.push(a.data(), a.size());
+
+		REQUIRE(Concat(queue.beginSend()) == a);
+
+		queue.push(b.data(), b.size());
+
+		REQUIRE(queue.endSend());
+		REQUIRE(Concat(queue.beginSend()) == b);
+		REQUIRE_FALSE(queue.endSend());
+	}
+
+	SECTION("large data is split into chunks")
+	{
+		const Array<Byte> a = MakePayload(100 * 1024, 0), b = MakePayload(10, 100);
+
+		queue.push(a.data(), a.size());
+		queue.push(b.data(), b.size());
+
+		const Array<Array<Byte>>& sending = queue.beginSend();
+
+		REQUIRE(sending.size() == 2);
+		REQUIRE(Concat(sending) == Array<Byte>(a).append(b));
+	}
+
+	SECTION("pushMessage() prefixes the little-endian payload size")
+	{
+		const Array<Byte> message = MakeMessage(MakePayload(0x0102, 7));
+
+		REQUIRE(message.size() == (4 + 0x0102));
+		REQUIRE(message[0] == Byte{ 0x02 });
+		REQUIRE(message[1] == Byte{ 0x01 });
+		REQUIRE(message[2] == Byte{ 0x00 });
+		REQUIRE(message[3] == Byte{ 0x00 });
+		REQUIRE(message[4] == Byte{ 7 });
+	}
+}
+
+TEST_CASE("TCPBuffer.ReceiveBuffer")
+{
+	detail::TCPReceiveBuffer buffer;
+
+	bool resume = false;
+
+	SECTION("a message is returned only after all its bytes arrive")
+	{
+		const Array<Byte> payload = MakePayload(100, 1);
+		const Array<Byte> message = MakeMessage(payload);
+
+		bool incomplete = false;
+
+		// 1 バイトずつ届く
+		for (size_t i = 0; i < (message.size() - 1); ++i)
+		{
+			Receive(buffer, &message[i], 1);
+
+			incomplete |= buffer.receiveMessage(resume).has_value();
+		}
+
+		REQUIRE_FALSE(incomplete);
+
+		Receive(buffer, &message.back(), 1);
+
+		const auto view = buffer.receiveMessage(resume);
+
+		REQUIRE(view.has_value());
+		REQUIRE(Equal(*view, payload));
+
+		// ビューは次の読み出し操作で解放される
+		REQUIRE(buffer.available(resume) == 0);
+	}
+
+	SECTION("consecutive messages in one read")
+	{
+		const Array<Byte> a = MakePayload(10, 1), b = MakePayload(0, 0), c = MakePayload(300, 2);
+
+		const Array<Byte> stream = MakeMessage(a).append(MakeMessage(b)).append(MakeMessage(c));
+
+		REQUIRE(Receive(buffer, stream.data(), stream.size()) == stream.size());
+
+		REQUIRE(Equal(*buffer.receiveMessage(resume), a));
+		REQUIRE(Equal(*buffer.receiveMessage(resume), b));
+		REQUIRE(Equal(*buffer.receiveMessage(resume), c));
+		REQUIRE_FALSE(buffer.receiveMessage(resume).has_value());
+	}
+
+	SECTION("a message that wraps around the ring is contiguous")
+	{
+		// 初期容量 (64 KiB) の末尾付近まで読み進めてから、末尾をまたぐメッセージを書き込む
+		const Array<Byte> filler = MakePayload(64 * 1024 - 100, 0);
+
+		Receive(buffer, filler.data(), filler.size());
+
+		REQUIRE(buffer.skip(filler.size(), resume));
+
+		const Array<Byte> payload = MakePayload(1000, 3);
+		const Array<Byte> message = MakeMessage(payload);
+
+		REQUIRE(Receive(buffer, message.data(), message.size()) == message.size());
+
+		const auto view = buffer.receiveMessage(resume);
+
+		REQUIRE(view.has_value());
+		REQUIRE(Equal(*view, payload));
+	}
+
+	SECTION("reads copy and consume the front")
+	{
+		const Array<Byte> data = MakePayload(16, 5);
+
+		Receive(buffer, data.data(), data.size());
+
+		Byte bytes[4] = {};
+
+		REQUIRE(buffer.lookahead(bytes, 4, resume));
+		REQUIRE(buffer.available(resume) == 16);
+		REQUIRE(buffer.read(bytes, 4, resume));
+		REQUIRE(bytes[3] == data[3]);
+		REQUIRE(buffer.available(resume) == 12);
+		REQUIRE_FALSE(buffer.read(bytes, 13, resume));
+	}
+
+	SECTION("the buffer grows while no view is held")
+	{
+		const Array<Byte> data = MakePayload(200 * 1024, 9);
+
+		REQUIRE(ReceiveAll(buffer, data.data(), data.size()) == data.size());
+
+		Array<Byte> read(data.size());
+
+		REQUIRE(buffer.read(read.data(), read.size(), resume));
+		REQUIRE(read == data);
+	}
+
+	SECTION("receiving pauses while a view is held on a full buffer")
+	{
+		const Array<Byte> message = MakeMessage(MakePayload(10, 1));
+
+		Receive(buffer, message.data(), message.size());
+
+		REQUIRE(buffer.receiveMessage(resume).has_value());
+
+		const Array<Byte> filler = MakePayload(64 * 1024, 0);
+
+		// 残りの空き領域を埋める
+		while (Receive(buffer, filler.data(), filler.size()))
+		{
+		}
+
+		std::array<std::pair<Byte*, size_t>, 2> regions;
+
+		REQUIRE(buffer.prepare(regions) == detail::TCPReceiveBuffer::PrepareResult::Paused);
+
+		// ビューを解放すると受信を再開する
+		REQUIRE(buffer.available(resume) == (64 * 1024 - message.size()));
+		REQUIRE(resume);
+		REQUIRE(buffer.prepare(regions) == detail::TCPReceiveBuffer::PrepareResult::OK);
+	}
+}
+
+TEST_CASE("TCPBuffer.Benchmark")
+{
+	// 小さなメッセージを送信キューから受信バッファへ流し、フレーミングの処理量を測る (ソケットは使わない)
+	constexpr size_t NumMessages = 10000;
+
+	const Array<Byte> payload = MakePayload(32, 0);
+
+	detail::TCPSendQueue sendQueue;
+
+	detail::TCPReceiveBuffer receiveBuffer;
+
+	size_t received = 0;
+
+	BENCHMARK("frame and receive 10000 messages of 32 bytes")
+	{
+		for (size_t i = 0; i < NumMessages; ++i)
+		{
+			sendQueue.pushMessage(payload.data(), payload.size());
+		}
+
+		for (const auto& chunk : sendQueue.beginSend())
+		{
+			ReceiveAll(receiveBuffer, chunk.data(), chunk.size());
+		}
+
+		sendQueue.endSend();
+
+		bool resume = false;
+
+		while (receiveBuffer.receiveMessage(resume))
+		{
+			++received;
+		}
+	}
+
+	REQUIRE(received == NumMessages);
+}
@@ -0,0 +1,205 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <TCPServer/TCPServerDetail.hpp>
+
+namespace
+{
+	// pred が true を返すか、タイムアウトするまで待つ
+	template <class Pred>
+	bool WaitUntil(Pred pred)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		while (!pred())
+		{
+			if ((std::chrono::steady_clock::now() - start) > std::chrono::seconds(10))
+			{
+				return false;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		return true;
+	}
+}
+
+TEST_CASE("TCPServer.ServerEventQueue")
+{
+	detail::ServerEventQueue queue;
+
+	SECTION("events are recorded only after enable()")
+	{
+		queue.push(1, TCPSessionEventType::Connected);
+
+		REQUIRE(queue.pop().isEmpty());
+
+		queue.enable();
+
+		queue.push(2, TCPSessionEventType::Connected);
+
+		queue.push(2, TCPSessionEventType::DataReceived);
+
+		const auto events = queue.pop();
+
+		REQUIRE(events.size() == 2);
+		REQUIRE(events[0].id == 2);
+		REQUIRE(events[1].type == TCPSessionEventType::DataReceived);
+
+		REQUIRE(queue.pop().isEmpty());
+	}
+
+	SECTION("the oldest events are dropped beyond MaxEvents")
+	{
+		constexpr size_t Overflow = 1000;
+
+		queue.enable();
+
+		for (size_t i = 0; i < (detail::ServerEventQueue::MaxEvents + Overflow); ++i)
+		{
+			queue.push(i, TCPSessionEventType::Connected);
+		}
+
+		const auto events = queue.pop();
+
+		REQUIRE(events.size() == detail::ServerEventQueue::MaxEvents);
+		REQUIRE(events.front().id == Overflow);
+		REQUIRE(events.back().id == (detail::ServerEventQueue::MaxEvents + Overflow - 1));
+	}
+}
+
+TEST_CASE("TCPServer.Loopback")
+{
+	// 複数の I/O スレッドで、各セッションのデータが送った順に届くことを確かめる
+	constexpr uint16 Port = 50019;
+
+	constexpr size_t NumClients = 64;
+
+	constexpr uint32 NumMessages = 200;
+
+	TCPServer server;
+
+	server.startAcceptMulti(Port, 4);
+
+	Array<std::unique_ptr<TCPClient>> clients;
+
+	for (size_t i = 0; i < NumClients; ++i)
+	{
+		clients.push_back(std::make_unique<TCPClient>());
+
+		clients.back()->connect(IPv4::Localhost(), Port);
+	}
+
+	REQUIRE(WaitUntil([&]() { return (server.num_sessions() == NumClients)
+		&& clients.all([](const auto& client) { return client->isConnected(); }); }));
+
+	SECTION("messages from each client arrive in order")
+	{
+		for (uint32 n = 0; n < NumMessages; ++n)
+		{
+			for (auto& client : clients)
+			{
+				client->sendMessage(n);
+			}
+		}
+
+		HashTable<SessionID, uint32> nextMessage;
+
+		bool inOrder = true;
+
+		const bool received = WaitUntil([&]()
+		{
+			for (const auto& event : server.getEvents())
+			{
+				if (event.type != TCPSessionEventType::DataReceived)
+				{
+					continue;
+				}
+
+				while (const auto message = server.receiveMessage(event.id))
+				{
+					uint32 n = 0;
+
+					std::memcpy(&n, message->data(), sizeof(n));
+
+					inOrder &= ((message->size() == sizeof(n)) && (n == nextMessage[event.id]));
+
+					nextMessage[event.id] = (n + 1);
+				}
+			}
+
+			return (nextMessage.size() == NumClients)
+				&& std::all_of(nextMessage.begin(), nextMessage.end(), [](const auto& p) { return (p.second == NumMessages); });
+		});
+
+		REQUIRE(received);
+		REQUIRE(inOrder);
+	}
+
+	SECTION("messages to each session arrive in order")
+	{
+		for (uint32 n = 0; n < NumMessages; ++n)
+		{
+			for (const auto id : server.getSessionIDs())
+			{
+				server.sendMessage(n, id);
+			}
+		}
+
+		Array<uint32> nextMessage(NumClients, 0);
+
+		bool inOrder = true;
+
+		const bool received = WaitUntil([&]()
+		{
+			for (size_t i = 0; i < NumClients; ++i)
+			{
+				while (const auto message = clients[i]->receiveMessage())
+				{
+					uint32 n = 0;
+
+					std::memcpy(&n, message->data(), sizeof(n));
+
+					inOrder &= ((message->size() == sizeof(n)) && (n == nextMessage[i]));
+
+					nextMessage[i] = (n + 1);
+				}
+			}
+
+			return nextMessage.all([](const uint32 n) { return (n == NumMessages); });
+		});
+
+		REQUIRE(received);
+		REQUIRE(inOrder);
+	}
+
+	SECTION("disconnections are reported once per session")
+	{
+		server.getEvents();
+
+		for (auto& client : clients)
+		{
+			client->disconnect();
+		}
+
+		HashSet<SessionID> disconnected;
+
+		REQUIRE(WaitUntil([&]()
+		{
+			for (const auto& event : server.getEvents())
+			{
+				if (event.type == TCPSessionEventType::Disconnected)
+				{
+					disconnected.insert(event.id);
+				}
+			}
+
+			return (disconnected.size() == NumClients);
+		}));
+
+		REQUIRE(WaitUntil([&]() { return (server.num_sessions() == 0); }));
+	}
+
+	server.disconnect();
+}
@@ -0,0 +1,203 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+
+// createTextures = false のアトラスは CPU 側の画像だけを扱うので、GL コンテキストなしで検証できる
+TEST_CASE("TextureAtlas.Packing")
+{
+	TextureAtlas atlas(Size(64, 64), 0, false);
+
+	const Image image(32, 32, Palette::White);
+
+	SECTION("images fill a page before a new page is added")
+	{
+		Array<TextureAtlas::IDType> ids;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ids.push_back(*atlas.add(image));
+		}
+
+		REQUIRE(atlas.num_pages() == 1);
+		REQUIRE(atlas.num_images() == 4);
+
+		bool overlapped = false;
+
+		for (size_t i = 0; i < ids.size(); ++i)
+		{
+			for (size_t k = (i + 1); k < ids.size(); ++k)
+			{
+				overlapped |= atlas.getRect(ids[i])->intersects(*atlas.getRect(ids[k]));
+			}
+		}
+
+		REQUIRE_FALSE(overlapped);
+
+		const auto fifth = atlas.add(image);
+
+		REQUIRE(fifth);
+		REQUIRE(atlas.num_pages() == 2);
+		REQUIRE(atlas.getPageIndex(*fifth) == size_t(1));
+	}
+
+	SECTION("a removed region is reused")
+	{
+		Array<TextureAtlas::IDType> ids;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ids.push_back(*atlas.add(image));
+		}
+
+		const Rect removedRect = *atlas.getRect(ids[2]);
+
+		REQUIRE(atlas.remove(ids[2]));
+		REQUIRE_FALSE(atlas.contains(ids[2]));
+		REQUIRE_FALSE(atlas.remove(ids[2]));
+
+		// 削除した領域は透明になる
+		REQUIRE(atlas.getPageImage(0)[removedRect.y][removedRect.x] == Color(0, 0));
+
+		const auto id = atlas.add(image);
+
+		REQUIRE(id);
+		REQUIRE(atlas.num_pages() == 1);
+		REQUIRE(atlas.getPageIndex(*id) == size_t(0));
+		REQUIRE(atlas.getRect(*id) == removedRect);
+	}
+
+	SECTION("adjacent free regions are merged")
+	{
+		// 上半分の 2 つを削除すると、64x32 の画像が入る
+		Array<TextureAtlas::IDType> ids;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			ids.push_back(*atlas.add(image));
+		}
+
+		for (const auto id : ids)
+		{
+			if (atlas.getRect(id)->y == 0)
+			{
+				atlas.remove(id);
+			}
+		}
+
+		const auto id = atlas.add(Image(64, 32, Palette::White));
+
+		REQUIRE(id);
+		REQUIRE(atlas.num_pages() == 1);
+		REQUIRE(atlas.getRect(*id) == Rect(0, 0, 64, 32));
+	}
+
+	SECTION("images larger than a page are rejected")
+	{
+		REQUIRE_FALSE(atlas.add(Image(65, 1, Palette::White)));
+		REQUIRE_FALSE(atlas.add(Image()));
+		REQUIRE(atlas.num_pages() == 0);
+	}
+}
+
+TEST_CASE("TextureAtlas.Padding")
+{
+	TextureAtlas atlas(Size(64, 64), 2, false);
+
+	// 左端の列と右端の列で色が異なる画像
+	Image image(4, 3, Palette::Green);
+
+	for (int32 y = 0; y < image.height(); ++y)
+	{
+		image[y][0] = Palette::Red;
+		image[y][3] = Palette::Blue;
+	}
+
+	const auto id = atlas.add(image);
+
+	REQUIRE(id);
+
+	const Rect rect = *atlas.getRect(*id);
+	const Image& page = atlas.getPageImage(0);
+
+	REQUIRE(rect.size == image.size());
+	REQUIRE(rect.pos == Point(2, 2));
+
+	// 余白には端のピクセルが複製される
+	REQUIRE(page[rect.y][rect.x - 1] == Palette::Red);
+	REQUIRE(page[rect.y][rect.x - 2] == Palette::Red);
+	REQUIRE(page[rect.y][rect.x + rect.w] == Palette::Blue);
+	REQUIRE(page[rect.y][rect.x + rect.w + 1] == Palette::Blue);
+	REQUIRE(page[rect.y - 2][rect.x + 1] == Palette::Green);
+	REQUIRE(page[rect.y + rect.h + 1][rect.x + 1] == Palette::Green);
+	REQUIRE(page[rect.y - 2][rect.x - 2] == Palette::Red);
+
+	// 余白を含めてページに収まらない画像は追加できない
+	REQUIRE_FALSE(atlas.add(Image(61, 1, Palette::White)));
+	REQUIRE(atlas.add(Image(60, 1, Palette::White)));
+}
+
+TEST_CASE("TextureAtlas.MaxPages")
+{
+	TextureAtlas atlas(Size(32, 32), 0, false);
+
+	atlas.setMaxPages(1);
+
+	const Image image(16, 16, Palette::White);
+
+	Array<TextureAtlas::IDType> ids;
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		ids.push_back(*atlas.add(image));
+	}
+
+	REQUIRE_FALSE(atlas.add(image));
+	REQUIRE(atlas.num_pages() == 1);
+	REQUIRE(atlas.getMaxPages() == 1);
+
+	// 空きができれば再び追加できる
+	atlas.remove(ids[0]);
+
+	REQUIRE(atlas.add(image));
+
+	// 上限を外すと新しいページが追加される
+	atlas.setMaxPages(0);
+
+	REQUIRE(atlas.add(image));
+	REQUIRE(atlas.num_pages() == 2);
+
+	atlas.clear();
+
+	REQUIRE(atlas.num_pages() == 0);
+	REQUIRE(atlas.num_images() == 0);
+}
+
+TEST_CASE("TextureAtlas.DirtyRect")
+{
+	TextureAtlas atlas(Size(64, 64), 0, false);
+
+	const Image image(16, 16, Palette::White);
+
+	const auto a = atlas.add(image);
+
+	REQUIRE(atlas.getDirtyRect(0) == atlas.getRect(*a));
+
+	// 転送する領域は、変更されたすべての領域を囲む 1 つの矩形にまとめられる
+	const auto b = atlas.add(image);
+
+	const Rect ra = *atlas.getRect(*a), rb = *atlas.getRect(*b);
+	const Rect dirty = *atlas.getDirtyRect(0);
+
+	REQUIRE(dirty.contains(ra));
+	REQUIRE(dirty.contains(rb));
+	REQUIRE(dirty.x == Min(ra.x, rb.x));
+	REQUIRE(dirty.y == Min(ra.y, rb.y));
+	REQUIRE((dirty.x + dirty.w) == Max(ra.x + ra.w, rb.x + rb.w));
+	REQUIRE((dirty.y + dirty.h) == Max(ra.y + ra.h, rb.y + rb.h));
+
+	// テクスチャを作成しない場合、upload() は何もしない
+	atlas.upload();
+
+	REQUIRE(atlas.getDirtyRect(0) == dirty);
+	REQUIRE_FALSE(atlas.getPageTexture(0));
+}
@@ -0,0 +1,134 @@
+﻿
+# include <Siv3D.hpp>
+# include <ThirdParty/Catch2/catch.hpp>
+# include <Threading/WorkerPool.hpp>
+
+TEST_CASE("WorkerPool.ParallelFor")
+{
+	detail::WorkerPool pool(3);
+
+	SECTION("every index is visited once")
+	{
+		constexpr size_t N = 100000;
+
+		std::vector<std::atomic<int32>> visited(N);
+
+		pool.parallelFor(N, 4, [&](const size_t i, size_t)
+		{
+			++visited[i];
+		});
+
+		REQUIRE(std::all_of(visited.begin(), visited.end(), [](const auto& v) { return (v == 1); }));
+	}
+
+	SECTION("concurrent calls never share a worker index")
+	{
+		constexpr size_t NumWorkers = 4;
+
+		std::array<std::atomic<int32>, NumWorkers> running{};
+
+		std::atomic<bool> overlapped = false;
+
+		std::atomic<bool> outOfRange = false;
+
+		pool.parallelFor(1000, NumWorkers, [&](size_t, const size_t workerIndex)
+		{
+			if (workerIndex >= NumWorkers)
+			{
+				outOfRange = true;
+
+				return;
+			}
+
+			if (++running[workerIndex] != 1)
+			{
+				overlapped = true;
+			}
+
+			std::this_thread::yield();
+
+			--running[workerIndex];
+		});
+
+		REQUIRE_FALSE(outOfRange);
+		REQUIRE_FALSE(overlapped);
+	}
+
+	SECTION("small batches run on the calling thread")
+	{
+		const auto caller = std::this_thread::get_id();
+
+		std::atomic<bool> otherThread = false;
+
+		pool.parallelFor(15, 4, [&](size_t, size_t)
+		{
+			if (std::this_thread::get_id() != caller)
+			{
+				otherThread = true;
+			}
+		}, 16);
+
+		REQUIRE_FALSE(otherThread);
+	}
+
+	SECTION("exceptions are rethrown on the calling thread")
+	{
+		REQUIRE_THROWS_AS(pool.parallelFor(1000, 4, [](const size_t i, size_t)
+		{
+			if (i == 500)
+			{
+				throw std::runtime_error("error");
+			}
+		}), std::runtime_error);
+
+		// 例外の後もワーカーは使える
+		std::atomic<size_t> sum = 0;
+
+		pool.parallelFor(100, 4, [&](const size_t i, size_t) { sum += i; });
+
+		REQUIRE(sum == 4950);
+	}
+
+	SECTION("nested and concurrent callers")
+	{
+		std::atomic<size_t> sum = 0;
+
+		std::thread other([&]()
+		{
+			pool.parallelFor(1000, 4, [&](size_t, size_t) { ++sum; });
+		});
+
+		pool.parallelFor(10, 4, [&](size_t, size_t)
+		{
+			pool.parallelFor(100, 4, [&](size_t, size_t) { ++sum; });
+		});
+
+		other.join();
+
+		REQUIRE(sum == 2000);
+	}
+
+	SECTION("resize")
+	{
+		pool.resize(1);
+
+		REQUIRE(pool.num_threads() == 1);
+
+		std::atomic<size_t> sum = 0;
+
+		std::atomic<size_t> maxWorkerIndex = 0;
+
+		pool.parallelFor(100, 8, [&](const size_t i, const size_t workerIndex)
+		{
+			for (size_t current = maxWorkerIndex; current < workerIndex;)
+			{
+				maxWorkerIndex.compare_exchange_weak(current, workerIndex);
+			}
+
+			sum += i;
+		});
+
+		REQUIRE(sum == 4950);
+		REQUIRE(maxWorkerIndex < 2);
+	}
+}
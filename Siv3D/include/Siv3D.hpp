@@ -1004,6 +1004,9 @@
 // 2D グラフィックス設定
 # include <Siv3D/ScopedViewport2D.hpp>
 
+// 2D グラフィックス設定
+# include <Siv3D/ScopedDrawSorting2D.hpp>
+
 // 2D グラフィックス設定
 # include <Siv3D/ScopedColor2D.hpp>
 
@@ -1040,6 +1043,9 @@
 // 動的テクスチャ
 # include <Siv3D/DynamicTexture.hpp>
 
+// テクスチャアトラス
+# include <Siv3D/TextureAtlas.hpp>
+
 // レンダーテクスチャ
 //# include <Siv3D/RenderTexture.hpp>
 
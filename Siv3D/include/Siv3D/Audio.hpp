@@ -59,6 +59,16 @@ namespace s3d
 
 		using IDType = AudioHandle::IDWrapperType;
 
+		/// <summary>
+		/// ファイルをストリーミング再生することを示すタグ
+		/// </summary>
+		struct FileStreaming {};
+
+		/// <summary>
+		/// ファイルをストリーミング再生することを示すタグ
+		/// </summary>
+		static constexpr FileStreaming Stream{};
+
 		/// <summary>
 		/// デフォルトコンストラクタ
 		/// </summary>
@@ -106,6 +116,32 @@ namespace s3d
 
 		Audio(const FilePath& path, Arg::loopBegin_<Duration> loopBegin, Arg::loopEnd_<Duration> loopEnd);
 
+		/// <summary>
+		/// オーディオファイルをストリーミング再生するオーディオを作成します。
+		/// </summary>
+		/// <param name="path">
+		/// オーディオファイルのパス
+		/// </param>
+		/// <remarks>
+		/// ファイル全体を Wave にデコードせず、再生に必要な分だけを少しずつデコードするため、
+		/// 長い BGM の読み込み時間とメモリ使用量を大きく削減できます。
+		/// WAVE と Ogg Vorbis に対応し、それ以外の形式はすべてデコードしてから再生します。
+		/// ストリーミング再生するオーディオの getWave() は空の Wave を返します。
+		/// </remarks>
+		Audio(FileStreaming, const FilePath& path);
+
+		Audio(FileStreaming, const FilePath& path, const Optional<AudioLoopTiming>& loop);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loop_<bool> loop);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loopBegin_<uint64> loopBegin);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loopBegin_<uint64> loopBegin, Arg::loopEnd_<uint64> loopEnd);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loopBegin_<Duration> loopBegin);
+
+		Audio(FileStreaming, const FilePath& path, Arg::loopBegin_<Duration> loopBegin, Arg::loopEnd_<Duration> loopEnd);
+
 		Audio(GMInstrument instrumrnt, uint8 key, const Duration& duration, double velocity = 1.0, Arg::samplingRate_<uint32> samplingRate = Wave::DefaultSamplingRate, float silenceValue = 0.01f);
 
 		explicit Audio(IReader&& reader, AudioFormat format = AudioFormat::Unspecified);
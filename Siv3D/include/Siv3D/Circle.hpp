@@ -465,6 +465,20 @@ namespace s3d
 		/// </returns>
 		const Circle& draw(const ColorF& color = Palette::White) const;
 
+		/// <summary>
+		/// 複数の円をまとめて描きます。
+		/// </summary>
+		/// <param name="circles">
+		/// 円の配列
+		/// </param>
+		/// <param name="color">
+		/// 色
+		/// </param>
+		/// <remarks>
+		/// 描画ステートの確認と頂点の生成を一括で行うため、draw() を繰り返し呼ぶよりも高速です。
+		/// </remarks>
+		static void DrawBatch(const Array<Circle>& circles, const ColorF& color = Palette::White);
+
 		/// <summary>
 		/// 円の枠を描きます。
 		/// </summary>
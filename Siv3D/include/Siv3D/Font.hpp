@@ -81,6 +81,37 @@ namespace s3d
 
 		int32 index = 0;
 	};
+
+	/// <summary>
+	/// フォントのグリフキャッシュの統計
+	/// </summary>
+	struct GlyphCacheStatistics
+	{
+		/// <summary>
+		/// キャッシュにあったグリフを参照した回数
+		/// </summary>
+		size_t hits = 0;
+
+		/// <summary>
+		/// グリフを新たにレンダリングした回数
+		/// </summary>
+		size_t misses = 0;
+
+		/// <summary>
+		/// ページに空きを作るためにグリフを削除した回数
+		/// </summary>
+		size_t evictions = 0;
+
+		/// <summary>
+		/// キャッシュにあるグリフの数
+		/// </summary>
+		size_t num_glyphs = 0;
+
+		/// <summary>
+		/// グリフを格納しているテクスチャのページ数
+		/// </summary>
+		size_t num_pages = 0;
+	};
 	
 	class Font
 	{
@@ -136,8 +167,34 @@ namespace s3d
 
 		[[nodiscard]] int32 height() const;
 
+		/// <summary>
+		/// 文字のグリフを返します。
+		/// </summary>
+		/// <remarks>
+		/// Glyph::texture は、取得したフレームの間だけ有効です。
+		/// グリフキャッシュが上限に達すると、以降のフレームで古いグリフが削除され、その領域は別のグリフに再利用されます。
+		/// </remarks>
+		/// <param name="codePoint">
+		/// 文字
+		/// </param>
+		/// <returns>
+		/// グリフ
+		/// </returns>
 		[[nodiscard]] Glyph getGlyph(char32 codePoint) const;
 
+		/// <summary>
+		/// 文字列の各文字のグリフを返します。
+		/// </summary>
+		/// <remarks>
+		/// Glyph::texture は、取得したフレームの間だけ有効です。
+		/// グリフキャッシュが上限に達すると、以降のフレームで古いグリフが削除され、その領域は別のグリフに再利用されます。
+		/// </remarks>
+		/// <param name="text">
+		/// 文字列
+		/// </param>
+		/// <returns>
+		/// 各文字のグリフ
+		/// </returns>
 		[[nodiscard]] Array<Glyph> getGlyphs(const String& text) const;
 
 		[[nodiscard]] Array<Glyph> getVerticalGlyphs(const String& text) const;
@@ -178,7 +235,55 @@ namespace s3d
 		template <class ... Args>
 		[[nodiscard]] inline DrawableText operator()(const Args& ... args) const;
 
+		/// <summary>
+		/// グリフを格納しているテクスチャを返します。
+		/// </summary>
+		/// <remarks>
+		/// グリフは複数のページに格納されます。この関数は最初のページだけを返すため、ページが 2 つ以上ある場合はエラーを記録します。
+		/// 個々のグリフを描画する場合は getGlyphs() の Glyph::texture を使ってください。
+		/// </remarks>
+		/// <returns>
+		/// 最初のページのテクスチャ
+		/// </returns>
 		[[nodiscard]] const Texture& getTexture() const;
+
+		/// <summary>
+		/// 文字のグリフをあらかじめ作成し、グリフキャッシュに格納します。
+		/// </summary>
+		/// <param name="characters">
+		/// 文字の一覧
+		/// </param>
+		/// <remarks>
+		/// グリフのラスタライズは複数のスレッドで並列に行われ、テクスチャへの転送は最後に 1 回だけ行われます。
+		/// 横書き用のグリフが対象です。
+		/// </remarks>
+		/// <returns>
+		/// すべてのグリフがキャッシュに格納された場合 true, それ以外の場合は false
+		/// </returns>
+		bool preload(StringView characters) const;
+
+		/// <summary>
+		/// グリフキャッシュのページ数の上限を設定します。
+		/// </summary>
+		/// <param name="maxPages">
+		/// ページ数の上限。0 の場合は上限なし
+		/// </param>
+		/// <remarks>
+		/// 上限に達すると、直近のフレームで使われていないグリフから順に削除されます。
+		/// 削除されたグリフの Glyph::texture は無効になります。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void setMaxGlyphCachePages(size_t maxPages) const;
+
+		/// <summary>
+		/// グリフキャッシュの統計を返します。
+		/// </summary>
+		/// <returns>
+		/// グリフキャッシュの統計
+		/// </returns>
+		[[nodiscard]] GlyphCacheStatistics getGlyphCacheStatistics() const;
 	};
 
 	class GlyphIterator
@@ -1074,6 +1074,12 @@ namespace s3d
 	//
 	class DynamicTexture;
 
+	//////////////////////////////////////////////////////
+	//
+	//	TextureAtlas.hpp
+	//
+	class TextureAtlas;
+
 	//////////////////////////////////////////////////////
 	//
 	//	OutlineGlyph.hpp
@@ -1087,6 +1093,7 @@ namespace s3d
 	enum class Typeface;
 	enum class FontStyle : uint32;
 	struct Glyph;
+	struct GlyphCacheStatistics;
 	class Font;
 	class GlyphIterator;
 	struct DrawableText;
@@ -47,5 +47,9 @@ namespace s3d
 		[[nodiscard]] double GetDisplayRefreshRateHz();
 
 		[[nodiscard]] double GetDPIScaling();
+
+		void SetPipelinedRendering(bool enabled);
+
+		[[nodiscard]] bool GetPipelinedRendering();
 	}
 }
@@ -116,5 +116,28 @@ namespace s3d
 		void SetSDFParameters(const Float4& parameters);
 
 		[[nodiscard]] Float4 GetSDFParameters();
+
+		/// <summary>
+		/// 2D 描画の並べ替えを有効にするかを設定します。
+		/// </summary>
+		/// <param name="enabled">
+		/// 有効にする場合 true, それ以外の場合は false
+		/// </param>
+		/// <remarks>
+		/// 有効な間の描画は描画順に依存しないものとして扱われ、同じシェーダとテクスチャを使う描画がまとめて発行されます。
+		/// 描画ステートを変更すると、それまでの描画はその時点で発行されます。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void SetDrawSorting(bool enabled);
+
+		/// <summary>
+		/// 2D 描画の並べ替えが有効であるかを返します。
+		/// </summary>
+		/// <returns>
+		/// 2D 描画の並べ替えが有効である場合 true, それ以外の場合は false
+		/// </returns>
+		[[nodiscard]] bool GetDrawSorting();
 	}
 }
@@ -11,6 +11,7 @@
 
 # pragma once
 # include "Fwd.hpp"
+# include "Threading.hpp"
 # include "NamedParameter.hpp"
 # include "PredefinedNamedParameter.hpp"
 # include "Unspecified.hpp"
@@ -19,6 +20,10 @@
 # include "Rectangle.hpp"
 # include "ImageFormat.hpp"
 
+# ifdef SIV3D_CONCURRENT
+#	include "ConcurrentTask.hpp"
+# endif
+
 namespace s3d
 {
 	enum class AdaptiveMethod
@@ -140,6 +145,9 @@ namespace s3d
 			return (t < y) ? t : (y * 2 - 1) - t;
 		}
 
+		// 画像を行単位のブロックに分け、エンジンの共有ワーカースレッドで f(context, pBegin, pEnd) を並列に呼ぶ
+		void parallelForEachRowBlock(size_t numThreads, void(*f)(void*, Color*, Color*), void* context);
+
 		[[nodiscard]] static constexpr double Biliner(double c1, double c2, double c3, double c4, double px, double py)
 		{
 			return px * py * (c1 - c2 - c3 + c4) + px * (c2 - c1) + py * (c3 - c1) + c1;
@@ -943,13 +951,58 @@ namespace s3d
 		/// <summary>
 		/// すべてのピクセルに変換関数を適用します。
 		/// </summary>
-		/// <param name="function">
+		/// <param name="f">
 		/// 変換関数
 		/// </param>
 		/// <returns>
 		/// *this
 		/// </returns>
-		Image& forEach(std::function<void(Color&)> function);
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Color&>>* = nullptr>
+		Image& forEach(Fty f)
+		{
+			for (auto& pixel : m_data)
+			{
+				f(pixel);
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		/// すべてのピクセルに変換関数を、行単位で並列化して適用します。
+		/// </summary>
+		/// <param name="f">
+		/// 変換関数
+		/// </param>
+		/// <param name="numThreads">
+		/// 使用するスレッド数の最大数
+		/// </param>
+		/// <remarks>
+		/// 変換関数は複数のスレッドから同時に呼ばれます。
+		/// </remarks>
+		/// <returns>
+		/// *this
+		/// </returns>
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Color&>>* = nullptr>
+		Image& parallelForEach(Fty f, size_t numThreads = Threading::GetConcurrency())
+		{
+			if (isEmpty())
+			{
+				return *this;
+			}
+
+			parallelForEachRowBlock(numThreads, [](void* context, Color* pBegin, Color* const pEnd)
+			{
+				Fty& func = *static_cast<Fty*>(context);
+
+				for (; pBegin != pEnd; ++pBegin)
+				{
+					func(*pBegin);
+				}
+			}, &f);
+
+			return *this;
+		}
 
 		Image& swapRB();
 
@@ -957,6 +1010,27 @@ namespace s3d
 
 		bool save(const FilePath& path, ImageFormat format = ImageFormat::Unspecified) const;
 
+	# ifdef SIV3D_CONCURRENT
+
+		/// <summary>
+		/// 画像を非同期でファイルに保存します。
+		/// </summary>
+		/// <param name="path">
+		/// 保存するファイルのパス
+		/// </param>
+		/// <param name="format">
+		/// 画像フォーマット。Unspecified の場合は拡張子から判断します
+		/// </param>
+		/// <remarks>
+		/// 画像のコピーを別スレッドで保存するため、呼び出し後に元の画像を変更しても結果に影響しません。
+		/// </remarks>
+		/// <returns>
+		/// 保存に成功したかを返すタスク
+		/// </returns>
+		[[nodiscard]] ConcurrentTask<bool> saveAsync(const FilePath& path, ImageFormat format = ImageFormat::Unspecified) const;
+
+	# endif
+
 		bool saveWithDialog() const;
 
 		bool savePNG(const FilePath& path, PNGFilter::Flag filterFlag = PNGFilter::Default) const;
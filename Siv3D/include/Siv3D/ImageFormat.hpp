@@ -12,6 +12,8 @@
 # pragma once
 # include "Fwd.hpp"
 # include "Array.hpp"
+# include "PointVector.hpp"
+# include "Threading.hpp"
 
 namespace s3d
 {
@@ -178,6 +180,23 @@ namespace s3d
 
 		virtual Image decode(IReader& reader) const = 0;
 
+		/// <summary>
+		/// 縮小した画像をデコードします。
+		/// </summary>
+		/// <param name="reader">
+		/// 画像データのリーダー
+		/// </param>
+		/// <param name="targetSize">
+		/// 最終的に必要な大きさ
+		/// </param>
+		/// <remarks>
+		/// 既定の実装は原寸でデコードします。縮小デコードに対応するフォーマットはこの関数をオーバーライドします。
+		/// </remarks>
+		/// <returns>
+		/// デコードした画像
+		/// </returns>
+		virtual Image decodeReduced(IReader& reader, const Size& targetSize) const;
+
 		virtual bool encode(const Image& image, IWriter& writer) const = 0;
 
 		virtual bool save(const Image& image, const FilePath& path) const = 0;
@@ -194,5 +213,41 @@ namespace s3d
 		[[nodiscard]] Size GetSize(const FilePath& path);
 
 		[[nodiscard]] Size GetSize(const IReader& reader);
+
+		/// <summary>
+		/// 画像ファイルを、必要な大きさまで縮小しながら読み込みます。
+		/// </summary>
+		/// <param name="path">
+		/// 画像ファイルのパス
+		/// </param>
+		/// <param name="targetSize">
+		/// 最終的に必要な大きさ。Size(0, 0) の場合は原寸で読み込みます
+		/// </param>
+		/// <remarks>
+		/// JPEG は DCT スケーリング (1/2, 1/4, 1/8)、PNG と WebP は縮小デコードを使い、原寸の画像を作りません。
+		/// 返される画像は targetSize に fitted() した結果より小さくならない範囲で縮小されているため、
+		/// 正確な大きさが必要な場合は、さらに fitted() などで調整してください。
+		/// </remarks>
+		/// <returns>
+		/// 読み込んだ画像
+		/// </returns>
+		[[nodiscard]] Image LoadReduced(const FilePath& path, const Size& targetSize);
+
+		/// <summary>
+		/// 複数の画像ファイルを、複数のスレッドで並列に読み込みます。
+		/// </summary>
+		/// <param name="paths">
+		/// 画像ファイルのパス
+		/// </param>
+		/// <param name="targetSize">
+		/// 最終的に必要な大きさ。Size(0, 0) の場合は原寸で読み込みます
+		/// </param>
+		/// <param name="numThreads">
+		/// 使用するスレッド数の最大数
+		/// </param>
+		/// <returns>
+		/// paths と同じ順番で並んだ画像。読み込みに失敗した要素は空の画像になります
+		/// </returns>
+		[[nodiscard]] Array<Image> LoadImages(const Array<FilePath>& paths, const Size& targetSize = Size(0, 0), size_t numThreads = Threading::GetConcurrency());
 	}
 }
@@ -15,6 +15,7 @@
 # include "Array.hpp"
 # include "PointVector.hpp"
 # include "Math.hpp"
+# include "Threading.hpp"
 
 namespace s3d
 {
@@ -32,6 +33,15 @@ namespace s3d
 
 		double agentRadius = 0.25;
 
+		/// <summary>
+		/// タイル 1 枚の一辺のセル数。0 の場合はタイルに分割せず 1 枚のメッシュを作成します。
+		/// </summary>
+		/// <remarks>
+		/// タイルに分割すると、タイルを並列に作成でき、NavMesh::update() で変更のあったタイルだけを作り直せます。
+		/// 32 ～ 128 程度が目安です。
+		/// </remarks>
+		int32 tileSize = 0;
+
 		[[nodiscard]] static constexpr NavMeshConfig Default()
 		{
 			return NavMeshConfig();
@@ -52,10 +62,80 @@ namespace s3d
 
 		~NavMesh();
 
-		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const NavMeshConfig& config = NavMeshConfig::Default());
-
-		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config = NavMeshConfig::Default());
+		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const NavMeshConfig& config = NavMeshConfig::Default(), size_t numThreads = Threading::GetConcurrency());
+
+		/// <summary>
+		/// ナビメッシュを作成します。
+		/// </summary>
+		/// <param name="vertices">
+		/// 地形の頂点
+		/// </param>
+		/// <param name="indices">
+		/// 地形の三角形の頂点インデックス
+		/// </param>
+		/// <param name="areaIDs">
+		/// 三角形ごとの地形の種類
+		/// </param>
+		/// <param name="config">
+		/// 設定
+		/// </param>
+		/// <param name="numThreads">
+		/// タイルの作成に使うスレッド数
+		/// </param>
+		/// <remarks>
+		/// config.tileSize が 0 の場合は numThreads は使われません。
+		/// </remarks>
+		/// <returns>
+		/// 作成に成功した場合 true, それ以外の場合は false
+		/// </returns>
+		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config = NavMeshConfig::Default(), size_t numThreads = Threading::GetConcurrency());
+
+		bool update(const Array<Float3>& vertices, const Array<uint16>& indices, size_t numThreads = Threading::GetConcurrency());
+
+		/// <summary>
+		/// 地形の変更をナビメッシュに反映します。
+		/// </summary>
+		/// <param name="vertices">
+		/// 変更後の地形の頂点
+		/// </param>
+		/// <param name="indices">
+		/// 変更後の地形の三角形の頂点インデックス
+		/// </param>
+		/// <param name="areaIDs">
+		/// 変更後の三角形ごとの地形の種類
+		/// </param>
+		/// <param name="numThreads">
+		/// タイルの作成に使うスレッド数
+		/// </param>
+		/// <remarks>
+		/// タイルに分割して作成した場合は、重なる三角形が変化したタイルだけを作り直します。
+		/// タイルに分割していない場合や、地形が作成時の範囲からはみ出す場合は、前回と同じ設定で全体を作り直します。
+		/// </remarks>
+		/// <returns>
+		/// 更新に成功した場合 true, それ以外の場合は false
+		/// </returns>
+		bool update(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, size_t numThreads = Threading::GetConcurrency());
 
 		[[nodiscard]] Array<Vec3> query(const Vec3& start, const Vec3& end) const;
+
+		/// <summary>
+		/// 複数の経路をまとめて探索します。
+		/// </summary>
+		/// <param name="startEnds">
+		/// 経路の始点と終点の一覧
+		/// </param>
+		/// <param name="results">
+		/// 経路の格納先。results[i] に startEnds[i] の経路が格納され、経路が見つからない場合は空になります
+		/// </param>
+		/// <param name="numThreads">
+		/// 探索に使うスレッド数
+		/// </param>
+		/// <remarks>
+		/// スレッドごとの探索用データと results の各要素のメモリは、呼び出しをまたいで再利用されます。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void query(const Array<std::pair<Vec3, Vec3>>& startEnds, Array<Array<Vec3>>& results, size_t numThreads = Threading::GetConcurrency()) const;
 	};
 }
@@ -16,6 +16,8 @@
 # include "BlendState.hpp"
 # include "Emitter2D.hpp"
 # include "Scene.hpp"
+# include "Array.hpp"
+# include "Threading.hpp"
 
 namespace s3d
 {
@@ -89,5 +91,11 @@ namespace s3d
 		void draw() const;
 
 		void drawDebug() const;
+
+		void setSeed(uint64 seed);
+
+		static void UpdateAll(const Array<ParticleSystem2D*>& systems, double deltaTime = Scene::DeltaTime(), size_t numThreads = Threading::GetConcurrency());
+
+		static void DrawAll(const Array<ParticleSystem2D*>& systems);
 	};
 }
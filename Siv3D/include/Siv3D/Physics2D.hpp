@@ -17,6 +17,7 @@
 # include "Polygon.hpp"
 # include "Scene.hpp"
 # include "HashTable.hpp"
+# include "Threading.hpp"
 
 // Box2D forward declaration
 class b2World;
@@ -138,6 +139,61 @@ namespace s3d
 		[[nodiscard]] std::array<P2Contact, 2>::const_iterator end() const noexcept;
 	};
 
+	enum class P2ContactEventType : uint8
+	{
+		/// <summary>
+		/// 2 つの物体が接触を始めた
+		/// </summary>
+		Begin,
+
+		/// <summary>
+		/// 2 つの物体の接触が終わった
+		/// </summary>
+		End,
+
+		/// <summary>
+		/// 1 ステップの計算で接触点に力積が加わった
+		/// </summary>
+		Impulse
+	};
+
+	struct P2ContactEvent
+	{
+		P2ContactPair pair;
+
+		P2ContactEventType type = P2ContactEventType::Begin;
+
+		/// <summary>
+		/// 接触点の数。Impulse 以外のイベントでは 0
+		/// </summary>
+		uint32 num_contacts = 0;
+
+		Vec2 normal = Vec2(0, 0);
+
+		std::array<P2Contact, 2> contacts;
+
+		[[nodiscard]] std::array<P2Contact, 2>::const_iterator begin() const noexcept;
+
+		[[nodiscard]] std::array<P2Contact, 2>::const_iterator end() const noexcept;
+	};
+
+	struct P2RaycastResult
+	{
+		P2BodyID id = 0;
+
+		/// <summary>
+		/// レイが物体に当たった位置
+		/// </summary>
+		Vec2 pos = Vec2(0, 0);
+
+		Vec2 normal = Vec2(0, 0);
+
+		/// <summary>
+		/// レイの始点から当たった位置までの距離の、レイの長さに対する割合 [0.0, 1.0]
+		/// </summary>
+		double fraction = 0.0;
+	};
+
 	class P2World
 	{
 	private:
@@ -164,8 +220,70 @@ namespace s3d
 
 		void shiftOrigin(const Vec2& newOrigin);
 
+		/// <summary>
+		/// 物理演算のワールドを更新します。
+		/// </summary>
+		/// <param name="timeStep">
+		/// 経過時間（秒）
+		/// </param>
+		/// <param name="velocityIterations">
+		/// 速度の計算の反復回数
+		/// </param>
+		/// <param name="positionIterations">
+		/// 位置の計算の反復回数
+		/// </param>
+		/// <remarks>
+		/// setFixedTimeStep() で固定タイムステップが設定されている場合、timeStep を蓄積し、固定の間隔で必要な回数だけステップを進めます。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
 		void update(double timeStep = Scene::DeltaTime(), int32 velocityIterations = 6, int32 positionIterations = 2) const;
 
+		/// <summary>
+		/// 互いに接触していない物体のグループ（島）を並列に計算するスレッド数を設定します。
+		/// </summary>
+		/// <param name="numThreads">
+		/// 呼び出し元を含むスレッド数。1 の場合は並列化しません
+		/// </param>
+		/// <remarks>
+		/// 並列化されるのは島ごとの拘束の計算です。衝突判定は呼び出し元のスレッドで行われます。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void setThreadCount(size_t numThreads = Threading::GetConcurrency());
+
+		[[nodiscard]] size_t getThreadCount() const;
+
+		/// <summary>
+		/// 固定タイムステップを設定します。
+		/// </summary>
+		/// <param name="fixedTimeStep">
+		/// 1 ステップの時間（秒）。0 の場合は update() に渡された時間でそのまま 1 ステップ進めます
+		/// </param>
+		/// <remarks>
+		/// 1 回の update() で進めるステップは最大 8 回で、それを超える時間は捨てられます。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void setFixedTimeStep(double fixedTimeStep = (1.0 / 60.0));
+
+		[[nodiscard]] double getFixedTimeStep() const;
+
+		/// <summary>
+		/// 描画用の補間係数を返します。
+		/// </summary>
+		/// <remarks>
+		/// 固定タイムステップで消化しきれなかった時間の、1 ステップに対する割合です。
+		/// 固定タイムステップを使わない場合は常に 1.0 です。
+		/// </remarks>
+		/// <returns>
+		/// 補間係数 [0.0, 1.0]
+		/// </returns>
+		[[nodiscard]] double getInterpolationAlpha() const;
+
 		[[nodiscard]] P2Body createDummy(const Vec2& center, P2BodyType bodyType = P2BodyType::Dynamic);
 
 		[[nodiscard]] P2Body createLine(const Vec2& center, const Line& line, const P2Material& material = P2Material(), const P2Filter& filter = P2Filter(), P2BodyType bodyType = P2BodyType::Dynamic);
@@ -234,8 +352,146 @@ namespace s3d
 		[[nodiscard]] P2RopeJoint createRopeJoint(const P2Body& bodyA, const Vec2& anchorPosA, const P2Body& bodyB, const Vec2& anchorPosB, double maxLength);
 		[[nodiscard]] P2SliderJoint createSliderJoint(const P2Body& bodyA, const P2Body& bodyB, const Vec2& anchorPos, const Vec2& normalizedAxis);
 
+		/// <summary>
+		/// 接触している物体の組と、直前の update() で加わった力積を返します。
+		/// </summary>
+		/// <remarks>
+		/// 接触イベントのモードでは、直前の update() の接触イベントから作られます。
+		/// その場合、update() の間に力積が加わらなかった接触（眠っている物体など）は含まれません。
+		/// </remarks>
+		/// <returns>
+		/// 物体の組と接触の情報
+		/// </returns>
 		[[nodiscard]] const HashTable<P2ContactPair, P2Collision>& getCollisions() const;
 
+		/// <summary>
+		/// 接触イベントのモードを設定します。
+		/// </summary>
+		/// <param name="enabled">
+		/// 接触イベントのモードにする場合 true, getCollisions() のハッシュテーブルを毎回更新する場合は false
+		/// </param>
+		/// <remarks>
+		/// 接触イベントのモードでは、接触のコールバックはハッシュテーブルを操作せず、再利用される配列にイベントを追加するだけになります。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void setContactEventsEnabled(bool enabled);
+
+		[[nodiscard]] bool getContactEventsEnabled() const;
+
+		/// <summary>
+		/// 直前の update() で発生した接触イベントを、発生した順に返します。
+		/// </summary>
+		/// <remarks>
+		/// 接触イベントのモードでない場合は空です。
+		/// 次の update() を呼ぶと内容は破棄されます。
+		/// </remarks>
+		/// <returns>
+		/// 接触イベントの配列
+		/// </returns>
+		[[nodiscard]] const Array<P2ContactEvent>& getContactEvents() const;
+
+		/// <summary>
+		/// 長方形と重なる物体を調べます。
+		/// </summary>
+		/// <param name="rect">
+		/// 長方形
+		/// </param>
+		/// <param name="results">
+		/// 物体の ID を格納する配列。呼び出し前の内容は消去されます
+		/// </param>
+		/// <remarks>
+		/// 物体の形状そのものではなく、形状を囲む AABB との重なりを調べます。
+		/// </remarks>
+		/// <returns>
+		/// 見つかった物体の数
+		/// </returns>
+		size_t queryAABB(const RectF& rect, Array<P2BodyID>& results) const;
+
+		/// <summary>
+		/// 複数の長方形について、それぞれと重なる物体を並列に調べます。
+		/// </summary>
+		/// <param name="rects">
+		/// 長方形の配列
+		/// </param>
+		/// <param name="results">
+		/// rects[i] の結果が results[i] に格納される配列。要素の配列の容量は再利用されます
+		/// </param>
+		/// <param name="numThreads">
+		/// 呼び出し元を含むスレッド数
+		/// </param>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void queryAABB(const Array<RectF>& rects, Array<Array<P2BodyID>>& results, size_t numThreads = Threading::GetConcurrency()) const;
+
+		/// <summary>
+		/// 点を含む物体を調べます。
+		/// </summary>
+		/// <param name="pos">
+		/// 点の座標
+		/// </param>
+		/// <param name="results">
+		/// 物体の ID を格納する配列。呼び出し前の内容は消去されます
+		/// </param>
+		/// <returns>
+		/// 見つかった物体の数
+		/// </returns>
+		size_t queryPoint(const Vec2& pos, Array<P2BodyID>& results) const;
+
+		void queryPoint(const Array<Vec2>& positions, Array<Array<P2BodyID>>& results, size_t numThreads = Threading::GetConcurrency()) const;
+
+		/// <summary>
+		/// 線分上で始点に最も近い物体を調べます。
+		/// </summary>
+		/// <param name="start">
+		/// レイの始点
+		/// </param>
+		/// <param name="end">
+		/// レイの終点
+		/// </param>
+		/// <returns>
+		/// 最も近い物体の情報, 物体が無い場合は none
+		/// </returns>
+		[[nodiscard]] Optional<P2RaycastResult> raycast(const Vec2& start, const Vec2& end) const;
+
+		/// <summary>
+		/// 複数のレイについて、それぞれ始点に最も近い物体を並列に調べます。
+		/// </summary>
+		/// <param name="rays">
+		/// レイの始点と終点の配列
+		/// </param>
+		/// <param name="results">
+		/// rays[i] の結果が results[i] に格納される配列
+		/// </param>
+		/// <param name="numThreads">
+		/// 呼び出し元を含むスレッド数
+		/// </param>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void raycast(const Array<Line>& rays, Array<Optional<P2RaycastResult>>& results, size_t numThreads = Threading::GetConcurrency()) const;
+
+		/// <summary>
+		/// 線分と交差するすべての物体を、始点に近い順に調べます。
+		/// </summary>
+		/// <param name="start">
+		/// レイの始点
+		/// </param>
+		/// <param name="end">
+		/// レイの終点
+		/// </param>
+		/// <param name="results">
+		/// 結果を格納する配列。呼び出し前の内容は消去されます。1 つの物体について最も近い交点だけが格納されます
+		/// </param>
+		/// <returns>
+		/// 見つかった物体の数
+		/// </returns>
+		size_t raycastAll(const Vec2& start, const Vec2& end, Array<P2RaycastResult>& results) const;
+
+		void raycastAll(const Array<Line>& rays, Array<Array<P2RaycastResult>>& results, size_t numThreads = Threading::GetConcurrency()) const;
+
 		[[nodiscard]] b2World* getWorldPtr() const;
 	};
 
@@ -328,6 +584,18 @@ namespace s3d
 
 		[[nodiscard]] std::pair<Vec2, double> getTransform() const;
 
+		/// <summary>
+		/// 最後のステップの前後の姿勢を P2World::getInterpolationAlpha() で補間した位置を返します。
+		/// </summary>
+		/// <returns>
+		/// 描画用の位置
+		/// </returns>
+		[[nodiscard]] Vec2 getInterpolatedPos() const;
+
+		[[nodiscard]] double getInterpolatedAngle() const;
+
+		[[nodiscard]] std::pair<Vec2, double> getInterpolatedTransform() const;
+
 		P2Body& setVelocity(const Vec2& v);
 
 		[[nodiscard]] Vec2 getVelocity() const;
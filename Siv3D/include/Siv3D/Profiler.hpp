@@ -19,6 +19,10 @@ namespace s3d
 		size_t drawcalls = 0;
 
 		size_t triangles = 0;
+
+		size_t batches = 0;
+
+		size_t uploadedBytes = 0;
 	};
 
 	/// <summary>
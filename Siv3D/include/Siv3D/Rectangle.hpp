@@ -18,6 +18,7 @@
 # include "Geometry2D.hpp"
 # include "Quad.hpp"
 # include "Color.hpp"
+# include "Array.hpp"
 
 namespace s3d
 {
@@ -1625,6 +1626,20 @@ namespace s3d
 			return draw({ *leftColor, *rightColor, *rightColor, *leftColor });
 		}
 
+		/// <summary>
+		/// 複数の長方形をまとめて描きます。
+		/// </summary>
+		/// <param name="rects">
+		/// 長方形の配列
+		/// </param>
+		/// <param name="color">
+		/// 色
+		/// </param>
+		/// <remarks>
+		/// 描画ステートの確認と頂点の生成を一括で行うため、draw() を繰り返し呼ぶよりも高速です。
+		/// </remarks>
+		static void DrawBatch(const Array<Rectangle>& rects, const ColorF& color = Palette::White);
+
 		/// <summary>
 		/// 長方形の枠を描きます。
 		/// </summary>
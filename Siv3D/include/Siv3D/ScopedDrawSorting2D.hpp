@@ -0,0 +1,45 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Fwd.hpp"
+# include "Graphics2D.hpp"
+# include "Uncopyable.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// スコープ内の 2D 描画を描画順に依存しないものとして扱い、同じシェーダとテクスチャを使う描画をまとめて発行します。
+	/// </summary>
+	/// <remarks>
+	/// 重なり合う半透明の描画など、描画順によって結果が変わる場合には使用しないでください。
+	/// </remarks>
+	class ScopedDrawSorting2D : Uncopyable
+	{
+	private:
+
+		Optional<bool> m_oldDrawSorting;
+
+		void clear();
+
+	public:
+
+		ScopedDrawSorting2D();
+
+		explicit ScopedDrawSorting2D(bool enabled);
+
+		ScopedDrawSorting2D(ScopedDrawSorting2D&& other);
+
+		~ScopedDrawSorting2D();
+
+		ScopedDrawSorting2D& operator =(ScopedDrawSorting2D&& other);
+	};
+}
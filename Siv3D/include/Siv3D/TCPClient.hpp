@@ -12,6 +12,8 @@
 # pragma once
 # include <memory>
 # include "Fwd.hpp"
+# include "Optional.hpp"
+# include "ByteArrayView.hpp"
 
 namespace s3d
 {
@@ -76,5 +78,40 @@ namespace s3d
 		{
 			return send(std::addressof(to), sizeof(Type));
 		}
+
+		/// <summary>
+		/// データを 1 つのメッセージとして送信します。
+		/// </summary>
+		/// <param name="data">
+		/// 送信するデータの先頭ポインタ
+		/// </param>
+		/// <param name="size">
+		/// 送信するデータのサイズ（バイト）
+		/// </param>
+		/// <remarks>
+		/// データの前に 4 バイトのサイズ（リトルエンディアン）が付加されます。
+		/// 続けて呼ばれた小さな送信はまとめられ、1 回の書き込みで送られます。
+		/// </remarks>
+		/// <returns>
+		/// 送信の予約に成功した場合 true, それ以外の場合は false
+		/// </returns>
+		bool sendMessage(const void* data, size_t size);
+
+		template <class Type, std::enable_if_t<std::is_trivially_copyable_v<Type>>* = nullptr>
+		bool sendMessage(const Type& to)
+		{
+			return sendMessage(std::addressof(to), sizeof(Type));
+		}
+
+		/// <summary>
+		/// sendMessage() で送られたメッセージを 1 つ受信します。
+		/// </summary>
+		/// <remarks>
+		/// 返されるビューは受信バッファを直接参照し、次に available(), skip(), lookahead(), read(), receiveMessage() を呼ぶまで有効です。
+		/// </remarks>
+		/// <returns>
+		/// メッセージのペイロード, メッセージがまだ揃っていない場合は none
+		/// </returns>
+		[[nodiscard]] Optional<ByteArrayView> receiveMessage();
 	};
 }
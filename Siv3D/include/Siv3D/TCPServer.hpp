@@ -14,12 +14,44 @@
 # include "Fwd.hpp"
 # include "Array.hpp"
 # include "Optional.hpp"
+# include "ByteArrayView.hpp"
 # include "Unspecified.hpp"
 
 namespace s3d
 {
 	using SessionID = uint64;
 
+	/// <summary>
+	/// TCPServer のセッションで発生したイベントの種類
+	/// </summary>
+	enum class TCPSessionEventType
+	{
+		/// <summary>
+		/// セッションが接続された
+		/// </summary>
+		Connected,
+
+		/// <summary>
+		/// データを受信した
+		/// </summary>
+		DataReceived,
+
+		/// <summary>
+		/// セッションが切断された
+		/// </summary>
+		Disconnected,
+	};
+
+	/// <summary>
+	/// TCPServer のセッションで発生したイベント
+	/// </summary>
+	struct TCPSessionEvent
+	{
+		SessionID id;
+
+		TCPSessionEventType type;
+	};
+
 	class TCPServer
 	{
 	private:
@@ -42,7 +74,23 @@ namespace s3d
 
 		void startAccept(uint16 port);
 
-		void startAcceptMulti(uint16 port);
+		/// <summary>
+		/// 複数のセッションの接続の受け付けを開始します。
+		/// </summary>
+		/// <param name="port">
+		/// ポート番号
+		/// </param>
+		/// <param name="numThreads">
+		/// 通信を処理するスレッド数
+		/// </param>
+		/// <remarks>
+		/// 通信スレッドは最初の受け付け開始時に作られ、disconnect() まで使われます。
+		/// 多数のセッションを扱う場合は numThreads を増やし、getEvents() でイベントのあったセッションだけを処理してください。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void startAcceptMulti(uint16 port, size_t numThreads = 1);
 
 		void cancelAccept();
 
@@ -87,5 +135,59 @@ namespace s3d
 		{
 			return send(std::addressof(to), sizeof(Type), id);
 		}
+
+		/// <summary>
+		/// データを 1 つのメッセージとして送信します。
+		/// </summary>
+		/// <param name="data">
+		/// 送信するデータの先頭ポインタ
+		/// </param>
+		/// <param name="size">
+		/// 送信するデータのサイズ（バイト）
+		/// </param>
+		/// <param name="id">
+		/// セッション ID
+		/// </param>
+		/// <remarks>
+		/// データの前に 4 バイトのサイズ（リトルエンディアン）が付加されます。
+		/// 続けて呼ばれた小さな送信はまとめられ、1 回の書き込みで送られます。
+		/// </remarks>
+		/// <returns>
+		/// 送信の予約に成功した場合 true, それ以外の場合は false
+		/// </returns>
+		bool sendMessage(const void* data, size_t size, const Optional<SessionID>& id = unspecified);
+
+		template <class Type, std::enable_if_t<std::is_trivially_copyable_v<Type>>* = nullptr>
+		bool sendMessage(const Type& to, const Optional<SessionID>& id = unspecified)
+		{
+			return sendMessage(std::addressof(to), sizeof(Type), id);
+		}
+
+		/// <summary>
+		/// sendMessage() で送られたメッセージを 1 つ受信します。
+		/// </summary>
+		/// <param name="id">
+		/// セッション ID
+		/// </param>
+		/// <remarks>
+		/// 返されるビューは受信バッファを直接参照し、次にこのセッションの available(), skip(), lookahead(), read(), receiveMessage() を呼ぶまで有効です。
+		/// </remarks>
+		/// <returns>
+		/// メッセージのペイロード, メッセージがまだ揃っていない場合は none
+		/// </returns>
+		[[nodiscard]] Optional<ByteArrayView> receiveMessage(const Optional<SessionID>& id = unspecified);
+
+		/// <summary>
+		/// 前回の呼び出し以降に発生したセッションのイベントを取り出します。
+		/// </summary>
+		/// <remarks>
+		/// イベントは startAccept() または startAcceptMulti() を呼んだ後から記録されます。
+		/// 取り出されていないイベントは最大 4096 件まで保持され、それを超えると古いものから破棄されます。
+		/// DataReceived は、そのセッションで次に読み出し操作（available(), skip(), lookahead(), read(), receiveMessage()）を行うまで再び通知されないため、受信したデータはまとめて読み出してください。
+		/// </remarks>
+		/// <returns>
+		/// 発生順のイベントの一覧
+		/// </returns>
+		[[nodiscard]] Array<TCPSessionEvent> getEvents();
 	};
 }
@@ -0,0 +1,208 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Fwd.hpp"
+# include "Optional.hpp"
+# include "PointVector.hpp"
+# include "Rectangle.hpp"
+# include "TextureRegion.hpp"
+
+namespace s3d
+{
+	/// <summary>
+	/// テクスチャアトラス
+	/// </summary>
+	/// <remarks>
+	/// 複数の画像を共有のページに詰め込み、テクスチャを切り替えずに描画できる TextureRegion を返します。
+	/// 画像の追加と削除はいつでも行え、変更された領域だけがテクスチャに転送されます。
+	/// </remarks>
+	class TextureAtlas
+	{
+	public:
+
+		using IDType = uint32;
+
+	private:
+
+		class TextureAtlasDetail;
+
+		std::shared_ptr<TextureAtlasDetail> pImpl;
+
+	public:
+
+		/// <summary>
+		/// デフォルトコンストラクタ
+		/// </summary>
+		TextureAtlas();
+
+		/// <summary>
+		/// テクスチャアトラスを作成します。
+		/// </summary>
+		/// <param name="pageSize">
+		/// 1 ページの大きさ（ピクセル）
+		/// </param>
+		/// <param name="padding">
+		/// 画像の周囲に確保する余白（ピクセル）。余白には画像の端のピクセルが複製されます
+		/// </param>
+		/// <param name="createTextures">
+		/// ページのテクスチャを作成する場合 true, CPU 側の画像だけを扱う場合は false
+		/// </param>
+		explicit TextureAtlas(const Size& pageSize, int32 padding = 1, bool createTextures = true);
+
+		/// <summary>
+		/// デストラクタ
+		/// </summary>
+		~TextureAtlas();
+
+		/// <summary>
+		/// 画像をアトラスに追加します。
+		/// </summary>
+		/// <param name="image">
+		/// 画像
+		/// </param>
+		/// <remarks>
+		/// 既存のページに空きがなく、ページ数が上限に達している場合は追加に失敗します。
+		/// </remarks>
+		/// <returns>
+		/// 追加に成功した場合は画像の ID, 画像がページに収まらない場合は none
+		/// </returns>
+		Optional<IDType> add(const Image& image);
+
+		/// <summary>
+		/// 画像をアトラスから削除し、その領域を再利用できるようにします。
+		/// </summary>
+		/// <param name="id">
+		/// 画像の ID
+		/// </param>
+		/// <returns>
+		/// 削除に成功した場合 true, 存在しない ID の場合は false
+		/// </returns>
+		bool remove(IDType id);
+
+		/// <summary>
+		/// すべての画像とページを削除します。
+		/// </summary>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void clear();
+
+		[[nodiscard]] bool contains(IDType id) const;
+
+		/// <summary>
+		/// 画像を描画するための TextureRegion を返します。
+		/// </summary>
+		/// <param name="id">
+		/// 画像の ID
+		/// </param>
+		/// <remarks>
+		/// 未転送の変更があるページは、この時点でテクスチャに転送されます。
+		/// </remarks>
+		/// <returns>
+		/// 画像の TextureRegion, 存在しない ID の場合は空の TextureRegion
+		/// </returns>
+		[[nodiscard]] TextureRegion operator ()(IDType id) const;
+
+		/// <summary>
+		/// 画像が配置されているページのインデックスを返します。
+		/// </summary>
+		/// <param name="id">
+		/// 画像の ID
+		/// </param>
+		/// <returns>
+		/// ページのインデックス, 存在しない ID の場合は none
+		/// </returns>
+		[[nodiscard]] Optional<size_t> getPageIndex(IDType id) const;
+
+		/// <summary>
+		/// 画像がページ内で占める領域を返します。
+		/// </summary>
+		/// <param name="id">
+		/// 画像の ID
+		/// </param>
+		/// <returns>
+		/// 画像の領域（余白を含まない）, 存在しない ID の場合は none
+		/// </returns>
+		[[nodiscard]] Optional<Rect> getRect(IDType id) const;
+
+		[[nodiscard]] size_t num_images() const;
+
+		[[nodiscard]] size_t num_pages() const;
+
+		[[nodiscard]] Size pageSize() const;
+
+		/// <summary>
+		/// ページ数の上限を設定します。
+		/// </summary>
+		/// <param name="maxPages">
+		/// ページ数の上限。0 の場合は上限なし
+		/// </param>
+		/// <remarks>
+		/// すでに作成されたページは削除されません。
+		/// </remarks>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void setMaxPages(size_t maxPages);
+
+		[[nodiscard]] size_t getMaxPages() const;
+
+		/// <summary>
+		/// ページの画像を返します。
+		/// </summary>
+		/// <param name="pageIndex">
+		/// ページのインデックス
+		/// </param>
+		/// <returns>
+		/// ページの画像
+		/// </returns>
+		[[nodiscard]] const Image& getPageImage(size_t pageIndex) const;
+
+		/// <summary>
+		/// ページのテクスチャを返します。
+		/// </summary>
+		/// <param name="pageIndex">
+		/// ページのインデックス
+		/// </param>
+		/// <remarks>
+		/// テクスチャを作成しない設定の場合は空のテクスチャを返します。
+		/// </remarks>
+		/// <returns>
+		/// ページのテクスチャ
+		/// </returns>
+		[[nodiscard]] const Texture& getPageTexture(size_t pageIndex) const;
+
+		/// <summary>
+		/// ページのテクスチャにまだ転送されていない領域を返します。
+		/// </summary>
+		/// <param name="pageIndex">
+		/// ページのインデックス
+		/// </param>
+		/// <remarks>
+		/// 変更された領域は、すべてを囲む 1 つの矩形にまとめられます。
+		/// テクスチャを作成しない設定の場合、この領域はリセットされません。
+		/// </remarks>
+		/// <returns>
+		/// 未転送の領域。無い場合は none
+		/// </returns>
+		[[nodiscard]] Optional<Rect> getDirtyRect(size_t pageIndex) const;
+
+		/// <summary>
+		/// 未転送の変更をすべてのページのテクスチャに転送します。
+		/// </summary>
+		/// <returns>
+		/// なし
+		/// </returns>
+		void upload() const;
+	};
+}
@@ -147,6 +147,23 @@ namespace s3d
 
 		RectF drawClipped(const Vec2& pos, const RectF& clipRect, const ColorF& diffuse = Palette::White) const;
 
+		/// <summary>
+		/// 複数のテクスチャ領域をまとめて描きます。
+		/// </summary>
+		/// <param name="regions">
+		/// テクスチャ領域の配列
+		/// </param>
+		/// <param name="positions">
+		/// 各テクスチャ領域を描く左上の座標
+		/// </param>
+		/// <param name="diffuse">
+		/// 乗算する色
+		/// </param>
+		/// <remarks>
+		/// 同じテクスチャを参照する領域が連続している場合、それらは 1 回の描画にまとめられます。
+		/// </remarks>
+		static void DrawBatch(const Array<TextureRegion>& regions, const Array<Vec2>& positions, const ColorF& diffuse = Palette::White);
+
 		/// <summary>
 		/// 中心位置を指定してテクスチャを描きます。
 		/// </summary>
@@ -9,28 +9,364 @@
 //
 //-----------------------------------------------
 
+# include <dirent.h>
+# include <poll.h>
+# include <unistd.h>
+# include <sys/inotify.h>
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Time.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include "DirectoryWatcherDetail.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		static constexpr uint32 WatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+		// 既にまとめられているイベントと新しいイベントを合成する。none の場合は両方を取り消す
+		[[nodiscard]] static Optional<FileAction> Merge(const FileAction previous, const FileAction current)
+		{
+			if (previous == FileAction::Added)
+			{
+				if (current == FileAction::Removed)
+				{
+					// 作成してすぐ削除された一時ファイル
+					return none;
+				}
+
+				return FileAction::Added;
+			}
+			else if (previous == FileAction::Removed)
+			{
+				if (current == FileAction::Added)
+				{
+					// 削除して作り直す保存方法
+					return FileAction::Modified;
+				}
+
+				return current;
+			}
+			else
+			{
+				if (current == FileAction::Added)
+				{
+					return FileAction::Modified;
+				}
+
+				return current;
+			}
+		}
+	}
+
 	DirectoryWatcher::DirectoryWatcherDetail::DirectoryWatcherDetail(const FilePath& directory)
 	{
+		if (directory.isEmpty() || !FileSystem::IsDirectory(directory))
+		{
+			LOG_FAIL(U"❌ DirectoryWatcher: `{}` is not a directory"_fmt(directory));
+
+			return;
+		}
+
+		m_directory = FileSystem::FullPath(directory);
+
+		m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+		if (m_inotify == -1)
+		{
+			LOG_FAIL(U"❌ DirectoryWatcher: inotify_init1() failed. `{}`"_fmt(m_directory));
+
+			return;
+		}
+
+		m_buffer.resize(BufferSize);
+
+		// 監視を始めてからスレッドを起動し、コンストラクタの直後の変更も取りこぼさないようにする
+		addWatches(m_directory, false, 0);
+
+		LOG_DEBUG(U"ℹ️ DirectoryWatcher: Started monitoring `{}` ({} directories)"_fmt(m_directory, m_watches.size()));
+
+		m_thread = std::thread(DirectoryWatcherDetail::Update, this);
 	}
-	
+
 	DirectoryWatcher::DirectoryWatcherDetail::~DirectoryWatcherDetail()
 	{
+		if (m_inotify == -1)
+		{
+			return;
+		}
+
+		m_abort = true;
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		::close(m_inotify);
+
+		m_inotify = -1;
+
+		LOG_DEBUG(U"ℹ️ DirectoryWatcher: End monitoring `{}`"_fmt(m_directory));
 	}
-	
+
 	Array<std::pair<FilePath, FileAction>> DirectoryWatcher::DirectoryWatcherDetail::retrieveChanges()
 	{
+		std::lock_guard lock(m_changesMutex);
+
 		Array<std::pair<FilePath, FileAction>> results;
+
+		results.swap(m_changes);
+
 		return results;
 	}
-	
+
 	const FilePath& DirectoryWatcher::DirectoryWatcherDetail::directory() const
 	{
 		return m_directory;
 	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::Update(DirectoryWatcherDetail* watcher)
+	{
+		while (!watcher->m_abort)
+		{
+			watcher->update();
+		}
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::addWatches(const FilePath& directory, const bool reportContents, const uint64 timeMillisec)
+	{
+		const int32 wd = ::inotify_add_watch(m_inotify, directory.narrow().c_str(), detail::WatchMask);
+
+		if (wd == -1)
+		{
+			LOG_FAIL(U"❌ DirectoryWatcher: inotify_add_watch() failed. `{}`"_fmt(directory));
+
+			return;
+		}
+
+		// 同じディレクトリが移動してきた場合は、同じ監視記述子のパスを更新する
+		m_watches[wd] = directory;
+
+		DIR* dir = ::opendir(directory.narrow().c_str());
+
+		if (!dir)
+		{
+			return;
+		}
+
+		while (const dirent* entry = ::readdir(dir))
+		{
+			const std::string_view name(entry->d_name);
+
+			if ((name == ".") || (name == ".."))
+			{
+				continue;
+			}
+
+			const FilePath path = directory + Unicode::Widen(name);
+
+			bool isDirectory = (entry->d_type == DT_DIR);
+
+			if (entry->d_type == DT_UNKNOWN)
+			{
+				isDirectory = FileSystem::IsDirectory(path);
+			}
+
+			if (reportContents)
+			{
+				// 監視を加える前に作られた項目は inotify から通知されない
+				addChange(path, FileAction::Added, timeMillisec);
+			}
+
+			if (isDirectory)
+			{
+				addWatches(path + U'/', reportContents, timeMillisec);
+			}
+		}
+
+		::closedir(dir);
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::removeWatches(const FilePath& directory)
+	{
+		for (auto it = m_watches.begin(); it != m_watches.end();)
+		{
+			if (it->second.starts_with(directory))
+			{
+				::inotify_rm_watch(m_inotify, it->first);
+
+				it = m_watches.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::update()
+	{
+		::pollfd fd = { m_inotify, POLLIN, 0 };
+
+		const int32 result = ::poll(&fd, 1, PollIntervalMillisec);
+
+		const uint64 timeMillisec = Time::GetMillisec();
+
+		if ((result > 0) && (fd.revents & POLLIN))
+		{
+			for (;;)
+			{
+				const ssize_t numBytes = ::read(m_inotify, m_buffer.data(), m_buffer.size());
+
+				if (numBytes <= 0)
+				{
+					break;
+				}
+
+				processEvents(static_cast<size_t>(numBytes), timeMillisec);
+			}
+		}
+
+		flushChanges(timeMillisec);
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::processEvents(const size_t numBytes, const uint64 timeMillisec)
+	{
+		for (size_t offset = 0; offset < numBytes;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(m_buffer.data() + offset);
+
+			offset += (sizeof(inotify_event) + event->len);
+
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				LOG_WARNING(U"⚠️ DirectoryWatcher: Event queue overflowed. Some changes in `{}` were lost"_fmt(m_directory));
+
+				continue;
+			}
+
+			if (event->mask & IN_IGNORED)
+			{
+				m_watches.erase(event->wd);
+
+				continue;
+			}
+
+			const auto it = m_watches.find(event->wd);
+
+			if ((it == m_watches.end()) || (event->len == 0))
+			{
+				continue;
+			}
+
+			const FilePath path = it->second + Unicode::Widen(std::string_view(event->name));
+
+			const bool isDirectory = (event->mask & IN_ISDIR);
+
+			if (event->mask & (IN_CREATE | IN_MOVED_TO))
+			{
+				addChange(path, FileAction::Added, timeMillisec);
+
+				if (isDirectory)
+				{
+					addWatches(path + U'/', true, timeMillisec);
+				}
+			}
+			else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+			{
+				addChange(path, FileAction::Removed, timeMillisec);
+
+				if (isDirectory && (event->mask & IN_MOVED_FROM))
+				{
+					// 監視対象の外に移動したディレクトリの監視を外す
+					removeWatches(path + U'/');
+				}
+			}
+			else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+			{
+				addChange(path, FileAction::Modified, timeMillisec);
+			}
+		}
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::addChange(const FilePath& path, const FileAction action, const uint64 timeMillisec)
+	{
+		if (const auto it = m_pendingIndices.find(path); it != m_pendingIndices.end())
+		{
+			PendingChange& pending = m_pendingChanges[it->second];
+
+			pending.timeMillisec = timeMillisec;
+
+			if (const auto merged = detail::Merge(pending.action, action))
+			{
+				pending.action = *merged;
+			}
+			else
+			{
+				pending.action = FileAction::Unknown;
+
+				m_pendingIndices.erase(it);
+			}
+
+			return;
+		}
+
+		m_pendingIndices.emplace(path, m_pendingChanges.size());
+
+		m_pendingChanges.push_back({ path, action, timeMillisec });
+	}
+
+	void DirectoryWatcher::DirectoryWatcherDetail::flushChanges(const uint64 timeMillisec)
+	{
+		if (m_pendingChanges.isEmpty())
+		{
+			return;
+		}
+
+		constexpr uint64 LatencyMillisec = static_cast<uint64>(LatencySec * 1000);
+
+		const bool hasReadyChange = m_pendingChanges.any([=](const PendingChange& pending)
+		{
+			return ((pending.timeMillisec + LatencyMillisec) <= timeMillisec);
+		});
+
+		if (!hasReadyChange)
+		{
+			return;
+		}
+
+		// 最後のイベントから LatencySec 経過したパスだけを、最初に起きた順で送出する
+		Array<PendingChange> remaining;
+
+		{
+			std::lock_guard lock(m_changesMutex);
+
+			for (auto& pending : m_pendingChanges)
+			{
+				if (pending.action == FileAction::Unknown)
+				{
+					continue;
+				}
+
+				if ((pending.timeMillisec + LatencyMillisec) <= timeMillisec)
+				{
+					m_changes.emplace_back(std::move(pending.path), pending.action);
+				}
+				else
+				{
+					remaining.push_back(std::move(pending));
+				}
+			}
+		}
+
+		m_pendingChanges.swap(remaining);
+
+		m_pendingIndices.clear();
+
+		for (size_t i = 0; i < m_pendingChanges.size(); ++i)
+		{
+			m_pendingIndices.emplace(m_pendingChanges[i].path, i);
+		}
+	}
 }
@@ -10,7 +10,10 @@
 //-----------------------------------------------
 
 # include <mutex>
+# include <thread>
+# include <atomic>
 # include <Siv3D/DirectoryWatcher.hpp>
+# include <Siv3D/HashTable.hpp>
 
 namespace s3d
 {
@@ -19,17 +22,61 @@ namespace s3d
 	private:
 
 		static constexpr double LatencySec = 0.25;
-		
+
+		// inotify を待つ間隔（ミリ秒）。この間隔で終了要求と、まとめたイベントの送出を確認する
+		static constexpr int32 PollIntervalMillisec = 20;
+
+		static constexpr size_t BufferSize = 64 * 1024;
+
+		struct PendingChange
+		{
+			FilePath path;
+
+			FileAction action = FileAction::Unknown;
+
+			// 最後にイベントを受け取った時刻
+			uint64 timeMillisec = 0;
+		};
+
 		FilePath m_directory;
-		
-		bool m_running = false;
-		
-		bool m_abort = false;
-		
+
+		int32 m_inotify = -1;
+
+		// 監視記述子と、監視しているディレクトリのパス（末尾は '/'）
+		HashTable<int32, FilePath> m_watches;
+
+		Array<uint8> m_buffer;
+
+		// LatencySec の間に同じパスで起きたイベントを 1 つにまとめる
+		Array<PendingChange> m_pendingChanges;
+
+		HashTable<FilePath, size_t> m_pendingIndices;
+
 		std::mutex m_changesMutex;
-		
+
 		Array<std::pair<FilePath, FileAction>> m_changes;
-		
+
+
+		std::thread m_thread;
+
+		std::atomic<bool> m_abort = false;
+
+
+		static void Update(DirectoryWatcherDetail* watcher);
+
+		// ディレクトリとそのサブディレクトリを監視に加える。reportContents が true の場合、見つかった項目を Added として記録する
+		void addWatches(const FilePath& directory, bool reportContents, uint64 timeMillisec);
+
+		void removeWatches(const FilePath& directory);
+
+		void update();
+
+		void processEvents(size_t numBytes, uint64 timeMillisec);
+
+		void addChange(const FilePath& path, FileAction action, uint64 timeMillisec);
+
+		void flushChanges(uint64 timeMillisec);
+
 	public:
 
 		explicit DirectoryWatcherDetail(const FilePath& directory);
@@ -23,6 +23,7 @@
 # include <Shader/GL/CShader_GL.hpp>
 # include <Texture/GL/CTexture_GL.hpp>
 # include <Renderer2D/GL/CRenderer2D_GL.hpp>
+# include <Profiler/IProfiler.hpp>
 # include "CGraphics_GL.hpp"
 
 namespace s3d
@@ -54,6 +55,8 @@ namespace s3d
 	CGraphics_GL::~CGraphics_GL()
 	{
 		LOG_TRACE(U"CGraphics_GL::~CGraphics_GL()");
+		
+		m_renderThread.reset();
 	}
 
 	void CGraphics_GL::init()
@@ -126,17 +129,17 @@ namespace s3d
 	{
 		const bool vSync = !m_targetFrameRateHz.has_value();
 		
-		if (vSync)
+		// パイプライン描画では、描画スレッドがフレームの最後に glfwSwapBuffers() を呼ぶ
+		if (!m_renderThread)
 		{
 			::glfwSwapBuffers(m_window);
 		}
-		else
+		
+		if (!vSync)
 		{
 			const double targetRefreshRateHz = m_targetFrameRateHz.value();
 			const double targetRefreshPeriodMillisec = (1000.0 / targetRefreshRateHz);
 			
-			::glfwSwapBuffers(m_window);
-			
 			double timeToSleepMillisec;
 			double countMillisec;
 			
@@ -158,12 +161,16 @@ namespace s3d
 		
 		if (m_sceneTexture.hasCaptureRequest())
 		{
-			m_sceneTexture.capture();
+			// キャプチャするフレームの描画の後に読み出す
+			invokeCommand([this]() { m_sceneTexture.capture(); });
 		}
 		
 		if constexpr (Platform::DebugBuild)
 		{
-			CheckGLError();
+			if (!m_renderThread)
+			{
+				CheckGLError();
+			}
 		}
 		
 		return true;
@@ -171,37 +178,101 @@ namespace s3d
 
 	void CGraphics_GL::clear()
 	{
-		if (!m_skipClearScene)
+		if (m_renderThread)
 		{
-			m_sceneTexture.clear(m_clearColor);
+			// 前のフレームを描画中なので、次のフレームの最初に描画スレッドで消去する
+			m_nextJob.clear = true;
+			m_nextJob.clearScene = !m_skipClearScene;
+			m_nextJob.clearColor = m_clearColor;
+			m_nextJob.letterboxColor = m_letterboxColor;
 		}
+		else
+		{
+			clearBuffers(!m_skipClearScene, m_clearColor, m_letterboxColor);
+		}
+		
 		m_skipClearScene = false;
+	}
+
+	void CGraphics_GL::flush()
+	{
+		::glfwGetFramebufferSize(m_window, &m_frameBufferSize.x, &m_frameBufferSize.y);
+		
+		CRenderer2D_GL* const pRenderer2D = dynamic_cast<CRenderer2D_GL*>(Siv3DEngine::Get<ISiv3DRenderer2D>());
+		
+		if (m_renderThread)
+		{
+			// 前のフレームの発行が終わるまで、発行用のフレームと描画スレッドの設定は変更できない
+			m_renderThread->wait();
+			
+			pRenderer2D->endRecording();
+			
+			pRenderer2D->reportStatistics();
+			
+			m_job = std::exchange(m_nextJob, FrameJob{});
+			m_job.linearFilter = (m_sceneTextureFilter == TextureFilter::Linear);
+			
+			m_renderThread->kick();
+		}
+		else
+		{
+			// Scene に 2D 描画
+			{
+				m_sceneTexture.bindSceneFrameBuffer();
+				pRenderer2D->flush();
+			}
+			
+			// ウィンドウに Scene を描画
+			{
+				getBlendState()->set(BlendState::Opaque);
+				getRasterizerState()->set(RasterizerState::SolidCullNone);
+				getSamplerState()->setPS(0, none);
+				m_sceneTexture.resolve(m_sceneTextureFilter == TextureFilter::Linear);
+			}
+		}
+		
+		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(1, 1);
+	}
+	
+	void CGraphics_GL::clearBuffers(const bool clearScene, const ColorF& clearColor, const ColorF& letterboxColor)
+	{
+		if (clearScene)
+		{
+			m_sceneTexture.clear(clearColor);
+		}
 		
 		::glBindFramebuffer(GL_FRAMEBUFFER, 0);
 		::glClearColor(
-					   static_cast<float>(m_letterboxColor.r),
-					   static_cast<float>(m_letterboxColor.g),
-					   static_cast<float>(m_letterboxColor.b),
+					   static_cast<float>(letterboxColor.r),
+					   static_cast<float>(letterboxColor.g),
+					   static_cast<float>(letterboxColor.b),
 					   1.0f);
 		::glClear(GL_COLOR_BUFFER_BIT);
 	}
-
-	void CGraphics_GL::flush()
+	
+	void CGraphics_GL::renderFrame()
 	{
-		::glfwGetFramebufferSize(m_window, &m_frameBufferSize.x, &m_frameBufferSize.y);
-		
-		// Scene に 2D 描画
+		// 描画スレッドで実行される。メインスレッドは wait() するまで m_job と発行用のフレームに触れない
+		if (m_job.clear)
 		{
-			m_sceneTexture.bindSceneFrameBuffer();
-			Siv3DEngine::Get<ISiv3DRenderer2D>()->flush();
+			clearBuffers(m_job.clearScene, m_job.clearColor, m_job.letterboxColor);
 		}
 		
-		// ウィンドウに Scene を描画
+		CRenderer2D_GL* const pRenderer2D = dynamic_cast<CRenderer2D_GL*>(Siv3DEngine::Get<ISiv3DRenderer2D>());
+		
+		m_sceneTexture.bindSceneFrameBuffer();
+		pRenderer2D->submitFrame();
+		
+		getBlendState()->set(BlendState::Opaque);
+		getRasterizerState()->set(RasterizerState::SolidCullNone);
+		getSamplerState()->setPS(0, none);
+		m_sceneTexture.resolve(m_job.linearFilter);
+		
+		::glfwSwapBuffers(m_window);
+		
+		if constexpr (Platform::DebugBuild)
 		{
-			getBlendState()->set(BlendState::Opaque);
-			getRasterizerState()->set(RasterizerState::SolidCullNone);
-			getSamplerState()->setPS(0, none);
-			m_sceneTexture.resolve(m_sceneTextureFilter == TextureFilter::Linear);
+			CheckGLError();
 		}
 	}
 	
@@ -229,7 +300,9 @@ namespace s3d
 	{
 		m_targetFrameRateHz = targetFrameRateHz;
 		
-		::glfwSwapInterval(m_targetFrameRateHz.has_value() ? 0 : 1);
+		const int32 interval = (m_targetFrameRateHz.has_value() ? 0 : 1);
+		
+		postCommand([interval]() { ::glfwSwapInterval(interval); });
 	}
 
 	Optional<double> CGraphics_GL::getTargetFrameRateHz() const
@@ -266,7 +339,8 @@ namespace s3d
 
 	void CGraphics_GL::setSceneSize(const Size& sceneSize)
 	{
-		m_sceneTexture.resize(sceneSize, m_clearColor);
+		// getSceneSize() がすぐに新しいサイズを返すよう、完了を待つ
+		invokeCommand([&]() { m_sceneTexture.resize(sceneSize, m_clearColor); });
 	}
 
 	void CGraphics_GL::resizeBuffers(const Size& backBufferSize, const Size& sceneSize)
@@ -289,4 +363,114 @@ namespace s3d
 	{
 		return m_sceneTexture.getImage();
 	}
+
+	void CGraphics_GL::setPipelinedRendering(const bool enabled)
+	{
+		if (enabled == getPipelinedRendering())
+		{
+			return;
+		}
+		
+		if (enabled)
+		{
+			m_renderThread = std::make_unique<GLRenderThread>(m_window, [this]() { renderFrame(); });
+			
+			LOG_INFO(U"ℹ️ CGraphics_GL: Pipelined rendering enabled");
+		}
+		else
+		{
+			m_renderThread->wait();
+			
+			// キューに残っている処理を実行し終えてから、コンテキストがメインスレッドに戻る
+			m_renderThread.reset();
+			
+			// 描画スレッドに任せる予定だった消去を行う
+			if (m_nextJob.clear)
+			{
+				clearBuffers(m_nextJob.clearScene, m_nextJob.clearColor, m_nextJob.letterboxColor);
+			}
+			
+			m_nextJob = FrameJob{};
+			
+			LOG_INFO(U"ℹ️ CGraphics_GL: Pipelined rendering disabled");
+		}
+	}
+	
+	bool CGraphics_GL::getPipelinedRendering() const
+	{
+		return (m_renderThread != nullptr);
+	}
+	
+	void CGraphics_GL::postCommand(std::function<void()> command)
+	{
+		if (m_renderThread)
+		{
+			m_renderThread->post(std::move(command));
+		}
+		else
+		{
+			command();
+		}
+	}
+	
+	void CGraphics_GL::invokeCommand(const std::function<void()>& command)
+	{
+		if (m_renderThread)
+		{
+			m_renderThread->invoke(command);
+		}
+		else
+		{
+			command();
+		}
+	}
+	
+	bool CGraphics_GL::isContextThread() const
+	{
+		return (!m_renderThread || m_renderThread->isRenderThread());
+	}
+	
+	static CGraphics_GL* GetGraphics()
+	{
+		if (!Siv3DEngine::isActive())
+		{
+			return nullptr;
+		}
+		
+		return dynamic_cast<CGraphics_GL*>(Siv3DEngine::Get<ISiv3DGraphics>());
+	}
+	
+	void PostGLCommand(std::function<void()> command)
+	{
+		if (CGraphics_GL* const pGraphics = GetGraphics())
+		{
+			pGraphics->postCommand(std::move(command));
+		}
+		else
+		{
+			command();
+		}
+	}
+	
+	void InvokeGLCommand(const std::function<void()>& command)
+	{
+		if (CGraphics_GL* const pGraphics = GetGraphics())
+		{
+			pGraphics->invokeCommand(command);
+		}
+		else
+		{
+			command();
+		}
+	}
+	
+	bool IsGLContextThread()
+	{
+		if (CGraphics_GL* const pGraphics = GetGraphics())
+		{
+			return pGraphics->isContextThread();
+		}
+		
+		return true;
+	}
 }
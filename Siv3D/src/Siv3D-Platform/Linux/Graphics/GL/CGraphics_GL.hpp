@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include <memory>
 # include <Siv3D/Color.hpp>
 # include <Siv3D/Optional.hpp>
@@ -18,6 +19,7 @@
 # include <GL/glew.h>
 # include <GLFW/glfw3.h>
 # include "SceneTexture.hpp"
+# include "GLRenderThread.hpp"
 # include "BlendState/GLBlendState.hpp"
 # include "RasterizerState/GLRasterizerState.hpp"
 # include "SamplerState/GLSamplerState.hpp"
@@ -46,6 +48,33 @@ namespace s3d
 		TextureFilter m_sceneTextureFilter = Scene::DefaultFilter;
 		
 		Size m_frameBufferSize = Size(0, 0);
+		
+		// 描画スレッドで実行する 1 フレーム分の処理の設定
+		struct FrameJob
+		{
+			// 前のフレームの present() の後の clear() をここで行う
+			bool clear = false;
+			
+			bool clearScene = false;
+			
+			ColorF clearColor;
+			
+			ColorF letterboxColor;
+			
+			bool linearFilter = false;
+		};
+		
+		// パイプライン描画のとき、clear() で記録した次のフレームの設定
+		FrameJob m_nextJob;
+		
+		// 描画スレッドが実行中のフレームの設定
+		FrameJob m_job;
+		
+		std::unique_ptr<GLRenderThread> m_renderThread;
+		
+		void clearBuffers(bool clearScene, const ColorF& clearColor, const ColorF& letterboxColor);
+		
+		void renderFrame();
 
 	public:
 
@@ -93,10 +122,34 @@ namespace s3d
 
 		const Image& getScreenCapture() const override;
 		
+		void setPipelinedRendering(bool enabled) override;
+		
+		bool getPipelinedRendering() const override;
+		
+		// GL コンテキストを持つスレッドで command を実行する。パイプライン描画では描画スレッドのキューに積み、完了を待たない
+		void postCommand(std::function<void()> command);
+		
+		// GL コンテキストを持つスレッドで command を実行し、完了を待つ
+		void invokeCommand(const std::function<void()>& command);
+		
+		// 現在のスレッドが GL コンテキストを持っているか
+		bool isContextThread() const;
+		
 		GLBlendState* getBlendState() { return m_pBlendState.get(); }
 		
 		GLRasterizerState* getRasterizerState() { return m_pRasterizerState.get(); }
 		
 		GLSamplerState* getSamplerState() { return m_pSamplerState.get(); }
 	};
+
+	// GL の処理を、GL コンテキストを持つスレッドで実行する
+	// パイプライン描画では描画スレッドのキューに積まれ、次のフレームの発行より前に実行される
+	// command が参照するデータは、実行されるまで有効でなければならない
+	void PostGLCommand(std::function<void()> command);
+	
+	// PostGLCommand() と同様だが、実行が終わるまで待つ。GL のオブジェクトの作成など、結果が必要な場合に使う
+	void InvokeGLCommand(const std::function<void()>& command);
+	
+	// 現在のスレッドで GL を直接呼べるか。パイプライン描画では描画スレッドだけが GL を呼べる
+	bool IsGLContextThread();
 }
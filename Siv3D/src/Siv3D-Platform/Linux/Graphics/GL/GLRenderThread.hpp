@@ -0,0 +1,82 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <condition_variable>
+# include <deque>
+# include <exception>
+# include <functional>
+# include <mutex>
+# include <thread>
+# include <Siv3D/Types.hpp>
+# include <GL/glew.h>
+# include <GLFW/glfw3.h>
+
+namespace s3d
+{
+	// 記録済みのフレームと、メインスレッドから依頼された GL の処理を別スレッドで発行する
+	// GL コンテキストはこのスレッドが持ち続け、依頼された順に 1 つずつ実行する
+	class GLRenderThread
+	{
+	private:
+		
+		GLFWwindow* m_window = nullptr;
+		
+		std::function<void()> m_job;
+		
+		std::thread m_thread;
+		
+		std::mutex m_mutex;
+		
+		std::condition_variable m_cv;
+		
+		// 描画スレッドで実行を待っている処理
+		std::deque<std::function<void()>> m_commands;
+		
+		// これまでにキューに積んだ処理と、実行を終えた処理の数
+		uint64 m_numPushed = 0;
+		
+		uint64 m_numExecuted = 0;
+		
+		// 最後に kick() したフレームの通し番号
+		uint64 m_lastFrame = 0;
+		
+		bool m_abort = false;
+		
+		std::exception_ptr m_exception;
+		
+		uint64 push(std::function<void()> command);
+		
+		void run();
+		
+	public:
+		
+		// window が nullptr の場合は GL コンテキストを扱わない（テスト用）
+		GLRenderThread(GLFWwindow* window, std::function<void()> job);
+		
+		// キューに残っている処理をすべて実行してから終了し、GL コンテキストをメインスレッドに戻す
+		~GLRenderThread();
+		
+		// ジョブを 1 回実行させる。それまでに post() した処理の後に実行される。前のジョブが終わっていなければ、終わるまで待つ
+		void kick();
+		
+		// 実行中のジョブの完了を待つ。ジョブや post() した処理が例外を投げた場合は、ここで再送出する
+		void wait();
+		
+		// 処理をキューに積み、完了を待たずに戻る。描画スレッドから呼ばれた場合はその場で実行する
+		void post(std::function<void()> command);
+		
+		// 処理をキューに積み、完了を待つ。処理が投げた例外は呼び出し元で再送出する
+		void invoke(const std::function<void()>& command);
+		
+		[[nodiscard]] bool isRenderThread() const;
+	};
+}
@@ -13,6 +13,7 @@
 # include <Siv3D/Time.hpp>
 # include <Siv3D/System.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FileSystem.hpp>
 # include "CLogger.hpp"
 
 namespace s3d
@@ -23,6 +24,8 @@ namespace s3d
 
 	namespace detail
 	{
+		static constexpr std::string_view UTF8BOM = "\xEF\xBB\xBF"sv;
+
 		static constexpr std::string_view HeaderA =
 			u8"<!DOCTYPE html>\n<html lang=\"ja\">\n<head>\n<meta charset=\"UTF-8\" />\n<title>"sv;
 
@@ -76,10 +79,10 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 			u8R"(<div class="trace">)"sv,
 		};
 
-		static void OutputDebug(const int64 timeStamp, const LogDescription desc, const String& text)
+		static void OutputDebug(std::string& console, const int64 timeStamp, const LogDescription desc, const String& text)
 		{
 			const String output = U"{}: {}{}\n"_fmt(timeStamp, LogLevelStr[FromEnum(desc)], text);
-			std::cout << output.narrow();
+			console.append(output.narrow());
 		}
 
 		[[nodiscard]] static constexpr bool Suppressed(const OutputLevel outputLevel, const LogDescription desc)
@@ -101,49 +104,64 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 
 	CLogger::CLogger()
 	{
+		const String fileName = FileSystem::BaseName(FileSystem::ModulePath()).xml_escaped();
+		const std::string titleUTF8 = Unicode::ToUTF8(fileName) + u8" Log";
+
+		if (FileSystem::IsSandBoxed())
+		{
+			m_path = FileSystem::SpecialFolderPath(SpecialFolder::LocalAppData) + fileName + U"_log.html";
+		}
+		else
+		{
+			m_path = fileName + U"_log.html";
+		}
 
+		// ログは終了時にまとめてではなく、書き込みスレッドが逐次ファイルに書き出す
+		m_file = std::fopen(m_path.narrow().c_str(), "wb");
+
+		if (m_file)
+		{
+			m_buffer.append(detail::UTF8BOM);
+			m_buffer.append(detail::HeaderA);
+			m_buffer.append(titleUTF8);
+			m_buffer.append(detail::HeaderB);
+			m_buffer.append(titleUTF8);
+			m_buffer.append(detail::HeaderC);
+			flush();
+		}
+
+		m_writerThread = std::thread([this] { run(); });
 	}
 
 	CLogger::~CLogger()
 	{
 		m_active = false;
 
-		if constexpr (!Platform::DebugBuild)
-		{
-			if (!m_hasImportantLog)
-			{
-				return;
-			}
-		}
+		m_queue.close();
 
-		const String fileName = FileSystem::BaseName(FileSystem::ModulePath()).xml_escaped();
-		const std::string titleUTF8 = Unicode::ToUTF8(fileName) + u8" Log";
-		FilePath path;
-		
-		if (FileSystem::IsSandBoxed())
+		if (m_writerThread.joinable())
 		{
-			path = FileSystem::SpecialFolderPath(SpecialFolder::LocalAppData) + fileName + U"_log.html";
+			m_writerThread.join();
 		}
-		else
+
+		if (!m_file)
 		{
-			path = fileName + U"_log.html";
+			return;
 		}
 
-		if (TextWriter writer{ path, TextEncoding::UTF8 })
+		m_buffer.append(detail::Footer);
+		flush();
+
+		std::fclose(m_file);
+		m_file = nullptr;
+
+		if constexpr (!Platform::DebugBuild)
 		{
-			writer.writeUTF8(detail::HeaderA);
-			writer.writeUTF8(titleUTF8);
-			writer.writeUTF8(detail::HeaderB);
-			writer.writeUTF8(titleUTF8);
-			writer.writeUTF8(detail::HeaderC);
-			
-			std::lock_guard lock(m_mutex);
+			// リリースビルドでは、エラーが記録されなかった場合にファイルを残さない
+			if (!m_hasImportantLog)
 			{
-				writer.writeUTF8(m_buffer);
-				m_buffer.clear();
+				std::remove(m_path.narrow().c_str());
 			}
-
-			writer.writeUTF8(detail::Footer);
 		}
 	}
 
@@ -161,17 +179,7 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 
 		const int64 timeStamp = Time::GetMillisec() - g_applicationTime;
 
-		std::lock_guard lock(m_mutex);
-		{
-			detail::OutputDebug(timeStamp, desc, text);
-
-			m_buffer.append(detail::LogLevelDiv[FromEnum(desc)]);
-			m_buffer.append(std::to_string(timeStamp) + u8": ");
-			m_buffer.append(text.xml_escaped().toUTF8());
-			m_buffer.append(detail::DivEnd);
-
-			m_hasImportantLog |= (desc == LogDescription::Error);
-		}
+		m_queue.push(LogRecord{ timeStamp, desc, text, {} });
 	}
 
 	void CLogger::writeOnce(const LogDescription desc, const uint32 id, const String& text)
@@ -183,36 +191,98 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 
 		const int64 timeStamp = Time::GetMillisec() - g_applicationTime;
 
-		std::lock_guard lock(m_mutex);
 		{
-			if (m_onceFlags.find(id) != m_onceFlags.end())
+			std::lock_guard lock(m_mutexOnceFlags);
+
+			if (!m_onceFlags.insert(id).second)
 			{
 				return;
 			}
+		}
+
+		m_queue.push(LogRecord{ timeStamp, desc, text, {} });
+	}
 
-			m_onceFlags.insert(id);
+	void CLogger::writeRawHTML_UTF8(const std::string_view htmlText)
+	{
+		if (!m_active || htmlText.empty())
+		{
+			return;
+		}
 
-			detail::OutputDebug(timeStamp, desc, text);
+		m_queue.push(LogRecord{ 0, LogDescription::App, {}, std::string(htmlText) });
+	}
 
-			m_buffer.append(detail::LogLevelDiv[FromEnum(desc)]);
-			m_buffer.append(std::to_string(timeStamp) + u8": ");
-			m_buffer.append(text.xml_escaped().toUTF8());
-			m_buffer.append(detail::DivEnd);
+	void CLogger::run()
+	{
+		LogRecord record;
 
-			m_hasImportantLog |= (desc == LogDescription::Error);
+		for (;;)
+		{
+			// close() 前に追加されたレコードをすべて書き出してから終了する
+			const bool closed = m_queue.isClosed();
+
+			bool written = false;
+
+			while (m_queue.pop(record))
+			{
+				writeRecord(record);
+
+				written = true;
+			}
+
+			flush();
+
+			if (closed)
+			{
+				break;
+			}
+
+			if (!written)
+			{
+				m_queue.wait(std::chrono::milliseconds(100));
+			}
 		}
 	}
 
-	void CLogger::writeRawHTML_UTF8(const std::string_view htmlText)
+	void CLogger::writeRecord(const LogRecord& record)
+	{
+		if (!record.rawHTML.empty())
+		{
+			m_buffer.append(record.rawHTML);
+			return;
+		}
+
+		detail::OutputDebug(m_console, record.timeStamp, record.desc, record.text);
+
+		m_buffer.append(detail::LogLevelDiv[FromEnum(record.desc)]);
+		m_buffer.append(std::to_string(record.timeStamp) + u8": ");
+		m_buffer.append(record.text.xml_escaped().toUTF8());
+		m_buffer.append(detail::DivEnd);
+
+		m_hasImportantLog |= (record.desc == LogDescription::Error);
+	}
+
+	void CLogger::flush()
 	{
-		if (!m_active)
+		if (!m_console.empty())
+		{
+			std::cout.write(m_console.data(), m_console.size());
+			std::cout.flush();
+			m_console.clear();
+		}
+
+		if (m_buffer.empty())
 		{
 			return;
 		}
 
-		std::lock_guard lock(m_mutex);
+		if (m_file)
 		{
-			m_buffer.append(htmlText);
+			std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+			std::fflush(m_file);
 		}
+
+		m_buffer.clear();
 	}
 }
@@ -30,6 +30,11 @@ namespace s3d
 	}
 	
 	void GLRenderer2DCommand::reset()
+	{
+		reset(*this);
+	}
+	
+	void GLRenderer2DCommand::reset(const GLRenderer2DCommand& previous)
 	{
 		m_commands.clear();
 		m_changes.reset();
@@ -40,35 +45,35 @@ namespace s3d
 		m_commands.emplace_back(RendererCommand::SetBuffers, 0);
 		m_commands.emplace_back(RendererCommand::UpdateBuffers, 0);
 		
-		m_colorMuls = { m_colorMuls.back() };
+		m_colorMuls = { previous.m_colorMuls.back() };
 		m_commands.emplace_back(RendererCommand::ColorMul, 0);
 		
-		m_colorAdds = { m_colorAdds.back() };
+		m_colorAdds = { previous.m_colorAdds.back() };
 		m_commands.emplace_back(RendererCommand::ColorAdd, 0);
 		
-		m_blendStates = { m_blendStates.back() };
+		m_blendStates = { previous.m_blendStates.back() };
 		m_commands.emplace_back(RendererCommand::BlendState, 0);
 		
-		m_rasterizerStates = { m_rasterizerStates.back() };
+		m_rasterizerStates = { previous.m_rasterizerStates.back() };
 		m_commands.emplace_back(RendererCommand::RasterizerState, 0);
 		
 		for (uint32 i = 0; i < SamplerState::MaxSamplerCount; ++i)
 		{
 			const auto command = ToEnum<RendererCommand>(FromEnum(RendererCommand::PSSamplerState0) + i);
-			m_psSamplerStates[i] = { m_psSamplerStates[i].back() };
+			m_psSamplerStates[i] = { previous.m_psSamplerStates[i].back() };
 			m_commands.emplace_back(command, 0);
 		}
 		
-		m_combinedTransforms = { m_combinedTransforms.back() };
+		m_combinedTransforms = { previous.m_combinedTransforms.back() };
 		m_commands.emplace_back(RendererCommand::Transform, 0);
 		
-		m_pixelShaders = { m_pixelShaders.back() };
+		m_pixelShaders = { previous.m_pixelShaders.back() };
 		m_commands.emplace_back(RendererCommand::SetPS, 0);
 		
-		m_scissorRects = { m_scissorRects.back() };
+		m_scissorRects = { previous.m_scissorRects.back() };
 		m_commands.emplace_back(RendererCommand::ScissorRect, 0);
 		
-		m_viewports = { m_viewports.back() };
+		m_viewports = { previous.m_viewports.back() };
 		m_commands.emplace_back(RendererCommand::Viewport, 0);
 		
 		for (uint32 i = 0; i < SamplerState::MaxSamplerCount; ++i)
@@ -78,7 +83,7 @@ namespace s3d
 			m_commands.emplace_back(command, 0);
 		}
 		
-		m_sdfParams = { m_sdfParams.back() };
+		m_sdfParams = { previous.m_sdfParams.back() };
 		m_commands.emplace_back(RendererCommand::SDFParam, 0);
 		
 		m_currentColorMul = m_colorMuls.front();
@@ -89,7 +94,10 @@ namespace s3d
 		{
 			m_currentPSSamplerStates[i] = m_psSamplerStates[i].front();
 		}
+		m_currentLocalTransform = previous.m_currentLocalTransform;
+		m_currentCameraTransform = previous.m_currentCameraTransform;
 		m_currentCombinedTransform = m_combinedTransforms.front();
+		m_currentMaxScaling = previous.m_currentMaxScaling;
 		m_currentPixelShader = m_pixelShaders.front();
 		m_currentScissorRect = m_scissorRects.front();
 		m_currentViewport = m_viewports.front();
@@ -208,7 +216,7 @@ namespace s3d
 		m_currentDraw.indexCount += indexCount;
 	}
 	
-	const DrawCommand& GLRenderer2DCommand::getDraw(const uint32 index)
+	const DrawCommand& GLRenderer2DCommand::getDraw(const uint32 index) const
 	{
 		return m_draws[index];
 	}
@@ -169,12 +169,15 @@ namespace s3d
 		
 		void reset();
 		
+		// previous の最後の状態を引き継いで、次のフレームの記録を始める
+		void reset(const GLRenderer2DCommand& previous);
+		
 		void flush();
 		
 		const Array<std::pair<RendererCommand, uint32>>& getList() const;
 		
 		void pushDraw(uint16 indexCount);
-		const DrawCommand& getDraw(uint32 index);
+		const DrawCommand& getDraw(uint32 index) const;
 		
 		void pushUpdateBuffers(uint32 batchIndex);
 		
@@ -0,0 +1,230 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/EngineLog.hpp>
+# include "GLSpriteBuffer.hpp"
+
+namespace s3d
+{
+	GLSpriteBuffer::~GLSpriteBuffer()
+	{
+		for (auto& fence : m_sectionFences)
+		{
+			if (fence)
+			{
+				::glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+		
+		if (m_indexBuffer)
+		{
+			::glDeleteBuffers(1, &m_indexBuffer);
+			m_indexBuffer = 0;
+		}
+		
+		if (m_vertexBuffer)
+		{
+			::glDeleteBuffers(1, &m_vertexBuffer);
+			m_vertexBuffer = 0;
+		}
+		
+		if (m_vao)
+		{
+			::glDeleteVertexArrays(1, &m_vao);
+			m_vao = 0;
+		}
+	}
+	
+	bool GLSpriteBuffer::init()
+	{
+		::glGenBuffers(1, &m_vertexBuffer);
+		::glGenBuffers(1, &m_indexBuffer);
+		
+		::glGenVertexArrays(1, &m_vao);
+		
+		::glBindVertexArray(m_vao);
+		{
+			::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+			::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+			
+			m_persistentMapped = (GLEW_ARB_buffer_storage && initPersistentBuffers());
+			
+			if (!m_persistentMapped)
+			{
+				::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+				::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
+			
+			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)0);
+			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)8);
+			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (GLubyte*)16);
+			
+			::glEnableVertexAttribArray(0);
+			::glEnableVertexAttribArray(1);
+			::glEnableVertexAttribArray(2);
+		}
+		::glBindVertexArray(0);
+		
+		LOG_INFO(U"ℹ️ GLSpriteBuffer: {}"_fmt(m_persistentMapped ? U"persistent-mapped ring buffer" : U"glMapBufferRange"));
+
+		return true;
+	}
+	
+	bool GLSpriteBuffer::initPersistentBuffers()
+	{
+		constexpr GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+		constexpr GLsizeiptr vertexBufferBytes = sizeof(Vertex2D) * VertexBufferSize * RingSectionCount;
+		constexpr GLsizeiptr indexBufferBytes = sizeof(IndexType) * IndexBufferSize * RingSectionCount;
+		
+		::glBufferStorage(GL_ARRAY_BUFFER, vertexBufferBytes, nullptr, flags);
+		::glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, indexBufferBytes, nullptr, flags);
+		
+		m_mappedVertices = static_cast<Vertex2D*>(::glMapBufferRange(GL_ARRAY_BUFFER, 0, vertexBufferBytes, flags));
+		m_mappedIndices = static_cast<IndexType*>(::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, indexBufferBytes, flags));
+		
+		if (m_mappedVertices && m_mappedIndices)
+		{
+			return true;
+		}
+		
+		// 失敗した場合は、バッファを作り直して従来の方法に戻す
+		LOG_FAIL(U"GLSpriteBuffer: failed to map persistent buffers");
+		
+		::glDeleteBuffers(1, &m_vertexBuffer);
+		::glDeleteBuffers(1, &m_indexBuffer);
+		::glGenBuffers(1, &m_vertexBuffer);
+		::glGenBuffers(1, &m_indexBuffer);
+		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+		
+		m_mappedVertices = nullptr;
+		m_mappedIndices = nullptr;
+		
+		return false;
+	}
+	
+	void GLSpriteBuffer::advanceSection()
+	{
+		// 現在の区画を使う描画の完了を示すフェンス
+		if (m_sectionFences[m_currentSection])
+		{
+			::glDeleteSync(m_sectionFences[m_currentSection]);
+		}
+		
+		m_sectionFences[m_currentSection] = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		
+		m_currentSection = ((m_currentSection + 1) % RingSectionCount);
+		
+		// 次の区画を GPU が読み終えるまで待つ
+		if (GLsync fence = m_sectionFences[m_currentSection])
+		{
+			while (::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED);
+			
+			::glDeleteSync(fence);
+			m_sectionFences[m_currentSection] = nullptr;
+		}
+		
+		m_vertexBufferWritePos = 0;
+		m_indexBufferWritePos = 0;
+	}
+	
+	BatchInfo GLSpriteBuffer::writePersistentBuffers(const BatchData& batch)
+	{
+		if ((VertexBufferSize < (m_vertexBufferWritePos + batch.vertexSize))
+			|| (IndexBufferSize < (m_indexBufferWritePos + batch.indexSize)))
+		{
+			advanceSection();
+		}
+		
+		const uint32 vertexBase = (VertexBufferSize * m_currentSection) + m_vertexBufferWritePos;
+		const uint32 indexBase = (IndexBufferSize * m_currentSection) + m_indexBufferWritePos;
+		
+		std::memcpy(m_mappedVertices + vertexBase, batch.pVertex, sizeof(Vertex2D) * batch.vertexSize);
+		std::memcpy(m_mappedIndices + indexBase, batch.pIndex, sizeof(IndexType) * batch.indexSize);
+		
+		m_vertexBufferWritePos += batch.vertexSize;
+		m_indexBufferWritePos += batch.indexSize;
+		
+		BatchInfo batchInfo;
+		batchInfo.indexCount = batch.indexSize;
+		batchInfo.startIndexLocation = indexBase;
+		batchInfo.baseVertexLocation = vertexBase;
+		batchInfo.uploadedBytes = static_cast<uint32>(sizeof(Vertex2D) * batch.vertexSize + sizeof(IndexType) * batch.indexSize);
+		return batchInfo;
+	}
+	
+	BatchInfo GLSpriteBuffer::updateBuffers(const GLSpriteBatch& batches, const size_t batchIndex)
+	{
+		const BatchData batch = batches.getBatch(batchIndex);
+		
+		::glBindVertexArray(m_vao);
+		
+		if (m_persistentMapped)
+		{
+			return writePersistentBuffers(batch);
+		}
+		
+		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		
+		BatchInfo batchInfo;
+		
+		// VB
+		if (const uint16 vertexSize = batch.vertexSize)
+		{
+			if (VertexBufferSize < (m_vertexBufferWritePos + vertexSize))
+			{
+				m_vertexBufferWritePos = 0;
+				::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
+			
+			void* pDst = ::glMapBufferRange(GL_ARRAY_BUFFER, sizeof(Vertex2D) * m_vertexBufferWritePos, sizeof(Vertex2D) * vertexSize,
+											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			std::memcpy(pDst, batch.pVertex, sizeof(Vertex2D) * vertexSize);
+			::glUnmapBuffer(GL_ARRAY_BUFFER);
+			
+			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D) * vertexSize);
+			m_vertexBufferWritePos += vertexSize;
+		}
+		
+		// IB
+		if (const uint32 indexSize = batch.indexSize)
+		{
+			if (IndexBufferSize < (m_indexBufferWritePos + indexSize))
+			{
+				m_indexBufferWritePos = 0;
+				::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
+			
+			void* pDst = ::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * m_indexBufferWritePos, sizeof(IndexType) * indexSize,
+											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			std::memcpy(pDst, batch.pIndex, sizeof(IndexType) * indexSize);
+			::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+			
+			batchInfo.indexCount = indexSize;
+			batchInfo.startIndexLocation = m_indexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(IndexType) * indexSize);
+			m_indexBufferWritePos += indexSize;
+		}
+		
+		return batchInfo;
+	}
+	
+	void GLSpriteBuffer::endFrame()
+	{
+		// 次のフレームは GPU が使っていない区画に書き込む
+		if (m_persistentMapped && (m_vertexBufferWritePos || m_indexBufferWritePos))
+		{
+			advanceSection();
+		}
+	}
+}
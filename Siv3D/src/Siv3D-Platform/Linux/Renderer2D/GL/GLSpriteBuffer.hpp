@@ -0,0 +1,80 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <GL/glew.h>
+# include <GLFW/glfw3.h>
+# include "GLSpriteBatch.hpp"
+
+namespace s3d
+{
+	struct BatchInfo
+	{
+		uint32 indexCount = 0;
+		
+		uint32 startIndexLocation = 0;
+		
+		uint32 baseVertexLocation = 0;
+		
+		uint32 uploadedBytes = 0;
+	};
+	
+	// GLSpriteBatch に記録されたバッチを GPU の頂点バッファ・インデックスバッファに転送する
+	class GLSpriteBuffer
+	{
+	private:
+		
+		GLuint m_vao = 0;
+		
+		GLuint m_vertexBuffer = 0;
+		uint32 m_vertexBufferWritePos = 0;
+		
+		GLuint m_indexBuffer = 0;
+		uint32 m_indexBufferWritePos = 0;
+		
+		// GL_ARB_buffer_storage が使える場合は、永続マップしたバッファを 3 つの区画のリングとして使う
+		// 記録は描画スレッドの発行と並行するため、マップした領域には直接書かず、GLSpriteBatch の配列からバッチごとに 1 回コピーする
+		// インデックスは Vertex2D::IndexType (uint16) を Direct3D 11 版や Vertex2DBuilder と共有するため 16-bit のまま
+		static constexpr uint32 RingSectionCount = 3;
+		
+		bool m_persistentMapped = false;
+		
+		Vertex2D* m_mappedVertices = nullptr;
+		
+		IndexType* m_mappedIndices = nullptr;
+		
+		uint32 m_currentSection = 0;
+		
+		std::array<GLsync, RingSectionCount> m_sectionFences{};
+		
+		[[nodiscard]] bool initPersistentBuffers();
+		
+		void advanceSection();
+		
+		[[nodiscard]] BatchInfo writePersistentBuffers(const BatchData& batch);
+		
+		static constexpr uint32 VertexBufferSize	= GLSpriteBatch::VertexBufferSize;
+		static constexpr uint32 IndexBufferSize		= GLSpriteBatch::IndexBufferSize;
+		
+	public:
+		
+		GLSpriteBuffer() = default;
+		
+		~GLSpriteBuffer();
+		
+		[[nodiscard]] bool init();
+		
+		[[nodiscard]] BatchInfo updateBuffers(const GLSpriteBatch& batches, size_t batchIndex);
+		
+		void endFrame();
+	};
+}
@@ -14,6 +14,7 @@
 # include <Siv3D/EngineError.hpp>
 # include <Siv3D/TextureFormat.hpp>
 # include <Siv3D/System.hpp>
+# include <Graphics/GL/CGraphics_GL.hpp>
 # include "CTexture_GL.hpp"
 
 namespace s3d
@@ -48,7 +49,7 @@ namespace s3d
 	{
 		LOG_TRACE(U"CTexture_GL::~CTexture_GL()");
 
-		m_textures.destroy();
+		InvokeGLCommand([this]() { m_textures.destroy(); });
 	}
 
 	void CTexture_GL::init()
@@ -110,9 +111,20 @@ namespace s3d
 			return pushRequest(image, Array<Image>(), desc);
 		}
 		
-		auto texture = std::make_unique<Texture_GL>(image, desc);
+		std::unique_ptr<Texture_GL> texture;
 		
-		if (!texture->isInitialized())
+		InvokeGLCommand([&]()
+		{
+			texture = std::make_unique<Texture_GL>(image, desc);
+			
+			// 作成に失敗したテクスチャも GL コンテキストを持つスレッドで破棄する
+			if (!texture->isInitialized())
+			{
+				texture.reset();
+			}
+		});
+		
+		if (!texture)
 		{
 			return TextureID::NullAsset();
 		}
@@ -132,9 +144,20 @@ namespace s3d
 			return pushRequest(image, mips, desc);
 		}
 		
-		auto texture = std::make_unique<Texture_GL>(image, mips, desc);
+		std::unique_ptr<Texture_GL> texture;
 		
-		if (!texture->isInitialized())
+		InvokeGLCommand([&]()
+		{
+			texture = std::make_unique<Texture_GL>(image, mips, desc);
+			
+			// 作成に失敗したテクスチャも GL コンテキストを持つスレッドで破棄する
+			if (!texture->isInitialized())
+			{
+				texture.reset();
+			}
+		});
+		
+		if (!texture)
 		{
 			return TextureID::NullAsset();
 		}
@@ -144,9 +167,20 @@ namespace s3d
 
 	TextureID CTexture_GL::createDynamic(const Size& size, const void* pData, const uint32 stride, const TextureFormat format, const TextureDesc desc)
 	{
-		auto texture = std::make_unique<Texture_GL>(size, pData, stride, format, desc);
+		std::unique_ptr<Texture_GL> texture;
+		
+		InvokeGLCommand([&]()
+		{
+			texture = std::make_unique<Texture_GL>(size, pData, stride, format, desc);
+			
+			// 作成に失敗したテクスチャも GL コンテキストを持つスレッドで破棄する
+			if (!texture->isInitialized())
+			{
+				texture.reset();
+			}
+		});
 		
-		if (!texture->isInitialized())
+		if (!texture)
 		{
 			return TextureID::NullAsset();
 		}
@@ -163,7 +197,8 @@ namespace s3d
 
 	void CTexture_GL::release(const TextureID handleID)
 	{
-		m_textures.erase(handleID);
+		// 先に積まれた fill() の後に破棄する
+		PostGLCommand([this, handleID]() { m_textures.erase(handleID); });
 	}
 
 	Size CTexture_GL::getSize(const TextureID handleID)
@@ -178,22 +213,76 @@ namespace s3d
 
 	bool CTexture_GL::fill(const TextureID handleID, const ColorF& color, const bool wait)
 	{
-		return m_textures[handleID]->fill(color, wait);
+		Texture_GL* const texture = m_textures[handleID];
+		
+		if (!texture->isDynamic())
+		{
+			return false;
+		}
+		
+		PostGLCommand([texture, color, wait]() { texture->fill(color, wait); });
+		
+		return true;
 	}
 
 	bool CTexture_GL::fillRegion(TextureID handleID, const ColorF& color, const Rect& rect)
 	{
-		return m_textures[handleID]->fillRegion(color, rect);
+		Texture_GL* const texture = m_textures[handleID];
+		
+		if (!texture->isDynamic() || !texture->contains(rect))
+		{
+			return false;
+		}
+		
+		PostGLCommand([texture, color, rect]() { texture->fillRegion(color, rect); });
+		
+		return true;
 	}
 
 	bool CTexture_GL::fill(const TextureID handleID, const void* const src, const uint32 stride, const bool wait)
 	{
-		return m_textures[handleID]->fill(src, stride, wait);
+		Texture_GL* const texture = m_textures[handleID];
+		
+		if (!texture->isDynamic())
+		{
+			return false;
+		}
+		
+		// src は描画スレッドで転送されるまで有効とは限らないのでコピーする
+		const Byte* const pSrc = static_cast<const Byte*>(src);
+		
+		Array<Byte> pixels(pSrc, pSrc + (stride * texture->getSize().y));
+		
+		PostGLCommand([texture, pixels = std::move(pixels), stride, wait]() { texture->fill(pixels.data(), stride, wait); });
+		
+		return true;
 	}
 
 	bool CTexture_GL::fillRegion(TextureID handleID, const void* src, uint32 stride, const Rect& rect, const bool wait)
 	{
-		return m_textures[handleID]->fillRegion(src, stride, rect, wait);
+		Texture_GL* const texture = m_textures[handleID];
+		
+		if (!texture->isDynamic() || !texture->contains(rect))
+		{
+			return false;
+		}
+		
+		if ((rect.w <= 0) || (rect.h <= 0))
+		{
+			return true;
+		}
+		
+		// 更新する行だけをコピーし、描画スレッドでは rect の左上の画素から転送する
+		const Byte* const pSrc = static_cast<const Byte*>(src) + (stride * rect.y);
+		
+		Array<Byte> pixels(pSrc, pSrc + (stride * rect.h));
+		
+		PostGLCommand([texture, pixels = std::move(pixels), stride, rect, wait]()
+		{
+			texture->fillRegion(pixels.data() + (sizeof(uint32) * rect.x), stride, rect, wait);
+		});
+		
+		return true;
 	}
 	
 	GLuint CTexture_GL::getTexture(const TextureID handleID)
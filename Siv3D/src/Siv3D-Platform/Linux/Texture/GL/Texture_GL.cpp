@@ -153,35 +153,26 @@ namespace s3d
 		return true;
 	}
 	
-	bool Texture_GL::fillRegion(const void* src, const uint32 stride, const Rect& rect, bool wait)
+	bool Texture_GL::fillRegion(const void* src, const uint32 stride, const Rect& rect, bool)
 	{
 		if (!m_isDynamic)
 		{
 			return false;
 		}
 		
-		Array<uint32> newData(rect.w * rect.h);
-		
-		if (newData.isEmpty())
+		if ((rect.w <= 0) || (rect.h <= 0))
 		{
 			return true;
 		}
 		
-		uint32* pDst = newData.data();
-
-		for (int32 y = rect.y; y < rect.y + rect.h; ++y)
-		{
-			const uint32* line = static_cast<const uint32*>(src) + (stride/sizeof(uint32)) * y;
-			
-			for (int32 x = rect.x; x < rect.x + rect.w; ++x)
-			{
-				*pDst++ = line[x];
-			}
-		}
-		
 		::glBindTexture(GL_TEXTURE_2D, m_texture);
 		
-		::glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, GL_RGBA, GL_UNSIGNED_BYTE, newData.data());
+		// 行の間隔を指定して、src から rect の範囲を直接転送する
+		::glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(stride / sizeof(uint32)));
+		
+		::glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, GL_RGBA, GL_UNSIGNED_BYTE, src);
+		
+		::glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 		
 		return true;
 	}
@@ -76,12 +76,24 @@ namespace s3d
 			return m_textureDesc;
 		}
 		
+		bool isDynamic() const noexcept
+		{
+			return m_isDynamic;
+		}
+		
+		bool contains(const Rect& rect) const noexcept
+		{
+			return (0 <= rect.x) && (0 <= rect.y)
+				&& ((rect.x + rect.w) <= m_size.x) && ((rect.y + rect.h) <= m_size.y);
+		}
+		
 		bool fill(const ColorF& color, bool wait);
 		
 		bool fillRegion(const ColorF& color, const Rect& rect);
 		
 		bool fill(const void* src, uint32 stride, bool wait);
 		
+		// src は rect の左上の画素を指す
 		bool fillRegion(const void* src, uint32 stride, const Rect& rect, bool wait);
 	};
 }
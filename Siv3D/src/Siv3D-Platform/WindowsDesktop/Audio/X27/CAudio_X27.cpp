@@ -131,6 +131,12 @@ namespace s3d
 		return m_audios.add(std::move(audio));
 	}
 
+	AudioID CAudio_X27::createStreaming(const FilePath& path)
+	{
+		// [Siv3D ToDo] XAudio2 のストリーミング再生
+		return create(Wave(path));
+	}
+
 	void CAudio_X27::release(const AudioID handleID)
 	{
 		m_audios.erase(handleID);
@@ -49,6 +49,8 @@ namespace s3d
 
 		AudioID create(Wave&& wave) override;
 
+		AudioID createStreaming(const FilePath& path) override;
+
 		void release(AudioID handleID) override;
 
 		uint32 samplingRate(AudioID handleID) override;
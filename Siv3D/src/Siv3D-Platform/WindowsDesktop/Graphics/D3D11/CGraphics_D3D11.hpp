@@ -89,6 +89,10 @@ namespace s3d
 
 		const Image& getScreenCapture() const override;
 
+		void setPipelinedRendering(bool) override {} // do nothing for Direct3D 11
+
+		bool getPipelinedRendering() const override { return false; }
+
 		ID3D11Device* getDevice() const { return m_device->getDevice(); }
 
 		ID3D11DeviceContext* getContext() const { return m_device->getContext(); }
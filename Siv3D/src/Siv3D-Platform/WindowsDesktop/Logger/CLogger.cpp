@@ -12,6 +12,7 @@
 # include <Siv3D/Logger.hpp>
 # include <Siv3D/Time.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Windows.hpp>
 # include "CLogger.hpp"
 
@@ -23,6 +24,8 @@ namespace s3d
 
 	namespace detail
 	{
+		static constexpr std::string_view UTF8BOM = "\xEF\xBB\xBF"sv;
+
 		static constexpr std::string_view HeaderA =
 			u8"<!DOCTYPE html>\n<html lang=\"ja\">\n<head>\n<meta charset=\"UTF-8\" />\n<title>"sv;
 
@@ -101,39 +104,60 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 
 	CLogger::CLogger()
 	{
+		const String fileName = FileSystem::BaseName(FileSystem::ModulePath()).xml_escaped();
+		const std::string titleUTF8 = Unicode::ToUTF8(fileName) + u8" Log";
 
+		m_path = fileName + U"_log.html";
+
+		// ログは終了時にまとめてではなく、書き込みスレッドが逐次ファイルに書き出す
+		if (::_wfopen_s(&m_file, m_path.toWstr().c_str(), L"wb") != 0)
+		{
+			m_file = nullptr;
+		}
+
+		if (m_file)
+		{
+			m_buffer.append(detail::UTF8BOM);
+			m_buffer.append(detail::HeaderA);
+			m_buffer.append(titleUTF8);
+			m_buffer.append(detail::HeaderB);
+			m_buffer.append(titleUTF8);
+			m_buffer.append(detail::HeaderC);
+			flush();
+		}
+
+		m_writerThread = std::thread([this] { run(); });
 	}
 
 	CLogger::~CLogger()
 	{
 		m_active = false;
 
-		if constexpr (!Platform::DebugBuild)
+		m_queue.close();
+
+		if (m_writerThread.joinable())
 		{
-			if (!m_hasImportantLog)
-			{
-				return;
-			}
+			m_writerThread.join();
 		}
 
-		const String fileName = FileSystem::BaseName(FileSystem::ModulePath()).xml_escaped();
-		const std::string titleUTF8 = Unicode::ToUTF8(fileName) + u8" Log";
+		if (!m_file)
+		{
+			return;
+		}
 
-		if (TextWriter writer{ fileName + U"_log.html", TextEncoding::UTF8 })
+		m_buffer.append(detail::Footer);
+		flush();
+
+		std::fclose(m_file);
+		m_file = nullptr;
+
+		if constexpr (!Platform::DebugBuild)
 		{
-			writer.writeUTF8(detail::HeaderA);
-			writer.writeUTF8(titleUTF8);
-			writer.writeUTF8(detail::HeaderB);
-			writer.writeUTF8(titleUTF8);
-			writer.writeUTF8(detail::HeaderC);
-			
-			std::lock_guard lock(m_mutex);
+			// リリースビルドでは、エラーが記録されなかった場合にファイルを残さない
+			if (!m_hasImportantLog)
 			{
-				writer.writeUTF8(m_buffer);
-				m_buffer.clear();
+				::DeleteFileW(m_path.toWstr().c_str());
 			}
-
-			writer.writeUTF8(detail::Footer);
 		}
 	}
 
@@ -151,17 +175,7 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 
 		const int64 timeStamp = Time::GetMillisec() - g_applicationTime;
 
-		std::lock_guard lock(m_mutex);
-		{
-			detail::OutputDebug(timeStamp, desc, text);
-
-			m_buffer.append(detail::LogLevelDiv[FromEnum(desc)]);
-			m_buffer.append(std::to_string(timeStamp) + u8": ");
-			m_buffer.append(text.xml_escaped().toUTF8());
-			m_buffer.append(detail::DivEnd);
-
-			m_hasImportantLog |= (desc == LogDescription::Error);
-		}
+		m_queue.push(LogRecord{ timeStamp, desc, text, {} });
 	}
 
 	void CLogger::writeOnce(const LogDescription desc, const uint32 id, const String& text)
@@ -173,36 +187,91 @@ div.messages { margin: 0 10% 28px; padding 0 0 28px; border: 1px solid; border-c
 
 		const int64 timeStamp = Time::GetMillisec() - g_applicationTime;
 
-		std::lock_guard lock(m_mutex);
 		{
-			if (m_onceFlags.find(id) != m_onceFlags.end())
+			std::lock_guard lock(m_mutexOnceFlags);
+
+			if (!m_onceFlags.insert(id).second)
 			{
 				return;
 			}
+		}
 
-			m_onceFlags.insert(id);
+		m_queue.push(LogRecord{ timeStamp, desc, text, {} });
+	}
 
-			detail::OutputDebug(timeStamp, desc, text);
+	void CLogger::writeRawHTML_UTF8(const std::string_view htmlText)
+	{
+		if (!m_active || htmlText.empty())
+		{
+			return;
+		}
+
+		m_queue.push(LogRecord{ 0, LogDescription::App, {}, std::string(htmlText) });
+	}
+
+	void CLogger::run()
+	{
+		LogRecord record;
+
+		for (;;)
+		{
+			// close() 前に追加されたレコードをすべて書き出してから終了する
+			const bool closed = m_queue.isClosed();
+
+			bool written = false;
+
+			while (m_queue.pop(record))
+			{
+				writeRecord(record);
+
+				written = true;
+			}
 
-			m_buffer.append(detail::LogLevelDiv[FromEnum(desc)]);
-			m_buffer.append(std::to_string(timeStamp) + u8": ");
-			m_buffer.append(text.xml_escaped().toUTF8());
-			m_buffer.append(detail::DivEnd);
+			flush();
 
-			m_hasImportantLog |= (desc == LogDescription::Error);
+			if (closed)
+			{
+				break;
+			}
+
+			if (!written)
+			{
+				m_queue.wait(std::chrono::milliseconds(100));
+			}
 		}
 	}
 
-	void CLogger::writeRawHTML_UTF8(const std::string_view htmlText)
+	void CLogger::writeRecord(const LogRecord& record)
+	{
+		if (!record.rawHTML.empty())
+		{
+			m_buffer.append(record.rawHTML);
+			return;
+		}
+
+		detail::OutputDebug(record.timeStamp, record.desc, record.text);
+
+		m_buffer.append(detail::LogLevelDiv[FromEnum(record.desc)]);
+		m_buffer.append(std::to_string(record.timeStamp) + u8": ");
+		m_buffer.append(record.text.xml_escaped().toUTF8());
+		m_buffer.append(detail::DivEnd);
+
+		m_hasImportantLog |= (record.desc == LogDescription::Error);
+	}
+
+	void CLogger::flush()
 	{
-		if (!m_active)
+		if (m_buffer.empty())
 		{
 			return;
 		}
 
-		std::lock_guard lock(m_mutex);
+		if (m_file)
 		{
-			m_buffer.append(htmlText);
+			std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+			std::fflush(m_file);
 		}
+
+		m_buffer.clear();
 	}
 }
@@ -10,11 +10,14 @@
 //-----------------------------------------------
 
 # pragma once
+# include <atomic>
+# include <cstdio>
 # include <mutex>
-# include <Siv3D/TextWriter.hpp>
+# include <thread>
 # include <Siv3D/Logger.hpp>
 # include <Siv3D/HashSet.hpp>
 # include <Logger/ILogger.hpp>
+# include <Logger/LogQueue.hpp>
 
 namespace s3d
 {
@@ -22,18 +25,34 @@ namespace s3d
 	{
 	private:
 
+		LogQueue m_queue;
+
+		std::thread m_writerThread;
+
+		FilePath m_path;
+
+		std::FILE* m_file = nullptr;
+
+		// 書き込みスレッドが 1 回の取り出しでまとめた HTML
 		std::string m_buffer;
 
 		HashSet<uint32> m_onceFlags;
 
-		std::mutex m_mutex;
+		std::mutex m_mutexOnceFlags;
 
 		OutputLevel m_outputLevel = Platform::DebugBuild ? OutputLevel::More : OutputLevel::Normal;
 
-		bool m_active = true;
+		std::atomic<bool> m_active = true;
 
+		// 書き込みスレッドのみが更新する
 		bool m_hasImportantLog = false;
 
+		void run();
+
+		void writeRecord(const LogRecord& record);
+
+		void flush();
+
 	public:
 
 		CLogger();
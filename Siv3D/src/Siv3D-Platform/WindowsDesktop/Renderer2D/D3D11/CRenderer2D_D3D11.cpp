@@ -17,6 +17,8 @@
 # include <Siv3D/FloatRect.hpp>
 # include <Siv3D/FloatQuad.hpp>
 # include <Siv3D/Line.hpp>
+# include <Siv3D/Circle.hpp>
+# include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/Math.hpp>
 # include <ConstantBuffer/D3D11/D3D11ConstantBuffer.hpp>
@@ -120,10 +122,7 @@ namespace s3d
 			throw EngineError(U"D3D11SpriteBatch::init() failed");
 		}
 
-		m_bufferCreator = [this](IndexType vertexSize, IndexType indexSize)
-		{
-			return m_batches.getBuffer(vertexSize, indexSize, m_commands);
-		};
+		m_bufferCreator = BufferCreator(m_batches, m_commands);
 
 		{
 			const Image boxShadowImage(Resource(U"engine/texture/box-shadow/256.png"));
@@ -156,6 +155,8 @@ namespace s3d
 			m_commands.reset();
 		};
 
+		flushSortedDraws();
+
 		m_commands.flush();
 
 		CGraphics_D3D11* const pGraphics = dynamic_cast<CGraphics_D3D11* const>(Siv3DEngine::Get<ISiv3DGraphics>());
@@ -171,7 +172,7 @@ namespace s3d
 		Mat3x2 transform = Mat3x2::Identity();
 		Mat3x2 screenMat = Mat3x2::Screen(currentRenderTargetSize);	
 		BatchInfo batchInfo;
-		size_t profile_drawcalls = 0, profile_vertices = 0;
+		size_t profile_drawcalls = 0, profile_vertices = 0, profile_batches = 0, profile_uploadedBytes = 0;
 
 		LOG_COMMAND(U"--Renderer2D commands--");
 
@@ -190,6 +191,9 @@ namespace s3d
 				{
 					batchInfo = m_batches.updateBuffers(index);
 
+					++profile_batches;
+					profile_uploadedBytes += batchInfo.uploadedBytes;
+
 					LOG_COMMAND(U"UpdateBuffers[{}] BatchInfo(indexCount = {}, startIndexLocation = {}, baseVertexLocation = {})"_fmt(
 						index, batchInfo.indexCount, batchInfo.startIndexLocation, batchInfo.baseVertexLocation));
 					break;
@@ -355,6 +359,7 @@ namespace s3d
 		LOG_COMMAND(U"--({} commands)--"_fmt(m_commands.getList().size()));
 
 		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(profile_drawcalls, profile_vertices / 3);
+		Siv3DEngine::Get<ISiv3DProfiler>()->reportBatches(profile_batches, profile_uploadedBytes);
 	}
 
 	std::pair<float, FloatRect> CRenderer2D_D3D11::getLetterboxingTransform() const
@@ -431,6 +436,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setColorMul(const Float4& color)
 	{
+		flushSortedDraws();
+
 		m_commands.pushColorMul(color);
 	}
 
@@ -441,6 +448,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setColorAdd(const Float4& color)
 	{
+		flushSortedDraws();
+
 		m_commands.pushColorAdd(color);
 	}
 
@@ -451,6 +460,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setBlendState(const BlendState& state)
 	{
+		flushSortedDraws();
+
 		m_commands.pushBlendState(state);
 	}
 
@@ -461,6 +472,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setRasterizerState(const RasterizerState& state)
 	{
+		flushSortedDraws();
+
 		m_commands.pushRasterizerState(state);
 	}
 
@@ -471,6 +484,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setPSSamplerState(const uint32 slot, const SamplerState& state)
 	{
+		flushSortedDraws();
+
 		m_commands.pushPSSamplerState(state, slot);
 	}
 
@@ -481,7 +496,9 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setLocalTransform(const Mat3x2& matrix)
 	{
-		return m_commands.pushLocalTransform(matrix);
+		flushSortedDraws();
+
+		m_commands.pushLocalTransform(matrix);
 	}
 
 	const Mat3x2& CRenderer2D_D3D11::getLocalTransform() const
@@ -491,7 +508,9 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setCameraTransform(const Mat3x2& matrix)
 	{
-		return m_commands.pushCameraTransform(matrix);
+		flushSortedDraws();
+
+		m_commands.pushCameraTransform(matrix);
 	}
 
 	const Mat3x2& CRenderer2D_D3D11::getCameraTransform() const
@@ -506,6 +525,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setScissorRect(const Rect& rect)
 	{
+		flushSortedDraws();
+
 		m_commands.pushScissorRect(rect);
 	}
 
@@ -516,6 +537,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setViewport(const Optional<Rect>& viewport)
 	{
+		flushSortedDraws();
+
 		m_commands.pushViewport(viewport);
 	}
 
@@ -526,6 +549,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::setSDFParameters(const Float4& parameters)
 	{
+		flushSortedDraws();
+
 		m_commands.pushSdfParam(parameters);
 	}
 
@@ -534,14 +559,39 @@ namespace s3d
 		return m_commands.getCurrentSdfParam();
 	}
 
+	void CRenderer2D_D3D11::setDrawSorting(const bool enabled)
+	{
+		if (enabled == m_drawSorting)
+		{
+			return;
+		}
+
+		flushSortedDraws();
+
+		m_drawSorting = enabled;
+
+		if (enabled)
+		{
+			m_bufferCreator = BufferCreator(m_sortedDraws, m_commands);
+		}
+		else
+		{
+			m_bufferCreator = BufferCreator(m_batches, m_commands);
+		}
+	}
+
+	bool CRenderer2D_D3D11::getDrawSorting() const
+	{
+		return m_drawSorting;
+	}
+
 	void CRenderer2D_D3D11::addLine(const LineStyle& style, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2])
 	{
 		if (style.isSquareCap())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildSquareCappedLine(m_bufferCreator, begin, end, thickness, colors))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isRoundCap())
@@ -550,8 +600,7 @@ namespace s3d
 
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundCappedLine(m_bufferCreator, begin, end, thickness, colors, startAngle))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 
 				const float thicknessHalf = thickness * 0.5f;
 				addCirclePie(begin, thicknessHalf, startAngle, Math::PiF, colors[0]);
@@ -562,24 +611,21 @@ namespace s3d
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildUncappedLine(m_bufferCreator, begin, end, thickness, colors))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isSquareDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildSquareDotLine(m_bufferCreator, begin, end, thickness, colors, static_cast<float>(style.dotOffset), getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::SquareDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::SquareDot, indexCount);
 			}
 		}
 		else if (style.isRoundDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundDotLine(m_bufferCreator, begin, end, thickness, colors, static_cast<float>(style.dotOffset), style.hasAlignedDot))
 			{
-				m_commands.pushPS(StandardPSIndex::RoundDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::RoundDot, indexCount);
 			}
 		}
 	}
@@ -588,8 +634,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, pts, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -597,8 +642,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, pts, colors))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -606,8 +650,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -615,8 +658,27 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, colors))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
+		}
+	}
+
+	void CRenderer2D_D3D11::addRects(const FloatRect* rects, size_t count, const Float4& color)
+	{
+		while (count)
+		{
+			const size_t n = std::min(count, Vertex2DBuilder::MaxBatchRectCount);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildRects(m_bufferCreator, rects, n, color))
+			{
+				commitDraw(StandardPSIndex::Shape, indexCount);
+			}
+			else
+			{
+				return;
+			}
+
+			rects += n;
+			count -= n;
 		}
 	}
 
@@ -624,8 +686,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -633,8 +694,29 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCircle(m_bufferCreator, center, r, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
+		}
+	}
+
+	void CRenderer2D_D3D11::addCircles(const Circle* circles, size_t count, const Float4& color)
+	{
+		const float scale = getMaxScaling();
+
+		while (count)
+		{
+			size_t builtCount = 0;
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, count, color, scale, builtCount))
+			{
+				commitDraw(StandardPSIndex::Shape, indexCount);
+			}
+			else
+			{
+				return;
+			}
+
+			circles += builtCount;
+			count -= builtCount;
 		}
 	}
 
@@ -642,8 +724,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -651,8 +732,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCirclePie(m_bufferCreator, center, r, startAngle, angle, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -660,8 +740,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCircleArc(m_bufferCreator, center, rInner, startAngle, angle, thickness, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -669,8 +748,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildEllipse(m_bufferCreator, center, a, b, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -678,8 +756,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildEllipseFrame(m_bufferCreator, center, aInner, bInner, thickness, innerColor, outerColor, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -687,8 +764,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -696,8 +772,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, colors))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -705,8 +780,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRoundRect(m_bufferCreator, rect, w, h, r, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -716,8 +790,7 @@ namespace s3d
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildSquareCappedLineString(m_bufferCreator, pts, size, offset, thickness, inner, color, isClosed, getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isRoundCap())
@@ -726,8 +799,7 @@ namespace s3d
 
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundCappedLineString(m_bufferCreator, pts, size, offset, thickness, inner, color, getMaxScaling(), startAngle, endAngle))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			
 				const float thicknessHalf = thickness * 0.5f;
 				addCirclePie(*pts, thicknessHalf, startAngle, Math::PiF, color);
@@ -740,24 +812,21 @@ namespace s3d
 
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundCappedLineString(m_bufferCreator, pts, size, offset, thickness, inner, color, getMaxScaling(), startAngle, endAngle))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isSquareDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildDotLineString(m_bufferCreator, pts, size, offset, thickness, color, isClosed, true, static_cast<float>(style.dotOffset), false, getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::SquareDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::SquareDot, indexCount);
 			}
 		}
 		else if (style.isRoundDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildDotLineString(m_bufferCreator, pts, size, offset, thickness, color, isClosed, false, static_cast<float>(style.dotOffset), style.hasAlignedDot, getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::RoundDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::RoundDot, indexCount);
 			}
 		}
 	}
@@ -766,8 +835,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildShape2D(m_bufferCreator, vertices, indices, offset, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(count);
+			commitDraw(StandardPSIndex::Shape, count);
 		}
 	}
 
@@ -775,8 +843,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildShape2DTransformed(m_bufferCreator, vertices, indices, s, c, offset, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(count);
+			commitDraw(StandardPSIndex::Shape, count);
 		}
 	}
 
@@ -784,8 +851,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildShape2DFrame(m_bufferCreator, pts, size, thickness, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -793,8 +859,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildSprite(m_bufferCreator, sprite, startIndex, indexCount))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(count);
+			commitDraw(StandardPSIndex::Shape, count);
 		}
 	}
 
@@ -802,9 +867,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildSprite(m_bufferCreator, sprite, startIndex, indexCount))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(count);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, count);
 		}
 	}
 
@@ -812,9 +875,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, color))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
 		}
 	}
 
@@ -822,9 +883,37 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, colors))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+		}
+	}
+
+	void CRenderer2D_D3D11::addTextureRegions(const TextureRegion* regions, const Vec2* positions, size_t count, const Float4& color)
+	{
+		while (count)
+		{
+			// 同じテクスチャが連続する範囲を 1 回で書き込む
+			const Texture& texture = regions->texture;
+			const TextureID textureID = texture.id();
+			const size_t maxCount = std::min(count, Vertex2DBuilder::MaxBatchRectCount);
+			size_t n = 1;
+
+			while ((n < maxCount) && (regions[n].texture.id() == textureID))
+			{
+				++n;
+			}
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegions(m_bufferCreator, regions, positions, n, color))
+			{
+				commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+			}
+			else
+			{
+				return;
+			}
+
+			regions += n;
+			positions += n;
+			count -= n;
 		}
 	}
 
@@ -832,9 +921,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTexturedCircle(m_bufferCreator, circle, uv, color, getMaxScaling()))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
 		}
 	}
 
@@ -842,27 +929,82 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTexturedQuad(m_bufferCreator, quad, uv, color))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+		}
+	}
+
+	void CRenderer2D_D3D11::addParticles(const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table)
+	{
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxBatchRectCount)
+		{
+			const size_t count = std::min(particles.size() - offset, Vertex2DBuilder::MaxBatchRectCount);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildParticles(m_bufferCreator, particles, offset, count, table))
+			{
+				commitDraw(StandardPSIndex::Shape, indexCount);
+			}
+			else
+			{
+				return;
+			}
+		}
+	}
+
+	void CRenderer2D_D3D11::addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table)
+	{
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxBatchRectCount)
+		{
+			const size_t count = std::min(particles.size() - offset, Vertex2DBuilder::MaxBatchRectCount);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildParticles(m_bufferCreator, particles, offset, count, table))
+			{
+				commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+			}
+			else
+			{
+				return;
+			}
+		}
+	}
+
+	const Texture& CRenderer2D_D3D11::getBoxShadowTexture() const
+	{
+		return *m_boxShadowTexture;
+	}
+
+	void CRenderer2D_D3D11::commitDraw(const size_t psIndex, const uint16 indexCount)
+	{
+		if (m_drawSorting)
+		{
+			m_sortedDraws.commit(psIndex, indexCount);
+		}
+		else
+		{
+			m_commands.pushPS(psIndex);
 			m_commands.pushDraw(indexCount);
 		}
 	}
 
-	void CRenderer2D_D3D11::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
+	void CRenderer2D_D3D11::commitDraw(const size_t psIndex, const Texture& texture, const uint16 indexCount)
 	{
-		if (const uint16 indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		if (m_drawSorting)
+		{
+			m_sortedDraws.commit(psIndex, texture, indexCount);
+		}
+		else
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
+			m_commands.pushPS(psIndex);
 			m_commands.pushPSTexture(0, texture);
 			m_commands.pushDraw(indexCount);
 		}
 	}
 
-	const Texture& CRenderer2D_D3D11::getBoxShadowTexture() const
+	void CRenderer2D_D3D11::flushSortedDraws()
 	{
-		return *m_boxShadowTexture;
+		if (!m_sortedDraws.isEmpty())
+		{
+			m_sortedDraws.flush(m_batches, m_commands);
+		}
 	}
 
 	void CRenderer2D_D3D11::setVS(const VertexShader& vs)
@@ -19,6 +19,7 @@
 # include "D3D11SpriteBatch.hpp"
 # include "D3D11Renderer2DCommand.hpp"
 # include <Renderer2D/Vertex2DBuilder.hpp>
+# include <Renderer2D/SortedDrawRecorder.hpp>
 
 namespace s3d
 {
@@ -89,13 +90,20 @@ namespace s3d
 
 		D3D11SpriteBatch m_batches;
 		D3D11Renderer2DCommand m_commands;
-		BufferCreatorFunc m_bufferCreator;
+		BufferCreator m_bufferCreator;
+
+		SortedDrawRecorder m_sortedDraws;
+		bool m_drawSorting = false;
 
 		std::unique_ptr<Texture> m_boxShadowTexture;
 
 		void setVS(const VertexShader& vs);
 		void setPS(const PixelShader& ps);
 
+		void commitDraw(size_t psIndex, uint16 indexCount);
+		void commitDraw(size_t psIndex, const Texture& texture, uint16 indexCount);
+		void flushSortedDraws();
+
 	public:
 
 		CRenderer2D_D3D11();
@@ -152,6 +160,10 @@ namespace s3d
 
 		Float4 getSDFParameters() const override;
 
+		void setDrawSorting(bool enabled) override;
+
+		bool getDrawSorting() const override;
+
 		void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) override;
 
 		void addTriangle(const Float2(&pts)[3], const Float4& color) override;
@@ -162,10 +174,14 @@ namespace s3d
 
 		void addRect(const FloatRect& rect, const Float4(&colors)[4]) override;
 
+		void addRects(const FloatRect* rects, size_t count, const Float4& color) override;
+
 		void addRectFrame(const FloatRect& rect, float thickness, const Float4& color) override;
 
 		void addCircle(const Float2& center, float r, const Float4& color) override;
 
+		void addCircles(const Circle* circles, size_t count, const Float4& color) override;
+
 		void addCircleFrame(const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor) override;
 
 		void addCirclePie(const Float2& center, float r, float startAngle, float angle, const Float4& color) override;
@@ -198,13 +214,15 @@ namespace s3d
 
 		void addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]) override;
 
+		void addTextureRegions(const TextureRegion* regions, const Vec2* positions, size_t count, const Float4& color) override;
+
 		void addTexturedCircle(const Texture& texture, const Circle& circle, const FloatRect& uv, const Float4& color) override;
 
 		void addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color) override;
 	
-		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
+		void addParticles(const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table) override;
+
+		void addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table) override;
 
 		const Texture& getBoxShadowTexture() const override;
 	};
@@ -192,6 +192,7 @@ namespace s3d
 			}
 
 			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D) * vertexSize);
 			m_vertexBufferWritePos += vertexSize;
 		}
 
@@ -224,6 +225,7 @@ namespace s3d
 
 			batchInfo.indexCount = indexSize;
 			batchInfo.startIndexLocation = m_indexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(IndexType) * indexSize);
 			m_indexBufferWritePos += indexSize;
 		}
 
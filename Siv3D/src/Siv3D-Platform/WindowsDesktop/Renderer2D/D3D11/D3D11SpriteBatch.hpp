@@ -27,6 +27,8 @@ namespace s3d
 		uint32 startIndexLocation = 0;
 
 		uint32 baseVertexLocation = 0;
+
+		uint32 uploadedBytes = 0;
 	};
 
 	class D3D11SpriteBatch
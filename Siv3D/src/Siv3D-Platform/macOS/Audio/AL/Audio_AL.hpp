@@ -10,648 +10,548 @@
 //-----------------------------------------------
 
 # pragma once
-# include <unistd.h>
 # include <OpenAL/al.h>
 # include <OpenAL/alc.h>
 
-# include <thread>
+# include <mutex>
+# include <atomic>
 # include <Audio/AudioControlManager.hpp>
 # include <Siv3D/Optional.hpp>
 # include <Siv3D/Audio.hpp>
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/Logger.hpp>
+# include <Siv3DEngine.hpp>
+# include <AudioFormat/IAudioFormat.hpp>
+# include <Audio/AL/AudioMixer_AL.hpp>
 
 namespace s3d
 {
-	class SimpleVoice_AL
+	// Wave または IAudioStream から、再生するサンプルを読み出す
+	class SampleSource_AL
 	{
 	private:
-		
-		const Wave* m_pWave = nullptr;
-		
-		ALuint m_source = 0;
-		
-		
-		bool m_isActive = false;
-		
-		bool m_isPaused = false;
-		
-		bool m_isEnd = false;
-		
 
-		std::thread m_thread;
-		
-		std::atomic<bool> m_abort = false;
-		
-		
-		static constexpr size_t BufferSamples = 2048;
-		
-		Array<WaveSampleS16> m_tmpBuffer;
-		
-		size_t m_freeBuffer = 2;
-		
-		std::atomic<size_t> m_readPos = 0;
-		
-		std::array<ALuint, 2> m_buffers = {{ 0, 0 }};
-		
-		size_t m_currentBufferID = 0;
-		
-		
-		void feedDetailNonLoop()
-		{
-			const size_t samplesLeft = m_pWave->size() - m_readPos;
-			
-			if (samplesLeft == 0)
-			{
-				return;
-			}
-			
-			const size_t samplesToFeed = std::min(samplesLeft, m_tmpBuffer.size());
-			
-			for (size_t i = 0; i < samplesToFeed; ++i)
-			{
-				const WaveSample& src = (*m_pWave)[m_readPos + i];
-				
-				m_tmpBuffer[i] = src.asWaveSampleS16();
-			}
-			
-			m_readPos += samplesToFeed;
-			
-			const size_t samplesWritten = samplesToFeed;
-			
-			::alBufferData(m_buffers[m_currentBufferID], AL_FORMAT_STEREO16, m_tmpBuffer.data(),
-						   static_cast<ALsizei>(samplesWritten * sizeof(WaveSampleS16)), m_pWave->samplingRate());
-			
-			::alSourceQueueBuffers(m_source, 1, &m_buffers[m_currentBufferID]);
-			
-			++m_currentBufferID %= 2;
-			
-			--m_freeBuffer;
-			
-			//LOG_DEBUG(U"feed {} samples, pos: {}"_fmt(samplesToFeed, m_readPos));
-		}
-		
-		void feed()
-		{
-			if (m_freeBuffer > 0)
-			{
-				feedDetailNonLoop();
-			}
-			
-			ALint processed = 0;
-			::alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
-			
-			while (processed--)
-			{
-				ALuint buffer = 0;
-				
-				::alSourceUnqueueBuffers(m_source, 1, &buffer);
-				
-				++m_freeBuffer;
-				
-				feedDetailNonLoop();
-			}
-		}
-		
-		void onStreamEnd()
+		// ミキサーの合成中に Audio_AL が破棄されても参照できるよう、所有権を共有する
+		std::shared_ptr<const Wave> m_pWave;
+
+		std::unique_ptr<IAudioStream> m_stream;
+
+		// m_stream が次に read() する位置
+		size_t m_streamPos = 0;
+
+		uint32 m_samplingRate = Wave::DefaultSamplingRate;
+
+		size_t m_samples = 0;
+
+	public:
+
+		SampleSource_AL() = default;
+
+		explicit SampleSource_AL(const std::shared_ptr<const Wave>& wave)
+			: m_pWave(wave)
+			, m_samplingRate(wave->samplingRate())
+			, m_samples(wave->size()) {}
+
+		explicit SampleSource_AL(std::unique_ptr<IAudioStream>&& stream)
+			: m_stream(std::move(stream))
+			, m_samplingRate(m_stream->samplingRate())
+			, m_samples(m_stream->samples()) {}
+
+		uint32 samplingRate() const noexcept
 		{
-			m_isActive = false;
-			m_isPaused = false;
-			m_isEnd = true;
-			
-			m_readPos  = 0;
-			
-			//LOG_TEST(U"End of Stream");
+			return m_samplingRate;
 		}
-		
-		void onUpdate()
+
+		size_t size() const noexcept
 		{
-			for (;;)
-			{
-				if (!m_source)
-				{
-					continue;
-				}
-				
-				if (m_isActive)
-				{
-					feed();
-					
-					ALint sampleOffset = 0;
-					::alGetSourcei(m_source, AL_SAMPLE_OFFSET, &sampleOffset);
-				}
-				
-				ALint currentState = 0;
-				::alGetSourcei(m_source, AL_SOURCE_STATE, &currentState);
-				
-				if (!m_isEnd && m_isActive && currentState == AL_STOPPED)
-				{
-					onStreamEnd();
-				}
-				
-				if (m_abort)
-				{
-					break;
-				}
-				
-				::usleep(5 * 1000);
-			}
+			return m_samples;
 		}
-		
-	public:
-		
-		SimpleVoice_AL() = default;
-		
-		SimpleVoice_AL(const Wave& wave, const double volume, const double pitch)
-			: m_pWave(&wave)
-			, m_tmpBuffer(BufferSamples)
-		{
-			::alGenBuffers(2, m_buffers.data());
-			::alGenSources(1, &m_source);
-			
-			::alSourcef(m_source, AL_GAIN, static_cast<float>(volume));
-			::alSourcef(m_source, AL_PITCH, static_cast<float>(pitch));
-			
-			::alSource3f(m_source, AL_POSITION, 0, 0, 0);
-			::alSource3f(m_source, AL_VELOCITY, 0, 0, 0);
-			::alSourcei(m_source, AL_LOOPING, AL_FALSE);
-			
-			feed();
-
-			m_thread = std::thread(&SimpleVoice_AL::onUpdate, this);
 
-			::alSourcePlay(m_source);
-			
-			m_isActive = true;
-			m_isPaused = false;
-		}
-		
-		~SimpleVoice_AL()
+		// pos から count サンプルを dst に書き込む
+		void read(const size_t pos, const size_t count, WaveSample* dst)
 		{
-			if (!m_abort)
-			{
-				m_abort = true;
-			}
-			
-			if (m_thread.joinable())
-			{
-				m_thread.join();
-			}
-			
-			if (m_source)
+			if (m_pWave)
 			{
-				::alSourceStop(m_source);
-				
-				::alDeleteSources(1, &m_source);
+				std::copy_n(m_pWave->begin() + pos, count, dst);
+
+				return;
 			}
-			
-			if (m_buffers[0])
+
+			if (pos != m_streamPos)
 			{
-				::alDeleteBuffers(2, &m_buffers[0]);
+				m_stream->seek(pos);
 			}
+
+			const size_t samplesRead = m_stream->read(dst, count);
+
+			// デコードできなかった部分は無音にする
+			std::fill(dst + samplesRead, dst + count, WaveSample::Zero());
+
+			m_streamPos = (pos + samplesRead);
 		}
 	};
-	
-	class VoiceStream_AL
+
+	// SampleSource_AL のサンプルを再生速度に合わせて線形補間し、ミキサーに出力する
+	class SourceVoice_AL : public AudioVoice_AL
 	{
 	private:
-		
-		const Wave* m_pWave = nullptr;
-		
-		ALuint m_source = 0;
-		
-		
-		Optional<AudioLoopTiming> m_loop;
-		
-		std::pair<double, double> m_volume = { 1.0, 1.0 };
-		
-		double m_speed = 1.0;
-		
 
-		bool m_isActive = false;
-		
-		bool m_isPaused = false;
-		
-		bool m_isEnd = false;
-		
-		
-		std::thread m_thread;
-		
-		bool m_hasThread = false;
-		
-		std::atomic<bool> m_abort = false;
-		
-		
-		std::atomic<int64> m_posSampleCurrentStream = 0;
-		
-		std::atomic<int64> m_samplesPlayedAccumulated = 0;
-		
-		std::atomic<size_t> m_posSmaplesAccumulated = 0;
-		
-		Array<size_t> m_samplesQueued;
-		
-		
-		static constexpr size_t BufferSamples = 2048;
-		
-		Array<WaveSampleS16> m_tmpBuffer;
-		
-		size_t m_freeBuffer = 2;
-		
+		// 1 回の読み込みでソースから取り出すサンプル数
+		static constexpr size_t WindowSamples = 2048;
+
+		SampleSource_AL m_sampleSource;
+
+		// ソースから読み込んだサンプル。m_window[m_windowPos] と m_window[m_windowPos + 1] の間を補間する
+		Array<WaveSample> m_window;
+
+		size_t m_windowPos = 0;
+
+		double m_phase = 0.0;
+
+		bool m_sourceEnded = false;
+
+		Array<float> m_scratch;
+
+		// ソースから次に読み込む位置
 		std::atomic<size_t> m_readPos = 0;
-		
-		std::array<ALuint, 2> m_buffers = {{ 0, 0 }};
-		
-		size_t m_currentBufferID = 0;
-		
-		
-		void feedDetailNonLoop()
+
+		std::atomic<int64> m_posSample = 0;
+
+		std::atomic<int64> m_samplesPlayed = 0;
+
+		// ループ区間 [begin, end) を返す。ループしない場合や区間が空の場合は none
+		Optional<std::pair<size_t, size_t>> getLoopRange() const
 		{
-			const size_t samplesLeft = m_pWave->size() - m_readPos;
-			
-			if (samplesLeft == 0)
+			if (!m_loop)
 			{
-				return;
+				return none;
 			}
-			
-			const size_t samplesToFeed = std::min(samplesLeft, m_tmpBuffer.size());
-			
-			for (size_t i = 0; i < samplesToFeed; ++i)
+
+			const size_t end = std::min<size_t>(m_loop->endPos, m_sampleSource.size());
+			const size_t begin = static_cast<size_t>(m_loop->beginPos);
+
+			if (end <= begin)
 			{
-				const WaveSample& src = (*m_pWave)[m_readPos + i];
-				
-				m_tmpBuffer[i] = src.asWaveSampleS16();
+				return none;
 			}
-			
-			m_readPos += samplesToFeed;
-			
-			const size_t samplesWritten = samplesToFeed;
-			
-			::alBufferData(m_buffers[m_currentBufferID], AL_FORMAT_STEREO16, m_tmpBuffer.data(),
-						   static_cast<ALsizei>(samplesWritten * sizeof(WaveSampleS16)), m_pWave->samplingRate());
-			
-			::alSourceQueueBuffers(m_source, 1, &m_buffers[m_currentBufferID]);
-			
-			m_samplesQueued << samplesWritten;
-			
-			++m_currentBufferID %= 2;
-			
-			--m_freeBuffer;
-			
-			//LOG_DEBUG(U"feed {} samples, pos: {}"_fmt(samplesToFeed, m_readPos));
+
+			return std::make_pair(begin, end);
 		}
-		
-		void feedDetailLoop()
+
+		// ループを考慮して、ソースから最大 count サンプルを順に読み込む
+		size_t fetch(WaveSample* dst, const size_t count)
 		{
-			const size_t bufferSize = m_tmpBuffer.size();
-			size_t samplesFed = 0;
-			size_t tmpBufferPos = 0;
-			
-			while (samplesFed < bufferSize)
+			const auto loopRange = getLoopRange();
+			const size_t end = loopRange ? loopRange->second : m_sampleSource.size();
+			size_t fetched = 0;
+
+			while (fetched < count)
 			{
-				size_t samplesAvailable = m_loop->endPos - m_readPos;
-				
-				if (samplesAvailable == 0)
-				{
-					m_readPos = m_loop->beginPos;
-					
-					// [Siv3D ToDo] ループすると Audio::posSample() が Audio::streamPosSample() より大きくなる
-					m_posSmaplesAccumulated = m_loop->beginPos;
-					m_posSampleCurrentStream = 0;
-					
-					samplesAvailable = m_loop->endPos - m_loop->beginPos;
-				}
-				
-				const size_t samplesToFeed = std::min(samplesAvailable, bufferSize - samplesFed);
-				
-				for (size_t i = 0; i < samplesToFeed; ++i)
+				size_t readPos = m_readPos;
+
+				if (end <= readPos)
 				{
-					const WaveSample& src = (*m_pWave)[m_readPos + i];
-					
-					m_tmpBuffer[tmpBufferPos++] = src.asWaveSampleS16();
+					if (!loopRange)
+					{
+						break;
+					}
+
+					readPos = loopRange->first;
 				}
-				
-				samplesFed += samplesToFeed;
-				m_readPos += samplesToFeed;
+
+				const size_t samplesToRead = std::min(end - readPos, count - fetched);
+
+				m_sampleSource.read(readPos, samplesToRead, dst + fetched);
+
+				fetched += samplesToRead;
+				m_readPos = (readPos + samplesToRead);
 			}
-			
-			const size_t samplesWritten = samplesFed;
-			
-			::alBufferData(m_buffers[m_currentBufferID], AL_FORMAT_STEREO16, m_tmpBuffer.data(),
-						   static_cast<ALsizei>(samplesWritten * sizeof(WaveSampleS16)), m_pWave->samplingRate());
-			
-			::alSourceQueueBuffers(m_source, 1, &m_buffers[m_currentBufferID]);
-			
-			m_samplesQueued << samplesWritten;
-			
-			++m_currentBufferID %= 2;
-			
-			--m_freeBuffer;
-			
-			//LOG_DEBUG(U"feed {} samples, pos: {}"_fmt(samplesFed, m_readPos));
+
+			return fetched;
 		}
-		
-		void feed()
+
+		// m_window[m_windowPos + 1] まで読み込まれた状態にする。ソースの終端に達した場合は false
+		bool prepareWindow()
 		{
-			if (m_freeBuffer > 0)
+			while ((m_windowPos + 1) >= m_window.size())
 			{
-				if (m_loop)
+				if (m_sourceEnded)
 				{
-					feedDetailLoop();
+					return false;
 				}
-				else
+
+				size_t kept = 0;
+
+				if (m_windowPos < m_window.size())
 				{
-					feedDetailNonLoop();
+					// 補間のために現在のサンプルを残す
+					m_window[0] = m_window[m_windowPos];
+					m_windowPos = 0;
+					kept = 1;
 				}
-			}
-			
-			ALint processed = 0;
-			::alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
-			
-			while (processed--)
-			{
-				ALuint buffer = 0;
-				
-				::alSourceUnqueueBuffers(m_source, 1, &buffer);
-				
-				m_posSmaplesAccumulated += m_samplesQueued.front();
-				
-				m_samplesPlayedAccumulated += m_samplesQueued.front();
-				
-				m_samplesQueued.pop_front();
-				
-				++m_freeBuffer;
-				
-				if (m_loop)
+				else
 				{
-					feedDetailLoop();
+					m_windowPos -= m_window.size();
 				}
-				else
+
+				m_window.resize(kept + WindowSamples);
+
+				const size_t fetched = fetch(m_window.data() + kept, WindowSamples);
+
+				m_window.resize(kept + fetched);
+
+				if (fetched < WindowSamples)
 				{
-					feedDetailNonLoop();
+					m_sourceEnded = true;
 				}
 			}
-			
-			//LOG_TEST(U"#{}+{}"_fmt(m_posSmaplesAccumulated, m_posSampleCurrentStream));
-		}
-		
-		void onStreamEnd()
-		{
-			m_isActive = false;
-			m_isPaused = false;
-			m_isEnd = true;
-			
-			m_readPos  = 0;
-			m_posSmaplesAccumulated = 0;
-			m_samplesPlayedAccumulated = 0;
-			m_posSampleCurrentStream = 0;
 
-			m_volume = { 1.0, 1.0 };
-			m_speed = 1.0;
-			
-			//LOG_TEST(U"End of Stream");
+			return true;
 		}
-		
-		void onUpdate()
+
+		void advance(const size_t samples)
 		{
-			for (;;)
+			m_windowPos += samples;
+			m_samplesPlayed += samples;
+
+			int64 posSample = (m_posSample + samples);
+
+			if (const auto loopRange = getLoopRange())
 			{
-				if (!m_source)
+				while (static_cast<int64>(loopRange->second) <= posSample)
 				{
-					continue;
+					posSample -= (loopRange->second - loopRange->first);
 				}
-				
-				if (m_isActive)
-				{
-					feed();
-					
-					ALint sampleOffset = 0;
-					::alGetSourcei(m_source, AL_SAMPLE_OFFSET, &sampleOffset);
-					m_posSampleCurrentStream = sampleOffset;
-				}
-	
-				ALint currentState = 0;
-				::alGetSourcei(m_source, AL_SOURCE_STATE, &currentState);
-				
-				if (!m_isEnd && m_isActive && currentState == AL_STOPPED)
-				{
-					onStreamEnd();
-				}
-				
-				if (m_abort)
+			}
+
+			m_posSample = posSample;
+		}
+
+	protected:
+
+		Optional<AudioLoopTiming> m_loop;
+
+		SourceVoice_AL() = default;
+
+		explicit SourceVoice_AL(SampleSource_AL&& sampleSource)
+			: m_sampleSource(std::move(sampleSource)) {}
+
+		// frames 分を dst に加算する。ソースの終端に達した場合は false
+		bool render(float* dst, const size_t frames, const uint32 outputSamplingRate,
+			const float gainL, const float gainR, const double speed)
+		{
+			const double step = (speed * m_sampleSource.samplingRate() / outputSamplingRate);
+
+			m_scratch.resize(frames * 2);
+
+			size_t rendered = 0;
+
+			for (; rendered < frames; ++rendered)
+			{
+				if (!prepareWindow())
 				{
 					break;
 				}
 
-				::usleep(5 * 1000);
+				const WaveSample& a = m_window[m_windowPos];
+				const WaveSample& b = m_window[m_windowPos + 1];
+				const float t = static_cast<float>(m_phase);
+
+				m_scratch[rendered * 2] = (a.left + (b.left - a.left) * t);
+				m_scratch[rendered * 2 + 1] = (a.right + (b.right - a.right) * t);
+
+				m_phase += step;
+
+				const size_t samplesAdvanced = static_cast<size_t>(m_phase);
+
+				m_phase -= samplesAdvanced;
+
+				advance(samplesAdvanced);
 			}
+
+			AudioMixer_AL::MixStereo(dst, m_scratch.data(), rendered, gainL, gainR);
+
+			return (rendered == frames);
 		}
-		
-		void updateVolume()
+
+		// 再生位置を posSample に移動する
+		void reset(const int64 posSample)
 		{
-			// [Siv3D ToDo]
-			const float volume = static_cast<float>((m_volume.first + m_volume.second) * 0.5);
-			
-			::alSourcef(m_source, AL_GAIN, volume);
+			m_window.clear();
+			m_windowPos = 0;
+			m_phase = 0.0;
+			m_sourceEnded = false;
+
+			m_readPos = static_cast<size_t>(posSample);
+			m_posSample = posSample;
 		}
-		
-		void updateSpeed()
+
+		void resetSamplesPlayed()
 		{
-			::alSourcef(m_source, AL_PITCH, static_cast<float>(m_speed));
+			m_samplesPlayed = 0;
 		}
-		
+
 	public:
-		
-		VoiceStream_AL() = default;
-		
-		VoiceStream_AL(const Wave& wave)
-			: m_pWave(&wave)
-			, m_tmpBuffer(BufferSamples)
+
+		size_t size() const noexcept
 		{
-			::alGenBuffers(2, m_buffers.data());
-			::alGenSources(1, &m_source);
-			
-			::alSourcef(m_source, AL_GAIN, 1.0);
-			::alSourcef(m_source, AL_PITCH, 1.0);
-			
-			::alSource3f(m_source, AL_POSITION, 0, 0, 0);
-			::alSource3f(m_source, AL_VELOCITY, 0, 0, 0);
-			::alSourcei(m_source, AL_LOOPING, AL_FALSE);
+			return m_sampleSource.size();
 		}
-		
-		~VoiceStream_AL()
+
+		int64 streamPosSample() const
+		{
+			return m_readPos;
+		}
+
+		int64 getPosSample() const
+		{
+			return std::min<int64>(m_posSample, m_sampleSource.size());
+		}
+
+		int64 samplesPlayed() const
+		{
+			return m_samplesPlayed;
+		}
+	};
+
+	class SimpleVoice_AL : public SourceVoice_AL
+	{
+	private:
+
+		float m_volume = 1.0f;
+
+		double m_pitch = 1.0;
+
+		std::atomic<bool> m_isFinished = false;
+
+	public:
+
+		SimpleVoice_AL() = default;
+
+		SimpleVoice_AL(SampleSource_AL&& sampleSource, const double volume, const double pitch)
+			: SourceVoice_AL(std::move(sampleSource))
+			, m_volume(static_cast<float>(volume))
+			, m_pitch(Clamp<double>(pitch, 1.0 / 1024.0, 2.0)) {}
+
+		bool mixTo(float* dst, const size_t frames, const uint32 outputSamplingRate) override
 		{
-			if (!m_abort)
+			if (m_isFinished)
 			{
-				m_abort = true;
+				return false;
 			}
-			
-			if (m_thread.joinable())
+
+			if (!render(dst, frames, outputSamplingRate, m_volume, m_volume, m_pitch))
 			{
-				m_thread.join();
+				m_isFinished = true;
+
+				return false;
 			}
-			
-			if (m_source)
+
+			return true;
+		}
+
+		bool isFinished() const noexcept override
+		{
+			return m_isFinished;
+		}
+	};
+
+	// ミキサーのスレッドから mixTo() が呼ばれるため、再生位置やループの変更はボイスのミューテックスを取得して行う。
+	// 音量と速度、再生状態は合成を待たずに読み書きできるよう atomic にする
+	class VoiceStream_AL : public SourceVoice_AL, public std::enable_shared_from_this<VoiceStream_AL>
+	{
+	private:
+
+		AudioMixer_AL* m_mixer = nullptr;
+
+		mutable std::mutex m_mutex;
+
+		std::atomic<double> m_volumeL = 1.0;
+
+		std::atomic<double> m_volumeR = 1.0;
+
+		std::atomic<double> m_speed = 1.0;
+
+		std::atomic<bool> m_isActive = false;
+
+		std::atomic<bool> m_isPaused = false;
+
+		std::atomic<bool> m_isEnd = false;
+
+		void onStreamEnd()
+		{
+			m_isActive = false;
+			m_isPaused = false;
+			m_isEnd = true;
+
+			reset(0);
+			resetSamplesPlayed();
+
+			m_volumeL = 1.0;
+			m_volumeR = 1.0;
+			m_speed = 1.0;
+		}
+
+		std::unique_lock<std::mutex> lock() const
+		{
+			return std::unique_lock<std::mutex>(m_mutex);
+		}
+
+	public:
+
+		VoiceStream_AL() = default;
+
+		VoiceStream_AL(AudioMixer_AL* mixer, SampleSource_AL&& sampleSource)
+			: SourceVoice_AL(std::move(sampleSource))
+			, m_mixer(mixer) {}
+
+		bool mixTo(float* dst, const size_t frames, const uint32 outputSamplingRate) override
+		{
+			const auto l = lock();
+
+			if (!m_isActive)
 			{
-				::alSourceStop(m_source);
-				
-				::alDeleteSources(1, &m_source);
+				return false;
 			}
-			
-			if (m_buffers[0])
+
+			if (m_isPaused)
+			{
+				return true;
+			}
+
+			if (!render(dst, frames, outputSamplingRate,
+				static_cast<float>(m_volumeL), static_cast<float>(m_volumeR), m_speed))
 			{
-				::alDeleteBuffers(2, &m_buffers[0]);
+				onStreamEnd();
+
+				return false;
 			}
+
+			return true;
 		}
-		
+
+		bool isFinished() const noexcept override
+		{
+			return !m_isActive;
+		}
+
 		bool isPlaying() const
 		{
 			return m_isActive && !m_isPaused;
 		}
-		
+
 		bool isPaused() const
 		{
 			return m_isPaused;
 		}
-		
-		int64 streamPosSample() const
-		{
-			return m_readPos;
-		}
-		
-		int64 getPosSample() const
-		{
-			//LOG_TEST(U"{}+{}"_fmt(m_posSmaplesAccumulated, m_posSampleCurrentStream));
-			
-			return std::min<int64>(m_posSmaplesAccumulated + m_posSampleCurrentStream, m_pWave->size());
-		}
-		
-		int64 samplesPlayed() const
-		{
-			return m_samplesPlayedAccumulated + m_posSampleCurrentStream;
-		}
-		
+
 		void setVolume(const std::pair<double, double>& volume)
 		{
-			if (volume == m_volume)
-			{
-				return;
-			}
-			
-			m_volume = volume;
-			
-			updateVolume();
+			m_volumeL = volume.first;
+			m_volumeR = volume.second;
 		}
-		
-		const std::pair<double, double> getVolume() const
+
+		std::pair<double, double> getVolume() const
 		{
-			return m_volume;
+			return{ m_volumeL, m_volumeR };
 		}
-		
+
 		void setSpeed(const double speed)
 		{
-			const double newSpeed = Clamp<double>(speed, 1.0 / 1024.0, 2.0);
-			
-			if (newSpeed == m_speed)
-			{
-				return;
-			}
-			
-			m_speed = newSpeed;
-			
-			updateSpeed();
+			m_speed = Clamp<double>(speed, 1.0 / 1024.0, 2.0);
 		}
-		
+
 		double getSpeed() const
 		{
 			return m_speed;
 		}
-		
+
 		void setLoop(const bool loop, const int64 loopBeginSample, const int64 loopEndSample)
 		{
-			if (!loop)
-			{
-				m_loop.reset();
-			}
-			else
 			{
-				m_loop.emplace(loopBeginSample, loopEndSample);
+				const auto l = lock();
+
+				if (!loop)
+				{
+					m_loop.reset();
+				}
+				else
+				{
+					m_loop.emplace(loopBeginSample, loopEndSample);
+				}
 			}
-			
+
 			stop();
 		}
-		
-		const Optional<AudioLoopTiming>& getLoop() const
+
+		Optional<AudioLoopTiming> getLoop() const
 		{
+			const auto l = lock();
+
 			return m_loop;
 		}
-		
+
 		bool play()
 		{
+			const auto l = lock();
+
 			if (m_isActive && !m_isPaused)
 			{
 				return true;
 			}
-			
-			feed();
-			
-			if (!m_hasThread)
-			{
-				m_thread = std::thread(&VoiceStream_AL::onUpdate, this);
-				
-				m_hasThread = true;
-			}
 
-			::alSourcePlay(m_source);
-			
 			m_isActive = true;
 			m_isPaused = false;
 			m_isEnd = false;
-			
+
+			std::lock_guard mixerLock(m_mixer->getMutex());
+
+			m_mixer->addVoice(shared_from_this());
+
 			return true;
 		}
-		
+
 		void pause()
 		{
+			const auto l = lock();
+
 			if (!m_isActive)
 			{
 				return;
 			}
-			
-			::alSourcePause(m_source);
-			
+
 			m_isPaused = true;
 		}
-		
+
 		void stop()
 		{
+			const auto l = lock();
+
 			if (!m_isActive)
 			{
 				return;
 			}
-			
-			::alSourceStop(m_source);
-			
-			//m_isActive = false;
-			//m_isPaused = false;
+
+			onStreamEnd();
 		}
-		
+
 		bool reachedEnd() const
 		{
 			return m_isEnd;
 		}
-		
+
 		void setPosSmaple(int64 posSample)
 		{
+			const auto l = lock();
+
 			if (m_loop && posSample >= m_loop->endPos)
 			{
 				posSample = m_loop->endPos - 1;
 			}
-			
-			posSample = std::min<int64>(posSample, m_pWave->size() - 1);
-			
-			m_readPos = posSample;
-			
-			m_posSmaplesAccumulated = posSample;
+
+			posSample = Clamp<int64>(posSample, 0, static_cast<int64>(size()) - 1);
+
+			reset(posSample);
 		}
 	};
 	
@@ -659,11 +559,21 @@ namespace s3d
 	{
 	private:
 	
-		Wave m_wave;
+		AudioMixer_AL* m_mixer = nullptr;
+
+		// ストリーミング再生の場合は空
+		std::shared_ptr<Wave> m_wave = std::make_shared<Wave>();
+		
+		// ストリーミング再生の場合のファイルパス
+		FilePath m_path;
+		
+		uint32 m_samplingRate = Wave::DefaultSamplingRate;
+		
+		size_t m_samples = 0;
 		
 		bool m_initialized = false;
 		
-		VoiceStream_AL m_stream;
+		std::shared_ptr<VoiceStream_AL> m_stream;
 		
 		static constexpr size_t MaxVoiceShots = 32;
 		
@@ -673,9 +583,24 @@ namespace s3d
 		
 		Audio_AL() = default;
 		
-		Audio_AL(Wave&& wave)
-			: m_wave(std::move(wave))
-			, m_stream(m_wave)
+		Audio_AL(AudioMixer_AL* mixer, Wave&& wave)
+			: m_mixer(mixer)
+			, m_wave(std::make_shared<Wave>(std::move(wave)))
+			, m_samplingRate(m_wave->samplingRate())
+			, m_samples(m_wave->size())
+			, m_stream(std::make_shared<VoiceStream_AL>(mixer, SampleSource_AL(m_wave)))
+		{
+			m_initialized = true;
+			
+			m_voiceShots.reserve(MaxVoiceShots);
+		}
+		
+		Audio_AL(AudioMixer_AL* mixer, const FilePath& path, std::unique_ptr<IAudioStream>&& stream)
+			: m_mixer(mixer)
+			, m_path(path)
+			, m_samplingRate(stream->samplingRate())
+			, m_samples(stream->samples())
+			, m_stream(std::make_shared<VoiceStream_AL>(mixer, SampleSource_AL(std::move(stream))))
 		{
 			m_initialized = true;
 			
@@ -684,7 +609,20 @@ namespace s3d
 		
 		~Audio_AL()
 		{
-			m_voiceShots.clear();
+			if (!m_mixer)
+			{
+				return;
+			}
+
+			// 合成中のボイスは m_wave の所有権を共有しているため、一覧から外すだけでよい
+			std::lock_guard lock(m_mixer->getMutex());
+
+			m_mixer->removeVoice(m_stream.get());
+
+			for (const auto& voiceShot : m_voiceShots)
+			{
+				m_mixer->removeVoice(voiceShot.get());
+			}
 		}
 		
 		bool isInitialized() const noexcept
@@ -692,33 +630,81 @@ namespace s3d
 			return m_initialized;
 		}
 
+		bool isStreaming() const noexcept
+		{
+			return !m_path.isEmpty();
+		}
+		
+		uint32 samplingRate() const noexcept
+		{
+			return m_samplingRate;
+		}
+		
+		size_t samples() const noexcept
+		{
+			return m_samples;
+		}
+		
+		// ストリーミング再生の場合は空の Wave を返す
 		const Wave& getWave() const
 		{
-			return m_wave;
+			return *m_wave;
 		}
 		
 		VoiceStream_AL& getStream()
 		{
-			return m_stream;
+			return *m_stream;
 		}
 		
 		const VoiceStream_AL& getStream() const
 		{
-			return m_stream;
+			return *m_stream;
 		}
 		
 		void playOneShot(const double volume, const double pitch)
 		{
+			std::shared_ptr<SimpleVoice_AL> voiceShot;
+
+			if (!isStreaming())
+			{
+				voiceShot = std::make_shared<SimpleVoice_AL>(SampleSource_AL(m_wave), volume, pitch);
+			}
+			else if (auto stream = Siv3DEngine::Get<ISiv3DAudioFormat>()->openStream(m_path))
+			{
+				// ショットごとに別のデコーダでファイルを開く
+				voiceShot = std::make_shared<SimpleVoice_AL>(SampleSource_AL(std::move(stream)), volume, pitch);
+			}
+
+			if (!voiceShot)
+			{
+				return;
+			}
+
+			std::lock_guard lock(m_mixer->getMutex());
+
+			m_voiceShots.remove_if([](const std::shared_ptr<SimpleVoice_AL>& v) { return v->isFinished(); });
+
 			if (m_voiceShots.size() + 1 >= MaxVoiceShots)
 			{
+				m_mixer->removeVoice(m_voiceShots.front().get());
+
 				m_voiceShots.pop_front();
 			}
-			
-			m_voiceShots.push_back(std::make_shared<SimpleVoice_AL>(m_wave, volume, pitch));
+
+			m_mixer->addVoice(voiceShot);
+
+			m_voiceShots.push_back(std::move(voiceShot));
 		}
 		
 		void stopAllShots()
 		{
+			std::lock_guard lock(m_mixer->getMutex());
+
+			for (const auto& voiceShot : m_voiceShots)
+			{
+				m_mixer->removeVoice(voiceShot.get());
+			}
+
 			m_voiceShots.clear();
 		}
 	};
@@ -27,6 +27,9 @@ namespace s3d
 		
 		m_audios.destroy();
 		
+		// ミキサーのスレッドと OpenAL のソースを、コンテキストより先に破棄する
+		m_mixer.reset();
+		
 		if (m_context)
 		{
 			m_device = ::alcGetContextsDevice(m_context);
@@ -41,39 +44,45 @@ namespace s3d
 
 	bool CAudio_AL::hasAudioDevice() const
 	{
-		// [Siv3D ToDo]
-		return true;
+		return (m_device != nullptr);
 	}
 
 	bool CAudio_AL::init()
 	{
 		LOG_TRACE(U"CAudio_AL::init()");
 		
-		m_device = ::alcOpenDevice(nullptr);
-		
-		if (!m_device)
-		{
-			return false;
-		}
+		m_mixer = std::make_unique<AudioMixer_AL>();
 		
-		m_context = ::alcCreateContext(m_device, nullptr);
+		m_device = ::alcOpenDevice(nullptr);
 		
-		if (!m_context)
+		if (m_device)
 		{
-			return false;
+			m_context = ::alcCreateContext(m_device, nullptr);
+			
+			if (!m_context)
+			{
+				return false;
+			}
+			
+			if (!::alcMakeContextCurrent(m_context))
+			{
+				return false;
+			}
+			
+			::alListener3f(AL_POSITION, 0, 0, 1.0f);
+			::alListener3f(AL_VELOCITY, 0, 0, 0);
+			const ALfloat listenerOri[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f };
+			::alListenerfv(AL_ORIENTATION, listenerOri);
 		}
-		
-		if (!::alcMakeContextCurrent(m_context))
+		else
 		{
-			return false;
+			// オーディオデバイスが無い環境では、ヌルデバイスに出力する
+			LOG_FAIL(U"❌ CAudio_AL: alcOpenDevice() failed");
 		}
 		
-		::alListener3f(AL_POSITION, 0, 0, 1.0f);
-		::alListener3f(AL_VELOCITY, 0, 0, 0);
-		const ALfloat listenerOri[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f };
-		::alListenerfv(AL_ORIENTATION, listenerOri);
+		m_mixer->init(m_device != nullptr);
 		
-		auto nullAudio = std::make_unique<Audio_AL>(
+		auto nullAudio = std::make_unique<Audio_AL>(m_mixer.get(),
 			Wave(SecondsF(0.5), Arg::generator = [](double t) {
 				return 0.5 * std::sin(t * Math::TwoPi) * std::sin(t * Math::TwoPi * 220.0 * (t * 4.0 + 1.0)); }));
 		
@@ -96,7 +105,7 @@ namespace s3d
 			return AudioID::NullAsset();
 		}
 		
-		auto audio = std::make_unique<Audio_AL>(std::move(wave));
+		auto audio = std::make_unique<Audio_AL>(m_mixer.get(), std::move(wave));
 		
 		if (!audio->isInitialized())
 		{
@@ -106,6 +115,26 @@ namespace s3d
 		return m_audios.add(std::move(audio));
 	}
 
+	AudioID CAudio_AL::createStreaming(const FilePath& path)
+	{
+		auto stream = Siv3DEngine::Get<ISiv3DAudioFormat>()->openStream(path);
+
+		// ストリーミング再生に対応していない形式は、すべてデコードしてから再生する
+		if (!stream)
+		{
+			return create(Wave(path));
+		}
+
+		auto audio = std::make_unique<Audio_AL>(m_mixer.get(), path, std::move(stream));
+
+		if (!audio->isInitialized())
+		{
+			return AudioID::NullAsset();
+		}
+
+		return m_audios.add(std::move(audio));
+	}
+
 	void CAudio_AL::release(const AudioID handleID)
 	{
 		m_audios.erase(handleID);
@@ -113,12 +142,12 @@ namespace s3d
 
 	uint32 CAudio_AL::samplingRate(const AudioID handleID)
 	{
-		return m_audios[handleID]->getWave().samplingRate();
+		return m_audios[handleID]->samplingRate();
 	}
 
 	size_t CAudio_AL::samples(const AudioID handleID)
 	{
-		return m_audios[handleID]->getWave().size();
+		return m_audios[handleID]->samples();
 	}
 
 	void CAudio_AL::setLoop(const AudioID handleID, const bool loop, const int64 loopBeginSample, const int64 loopEndSample)
@@ -23,6 +23,9 @@ namespace s3d
 		
 		ALCcontext* m_context = nullptr;
 		
+		// すべてのボイスを合成するミキサー。m_audios より先に破棄されないよう、先に宣言する
+		std::unique_ptr<AudioMixer_AL> m_mixer;
+		
 		AssetHandleManager<AudioID, Audio_AL> m_audios{ U"Audio" };
 
 	public:
@@ -37,6 +40,8 @@ namespace s3d
 
 		AudioID create(Wave&& wave) override;
 
+		AudioID createStreaming(const FilePath& path) override;
+
 		void release(AudioID handleID) override;
 
 		uint32 samplingRate(AudioID handleID) override;
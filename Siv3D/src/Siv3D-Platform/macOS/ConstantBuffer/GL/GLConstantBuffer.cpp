@@ -9,12 +9,22 @@
 //
 //-----------------------------------------------
 
+# include <Graphics/GL/CGraphics_GL.hpp>
 # include "GLConstantBuffer.hpp"
 
 namespace s3d
 {
 	namespace detail
 	{
+		static void Upload(const GLuint handle, const void* const data, const size_t size)
+		{
+			::glBindBuffer(GL_UNIFORM_BUFFER, handle);
+			
+			::glBufferData(GL_UNIFORM_BUFFER, size, data, GL_STATIC_DRAW);
+			
+			::glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		}
+		
 		ConstantBufferBase::ConstantBufferDetail::ConstantBufferDetail(const size_t size)
 		: m_bufferSize(size)
 		{
@@ -23,9 +33,9 @@ namespace s3d
 		
 		ConstantBufferBase::ConstantBufferDetail::~ConstantBufferDetail()
 		{
-			if (m_uniformBufferHandle)
+			if (const GLuint handle = m_uniformBufferHandle)
 			{
-				::glDeleteBuffers(1, &m_uniformBufferHandle);
+				PostGLCommand([handle]() { ::glDeleteBuffers(1, &handle); });
 			}
 		}
 		
@@ -38,11 +48,20 @@ namespace s3d
 			
 			assert(size <= m_bufferSize);
 			
-			::glBindBuffer(GL_UNIFORM_BUFFER, m_uniformBufferHandle);
-			
-			::glBufferData(GL_UNIFORM_BUFFER, size, data, GL_STATIC_DRAW);
-			
-			::glBindBuffer(GL_UNIFORM_BUFFER, 0);
+			if (IsGLContextThread())
+			{
+				Upload(m_uniformBufferHandle, data, size);
+			}
+			else
+			{
+				// data は描画スレッドで転送されるまで有効とは限らないのでコピーする
+				const Byte* const pData = static_cast<const Byte*>(data);
+				
+				PostGLCommand([handle = m_uniformBufferHandle, buffer = Array<Byte>(pData, pData + size)]()
+				{
+					Upload(handle, buffer.data(), buffer.size());
+				});
+			}
 			
 			return true;
 		}
@@ -59,7 +78,8 @@ namespace s3d
 		
 		void ConstantBufferBase::ConstantBufferDetail::init() const
 		{
-			::glGenBuffers(1, &m_uniformBufferHandle);
+			// ハンドルはメインスレッドからも参照するので、作成は完了を待つ
+			InvokeGLCommand([this]() { ::glGenBuffers(1, &m_uniformBufferHandle); });
 		}
 	}
 }
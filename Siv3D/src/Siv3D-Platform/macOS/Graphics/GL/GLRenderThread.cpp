@@ -0,0 +1,204 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <utility>
+# include "GLRenderThread.hpp"
+
+namespace s3d
+{
+	GLRenderThread::GLRenderThread(GLFWwindow* const window, std::function<void()> job)
+		: m_window(window)
+		, m_job(std::move(job))
+	{
+		// コンテキストは同時に 1 つのスレッドでしか current にできない
+		if (m_window)
+		{
+			::glfwMakeContextCurrent(nullptr);
+		}
+		
+		m_thread = std::thread([this]() { run(); });
+	}
+	
+	GLRenderThread::~GLRenderThread()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			
+			m_abort = true;
+		}
+		
+		m_cv.notify_all();
+		
+		m_thread.join();
+		
+		if (m_window)
+		{
+			::glfwMakeContextCurrent(m_window);
+		}
+	}
+	
+	void GLRenderThread::kick()
+	{
+		wait();
+		
+		const uint64 frame = push([this]() { m_job(); });
+		
+		std::lock_guard lock(m_mutex);
+		
+		m_lastFrame = frame;
+	}
+	
+	void GLRenderThread::wait()
+	{
+		std::exception_ptr exception;
+		
+		{
+			std::unique_lock lock(m_mutex);
+			
+			m_cv.wait(lock, [this]() { return (m_lastFrame <= m_numExecuted); });
+			
+			exception = std::exchange(m_exception, nullptr);
+		}
+		
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+	
+	void GLRenderThread::post(std::function<void()> command)
+	{
+		if (isRenderThread())
+		{
+			command();
+			
+			return;
+		}
+		
+		push(std::move(command));
+	}
+	
+	void GLRenderThread::invoke(const std::function<void()>& command)
+	{
+		if (isRenderThread())
+		{
+			command();
+			
+			return;
+		}
+		
+		std::exception_ptr exception;
+		
+		const uint64 index = push([&]()
+		{
+			try
+			{
+				command();
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+		});
+		
+		{
+			std::unique_lock lock(m_mutex);
+			
+			m_cv.wait(lock, [&]() { return (index <= m_numExecuted); });
+		}
+		
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+	
+	bool GLRenderThread::isRenderThread() const
+	{
+		return (std::this_thread::get_id() == m_thread.get_id());
+	}
+	
+	uint64 GLRenderThread::push(std::function<void()> command)
+	{
+		uint64 index;
+		
+		{
+			std::lock_guard lock(m_mutex);
+			
+			m_commands.push_back(std::move(command));
+			
+			index = ++m_numPushed;
+		}
+		
+		m_cv.notify_all();
+		
+		return index;
+	}
+	
+	void GLRenderThread::run()
+	{
+		if (m_window)
+		{
+			::glfwMakeContextCurrent(m_window);
+		}
+		
+		for (;;)
+		{
+			std::function<void()> command;
+			
+			{
+				std::unique_lock lock(m_mutex);
+				
+				m_cv.wait(lock, [this]() { return (!m_commands.empty() || m_abort); });
+				
+				// 終了の前にキューを空にする
+				if (m_commands.empty())
+				{
+					break;
+				}
+				
+				command = std::move(m_commands.front());
+				
+				m_commands.pop_front();
+			}
+			
+			std::exception_ptr exception;
+			
+			try
+			{
+				command();
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+			
+			{
+				std::lock_guard lock(m_mutex);
+				
+				if (exception && !m_exception)
+				{
+					m_exception = exception;
+				}
+				
+				++m_numExecuted;
+			}
+			
+			m_cv.notify_all();
+		}
+		
+		// メインスレッドがデストラクタでコンテキストを取り戻せるように手放す
+		if (m_window)
+		{
+			::glfwMakeContextCurrent(nullptr);
+		}
+	}
+}
@@ -322,8 +322,6 @@ namespace s3d
 			::glBindVertexArray(0);
 		}
 		::glUseProgram(0);
-			
-		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(1, 1);
 		
 	# else
 		
@@ -347,8 +345,6 @@ namespace s3d
 		}
 		::glUseProgram(0);
 		
-		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(1, 1);
-		
 	# endif
 	}
 	
@@ -16,6 +16,8 @@
 # include <Siv3D/FloatRect.hpp>
 # include <Siv3D/FloatQuad.hpp>
 # include <Siv3D/Line.hpp>
+# include <Siv3D/Circle.hpp>
+# include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/Resource.hpp>
 # include <Siv3D/Math.hpp>
 # include <ConstantBuffer/GL/GLConstantBuffer.hpp>
@@ -79,6 +81,12 @@ namespace s3d
 	CRenderer2D_GL::~CRenderer2D_GL()
 	{
 		LOG_TRACE(U"CRenderer2D_GL::~CRenderer2D_GL()");
+
+		// メンバの GL のリソースはデストラクタで解放されるので、描画スレッドを止めてコンテキストをメインスレッドに戻しておく
+		if (CGraphics_GL* const pGraphics = dynamic_cast<CGraphics_GL*>(Siv3DEngine::Get<ISiv3DGraphics>()))
+		{
+			pGraphics->setPipelinedRendering(false);
+		}
 	}
 
 	void CRenderer2D_GL::init()
@@ -106,15 +114,12 @@ namespace s3d
 			throw EngineError(U"ShaderPipeline::init() failed");
 		}
 		
-		if (!m_batches.init())
+		if (!m_spriteBuffer.init())
 		{
-			throw EngineError(U"GLSpriteBatch::init() failed");
+			throw EngineError(U"GLSpriteBuffer::init() failed");
 		}
 
-		m_bufferCreator = [this](IndexType vertexSize, IndexType indexSize)
-		{
-			return m_batches.getBuffer(vertexSize, indexSize, m_commands);
-		};
+		updateBufferCreator();
 		
 		{
 			const Image boxShadowImage(Resource(U"engine/texture/box-shadow/256.png"));
@@ -139,18 +144,70 @@ namespace s3d
 		LOG_INFO(U"ℹ️ CRenderer2D_GL initialized");
 	}
 
-	void CRenderer2D_GL::flush()
+	// 記録済みのフレームから、発行したときの統計を求める
+	static GLRenderer2DStatistics MeasureFrame(const GLRenderer2DCommand& commands, const GLSpriteBatch& batches)
 	{
-		//CheckError(U"F00");
+		GLRenderer2DStatistics statistics;
 		
-		ScopeGuard cleanUp = [this]()
+		for (auto[command, index] : commands.getList())
 		{
-			m_batches.reset();
-			m_commands.reset();
-		};
+			if (command == RendererCommand::UpdateBuffers)
+			{
+				const BatchData batch = batches.getBatch(index);
+				
+				++statistics.batches;
+				statistics.uploadedBytes += (sizeof(Vertex2D) * batch.vertexSize + sizeof(IndexType) * batch.indexSize);
+			}
+			else if (command == RendererCommand::Draw)
+			{
+				++statistics.drawcalls;
+				statistics.vertices += commands.getDraw(index).indexCount;
+			}
+		}
 		
-		m_commands.flush();
+		return statistics;
+	}
+	
+	void CRenderer2D_GL::flush()
+	{
+		endRecording();
+
+		submitFrame();
 
+		reportStatistics();
+	}
+
+	void CRenderer2D_GL::endRecording()
+	{
+		flushSortedDraws();
+
+		m_recording->commands.flush();
+
+		// 統計は発行を待たずに、記録したフレームから求める
+		m_statistics = MeasureFrame(m_recording->commands, m_recording->batches);
+
+		// 記録を終えたフレームを発行用にし、もう一方のフレームに次のフレームを記録する
+		std::swap(m_recording, m_submitting);
+
+		m_recording->commands.reset(m_submitting->commands);
+		m_recording->batches.reset();
+
+		updateBufferCreator();
+	}
+
+	void CRenderer2D_GL::submitFrame()
+	{
+		submit(m_submitting->commands, m_submitting->batches);
+	}
+
+	void CRenderer2D_GL::reportStatistics()
+	{
+		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(m_statistics.drawcalls, m_statistics.vertices / 3);
+		Siv3DEngine::Get<ISiv3DProfiler>()->reportBatches(m_statistics.batches, m_statistics.uploadedBytes);
+	}
+
+	void CRenderer2D_GL::submit(const GLRenderer2DCommand& commands, const GLSpriteBatch& batches)
+	{
 		CGraphics_GL* const pGraphics = dynamic_cast<CGraphics_GL* const>(Siv3DEngine::Get<ISiv3DGraphics>());
 		CShader_GL* const pShader = dynamic_cast<CShader_GL* const>(Siv3DEngine::Get<ISiv3DShader>());
 		CTexture_GL* const pTexture = dynamic_cast<CTexture_GL* const>(Siv3DEngine::Get<ISiv3DTexture>());
@@ -163,14 +220,13 @@ namespace s3d
 		Mat3x2 transform = Mat3x2::Identity();
 		Mat3x2 screenMat = Mat3x2::Screen(currentRenderTargetSize);
 		BatchInfo batchInfo;
-		size_t profile_drawcalls = 0, profile_vertices = 0;
 		
 		::glBindBufferBase(GL_UNIFORM_BUFFER, m_vscbSprite.BindingPoint(), m_vscbSprite.base()._detail()->getHandle());
 		::glBindBufferBase(GL_UNIFORM_BUFFER, m_pscbSprite.BindingPoint(), m_pscbSprite.base()._detail()->getHandle());
 		
 		LOG_COMMAND(U"--Renderer2D commands--");
 		
-		for (auto[command, index] : m_commands.getList())
+		for (auto[command, index] : commands.getList())
 		{
 			switch (command)
 			{
@@ -181,7 +237,7 @@ namespace s3d
 				}
 			case RendererCommand::UpdateBuffers:
 				{
-					batchInfo = m_batches.updateBuffers(index);
+					batchInfo = m_spriteBuffer.updateBuffers(batches, index);
 					
 					LOG_COMMAND(U"UpdateBuffers[{}] BatchInfo(indexCount = {}, startIndexLocation = {}, baseVertexLocation = {})"_fmt(
 																																	  index, batchInfo.indexCount, batchInfo.startIndexLocation, batchInfo.baseVertexLocation));
@@ -192,7 +248,7 @@ namespace s3d
 					m_vscbSprite._update_if_dirty();
 					m_pscbSprite._update_if_dirty();
 					
-					const DrawCommand& draw = m_commands.getDraw(index);
+					const DrawCommand& draw = commands.getDraw(index);
 					const uint32 indexCount = draw.indexCount;
 					const uint32 startIndexLocation = batchInfo.startIndexLocation;
 					const uint32 baseVertexLocation = batchInfo.baseVertexLocation;
@@ -200,36 +256,33 @@ namespace s3d
 					::glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, (IndexType*)(nullptr) + startIndexLocation, baseVertexLocation);
 					batchInfo.startIndexLocation += indexCount;
 					
-					++profile_drawcalls;
-					profile_vertices += indexCount;
-					
 					LOG_COMMAND(U"Draw[{}] indexCount = {}, startIndexLocation = {}"_fmt(index, indexCount, startIndexLocation));
 					break;
 				}
 				case RendererCommand::ColorMul:
 				{
-					m_vscbSprite->colorMul = m_commands.getColorMul(index);
+					m_vscbSprite->colorMul = commands.getColorMul(index);
 					
 					LOG_COMMAND(U"ColorMul[{}] {}"_fmt(index, m_vscbSprite->colorMul));
 					break;
 				}
 				case RendererCommand::ColorAdd:
 				{
-					m_pscbSprite->colorAdd = m_commands.getColorAdd(index);
+					m_pscbSprite->colorAdd = commands.getColorAdd(index);
 					
 					LOG_COMMAND(U"ColorAdd[{}] {}"_fmt(index, m_pscbSprite->colorAdd));
 					break;
 				}
 				case RendererCommand::BlendState:
 				{
-					const auto& blendState = m_commands.getBlendState(index);
+					const auto& blendState = commands.getBlendState(index);
 					pGraphics->getBlendState()->set(blendState);
 					LOG_COMMAND(U"BlendState[{}]"_fmt(index));
 					break;
 				}
 				case RendererCommand::RasterizerState:
 				{
-					const auto& rasterizerState = m_commands.getRasterizerState(index);
+					const auto& rasterizerState = commands.getRasterizerState(index);
 					pGraphics->getRasterizerState()->set(rasterizerState);
 					LOG_COMMAND(U"RasterizerState[{}]"_fmt(index));
 					break;
@@ -244,14 +297,14 @@ namespace s3d
 				case RendererCommand::PSSamplerState7:
 				{
 					const uint32 slot = FromEnum(command) - FromEnum(RendererCommand::PSSamplerState0);
-					const auto& samplerState = m_commands.getPSSamplerState(slot, index);
+					const auto& samplerState = commands.getPSSamplerState(slot, index);
 					pGraphics->getSamplerState()->setPS(slot, samplerState);
 					LOG_COMMAND(U"PSSamplerState{}[{}] "_fmt(slot, index));
 					break;
 				}
 				case RendererCommand::Transform:
 				{
-					transform = m_commands.getCombinedTransform(index);
+					transform = commands.getCombinedTransform(index);
 					const Mat3x2 matrix = transform * screenMat;
 					m_vscbSprite->transform[0].set(matrix._11, matrix._12, matrix._31, matrix._32);
 					m_vscbSprite->transform[1].set(matrix._21, matrix._22, 0.0f, 1.0f);
@@ -261,7 +314,7 @@ namespace s3d
 				}
 				case RendererCommand::SetPS:
 				{
-					const size_t standadPSIndex = m_commands.getPS(index);
+					const size_t standadPSIndex = commands.getPS(index);
 
 					const auto psID = m_standardPSs[standadPSIndex].id();
 					m_pipeline.setPS(pShader->getPSProgram(psID));
@@ -272,14 +325,14 @@ namespace s3d
 				}
 				case RendererCommand::ScissorRect:
 				{
-					const auto& r = m_commands.getScissorRect(index);
+					const auto& r = commands.getScissorRect(index);
 					::glScissor(r.x, currentRenderTargetSize.y - r.h - r.y, r.w, r.h);
 					LOG_COMMAND(U"ScissorRect[{}] {}"_fmt(index, r));
 					break;
 				}
 				case RendererCommand::Viewport:
 				{
-					const auto& viewport = m_commands.getViewport(index);
+					const auto& viewport = commands.getViewport(index);
 					
 					Rect rect;
 					
@@ -316,7 +369,7 @@ namespace s3d
 				case RendererCommand::PSTexture7:
 				{
 					const uint32 slot = FromEnum(command) - FromEnum(RendererCommand::PSTexture0);
-					const auto& textureID = m_commands.getPSTexture(slot, index);
+					const auto& textureID = commands.getPSTexture(slot, index);
 
 					if (textureID == TextureID::InvalidValue())
 					{
@@ -334,7 +387,7 @@ namespace s3d
 				}
 				case RendererCommand::SDFParam:
 				{
-					m_pscbSprite->sdfParam = m_commands.getSdfParam(index);
+					m_pscbSprite->sdfParam = commands.getSdfParam(index);
 					
 					LOG_COMMAND(U"SDFParam[{}] {}"_fmt(index, m_pscbSprite->sdfParam));
 					break;
@@ -348,11 +401,7 @@ namespace s3d
 		
 		::glBindVertexArray(0);
 		
-		LOG_COMMAND(U"--({} commands)--"_fmt(m_commands.getList().size()));
-		
-		Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(profile_drawcalls, profile_vertices / 3);
-
-		//CheckError(U"F300");
+		LOG_COMMAND(U"--({} commands)--"_fmt(commands.getList().size()));
 	}
 
 	std::pair<float, FloatRect> CRenderer2D_GL::getLetterboxingTransform() const
@@ -382,107 +431,146 @@ namespace s3d
 
 	void CRenderer2D_GL::setColorMul(const Float4& color)
 	{
-		m_commands.pushColorMul(color);
+		flushSortedDraws();
+
+		m_recording->commands.pushColorMul(color);
 	}
 
 	ColorF CRenderer2D_GL::getColorMul() const
 	{
-		return ColorF(m_commands.getCurrentColorMul());
+		return ColorF(m_recording->commands.getCurrentColorMul());
 	}
 
 	void CRenderer2D_GL::setColorAdd(const Float4& color)
 	{
-		m_commands.pushColorAdd(color);
+		flushSortedDraws();
+
+		m_recording->commands.pushColorAdd(color);
 	}
 
 	ColorF CRenderer2D_GL::getColorAdd() const
 	{
-		return ColorF(m_commands.getCurrentColorAdd());
+		return ColorF(m_recording->commands.getCurrentColorAdd());
 	}
 
 	void CRenderer2D_GL::setBlendState(const BlendState& state)
 	{
-		m_commands.pushBlendState(state);
+		flushSortedDraws();
+
+		m_recording->commands.pushBlendState(state);
 	}
 
 	BlendState CRenderer2D_GL::getBlendState() const
 	{
-		return m_commands.getCurrentBlendState();
+		return m_recording->commands.getCurrentBlendState();
 	}
 
 	void CRenderer2D_GL::setRasterizerState(const RasterizerState& state)
 	{
-		m_commands.pushRasterizerState(state);
+		flushSortedDraws();
+
+		m_recording->commands.pushRasterizerState(state);
 	}
 
 	RasterizerState CRenderer2D_GL::getRasterizerState() const
 	{
-		return m_commands.getCurrentRasterizerState();
+		return m_recording->commands.getCurrentRasterizerState();
 	}
 
 	void CRenderer2D_GL::setPSSamplerState(const uint32 slot, const SamplerState& state)
 	{
-		m_commands.pushPSSamplerState(state, slot);
+		flushSortedDraws();
+
+		m_recording->commands.pushPSSamplerState(state, slot);
 	}
 
 	SamplerState CRenderer2D_GL::getPSSamplerState(const uint32 slot) const
 	{
-		return m_commands.getPSCurrentSamplerState(slot);
+		return m_recording->commands.getPSCurrentSamplerState(slot);
 	}
 
 	void CRenderer2D_GL::setLocalTransform(const Mat3x2& matrix)
 	{
-		m_commands.pushLocalTransform(matrix);
+		flushSortedDraws();
+
+		m_recording->commands.pushLocalTransform(matrix);
 	}
 
 	const Mat3x2& CRenderer2D_GL::getLocalTransform() const
 	{
-		return m_commands.getCurrentLocalTransform();
+		return m_recording->commands.getCurrentLocalTransform();
 	}
 
 	void CRenderer2D_GL::setCameraTransform(const Mat3x2& matrix)
 	{
-		m_commands.pushCameraTransform(matrix);
+		flushSortedDraws();
+
+		m_recording->commands.pushCameraTransform(matrix);
 	}
 
 	const Mat3x2& CRenderer2D_GL::getCameraTransform() const
 	{
-		return m_commands.getCurrentCameraTransform();
+		return m_recording->commands.getCurrentCameraTransform();
 	}
 
 	float CRenderer2D_GL::getMaxScaling() const
 	{
-		return m_commands.getCurrentMaxScaling();
+		return m_recording->commands.getCurrentMaxScaling();
 	}
 
 	void CRenderer2D_GL::setScissorRect(const Rect& rect)
 	{
-		m_commands.pushScissorRect(rect);
+		flushSortedDraws();
+
+		m_recording->commands.pushScissorRect(rect);
 	}
 
 	Rect CRenderer2D_GL::getScissorRect() const
 	{
-		return m_commands.getCurrentScissorRect();
+		return m_recording->commands.getCurrentScissorRect();
 	}
 
 	void CRenderer2D_GL::setViewport(const Optional<Rect>& viewport)
 	{
-		m_commands.pushViewport(viewport);
+		flushSortedDraws();
+
+		m_recording->commands.pushViewport(viewport);
 	}
 
 	Optional<Rect> CRenderer2D_GL::getViewport() const
 	{
-		return m_commands.getCurrentViewport();
+		return m_recording->commands.getCurrentViewport();
 	}
 
 	void CRenderer2D_GL::setSDFParameters(const Float4& parameters)
 	{
-		m_commands.pushSdfParam(parameters);
+		flushSortedDraws();
+
+		m_recording->commands.pushSdfParam(parameters);
 	}
 
 	Float4 CRenderer2D_GL::getSDFParameters() const
 	{
-		return m_commands.getCurrentSdfParam();
+		return m_recording->commands.getCurrentSdfParam();
+	}
+
+	void CRenderer2D_GL::setDrawSorting(const bool enabled)
+	{
+		if (enabled == m_drawSorting)
+		{
+			return;
+		}
+
+		flushSortedDraws();
+
+		m_drawSorting = enabled;
+
+		updateBufferCreator();
+	}
+
+	bool CRenderer2D_GL::getDrawSorting() const
+	{
+		return m_drawSorting;
 	}
 
 	void CRenderer2D_GL::addLine(const LineStyle& style, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2])
@@ -491,8 +579,7 @@ namespace s3d
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildSquareCappedLine(m_bufferCreator, begin, end, thickness, colors))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isRoundCap())
@@ -501,8 +588,7 @@ namespace s3d
 			
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundCappedLine(m_bufferCreator, begin, end, thickness, colors, startAngle))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 				
 				const float thicknessHalf = thickness * 0.5f;
 				addCirclePie(begin, thicknessHalf, startAngle, Math::PiF, colors[0]);
@@ -513,24 +599,21 @@ namespace s3d
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildUncappedLine(m_bufferCreator, begin, end, thickness, colors))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isSquareDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildSquareDotLine(m_bufferCreator, begin, end, thickness, colors, static_cast<float>(style.dotOffset), getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::SquareDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::SquareDot, indexCount);
 			}
 		}
 		else if (style.isRoundDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundDotLine(m_bufferCreator, begin, end, thickness, colors, static_cast<float>(style.dotOffset), style.hasAlignedDot))
 			{
-				m_commands.pushPS(StandardPSIndex::RoundDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::RoundDot, indexCount);
 			}
 		}
 	}
@@ -539,8 +622,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, pts, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -548,8 +630,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTriangle(m_bufferCreator, pts, colors))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -557,8 +638,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -566,8 +646,27 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRect(m_bufferCreator, rect, colors))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
+		}
+	}
+
+	void CRenderer2D_GL::addRects(const FloatRect* rects, size_t count, const Float4& color)
+	{
+		while (count)
+		{
+			const size_t n = std::min(count, Vertex2DBuilder::MaxBatchRectCount);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildRects(m_bufferCreator, rects, n, color))
+			{
+				commitDraw(StandardPSIndex::Shape, indexCount);
+			}
+			else
+			{
+				return;
+			}
+
+			rects += n;
+			count -= n;
 		}
 	}
 
@@ -575,8 +674,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRectFrame(m_bufferCreator, rect, thickness, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -584,8 +682,29 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCircle(m_bufferCreator, center, r, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
+		}
+	}
+
+	void CRenderer2D_GL::addCircles(const Circle* circles, size_t count, const Float4& color)
+	{
+		const float scale = getMaxScaling();
+
+		while (count)
+		{
+			size_t builtCount = 0;
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildCircles(m_bufferCreator, circles, count, color, scale, builtCount))
+			{
+				commitDraw(StandardPSIndex::Shape, indexCount);
+			}
+			else
+			{
+				return;
+			}
+
+			circles += builtCount;
+			count -= builtCount;
 		}
 	}
 
@@ -593,8 +712,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCircleFrame(m_bufferCreator, center, rInner, thickness, innerColor, outerColor, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -602,8 +720,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCirclePie(m_bufferCreator, center, r, startAngle, angle, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -611,8 +728,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildCircleArc(m_bufferCreator, center, rInner, startAngle, angle, thickness, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -620,8 +736,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildEllipse(m_bufferCreator, center, a, b, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -629,8 +744,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildEllipseFrame(m_bufferCreator, center, aInner, bInner, thickness, innerColor, outerColor, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -638,8 +752,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -647,8 +760,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildQuad(m_bufferCreator, quad, colors))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -656,8 +768,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildRoundRect(m_bufferCreator, rect, w, h, r, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -667,8 +778,7 @@ namespace s3d
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildSquareCappedLineString(m_bufferCreator, pts, size, offset, thickness, inner, color, isClosed, getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isRoundCap())
@@ -677,8 +787,7 @@ namespace s3d
 			
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundCappedLineString(m_bufferCreator, pts, size, offset, thickness, inner, color, getMaxScaling(), startAngle, endAngle))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 				
 				const float thicknessHalf = thickness * 0.5f;
 				addCirclePie(*pts, thicknessHalf, startAngle, Math::PiF, color);
@@ -691,24 +800,21 @@ namespace s3d
 			
 			if (const uint16 indexCount = Vertex2DBuilder::BuildRoundCappedLineString(m_bufferCreator, pts, size, offset, thickness, inner, color, getMaxScaling(), startAngle, endAngle))
 			{
-				m_commands.pushPS(StandardPSIndex::Shape);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::Shape, indexCount);
 			}
 		}
 		else if (style.isSquareDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildDotLineString(m_bufferCreator, pts, size, offset, thickness, color, isClosed, true, static_cast<float>(style.dotOffset), false, getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::SquareDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::SquareDot, indexCount);
 			}
 		}
 		else if (style.isRoundDot())
 		{
 			if (const uint16 indexCount = Vertex2DBuilder::BuildDotLineString(m_bufferCreator, pts, size, offset, thickness, color, isClosed, false, static_cast<float>(style.dotOffset), style.hasAlignedDot, getMaxScaling()))
 			{
-				m_commands.pushPS(StandardPSIndex::RoundDot);
-				m_commands.pushDraw(indexCount);
+				commitDraw(StandardPSIndex::RoundDot, indexCount);
 			}
 		}
 	}
@@ -717,8 +823,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildShape2D(m_bufferCreator, vertices, indices, offset, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(count);
+			commitDraw(StandardPSIndex::Shape, count);
 		}
 	}
 
@@ -726,8 +831,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildShape2DTransformed(m_bufferCreator, vertices, indices, s, c, offset, color))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(count);
+			commitDraw(StandardPSIndex::Shape, count);
 		}
 	}
 
@@ -735,8 +839,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildShape2DFrame(m_bufferCreator, pts, size, thickness, color, getMaxScaling()))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(indexCount);
+			commitDraw(StandardPSIndex::Shape, indexCount);
 		}
 	}
 
@@ -744,8 +847,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildSprite(m_bufferCreator, sprite, startIndex, indexCount))
 		{
-			m_commands.pushPS(StandardPSIndex::Shape);
-			m_commands.pushDraw(count);
+			commitDraw(StandardPSIndex::Shape, count);
 		}
 	}
 
@@ -753,9 +855,7 @@ namespace s3d
 	{
 		if (const uint16 count = Vertex2DBuilder::BuildSprite(m_bufferCreator, sprite, startIndex, indexCount))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(count);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, count);
 		}
 	}
 
@@ -763,9 +863,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, color))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
 		}
 	}
 
@@ -773,9 +871,37 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegion(m_bufferCreator, rect, uv, colors))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+		}
+	}
+
+	void CRenderer2D_GL::addTextureRegions(const TextureRegion* regions, const Vec2* positions, size_t count, const Float4& color)
+	{
+		while (count)
+		{
+			// 同じテクスチャが連続する範囲を 1 回で書き込む
+			const Texture& texture = regions->texture;
+			const TextureID textureID = texture.id();
+			const size_t maxCount = std::min(count, Vertex2DBuilder::MaxBatchRectCount);
+			size_t n = 1;
+
+			while ((n < maxCount) && (regions[n].texture.id() == textureID))
+			{
+				++n;
+			}
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildTextureRegions(m_bufferCreator, regions, positions, n, color))
+			{
+				commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+			}
+			else
+			{
+				return;
+			}
+
+			regions += n;
+			positions += n;
+			count -= n;
 		}
 	}
 
@@ -783,9 +909,7 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTexturedCircle(m_bufferCreator, circle, uv, color, getMaxScaling()))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
 		}
 	}
 
@@ -793,21 +917,41 @@ namespace s3d
 	{
 		if (const uint16 indexCount = Vertex2DBuilder::BuildTexturedQuad(m_bufferCreator, quad, uv, color))
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+		}
+	}
+
+	void CRenderer2D_GL::addParticles(const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table)
+	{
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxBatchRectCount)
+		{
+			const size_t count = std::min(particles.size() - offset, Vertex2DBuilder::MaxBatchRectCount);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildParticles(m_bufferCreator, particles, offset, count, table))
+			{
+				commitDraw(StandardPSIndex::Shape, indexCount);
+			}
+			else
+			{
+				return;
+			}
 		}
 	}
 
-	void CRenderer2D_GL::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
+	void CRenderer2D_GL::addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table)
 	{
-		if (const uint16 indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxBatchRectCount)
 		{
-			m_commands.pushPS(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture);
-			m_commands.pushPSTexture(0, texture);
-			m_commands.pushDraw(indexCount);
+			const size_t count = std::min(particles.size() - offset, Vertex2DBuilder::MaxBatchRectCount);
+
+			if (const uint16 indexCount = Vertex2DBuilder::BuildParticles(m_bufferCreator, particles, offset, count, table))
+			{
+				commitDraw(texture.isSDF() ? StandardPSIndex::SDF : StandardPSIndex::Texture, texture, indexCount);
+			}
+			else
+			{
+				return;
+			}
 		}
 	}
 
@@ -815,4 +959,51 @@ namespace s3d
 	{
 		return *m_boxShadowTexture;
 	}
+
+	void CRenderer2D_GL::commitDraw(const size_t psIndex, const uint16 indexCount)
+	{
+		if (m_drawSorting)
+		{
+			m_sortedDraws.commit(psIndex, indexCount);
+		}
+		else
+		{
+			m_recording->commands.pushPS(psIndex);
+			m_recording->commands.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_GL::commitDraw(const size_t psIndex, const Texture& texture, const uint16 indexCount)
+	{
+		if (m_drawSorting)
+		{
+			m_sortedDraws.commit(psIndex, texture, indexCount);
+		}
+		else
+		{
+			m_recording->commands.pushPS(psIndex);
+			m_recording->commands.pushPSTexture(0, texture);
+			m_recording->commands.pushDraw(indexCount);
+		}
+	}
+
+	void CRenderer2D_GL::flushSortedDraws()
+	{
+		if (!m_sortedDraws.isEmpty())
+		{
+			m_sortedDraws.flush(m_recording->batches, m_recording->commands);
+		}
+	}
+
+	void CRenderer2D_GL::updateBufferCreator()
+	{
+		if (m_drawSorting)
+		{
+			m_bufferCreator = BufferCreator(m_sortedDraws, m_recording->commands);
+		}
+		else
+		{
+			m_bufferCreator = BufferCreator(m_recording->batches, m_recording->commands);
+		}
+	}
 }
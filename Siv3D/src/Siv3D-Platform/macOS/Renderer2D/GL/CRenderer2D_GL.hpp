@@ -17,9 +17,11 @@
 # include <Siv3D/PixelShader.hpp>
 # include <Siv3D/ConstantBuffer.hpp>
 # include <Renderer2D/Vertex2DBuilder.hpp>
+# include <Renderer2D/SortedDrawRecorder.hpp>
 # include <GL/glew.h>
 # include <GLFW/glfw3.h>
 # include "GLSpriteBatch.hpp"
+# include "GLSpriteBuffer.hpp"
 # include "GLRenderer2DCommand.hpp"
 
 
@@ -100,6 +102,25 @@ namespace s3d
 		Float4 sdfParam;
 	};
 	
+	// 1 フレーム分の記録。記録用と発行用の 2 つを交互に使う
+	struct GLRenderer2DFrame
+	{
+		GLRenderer2DCommand commands;
+		
+		GLSpriteBatch batches;
+	};
+	
+	struct GLRenderer2DStatistics
+	{
+		size_t drawcalls = 0;
+		
+		size_t vertices = 0;
+		
+		size_t batches = 0;
+		
+		size_t uploadedBytes = 0;
+	};
+	
 	class CRenderer2D_GL : public ISiv3DRenderer2D
 	{
 	private:
@@ -107,19 +128,37 @@ namespace s3d
 		Array<VertexShader> m_standardVSs;
 		Array<PixelShader> m_standardPSs;
 		
-		BufferCreatorFunc m_bufferCreator;
+		BufferCreator m_bufferCreator;
 		
 		ShaderPipeline m_pipeline;
 		
 		ConstantBuffer<VscbSprite> m_vscbSprite;
 		ConstantBuffer<PscbSprite> m_pscbSprite;
 		
-		GLSpriteBatch m_batches;
+		std::array<GLRenderer2DFrame, 2> m_frames;
+		
+		GLRenderer2DFrame* m_recording = &m_frames[0];
+		
+		GLRenderer2DFrame* m_submitting = &m_frames[1];
+		
+		GLSpriteBuffer m_spriteBuffer;
 		
-		GLRenderer2DCommand m_commands;
+		GLRenderer2DStatistics m_statistics;
+		
+		SortedDrawRecorder m_sortedDraws;
+		bool m_drawSorting = false;
 		
 		std::unique_ptr<Texture> m_boxShadowTexture;
 
+		// 記録済みのコマンドと頂点データを GL に発行する
+		void submit(const GLRenderer2DCommand& commands, const GLSpriteBatch& batches);
+
+		void updateBufferCreator();
+
+		void commitDraw(size_t psIndex, uint16 indexCount);
+		void commitDraw(size_t psIndex, const Texture& texture, uint16 indexCount);
+		void flushSortedDraws();
+
 	public:
 
 		CRenderer2D_GL();
@@ -130,6 +169,15 @@ namespace s3d
 
 		void flush() override;
 
+		// 記録中のフレームを閉じ、submitFrame() で発行するフレームにする
+		void endRecording();
+
+		// endRecording() で閉じたフレームを GL に発行する。パイプライン描画では描画スレッドから呼ばれる
+		void submitFrame();
+
+		// 最後に endRecording() で閉じたフレームの統計を Profiler に報告する
+		void reportStatistics();
+
 		std::pair<float, FloatRect> getLetterboxingTransform() const override;
 
 		void drawFullscreen(bool) override {} // do nothing for OpenGL
@@ -176,6 +224,10 @@ namespace s3d
 
 		Float4 getSDFParameters() const override;
 
+		void setDrawSorting(bool enabled) override;
+
+		bool getDrawSorting() const override;
+
 		void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) override;
 
 		void addTriangle(const Float2(&pts)[3], const Float4& color) override;
@@ -186,10 +238,14 @@ namespace s3d
 
 		void addRect(const FloatRect& rect, const Float4(&colors)[4]) override;
 
+		void addRects(const FloatRect* rects, size_t count, const Float4& color) override;
+
 		void addRectFrame(const FloatRect& rect, float thickness, const Float4& color) override;
 
 		void addCircle(const Float2& center, float r, const Float4& color) override;
 
+		void addCircles(const Circle* circles, size_t count, const Float4& color) override;
+
 		void addCircleFrame(const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor) override;
 
 		void addCirclePie(const Float2& center, float r, float startAngle, float angle, const Float4& color) override;
@@ -222,13 +278,15 @@ namespace s3d
 
 		void addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]) override;
 
+		void addTextureRegions(const TextureRegion* regions, const Vec2* positions, size_t count, const Float4& color) override;
+
 		void addTexturedCircle(const Texture& texture, const Circle& circle, const FloatRect& uv, const Float4& color) override;
 
 		void addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color) override;
 	
-		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
+		void addParticles(const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table) override;
+
+		void addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table) override;
 
 		const Texture& getBoxShadowTexture() const override;
 	};
@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# include <cassert>
 # include <Siv3D/EngineLog.hpp>
 # include "GLSpriteBatch.hpp"
 
@@ -37,55 +38,6 @@ namespace s3d
 	
 	}
 	
-	GLSpriteBatch::~GLSpriteBatch()
-	{
-		if (m_indexBuffer)
-		{
-			::glDeleteBuffers(1, &m_indexBuffer);
-			m_indexBuffer = 0;
-		}
-		
-		if (m_vertexBuffer)
-		{
-			::glDeleteBuffers(1, &m_vertexBuffer);
-			m_vertexBuffer = 0;
-		}
-		
-		if (m_vao)
-		{
-			::glDeleteVertexArrays(1, &m_vao);
-			m_vao = 0;
-		}
-	}
-	
-	bool GLSpriteBatch::init()
-	{
-		::glGenBuffers(1, &m_vertexBuffer);
-		::glGenBuffers(1, &m_indexBuffer);
-		
-		::glGenVertexArrays(1, &m_vao);
-		
-		::glBindVertexArray(m_vao);
-		{
-			::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-			::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
-			
-			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)0);
-			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)8);
-			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (GLubyte*)16);
-			
-			::glEnableVertexAttribArray(0);
-			::glEnableVertexAttribArray(1);
-			::glEnableVertexAttribArray(2);
-			
-			::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
-			::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
-		}
-		::glBindVertexArray(0);
-
-		return true;
-	}
-	
 	std::tuple<Vertex2D*, IndexType*, IndexType> GLSpriteBatch::getBuffer(const uint16 vertexSize, const uint32 indexSize, GLRenderer2DCommand& command)
 	{
 		// VB
@@ -143,23 +95,7 @@ namespace s3d
 		return m_batches.size();
 	}
 	
-	void GLSpriteBatch::reset()
-	{
-		m_batches.clear();
-		m_batches.emplace_back();
-		
-		m_vertexArrayWritePos	= 0;
-		m_indexArrayWritePos	= 0;
-	}
-	
-	/*
-	void GLSpriteBatch::setBuffers()
-	{
-		
-	}
-	 */
-	
-	BatchInfo GLSpriteBatch::updateBuffers(const size_t batchIndex)
+	BatchData GLSpriteBatch::getBatch(const size_t batchIndex) const
 	{
 		assert(batchIndex < m_batches.size());
 		
@@ -172,53 +108,22 @@ namespace s3d
 			indexArrayReadPos	+= m_batches[i].indexPos;
 		}
 		
-		::glBindVertexArray(m_vao);
-		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-		
-		BatchInfo batchInfo;
 		const auto& currentBatch = m_batches[batchIndex];
 		
-		// VB
-		if (const uint16 vertexSize = currentBatch.vertexPos)
-		{
-			const Vertex2D* pSrc = m_vertexArray.data() + vertexArrayReadPos;
-			
-			if (VertexBufferSize < (m_vertexBufferWritePos + vertexSize))
-			{
-				m_vertexBufferWritePos = 0;
-				::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
-			}
-			
-			void* pDst = ::glMapBufferRange(GL_ARRAY_BUFFER, sizeof(Vertex2D) * m_vertexBufferWritePos, sizeof(Vertex2D) * vertexSize,
-											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			std::memcpy(pDst, pSrc, sizeof(Vertex2D) * vertexSize);
-			::glUnmapBuffer(GL_ARRAY_BUFFER);
-			
-			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
-			m_vertexBufferWritePos += vertexSize;
-		}
-		
-		// IB
-		if (const uint32 indexSize = currentBatch.indexPos)
-		{
-			const IndexType* pSrc	= m_indexArray.data() + indexArrayReadPos;
-			
-			if (IndexBufferSize < (m_indexBufferWritePos + indexSize))
-			{
-				m_indexBufferWritePos = 0;
-				::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
-			}
-			
-			void* pDst = ::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * m_indexBufferWritePos, sizeof(IndexType) * indexSize,
-											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
-			std::memcpy(pDst, pSrc, sizeof(IndexType) * indexSize);
-			::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
-			
-			batchInfo.indexCount = indexSize;
-			batchInfo.startIndexLocation = m_indexBufferWritePos;
-			m_indexBufferWritePos += indexSize;
-		}
+		BatchData batch;
+		batch.pVertex		= m_vertexArray.data() + vertexArrayReadPos;
+		batch.vertexSize	= currentBatch.vertexPos;
+		batch.pIndex		= m_indexArray.data() + indexArrayReadPos;
+		batch.indexSize		= currentBatch.indexPos;
+		return batch;
+	}
+	
+	void GLSpriteBatch::reset()
+	{
+		m_batches.clear();
+		m_batches.emplace_back();
 		
-		return batchInfo;
+		m_vertexArrayWritePos	= 0;
+		m_indexArrayWritePos	= 0;
 	}
 }
@@ -10,8 +10,6 @@
 //-----------------------------------------------
 
 # pragma once
-# include <GL/glew.h>
-# include <GLFW/glfw3.h>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/Vertex2D.hpp>
 # include "GLRenderer2DCommand.hpp"
@@ -20,15 +18,19 @@ namespace s3d
 {
 	using IndexType = Vertex2D::IndexType;
 	
-	struct BatchInfo
+	// 1 つのバッチの頂点とインデックス
+	struct BatchData
 	{
-		uint32 indexCount = 0;
+		const Vertex2D* pVertex = nullptr;
 		
-		uint32 startIndexLocation = 0;
+		uint16 vertexSize = 0;
 		
-		uint32 baseVertexLocation = 0;
+		const IndexType* pIndex = nullptr;
+		
+		uint32 indexSize = 0;
 	};
 	
+	// 1 フレーム分の頂点とインデックスを CPU 側の配列に記録する。GL の呼び出しは行わない
 	class GLSpriteBatch
 	{
 	private:
@@ -40,14 +42,6 @@ namespace s3d
 			uint32 indexPos = 0;
 		};
 		
-		GLuint m_vao = 0;
-		
-		GLuint m_vertexBuffer = 0;
-		uint32 m_vertexBufferWritePos = 0;
-		
-		GLuint m_indexBuffer = 0;
-		uint32 m_indexBufferWritePos = 0;
-		
 		Array<Vertex2D> m_vertexArray;
 		uint32 m_vertexArrayWritePos = 0;
 		
@@ -62,25 +56,19 @@ namespace s3d
 		static constexpr uint32 MaxVertexArraySize		= 65536 * 64; // 4,194,304
 		static constexpr uint32 MaxIndexArraySize		= 65536 * 64; // 4,194,304
 		
+	public:
+		
 		static constexpr uint32 VertexBufferSize		= 65535;// 65535;
 		static constexpr uint32 IndexBufferSize			= (VertexBufferSize + 1) * 4; // 524,288
 		
-	public:
-		
 		GLSpriteBatch();
 		
-		~GLSpriteBatch();
-		
-		[[nodiscard]] bool init();
-		
 		[[nodiscard]] std::tuple<Vertex2D*, IndexType*, IndexType> getBuffer(const uint16 vertexSize, const uint32 indexSize, GLRenderer2DCommand& command);
 		
 		[[nodiscard]] size_t num_batches() const noexcept;
 		
-		void reset();
-		
-		//void setBuffers();
+		[[nodiscard]] BatchData getBatch(size_t batchIndex) const;
 		
-		[[nodiscard]] BatchInfo updateBuffers(size_t batchIndex);
+		void reset();
 	};
 }
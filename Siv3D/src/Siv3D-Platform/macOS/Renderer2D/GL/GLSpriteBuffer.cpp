@@ -0,0 +1,115 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "GLSpriteBuffer.hpp"
+
+namespace s3d
+{
+	GLSpriteBuffer::~GLSpriteBuffer()
+	{
+		if (m_indexBuffer)
+		{
+			::glDeleteBuffers(1, &m_indexBuffer);
+			m_indexBuffer = 0;
+		}
+		
+		if (m_vertexBuffer)
+		{
+			::glDeleteBuffers(1, &m_vertexBuffer);
+			m_vertexBuffer = 0;
+		}
+		
+		if (m_vao)
+		{
+			::glDeleteVertexArrays(1, &m_vao);
+			m_vao = 0;
+		}
+	}
+	
+	bool GLSpriteBuffer::init()
+	{
+		::glGenBuffers(1, &m_vertexBuffer);
+		::glGenBuffers(1, &m_indexBuffer);
+		
+		::glGenVertexArrays(1, &m_vao);
+		
+		::glBindVertexArray(m_vao);
+		{
+			::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+			::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			
+			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)0);
+			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (GLubyte*)8);
+			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (GLubyte*)16);
+			
+			::glEnableVertexAttribArray(0);
+			::glEnableVertexAttribArray(1);
+			::glEnableVertexAttribArray(2);
+			
+			::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+			::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+		}
+		::glBindVertexArray(0);
+
+		return true;
+	}
+	
+	BatchInfo GLSpriteBuffer::updateBuffers(const GLSpriteBatch& batches, const size_t batchIndex)
+	{
+		const BatchData batch = batches.getBatch(batchIndex);
+		
+		::glBindVertexArray(m_vao);
+		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		
+		BatchInfo batchInfo;
+		
+		// VB
+		if (const uint16 vertexSize = batch.vertexSize)
+		{
+			if (VertexBufferSize < (m_vertexBufferWritePos + vertexSize))
+			{
+				m_vertexBufferWritePos = 0;
+				::glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex2D) * VertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
+			
+			void* pDst = ::glMapBufferRange(GL_ARRAY_BUFFER, sizeof(Vertex2D) * m_vertexBufferWritePos, sizeof(Vertex2D) * vertexSize,
+											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			std::memcpy(pDst, batch.pVertex, sizeof(Vertex2D) * vertexSize);
+			::glUnmapBuffer(GL_ARRAY_BUFFER);
+			
+			batchInfo.baseVertexLocation = m_vertexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(Vertex2D) * vertexSize);
+			m_vertexBufferWritePos += vertexSize;
+		}
+		
+		// IB
+		if (const uint32 indexSize = batch.indexSize)
+		{
+			if (IndexBufferSize < (m_indexBufferWritePos + indexSize))
+			{
+				m_indexBufferWritePos = 0;
+				::glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * IndexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+			}
+			
+			void* pDst = ::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, sizeof(IndexType) * m_indexBufferWritePos, sizeof(IndexType) * indexSize,
+											GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			std::memcpy(pDst, batch.pIndex, sizeof(IndexType) * indexSize);
+			::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+			
+			batchInfo.indexCount = indexSize;
+			batchInfo.startIndexLocation = m_indexBufferWritePos;
+			batchInfo.uploadedBytes += static_cast<uint32>(sizeof(IndexType) * indexSize);
+			m_indexBufferWritePos += indexSize;
+		}
+		
+		return batchInfo;
+	}
+}
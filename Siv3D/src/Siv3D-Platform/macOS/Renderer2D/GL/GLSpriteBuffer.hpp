@@ -0,0 +1,56 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <GL/glew.h>
+# include <GLFW/glfw3.h>
+# include "GLSpriteBatch.hpp"
+
+namespace s3d
+{
+	struct BatchInfo
+	{
+		uint32 indexCount = 0;
+		
+		uint32 startIndexLocation = 0;
+		
+		uint32 baseVertexLocation = 0;
+		
+		uint32 uploadedBytes = 0;
+	};
+	
+	// GLSpriteBatch に記録されたバッチを GPU の頂点バッファ・インデックスバッファに転送する
+	class GLSpriteBuffer
+	{
+	private:
+		
+		GLuint m_vao = 0;
+		
+		GLuint m_vertexBuffer = 0;
+		uint32 m_vertexBufferWritePos = 0;
+		
+		GLuint m_indexBuffer = 0;
+		uint32 m_indexBufferWritePos = 0;
+		
+		static constexpr uint32 VertexBufferSize	= GLSpriteBatch::VertexBufferSize;
+		static constexpr uint32 IndexBufferSize		= GLSpriteBatch::IndexBufferSize;
+		
+	public:
+		
+		GLSpriteBuffer() = default;
+		
+		~GLSpriteBuffer();
+		
+		[[nodiscard]] bool init();
+		
+		[[nodiscard]] BatchInfo updateBuffers(const GLSpriteBatch& batches, size_t batchIndex);
+	};
+}
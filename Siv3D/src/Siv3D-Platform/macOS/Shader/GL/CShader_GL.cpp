@@ -13,6 +13,7 @@
 # include <Siv3D/TextReader.hpp>
 # include <Siv3D/EngineError.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Graphics/GL/CGraphics_GL.hpp>
 # include "CShader_GL.hpp"
 
 namespace s3d
@@ -26,8 +27,11 @@ namespace s3d
 	{
 		LOG_TRACE(U"CShader_GL::~CShader_GL()");
 
-		m_pixelShaders.destroy();
-		m_vertexShaders.destroy();
+		InvokeGLCommand([this]()
+		{
+			m_pixelShaders.destroy();
+			m_vertexShaders.destroy();
+		});
 	}
 	
 	bool CShader_GL::init()
@@ -87,16 +91,28 @@ namespace s3d
 	
 	VertexShaderID CShader_GL::createVSFromSource(const String& source, const Array<BindingPoint>& bindingPoints)
 	{
-		auto vertexShader = std::make_unique<VertexShader_GL>(source);
+		std::unique_ptr<VertexShader_GL> vertexShader;
 		
-		if (!vertexShader->isInitialized())
+		InvokeGLCommand([&]()
 		{
-			return VertexShaderID::NullAsset();
-		}
+			vertexShader = std::make_unique<VertexShader_GL>(source);
+			
+			if (!vertexShader->isInitialized())
+			{
+				vertexShader.reset();
+				
+				return;
+			}
+			
+			for (const auto& bindingPoint : bindingPoints)
+			{
+				vertexShader->setUniformBlockBinding(bindingPoint.bufferName.narrow().c_str(), bindingPoint.index);
+			}
+		});
 		
-		for (const auto& bindingPoint : bindingPoints)
+		if (!vertexShader)
 		{
-			vertexShader->setUniformBlockBinding(bindingPoint.bufferName.narrow().c_str(), bindingPoint.index);
+			return VertexShaderID::NullAsset();
 		}
 		
 		return m_vertexShaders.add(std::move(vertexShader));
@@ -128,16 +144,28 @@ namespace s3d
 	
 	PixelShaderID CShader_GL::createPSFromSource(const String& source, const Array<BindingPoint>& bindingPoints)
 	{
-		auto pixelShader = std::make_unique<PixelShader_GL>(source);
+		std::unique_ptr<PixelShader_GL> pixelShader;
 		
-		if (!pixelShader->isInitialized())
+		InvokeGLCommand([&]()
 		{
-			return PixelShaderID::NullAsset();
-		}
+			pixelShader = std::make_unique<PixelShader_GL>(source);
+			
+			if (!pixelShader->isInitialized())
+			{
+				pixelShader.reset();
+				
+				return;
+			}
+			
+			for (const auto& bindingPoint : bindingPoints)
+			{
+				pixelShader->setUniformBlockBinding(bindingPoint.bufferName.narrow().c_str(), bindingPoint.index);
+			}
+		});
 		
-		for (const auto& bindingPoint : bindingPoints)
+		if (!pixelShader)
 		{
-			pixelShader->setUniformBlockBinding(bindingPoint.bufferName.narrow().c_str(), bindingPoint.index);
+			return PixelShaderID::NullAsset();
 		}
 		
 		return m_pixelShaders.add(std::move(pixelShader));
@@ -145,12 +173,12 @@ namespace s3d
 	
 	void CShader_GL::release(const VertexShaderID handleID)
 	{
-		m_vertexShaders.erase(handleID);
+		PostGLCommand([this, handleID]() { m_vertexShaders.erase(handleID); });
 	}
 	
 	void CShader_GL::release(const PixelShaderID handleID)
 	{
-		m_pixelShaders.erase(handleID);
+		PostGLCommand([this, handleID]() { m_pixelShaders.erase(handleID); });
 	}
 	
 	ByteArrayView CShader_GL::getBinaryView(const VertexShaderID handleID)
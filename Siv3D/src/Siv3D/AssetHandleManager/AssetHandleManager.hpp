@@ -10,97 +10,285 @@
 //-----------------------------------------------
 
 # pragma once
+# include <array>
+# include <atomic>
 # include <memory>
 # include <mutex>
-# include <Siv3D/HashTable.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Optional.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include "AssetReport.hpp"
 
 namespace s3d
 {
+	// ID の下位ビットにスロットの位置、上位ビットに世代を持つスロットマップ
+	// operator [] はロックを取らず、add() と erase() はミューテックスで排他する
+	// erase() はデータをその場で破棄するため、同じ ID の operator [] や、そこで得たポインタの使用と同時に呼んではならない
+	// (エンジンでは erase() はその ID を持つハンドルの破棄時にだけ呼ばれ、破棄中のハンドルを他のスレッドが使うことはない)
 	template <class IDType, class Data>
 	class AssetHandleManager
 	{
 	private:
 
-		using MapType = HashTable<IDType, std::unique_ptr<Data>>;
+		using ValueType = typename IDType::ValueType;
 
-		MapType m_data;
+		static constexpr uint32 IndexBits = 20;
 
-		String m_assetTypeName;
+		static constexpr ValueType IndexMask = ((ValueType(1) << IndexBits) - 1);
+
+		// この世代に達したスロットは再利用しない（InvalidID を作らないため）
+		static constexpr ValueType MaxGeneration = (IDType::InvalidID >> IndexBits);
+
+		static constexpr uint32 ChunkBits = 10;
+
+		static constexpr size_t ChunkSize = (size_t(1) << ChunkBits);
+
+		static constexpr size_t MaxChunks = ((size_t(IndexMask) + 1) / ChunkSize);
+
+		struct Slot
+		{
+			// 範囲 for 文で data.first, data.second として参照される
+			std::pair<IDType, std::unique_ptr<Data>> entry;
+
+			// 使用中であればそのスロットの ID, 空きであれば InvalidID
+			std::atomic<ValueType> id = IDType::InvalidID;
 
-		typename IDType::ValueType m_idCount = 0;
+			// ロックを取らずに読み出すためのポインタ
+			std::atomic<Data*> pData = nullptr;
 
-		bool m_idFilled = false;
+			ValueType generation = 0;
+		};
+
+		// スロットはチャンク単位で確保し、読み出し中に移動しないようにする
+		std::array<std::atomic<Slot*>, MaxChunks> m_chunks = {};
+
+		std::atomic<size_t> m_num_slots = 0;
+
+		Array<uint32> m_freeSlots;
+
+		String m_assetTypeName;
 
 		std::mutex m_mutex;
 
+		[[nodiscard]] static constexpr uint32 GetIndex(const ValueType value) noexcept
+		{
+			return (value & IndexMask);
+		}
+
+		[[nodiscard]] static constexpr ValueType MakeID(const uint32 index, const ValueType generation) noexcept
+		{
+			return ((generation << IndexBits) | index);
+		}
+
+		[[nodiscard]] Slot& getSlot(const size_t index) const noexcept
+		{
+			return m_chunks[index >> ChunkBits].load(std::memory_order_acquire)[index & (ChunkSize - 1)];
+		}
+
+		// 新しいスロットを確保する。上限に達した場合は none
+		[[nodiscard]] Optional<uint32> allocateSlot()
+		{
+			if (m_freeSlots)
+			{
+				const uint32 index = m_freeSlots.back();
+
+				m_freeSlots.pop_back();
+
+				return index;
+			}
+
+			const size_t index = m_num_slots.load(std::memory_order_relaxed);
+
+			if (index > IndexMask)
+			{
+				return none;
+			}
+
+			if (auto& chunk = m_chunks[index >> ChunkBits]; !chunk.load(std::memory_order_relaxed))
+			{
+				chunk.store(new Slot[ChunkSize], std::memory_order_release);
+			}
+
+			m_num_slots.store(index + 1, std::memory_order_release);
+
+			return static_cast<uint32>(index);
+		}
+
+		void construct(Slot& slot, const ValueType id, std::unique_ptr<Data>&& data)
+		{
+			slot.entry = { IDType(id), std::move(data) };
+
+			slot.pData.store(slot.entry.second.get(), std::memory_order_relaxed);
+
+			// ID を最後に書き込み、読み出し側にデータが見えるようにする
+			slot.id.store(id, std::memory_order_release);
+		}
+
+		// 読み出し側はここで解放されるデータを参照していてはならない (クラスのコメントを参照)
+		void release(Slot& slot)
+		{
+			slot.id.store(IDType::InvalidID, std::memory_order_release);
+
+			slot.pData.store(nullptr, std::memory_order_relaxed);
+
+			slot.entry.second.reset();
+		}
+
+		template <class SlotMap, class Value>
+		class Iterator
+		{
+		private:
+
+			SlotMap* m_map = nullptr;
+
+			size_t m_index = 0;
+
+			void skipEmptySlots()
+			{
+				while ((m_index < m_map->m_num_slots) && !m_map->getSlot(m_index).entry.second)
+				{
+					++m_index;
+				}
+			}
+
+		public:
+
+			using iterator_category	= std::forward_iterator_tag;
+			using value_type		= Value;
+			using difference_type	= std::ptrdiff_t;
+			using pointer			= Value*;
+			using reference			= Value&;
+
+			Iterator(SlotMap* map, const size_t index)
+				: m_map(map)
+				, m_index(index)
+			{
+				skipEmptySlots();
+			}
+
+			reference operator *() const
+			{
+				return m_map->getSlot(m_index).entry;
+			}
+
+			pointer operator ->() const
+			{
+				return &m_map->getSlot(m_index).entry;
+			}
+
+			Iterator& operator ++()
+			{
+				++m_index;
+
+				skipEmptySlots();
+
+				return *this;
+			}
+
+			[[nodiscard]] bool operator ==(const Iterator& other) const noexcept
+			{
+				return (m_index == other.m_index);
+			}
+
+			[[nodiscard]] bool operator !=(const Iterator& other) const noexcept
+			{
+				return (m_index != other.m_index);
+			}
+		};
+
 	public:
 
-		using iterator			= typename MapType::iterator;
-		using const_iterator	= typename MapType::const_iterator;
+		using iterator			= Iterator<AssetHandleManager, std::pair<IDType, std::unique_ptr<Data>>>;
+		using const_iterator	= Iterator<const AssetHandleManager, const std::pair<IDType, std::unique_ptr<Data>>>;
 
 		explicit AssetHandleManager(const String& name)
 			: m_assetTypeName(name) {}
 
+		~AssetHandleManager()
+		{
+			for (auto& chunk : m_chunks)
+			{
+				delete[] chunk.load(std::memory_order_relaxed);
+			}
+		}
+
 		void setNullData(std::unique_ptr<Data>&& data)
 		{
-			m_data.emplace(IDType(IDType::NullAssetID), std::move(data));
+			std::lock_guard lock(m_mutex);
+
+			// スロット 0 は、世代 0 の ID (= NullAssetID) でヌルデータが使う
+			if (m_num_slots == 0)
+			{
+				allocateSlot();
+			}
+
+			Slot& slot = getSlot(0);
+
+			if (slot.entry.second)
+			{
+				release(slot);
+			}
+
+			construct(slot, IDType::NullAssetID, std::move(data));
 
 			LOG_DEBUG(U"💠 Created {0}[0(null)]"_fmt(m_assetTypeName));
 		}
 
+		// 存在しない ID に対してはヌルデータを返す
 		Data* operator [](const IDType id)
 		{
-			std::lock_guard lock(m_mutex);
+			const ValueType value = id.value();
+			const uint32 index = GetIndex(value);
 
-			return m_data[id].get();
+			if (index < m_num_slots.load(std::memory_order_acquire))
+			{
+				const Slot& slot = getSlot(index);
+
+				if (slot.id.load(std::memory_order_acquire) == value)
+				{
+					return slot.pData.load(std::memory_order_relaxed);
+				}
+			}
+
+			if (m_num_slots.load(std::memory_order_acquire) == 0)
+			{
+				return nullptr;
+			}
+
+			return getSlot(0).pData.load(std::memory_order_relaxed);
 		}
 
 		IDType add(std::unique_ptr<Data>&& data, [[maybe_unused]] const String& info = U"")
 		{
 			std::lock_guard lock(m_mutex);
 
-			if (++m_idCount == IDType::InvalidID)
+			if (m_num_slots == 0)
 			{
-				m_idFilled = true;
-				m_idCount = 0;
+				// スロット 0 をヌルデータ用に予約する
+				allocateSlot();
 			}
 
-			if (!m_idFilled)
-			{
-				m_data.emplace(m_idCount, std::move(data));
+			const auto index = allocateSlot();
 
-				LOG_DEBUG(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, m_idCount, info));
+			if (!index)
+			{
+				LOG_FAIL(U"❌ No more {0}s can be created"_fmt(m_assetTypeName));
 
-				return IDType(m_idCount);
+				return IDType(IDType::NullAssetID);
 			}
-			else
-			{
-				if (m_data.size() == (IDType::InvalidID - 1))
-				{
-					LOG_FAIL(U"❌ No more {0}s can be created"_fmt(m_assetTypeName));
 
-					return IDType(IDType::NullAssetID);
-				}
+			Slot& slot = getSlot(*index);
+			const ValueType id = MakeID(*index, slot.generation);
 
-				while (++m_idCount < IDType::InvalidID)
-				{
-					if (m_data.find(IDType(++m_idCount)) == m_data.end())
-					{
-						m_data.emplace(m_idCount, std::move(data));
+			construct(slot, id, std::move(data));
 
-						LOG_DEBUG(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, m_idCount, info));
+			LOG_DEBUG(U"💠 Created {0}[{1}] {2}"_fmt(m_assetTypeName, id, info));
 
-						return IDType(m_idCount);
-					}
-				}
-
-				return IDType(IDType::NullAssetID);
-			}
+			return IDType(id);
 		}
 
+		// id を使う operator [] の呼び出しと同時に呼んではならない
 		void erase(const IDType id)
 		{
 			if (id.isNullAsset())
@@ -110,13 +298,23 @@ namespace s3d
 
 			std::lock_guard lock(m_mutex);
 
-			const auto it = m_data.find(id);
+			const uint32 index = GetIndex(id.value());
 
-			assert(it != m_data.end());
+			assert(index < m_num_slots);
+
+			Slot& slot = getSlot(index);
+
+			assert(slot.id.load(std::memory_order_relaxed) == id.value());
 
 			LOG_DEBUG(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, id.value()));
 
-			m_data.erase(it);
+			release(slot);
+
+			// 世代を進めて、古い ID で参照されないようにする
+			if (++slot.generation < MaxGeneration)
+			{
+				m_freeSlots.push_back(index);
+			}
 
 			ReportAssetRelease();
 		}
@@ -125,9 +323,16 @@ namespace s3d
 		{
 			std::lock_guard lock(m_mutex);
 
-			for (const auto& data : m_data)
+			for (size_t i = 0; i < m_num_slots; ++i)
 			{
-				if (const auto id = data.first; !id.isNullAsset())
+				Slot& slot = getSlot(i);
+
+				if (!slot.entry.second)
+				{
+					continue;
+				}
+
+				if (const auto id = slot.entry.first; !id.isNullAsset())
 				{
 					LOG_DEBUG(U"♻️ Released {0}[{1}]"_fmt(m_assetTypeName, id.value()));
 				}
@@ -135,29 +340,29 @@ namespace s3d
 				{
 					LOG_DEBUG(U"♻️ Released {0}[0(null)]"_fmt(m_assetTypeName));
 				}
-			}
 
-			m_data.clear();
+				release(slot);
+			}
 		}
 
 		iterator begin()
 		{
-			return m_data.begin();
+			return iterator(this, 0);
 		}
 
 		iterator end()
 		{
-			return m_data.end();
+			return iterator(this, m_num_slots);
 		}
 
 		const_iterator begin() const
 		{
-			return m_data.cbegin();
+			return const_iterator(this, 0);
 		}
 
 		const_iterator end() const
 		{
-			return m_data.cend();
+			return const_iterator(this, m_num_slots);
 		}
 	};
 }
@@ -0,0 +1,261 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <algorithm>
+# include <chrono>
+# include <emmintrin.h>
+# include <Siv3D/EngineLog.hpp>
+# include "AudioMixer_AL.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		constexpr std::chrono::microseconds BufferDuration((AudioMixer_AL::BufferFrames * 1'000'000) / AudioMixer_AL::SamplingRate);
+
+		// [-1.0, 1.0] のステレオ float を 16-bit に変換する
+		static void ConvertToS16(const float* src, WaveSampleS16* dst, const size_t frames)
+		{
+			const size_t count = (frames * 2);
+			int16* pDst = &dst->left;
+			const __m128 scale = _mm_set1_ps(32767.0f);
+			size_t i = 0;
+
+			for (; (i + 8) <= count; i += 8)
+			{
+				const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), scale));
+				const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale));
+
+				// 範囲外の値は飽和させる
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi32(a, b));
+			}
+
+			for (; i < count; ++i)
+			{
+				const float s = (src[i] * 32767.0f);
+				pDst[i] = static_cast<int16>((s < -32768.0f) ? -32768.0f : ((32767.0f < s) ? 32767.0f : s));
+			}
+		}
+	}
+
+	AudioMixer_AL::AudioMixer_AL()
+		: m_mixBuffer(BufferFrames * 2)
+		, m_outputBuffer(BufferFrames)
+	{
+
+	}
+
+	AudioMixer_AL::~AudioMixer_AL()
+	{
+		m_abort = true;
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		if (m_source)
+		{
+			::alSourceStop(m_source);
+
+			::alDeleteSources(1, &m_source);
+		}
+
+		if (m_buffers[0])
+		{
+			::alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), m_buffers.data());
+		}
+	}
+
+	void AudioMixer_AL::init(const bool useOpenAL)
+	{
+		m_useOpenAL = useOpenAL;
+
+		if (m_useOpenAL)
+		{
+			::alGenBuffers(static_cast<ALsizei>(m_buffers.size()), m_buffers.data());
+			::alGenSources(1, &m_source);
+
+			::alSourcef(m_source, AL_GAIN, 1.0f);
+			::alSourcef(m_source, AL_PITCH, 1.0f);
+			::alSource3f(m_source, AL_POSITION, 0, 0, 0);
+			::alSource3f(m_source, AL_VELOCITY, 0, 0, 0);
+			::alSourcei(m_source, AL_LOOPING, AL_FALSE);
+
+			for (const auto buffer : m_buffers)
+			{
+				queueBuffer(buffer);
+			}
+
+			::alSourcePlay(m_source);
+		}
+		else
+		{
+			LOG_INFO(U"ℹ️ AudioMixer_AL: No audio device. Mixing to the null device");
+		}
+
+		m_thread = std::thread(&AudioMixer_AL::run, this);
+	}
+
+	bool AudioMixer_AL::isHeadless() const noexcept
+	{
+		return !m_useOpenAL;
+	}
+
+	std::mutex& AudioMixer_AL::getMutex() noexcept
+	{
+		return m_mutex;
+	}
+
+	void AudioMixer_AL::addVoice(const std::shared_ptr<AudioVoice_AL>& voice)
+	{
+		if (std::find(m_voices.begin(), m_voices.end(), voice) == m_voices.end())
+		{
+			m_voices.push_back(voice);
+		}
+	}
+
+	void AudioMixer_AL::removeVoice(const AudioVoice_AL* voice)
+	{
+		m_voices.remove_if([voice](const std::shared_ptr<AudioVoice_AL>& v) { return (v.get() == voice); });
+	}
+
+	void AudioMixer_AL::mix(float* dst, const size_t frames)
+	{
+		std::lock_guard mixLock(m_mixMutex);
+
+		std::fill_n(dst, (frames * 2), 0.0f);
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_mixingVoices.assign(m_voices.begin(), m_voices.end());
+		}
+
+		// デコードや読み込みを含む合成は、ロックを外して行う
+		bool hasFinished = false;
+
+		for (const auto& voice : m_mixingVoices)
+		{
+			if (!voice->mixTo(dst, frames, SamplingRate))
+			{
+				hasFinished = true;
+			}
+		}
+
+		m_mixingVoices.clear();
+
+		if (!hasFinished)
+		{
+			return;
+		}
+
+		std::lock_guard lock(m_mutex);
+
+		// 合成後に再生が再開されたボイスは残す
+		m_voices.remove_if([](const std::shared_ptr<AudioVoice_AL>& voice)
+		{
+			if (!voice->isFinished())
+			{
+				return false;
+			}
+
+			voice->onRemoved();
+
+			return true;
+		});
+	}
+
+	size_t AudioMixer_AL::num_voices()
+	{
+		std::lock_guard lock(m_mutex);
+
+		return m_voices.size();
+	}
+
+	void AudioMixer_AL::MixStereo(float* dst, const float* src, const size_t frames, const float gainL, const float gainR)
+	{
+		const size_t count = (frames * 2);
+		const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+		size_t i = 0;
+
+		for (; (i + 4) <= count; i += 4)
+		{
+			const __m128 s = _mm_mul_ps(_mm_loadu_ps(src + i), gain);
+			_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), s));
+		}
+
+		for (; i < count; i += 2)
+		{
+			dst[i] += (src[i] * gainL);
+			dst[i + 1] += (src[i + 1] * gainR);
+		}
+	}
+
+	void AudioMixer_AL::run()
+	{
+		auto lastTime = std::chrono::steady_clock::now();
+		uint64 framesMixed = 0;
+
+		while (!m_abort)
+		{
+			if (m_useOpenAL)
+			{
+				ALint processed = 0;
+				::alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+
+				while (0 < processed--)
+				{
+					ALuint buffer = 0;
+					::alSourceUnqueueBuffers(m_source, 1, &buffer);
+
+					queueBuffer(buffer);
+				}
+
+				// 合成が間に合わずに止まった場合は再開する
+				ALint state = 0;
+				::alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+
+				if (state != AL_PLAYING)
+				{
+					::alSourcePlay(m_source);
+				}
+			}
+			else
+			{
+				// ヌルデバイスでは、経過時間の分だけ合成して捨てる
+				const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lastTime);
+				const uint64 framesDue = (static_cast<uint64>(elapsed.count()) * SamplingRate / 1'000'000);
+
+				while ((framesMixed + BufferFrames) <= framesDue)
+				{
+					mix(m_mixBuffer.data(), BufferFrames);
+
+					framesMixed += BufferFrames;
+				}
+			}
+
+			std::this_thread::sleep_for(detail::BufferDuration / 2);
+		}
+	}
+
+	void AudioMixer_AL::queueBuffer(const ALuint buffer)
+	{
+		mix(m_mixBuffer.data(), BufferFrames);
+
+		detail::ConvertToS16(m_mixBuffer.data(), m_outputBuffer.data(), BufferFrames);
+
+		::alBufferData(buffer, AL_FORMAT_STEREO16, m_outputBuffer.data(),
+			static_cast<ALsizei>(m_outputBuffer.size() * sizeof(WaveSampleS16)), SamplingRate);
+
+		::alSourceQueueBuffers(m_source, 1, &buffer);
+	}
+}
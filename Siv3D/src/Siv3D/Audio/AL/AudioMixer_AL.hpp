@@ -0,0 +1,121 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Platform.hpp>
+
+// Linux 版と macOS 版で共有する
+# if SIV3D_PLATFORM(MACOS)
+#	include <OpenAL/al.h>
+#	include <OpenAL/alc.h>
+# else
+#	include <AL/al.h>
+#	include <AL/alc.h>
+# endif
+
+# include <array>
+# include <atomic>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/WaveSample.hpp>
+
+namespace s3d
+{
+	// ミキサーで合成されるボイス
+	class AudioVoice_AL
+	{
+	public:
+
+		virtual ~AudioVoice_AL() = default;
+
+		// outputSamplingRate のステレオ float を frames 分 dst に加算する。再生が終わった場合は false を返す
+		virtual bool mixTo(float* dst, size_t frames, uint32 outputSamplingRate) = 0;
+
+		// true を返すボイスはミキサーから外される
+		[[nodiscard]] virtual bool isFinished() const = 0;
+
+		// ミキサーから外されるときに呼ばれる
+		virtual void onRemoved() {}
+	};
+
+	// すべてのボイスを 1 つのスレッドで合成し、1 つの OpenAL ソースに出力する
+	class AudioMixer_AL
+	{
+	public:
+
+		static constexpr uint32 SamplingRate = 44100;
+
+		// 1 バッファあたりのフレーム数 (約 23 ms)
+		static constexpr size_t BufferFrames = 1024;
+
+		static constexpr size_t BufferCount = 4;
+
+		AudioMixer_AL();
+
+		~AudioMixer_AL();
+
+		// 合成スレッドを起動する。OpenAL のコンテキストが無い場合は、合成結果を捨てるヌルデバイスとして動作する。
+		// init() を呼ばない場合はスレッドを起動しないため、mix() を直接呼んで合成できる
+		void init(bool useOpenAL);
+
+		[[nodiscard]] bool isHeadless() const noexcept;
+
+		// ボイスの一覧は、このミューテックスを取得してから変更する。
+		// 合成中はこのミューテックスを保持しないため、ボイスの状態は各ボイスが排他する
+		[[nodiscard]] std::mutex& getMutex() noexcept;
+
+		// 以下の 2 つは getMutex() を取得した状態で呼ぶ
+		void addVoice(const std::shared_ptr<AudioVoice_AL>& voice);
+
+		void removeVoice(const AudioVoice_AL* voice);
+
+		// 登録されているボイスを frames 分合成して dst に書き込む。
+		// 合成スレッドと同時に呼ばれた場合は、一方の合成が終わるまで待つ
+		void mix(float* dst, size_t frames);
+
+		[[nodiscard]] size_t num_voices();
+
+		// インターリーブされたステレオ float の src に左右の音量を掛けて dst に加算する
+		static void MixStereo(float* dst, const float* src, size_t frames, float gainL, float gainR);
+
+	private:
+
+		Array<std::shared_ptr<AudioVoice_AL>> m_voices;
+
+		// 合成中のボイス。m_voices をロック中に複製し、ロックを外して合成する
+		Array<std::shared_ptr<AudioVoice_AL>> m_mixingVoices;
+
+		std::mutex m_mutex;
+
+		// mix() 全体を排他する。m_mixingVoices はこのミューテックスで守られる
+		std::mutex m_mixMutex;
+
+		bool m_useOpenAL = false;
+
+		ALuint m_source = 0;
+
+		std::array<ALuint, BufferCount> m_buffers = {};
+
+		Array<float> m_mixBuffer;
+
+		Array<WaveSampleS16> m_outputBuffer;
+
+		std::thread m_thread;
+
+		std::atomic<bool> m_abort = false;
+
+		void run();
+
+		void queueBuffer(ALuint buffer);
+	};
+}
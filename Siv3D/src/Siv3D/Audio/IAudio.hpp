@@ -29,6 +29,9 @@ namespace s3d
 
 		virtual AudioID create(Wave&& wave) = 0;
 
+		// ファイルを少しずつデコードしながら再生するオーディオを作成する
+		virtual AudioID createStreaming(const FilePath& path) = 0;
+
 		virtual void release(AudioID handleID) = 0;
 
 		virtual uint32 samplingRate(AudioID handleID) = 0;
@@ -41,6 +41,11 @@ namespace s3d
 		return AudioID::NullAsset();
 	}
 
+	AudioID CAudio_Null::createStreaming(const FilePath&)
+	{
+		return AudioID::NullAsset();
+	}
+
 	void CAudio_Null::release(const AudioID)
 	{
 
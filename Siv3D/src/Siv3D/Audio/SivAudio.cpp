@@ -209,6 +209,61 @@ namespace s3d
 		setLoop(loopBegin, loopEnd);
 	}
 
+	Audio::Audio(FileStreaming, const FilePath& path)
+		: m_handle(std::make_shared<AudioHandle>(Siv3DEngine::Get<ISiv3DAudio>()->createStreaming(path)))
+	{
+		ReportAssetCreation();
+	}
+
+	Audio::Audio(const FileStreaming stream, const FilePath& path, const Optional<AudioLoopTiming>& loop)
+		: Audio(stream, path)
+	{
+		if (loop)
+		{
+			if (loop->endPos)
+			{
+				setLoop(Arg::loopBegin = loop->beginPos, Arg::loopEnd = loop->endPos);
+			}
+			else
+			{
+				setLoop(Arg::loopBegin = loop->beginPos);
+			}
+		}
+	}
+
+	Audio::Audio(const FileStreaming stream, const FilePath& path, const Arg::loop_<bool> loop)
+		: Audio(stream, path)
+	{
+		if (*loop)
+		{
+			setLoop(true);
+		}
+	}
+
+	Audio::Audio(const FileStreaming stream, const FilePath& path, const Arg::loopBegin_<uint64> loopBegin)
+		: Audio(stream, path)
+	{
+		setLoop(loopBegin);
+	}
+
+	Audio::Audio(const FileStreaming stream, const FilePath& path, const Arg::loopBegin_<uint64> loopBegin, const Arg::loopEnd_<uint64> loopEnd)
+		: Audio(stream, path)
+	{
+		setLoop(loopBegin, loopEnd);
+	}
+
+	Audio::Audio(const FileStreaming stream, const FilePath& path, const Arg::loopBegin_<Duration> loopBegin)
+		: Audio(stream, path)
+	{
+		setLoop(loopBegin);
+	}
+
+	Audio::Audio(const FileStreaming stream, const FilePath& path, const Arg::loopBegin_<Duration> loopBegin, const Arg::loopEnd_<Duration> loopEnd)
+		: Audio(stream, path)
+	{
+		setLoop(loopBegin, loopEnd);
+	}
+
 	Audio::Audio(const GMInstrument instrumrnt, const uint8 key, const Duration& duration, const double velocity, const Arg::samplingRate_<uint32> samplingRate, const float silenceValue)
 		: Audio(Wave(instrumrnt, key, duration, velocity, samplingRate, silenceValue))
 	{
@@ -169,6 +169,28 @@ namespace s3d
 		return (*it)->decode(reader);
 	}
 
+	std::unique_ptr<IAudioStream> CAudioFormat::openStream(const FilePath& path) const
+	{
+		const auto it = findFormat(BinaryReader(path), path);
+
+		if (it == m_audioFormats.end())
+		{
+			return nullptr;
+		}
+
+		if (const AudioFormat_WAVE* wave = dynamic_cast<const AudioFormat_WAVE*>(it->get()))
+		{
+			return wave->openStream(path);
+		}
+
+		if (const AudioFormat_OggVorbis* oggVorbis = dynamic_cast<const AudioFormat_OggVorbis*>(it->get()))
+		{
+			return oggVorbis->openStream(path);
+		}
+
+		return nullptr;
+	}
+
 	bool CAudioFormat::encodeWAVE(IWriter& writer, const Wave& wave, const WAVEFormat format) const
 	{
 		const auto p = findFormat(AudioFormat::WAVE);
@@ -42,6 +42,8 @@ namespace s3d
 
 		Wave decode(IReader&& reader, AudioFormat format) const override;
 
+		std::unique_ptr<IAudioStream> openStream(const FilePath& path) const override;
+
 		bool encodeWAVE(IWriter& writer, const Wave& wave, WAVEFormat format) const override;
 
 		bool encodeOggVorbis(IWriter& writer, const Wave& wave, int32 quality) const override;
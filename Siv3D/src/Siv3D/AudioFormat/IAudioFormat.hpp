@@ -10,7 +10,9 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
 # include <Siv3D/Fwd.hpp>
+# include "IAudioStream.hpp"
 
 namespace s3d
 {
@@ -32,6 +34,9 @@ namespace s3d
 
 		virtual Wave decode(IReader&& reader, AudioFormat format) const = 0;
 
+		// ストリーミング再生に対応していない形式の場合は nullptr を返す
+		virtual std::unique_ptr<IAudioStream> openStream(const FilePath& path) const = 0;
+
 		virtual bool encodeWAVE(IWriter& writer, const Wave& wave, WAVEFormat format) const = 0;
 
 		virtual bool encodeOggVorbis(IWriter& writer, const Wave& wave, int32 quality) const = 0;
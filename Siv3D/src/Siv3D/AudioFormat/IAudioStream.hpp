@@ -0,0 +1,34 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+
+namespace s3d
+{
+	// オーディオファイルを再生に必要な分だけ少しずつデコードする
+	class IAudioStream
+	{
+	public:
+
+		virtual ~IAudioStream() = default;
+
+		[[nodiscard]] virtual uint32 samplingRate() const = 0;
+
+		[[nodiscard]] virtual size_t samples() const = 0;
+
+		// 次に read() するサンプルの位置を変更する
+		virtual bool seek(size_t posSample) = 0;
+
+		// 最大 count サンプルをデコードして dst に書き込み、書き込んだサンプル数を返す
+		virtual size_t read(WaveSample* dst, size_t count) = 0;
+	};
+}
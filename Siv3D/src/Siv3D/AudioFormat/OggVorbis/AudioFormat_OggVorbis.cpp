@@ -145,7 +145,7 @@ namespace s3d
 
 			OggVorbis_File vf;
 
-			if (::ov_open_callbacks(&reader, &vf, nullptr, -1, callbacks) != 0)
+			if (::ov_open_callbacks(static_cast<IReader*>(&reader), &vf, nullptr, -1, callbacks) != 0)
 			{
 				return Wave();
 			}
@@ -368,4 +368,112 @@ namespace s3d
 
 		return true;
 	}
+
+	std::unique_ptr<IAudioStream> AudioFormat_OggVorbis::openStream(const FilePath& path) const
+	{
+		auto stream = std::make_unique<AudioStream_OggVorbis>(path);
+
+		if (!stream->isOpened())
+		{
+			return nullptr;
+		}
+
+		return stream;
+	}
+
+	AudioStream_OggVorbis::AudioStream_OggVorbis(const FilePath& path)
+		: m_reader(path)
+	{
+		if (!m_reader.isOpened())
+		{
+			return;
+		}
+
+		ov_callbacks callbacks;
+		callbacks.read_func = ReadOgg_Callback;
+		callbacks.seek_func = SeekOgg_Callback;
+		callbacks.close_func = CloseOgg_Callback;
+		callbacks.tell_func = TellOgg_Callback;
+
+		if (::ov_open_callbacks(static_cast<IReader*>(&m_reader), &m_vf, nullptr, -1, callbacks) != 0)
+		{
+			return;
+		}
+
+		m_opened = true;
+
+		const vorbis_info* vi = ::ov_info(&m_vf, -1);
+
+		if (!vi || ((vi->channels != 1) && (vi->channels != 2)))
+		{
+			return;
+		}
+
+		m_samplingRate	= vi->rate ? static_cast<uint32>(vi->rate) : Wave::DefaultSamplingRate;
+		m_samples		= static_cast<size_t>((::ov_pcm_total(&m_vf, -1)) & 0xffFFffFF);
+		m_channels		= vi->channels;
+	}
+
+	AudioStream_OggVorbis::~AudioStream_OggVorbis()
+	{
+		if (m_opened)
+		{
+			::ov_clear(&m_vf);
+		}
+	}
+
+	bool AudioStream_OggVorbis::isOpened() const noexcept
+	{
+		return (m_opened && (m_samples != 0));
+	}
+
+	uint32 AudioStream_OggVorbis::samplingRate() const
+	{
+		return m_samplingRate;
+	}
+
+	size_t AudioStream_OggVorbis::samples() const
+	{
+		return m_samples;
+	}
+
+	bool AudioStream_OggVorbis::seek(const size_t posSample)
+	{
+		return (::ov_pcm_seek(&m_vf, static_cast<ogg_int64_t>(posSample)) == 0);
+	}
+
+	size_t AudioStream_OggVorbis::read(WaveSample* dst, const size_t count)
+	{
+		size_t samplesRead = 0;
+		int current_sec = 0;
+
+		while (samplesRead < count)
+		{
+			float** pcm = nullptr;
+
+			const long result = ::ov_read_float(&m_vf, &pcm, static_cast<int>(Min<size_t>(count - samplesRead, 4096)), &current_sec);
+
+			if (result <= 0)
+			{
+				break;
+			}
+
+			if (m_channels == 1)
+			{
+				for (long i = 0; i < result; ++i)
+				{
+					dst[samplesRead++].set(pcm[0][i]);
+				}
+			}
+			else
+			{
+				for (long i = 0; i < result; ++i)
+				{
+					dst[samplesRead++].set(pcm[0][i], pcm[1][i]);
+				}
+			}
+		}
+
+		return samplesRead;
+	}
 }
@@ -12,6 +12,9 @@
 # pragma once
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/AudioFormat.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <libvorbis/vorbisfile.h>
+# include <AudioFormat/IAudioStream.hpp>
 
 namespace s3d
 {
@@ -30,5 +33,41 @@ namespace s3d
 		Wave decode(IReader& reader) const override;
 
 		bool encode(const Wave& wave, int32 quality, IWriter& writer) const;
+
+		std::unique_ptr<IAudioStream> openStream(const FilePath& path) const;
+	};
+
+	// libvorbisfile で再生位置の周辺だけをデコードする
+	class AudioStream_OggVorbis : public IAudioStream
+	{
+	private:
+
+		BinaryReader m_reader;
+
+		OggVorbis_File m_vf;
+
+		bool m_opened = false;
+
+		uint32 m_samplingRate = 0;
+
+		size_t m_samples = 0;
+
+		int32 m_channels = 0;
+
+	public:
+
+		explicit AudioStream_OggVorbis(const FilePath& path);
+
+		~AudioStream_OggVorbis() override;
+
+		[[nodiscard]] bool isOpened() const noexcept;
+
+		uint32 samplingRate() const override;
+
+		size_t samples() const override;
+
+		bool seek(size_t posSample) override;
+
+		size_t read(WaveSample* dst, size_t count) override;
 	};
 }
@@ -479,4 +479,188 @@ namespace s3d
 
 		return true;
 	}
+
+	std::unique_ptr<IAudioStream> AudioFormat_WAVE::openStream(const FilePath& path) const
+	{
+		auto stream = std::make_unique<AudioStream_WAVE>(path);
+
+		if (!stream->isOpened())
+		{
+			return nullptr;
+		}
+
+		return stream;
+	}
+
+	AudioStream_WAVE::AudioStream_WAVE(const FilePath& path)
+		: m_reader(path)
+	{
+		RiffHeader riffHeader;
+
+		if (!m_reader.read(riffHeader))
+		{
+			return;
+		}
+
+		if (!detail::MemEqual(riffHeader.riff, detail::RIFF_SIGN) || !detail::MemEqual(riffHeader.type, detail::WAVE_SIGN))
+		{
+			return;
+		}
+
+		ChunkHeader chunkHeader;
+
+		for (;;)
+		{
+			if (!m_reader.read(chunkHeader))
+			{
+				return;
+			}
+
+			if (detail::MemEqual(chunkHeader.chunkID, detail::FMT_CHUNK))
+			{
+				break;
+			}
+			else
+			{
+				m_reader.setPos(m_reader.getPos() + chunkHeader.chunkSize);
+			}
+		}
+
+		FormatHeader formatHeader;
+
+		if (!m_reader.read(formatHeader))
+		{
+			return;
+		}
+
+		if (chunkHeader.chunkSize > sizeof(formatHeader))
+		{
+			m_reader.skip(chunkHeader.chunkSize - sizeof(formatHeader));
+		}
+
+		for (;;)
+		{
+			if (!m_reader.read(chunkHeader))
+			{
+				return;
+			}
+
+			if (detail::MemEqual(chunkHeader.chunkID, detail::DATA_CHUNK))
+			{
+				break;
+			}
+			else
+			{
+				m_reader.setPos(m_reader.getPos() + chunkHeader.chunkSize);
+			}
+		}
+
+		const bool isPCM = ((formatHeader.bitsWidth == 8) || (formatHeader.bitsWidth == 16) || (formatHeader.bitsWidth == 24));
+		const bool isFloat = ((formatHeader.formatID == WAVE_FORMAT_IEEE_FLOAT) && (formatHeader.bitsWidth == 32));
+
+		if ((!isPCM && !isFloat) || ((formatHeader.channels != 1) && (formatHeader.channels != 2)))
+		{
+			return;
+		}
+
+		m_dataOffset	= m_reader.getPos();
+		m_samples		= chunkHeader.chunkSize / (formatHeader.channels * (formatHeader.bitsWidth / 8));
+		m_samplingRate	= formatHeader.samplerate;
+		m_formatID		= formatHeader.formatID;
+		m_channels		= formatHeader.channels;
+		m_bitsWidth		= formatHeader.bitsWidth;
+	}
+
+	bool AudioStream_WAVE::isOpened() const noexcept
+	{
+		return (m_samples != 0);
+	}
+
+	uint32 AudioStream_WAVE::samplingRate() const
+	{
+		return m_samplingRate;
+	}
+
+	size_t AudioStream_WAVE::samples() const
+	{
+		return m_samples;
+	}
+
+	bool AudioStream_WAVE::seek(const size_t posSample)
+	{
+		if (m_samples < posSample)
+		{
+			return false;
+		}
+
+		m_pos = posSample;
+
+		return true;
+	}
+
+	size_t AudioStream_WAVE::read(WaveSample* dst, size_t count)
+	{
+		count = Min(count, (m_samples - m_pos));
+
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		const size_t bytesPerSample = (m_channels * (m_bitsWidth / 8));
+
+		m_buffer.resize(count * bytesPerSample);
+
+		const int64 bytesToRead = static_cast<int64>(m_buffer.size());
+
+		if (m_reader.read(m_buffer.data(), m_dataOffset + static_cast<int64>(m_pos * bytesPerSample), bytesToRead) != bytesToRead)
+		{
+			return 0;
+		}
+
+		const uint8* pSrc = m_buffer.data();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			float channels[2];
+
+			for (uint16 ch = 0; ch < m_channels; ++ch)
+			{
+				if (m_bitsWidth == 8)
+				{
+					channels[ch] = (pSrc[0] / 127.5f - 1.0f);
+				}
+				else if (m_bitsWidth == 16)
+				{
+					int16 s;
+					std::memcpy(&s, pSrc, sizeof(s));
+					channels[ch] = (s / 32768.0f);
+				}
+				else if (m_bitsWidth == 24)
+				{
+					const int32 s = ((pSrc[2] << 24) | (pSrc[1] << 16) | (pSrc[0] << 8)) / 65536;
+					channels[ch] = (s / 32768.0f);
+				}
+				else
+				{
+					std::memcpy(&channels[ch], pSrc, sizeof(float));
+				}
+
+				pSrc += (m_bitsWidth / 8);
+			}
+
+			if (m_channels == 1)
+			{
+				dst[i].set(channels[0]);
+			}
+			else
+			{
+				dst[i].set(channels[0], channels[1]);
+			}
+		}
+
+		m_pos += count;
+
+		return count;
+	}
 }
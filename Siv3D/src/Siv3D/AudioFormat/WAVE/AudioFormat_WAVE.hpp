@@ -12,6 +12,8 @@
 # pragma once
 # include <Siv3D/Wave.hpp>
 # include <Siv3D/AudioFormat.hpp>
+# include <Siv3D/BinaryReader.hpp>
+# include <AudioFormat/IAudioStream.hpp>
 
 namespace s3d
 {
@@ -30,5 +32,45 @@ namespace s3d
 		Wave decode(IReader& reader) const override;
 
 		bool encode(const Wave& wave, IWriter& writer, WAVEFormat format) const;
+
+		std::unique_ptr<IAudioStream> openStream(const FilePath& path) const;
+	};
+
+	// data チャンクを必要な分だけ読み込んで変換する
+	class AudioStream_WAVE : public IAudioStream
+	{
+	private:
+
+		BinaryReader m_reader;
+
+		int64 m_dataOffset = 0;
+
+		size_t m_samples = 0;
+
+		uint32 m_samplingRate = 0;
+
+		uint16 m_formatID = 0;
+
+		uint16 m_channels = 0;
+
+		uint16 m_bitsWidth = 0;
+
+		size_t m_pos = 0;
+
+		Array<uint8> m_buffer;
+
+	public:
+
+		explicit AudioStream_WAVE(const FilePath& path);
+
+		[[nodiscard]] bool isOpened() const noexcept;
+
+		uint32 samplingRate() const override;
+
+		size_t samples() const override;
+
+		bool seek(size_t posSample) override;
+
+		size_t read(WaveSample* dst, size_t count) override;
 	};
 }
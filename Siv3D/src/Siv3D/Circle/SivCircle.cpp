@@ -118,6 +118,11 @@ namespace s3d
 		return *this;
 	}
 
+	void Circle::DrawBatch(const Array<Circle>& circles, const ColorF& color)
+	{
+		Siv3DEngine::Get<ISiv3DRenderer2D>()->addCircles(circles.data(), circles.size(), color.toFloat4());
+	}
+
 	const Circle& Circle::drawFrame(const double thickness, const ColorF& color) const
 	{
 		return drawFrame(thickness * 0.5, thickness * 0.5, color);
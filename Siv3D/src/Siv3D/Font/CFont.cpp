@@ -406,6 +406,21 @@ namespace s3d
 		return m_fonts[handleID]->getTexture();
 	}
 
+	bool CFont::preload(const FontID handleID, const String& codePoints)
+	{
+		return m_fonts[handleID]->preload(codePoints);
+	}
+
+	void CFont::setMaxGlyphCachePages(const FontID handleID, const size_t maxPages)
+	{
+		m_fonts[handleID]->setMaxGlyphCachePages(maxPages);
+	}
+
+	GlyphCacheStatistics CFont::getGlyphCacheStatistics(const FontID handleID)
+	{
+		return m_fonts[handleID]->getGlyphCacheStatistics();
+	}
+
 	RectF CFont::getBoundingRect(FontID handleID, const String& codePoints, const double lineSpacingScale)
 	{
 		return m_fonts[handleID]->getBoundingRect(codePoints, lineSpacingScale);
@@ -76,6 +76,12 @@ namespace s3d
 
 		const Texture& getTexture(FontID handleID) override;
 
+		bool preload(FontID handleID, const String& codePoints) override;
+
+		void setMaxGlyphCachePages(FontID handleID, size_t maxPages) override;
+
+		GlyphCacheStatistics getGlyphCacheStatistics(FontID handleID) override;
+
 		RectF getBoundingRect(FontID handleID, const String& codePoints, double lineSpacingScale) override;
 
 		RectF getRegion(FontID handleID, const String& codePoints, double lineSpacingScale) override;
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <cfloat>
+# include <numeric>
 # include "FontData.hpp"
 # include FT_OPENTYPE_VALIDATE_H
 # include <Siv3D/Unicode.hpp>
@@ -19,6 +20,9 @@
 # include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3DEngine.hpp>
+# include <System/ISystem.hpp>
+# include <Threading/WorkerPool.hpp>
 
 namespace s3d
 {
@@ -85,6 +89,11 @@ namespace s3d
 		{
 			return uint16(((uint16)p[0] << 8) + (uint16)p[1]);
 		}
+
+		[[nodiscard]] static uint64 GetFrameCount()
+		{
+			return Siv3DEngine::Get<ISiv3DSystem>()->getSystemFrameCount();
+		}
 	}
 
 	FontData::FontData(Null, FT_Library)
@@ -178,6 +187,11 @@ namespace s3d
 			}
 		}
 
+		// preload() でワーカースレッド用のフェイスを開くために記録しておく
+		m_library = library;
+		m_filePath = filePath;
+		m_emojiFilePath = emojiFilePath;
+
 		m_familyName = Unicode::Widen(m_faceText.face->family_name);
 		m_styleName = Unicode::Widen(m_faceText.face->style_name);
 
@@ -201,6 +215,18 @@ namespace s3d
 			m_tabWidth = static_cast<int32>(m_faceText.face->glyph->metrics.horiAdvance * 4 / 64);
 		}
 
+		const int32 pageSize =
+			m_fontSize <= 16 ? 512 :
+			m_fontSize <= 32 ? 768 :
+			m_fontSize <= 48 ? 1024 :
+			m_fontSize <= 64 ? 1536 : 2048;
+
+		// 余白はグリフの画像に含めるので、アトラスの余白は 0 にする
+		m_atlas = TextureAtlas(Size(pageSize, pageSize), 0);
+
+		// 既定では、ページの合計が以前の最大の大きさ (幅 x 4096) 程度になるようにする
+		m_atlas.setMaxPages(Max(4096 / pageSize, 2));
+
 		m_initialized = true;
 	}
 
@@ -270,8 +296,8 @@ namespace s3d
 			else
 			{
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo	= m_glyphs[m_glyphVHIndexTable[indexVH]];
-				glyph.texture			= m_texture(glyphInfo.bitmapRect);
+				const auto& glyphInfo	= getGlyphInfo(indexVH);
+				glyph.texture			= getTextureRegion(glyphInfo);
 				glyph.offset			= glyphInfo.offset;
 				glyph.bearingY			= glyphInfo.bearingY;
 				glyph.xAdvance			= glyphInfo.xAdvance;
@@ -317,8 +343,8 @@ namespace s3d
 			else
 			{
 				const char32VH indexVH = codePoint | Vertical;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
-				glyph.texture = m_texture(glyphInfo.bitmapRect);
+				const auto& glyphInfo = getGlyphInfo(indexVH);
+				glyph.texture = getTextureRegion(glyphInfo);
 				glyph.offset = glyphInfo.offset;
 				glyph.bearingY = glyphInfo.bearingY;
 				glyph.xAdvance = glyphInfo.xAdvance;
@@ -383,7 +409,31 @@ namespace s3d
 
 	const Texture& FontData::getTexture() const
 	{
-		return m_texture;
+		if (m_atlas.num_pages() == 0)
+		{
+			return m_emptyTexture;
+		}
+
+		// 2 ページ目以降のグリフは返すテクスチャに含まれない
+		if (m_atlas.num_pages() > 1)
+		{
+			LOG_FAIL_ONCE(U"❌ Font::getTexture(): The glyph cache has {} pages. Only the first page is returned. Use Glyph::texture instead"_fmt(m_atlas.num_pages()));
+		}
+
+		return m_atlas.getPageTexture(0);
+	}
+
+	void FontData::setMaxGlyphCachePages(const size_t maxPages)
+	{
+		m_atlas.setMaxPages(maxPages);
+	}
+
+	GlyphCacheStatistics FontData::getGlyphCacheStatistics() const
+	{
+		GlyphCacheStatistics statistics = m_cacheStatistics;
+		statistics.num_glyphs = (m_glyphs.size() - m_freeGlyphIndices.size());
+		statistics.num_pages = m_atlas.num_pages();
+		return statistics;
 	}
 
 	RectF FontData::getBoundingRect(const String& codePoints, const double lineSpacingScale)
@@ -415,7 +465,7 @@ namespace s3d
 			else if (!IsControl(codePoint))
 			{
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
+				const auto& glyphInfo = getGlyphInfo(indexVH);
 				const RectF region(penPos + glyphInfo.offset, glyphInfo.bitmapRect.size);
 				const int32 characterWidth = glyphInfo.bitmapRect.size.isZero() ? glyphInfo.xAdvance : glyphInfo.bitmapRect.size.x;
 				minPos.x = std::min(minPos.x, region.x);
@@ -470,7 +520,7 @@ namespace s3d
 				}
 
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
+				const auto& glyphInfo = getGlyphInfo(indexVH);
 				const RectF region(penPos + glyphInfo.offset, glyphInfo.bitmapRect.size);
 				const int32 characterWidth = glyphInfo.xAdvance;
 				minPos.x = std::min(minPos.x, region.x);
@@ -511,7 +561,7 @@ namespace s3d
 			else
 			{
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
+				const auto& glyphInfo = getGlyphInfo(indexVH);
 				xAdvabces.push_back(glyphInfo.xAdvance);
 			}
 		}
@@ -519,14 +569,158 @@ namespace s3d
 		return xAdvabces;
 	}
 
-	RectF FontData::draw(const String& codePoints, const Vec2& pos, const ColorF& color, double lineSpacingScale)
+	RectF FontData::draw(const String& codePoints, const Vec2& pos, const ColorF& color, const double lineSpacingScale)
 	{
-		if (!render(codePoints))
+		const TextLayout* layout = getLayout(codePoints, none, lineSpacingScale);
+
+		if (!layout)
 		{
 			return RectF(pos, 0);
 		}
+
+		drawLayout(*layout, pos, color);
+
+		return RectF(pos, layout->size);
+	}
+
+	bool FontData::draw(const String& codePoints, const RectF& area, const ColorF& color, const double lineSpacingScale)
+	{
+		const TextLayout* layout = getLayout(codePoints, area.size, lineSpacingScale);
+
+		if (!layout)
+		{
+			return false;
+		}
+
+		drawLayout(*layout, area.pos, color);
+
+		return layout->fits;
+	}
+
+	size_t FontData::TextLayoutKeyHash::operator()(const TextLayoutKeyView& key) const noexcept
+	{
+		const double parameters[3] = { (key.areaSize ? key.areaSize->x : -1.0), (key.areaSize ? key.areaSize->y : -1.0), key.lineSpacingScale };
+
+		return (Hash::FNV1a(key.text.data(), key.text.size_bytes()) ^ (Hash::FNV1a(parameters, sizeof(parameters)) * 1099511628211ULL));
+	}
+
+	const FontData::TextLayout* FontData::getLayout(const String& codePoints, const Optional<SizeF>& areaSize, const double lineSpacingScale)
+	{
+		const uint64 frameCount = detail::GetFrameCount();
+
+		const TextLayoutKeyView key{ codePoints, areaSize, lineSpacingScale };
+
+		if (auto it = m_layoutCache.find(key); it != m_layoutCache.end())
+		{
+			TextLayout& layout = it.value();
+
+			// グリフが削除されていなければ、テクスチャの領域はそのまま使える
+			if (layout.evictions == m_cacheStatistics.evictions)
+			{
+				for (const auto index : layout.glyphIndices)
+				{
+					markUsed(index);
+				}
+
+				m_cacheStatistics.hits += layout.regions.size();
+
+				layout.lastUsedFrame = frameCount;
+
+				return &layout;
+			}
+
+			m_layoutCache.erase(it);
+		}
+
+		if (MaxCachedLayouts <= m_layoutCache.size())
+		{
+			// 現在のフレームで使われていないレイアウトを破棄する
+			for (auto it = m_layoutCache.begin(); it != m_layoutCache.end();)
+			{
+				if (it->second.lastUsedFrame != frameCount)
+				{
+					it = m_layoutCache.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		TextLayout layout;
+
+		if (!(areaSize ? buildAreaLayout(codePoints, *areaSize, lineSpacingScale, layout)
+			: buildLayout(codePoints, lineSpacingScale, layout)))
+		{
+			return nullptr;
+		}
+
+		layout.glyphIndices.unique();
+
+		// レイアウトの作成中に削除されたグリフがあれば、削除回数を記録し直す
+		layout.evictions = m_cacheStatistics.evictions;
+		layout.lastUsedFrame = frameCount;
+
+		// 欠けたグリフは、アトラスに空きができた後の描画で作り直す
+		if (!layout.complete || (MaxCachedLayouts <= m_layoutCache.size()))
+		{
+			m_uncachedLayout = std::move(layout);
+
+			return &m_uncachedLayout;
+		}
+
+		return &m_layoutCache.emplace(TextLayoutKey{ codePoints, areaSize, lineSpacingScale }, std::move(layout)).first.value();
+	}
+
+	void FontData::addToLayout(TextLayout& layout, const char32VH indexVH, const Vec2& offset)
+	{
+		const auto it = m_glyphVHIndexTable.find(indexVH);
+
+		if (it == m_glyphVHIndexTable.end())
+		{
+			// render() でアトラスに追加できなかったグリフ
+			layout.complete = false;
+
+			return;
+		}
+
+		const CommonGlyphIndex index = it->second;
+		const GlyphInfo& glyphInfo = m_glyphs[index];
+
+		// ビットマップが空のグリフは描画しない
+		if (!glyphInfo.atlasID)
+		{
+			return;
+		}
+
+		layout.regions.push_back(getTextureRegion(glyphInfo));
+		layout.offsets.push_back(offset);
+		layout.glyphIndices.push_back(index);
+	}
+
+	void FontData::drawLayout(const TextLayout& layout, const Vec2& pos, const ColorF& color)
+	{
+		const size_t count = layout.offsets.size();
+
+		m_layoutPositions.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			m_layoutPositions[i] = (pos + layout.offsets[i]);
+		}
+
+		TextureRegion::DrawBatch(layout.regions, m_layoutPositions, color);
+	}
+
+	bool FontData::buildLayout(const String& codePoints, const double lineSpacingScale, TextLayout& layout)
+	{
+		if (!render(codePoints))
+		{
+			return false;
+		}
 		
-		Vec2 penPos(pos);
+		Vec2 penPos(0, 0);
 		double maxPosX = DBL_MIN;
 		int32 lineCount = 0;
 		
@@ -534,7 +728,7 @@ namespace s3d
 		{
 			if (codePoint == U'\n')
 			{
-				penPos.x = pos.x;
+				penPos.x = 0;
 				penPos.y += m_lineSpacing * lineSpacingScale;
 				++lineCount;
 				continue;
@@ -553,38 +747,40 @@ namespace s3d
 				}
 
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
-				const RectF region = m_texture(glyphInfo.bitmapRect).draw(penPos + glyphInfo.offset, color);
+				const auto& glyphInfo = getGlyphInfo(indexVH);
+				addToLayout(layout, indexVH, penPos + glyphInfo.offset);
 				const int32 characterWidth = glyphInfo.xAdvance;
-				maxPosX = std::max(maxPosX, region.x + characterWidth);
+				maxPosX = std::max(maxPosX, penPos.x + glyphInfo.offset.x + characterWidth);
 				penPos.x += glyphInfo.xAdvance;
 			}
 		}
 
-		if (!lineCount)
+		if (lineCount)
 		{
-			return RectF(pos, 0);
+			layout.size.set(maxPosX, lineCount * m_lineSpacing * lineSpacingScale);
 		}
-		
-		return RectF(pos, maxPosX - pos.x, lineCount * m_lineSpacing * lineSpacingScale);
+
+		return true;
 	}
 
-	bool FontData::draw(const String& codePoints, const RectF& area, const ColorF& color, const double lineSpacingScale)
+	bool FontData::buildAreaLayout(const String& codePoints, const SizeF& areaSize, const double lineSpacingScale, TextLayout& layout)
 	{
 		if (!render(codePoints))
 		{
 			return false;
 		}
 
-		const double width = area.w;
-		const double height = area.h;
+		const double width = areaSize.x;
+		const double height = areaSize.y;
 
 		std::u32string adjustedText;
 		bool needDots = false;
 
 		if (m_lineSpacing > height)
 		{
-			return false;
+			layout.fits = false;
+
+			return true;
 		}
 		
 		{
@@ -626,7 +822,9 @@ namespace s3d
 						{
 							if (characterWidth > width)
 							{
-								return false;
+								layout.fits = false;
+
+								return true;
 							}
 
 							penPos.x = characterWidth;
@@ -647,7 +845,7 @@ namespace s3d
 				}
 
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
+				const auto& glyphInfo = getGlyphInfo(indexVH);
 				const int32 characterWidth = glyphInfo.offset.x + glyphInfo.bitmapRect.w;
 
 				if (penPos.x + characterWidth <= width)
@@ -664,7 +862,9 @@ namespace s3d
 					{
 						if (glyphInfo.xAdvance > width)
 						{
-							return false;
+							layout.fits = false;
+
+							return true;
 						}
 
 						penPos.x = glyphInfo.xAdvance;
@@ -684,10 +884,12 @@ namespace s3d
 			{
 				if (!render(String(1, U'.')))
 				{
-					return false;
+					layout.fits = false;
+
+					return true;
 				}
 
-				const auto& dotGlyph = m_glyphs[m_glyphVHIndexTable[U'.' | Horizontal]];
+				const auto& dotGlyph = getGlyphInfo(U'.' | Horizontal);
 				const int32 dotWidth = dotGlyph.offset.x + dotGlyph.bitmapRect.w;
 				const int32 dotsWidth = dotGlyph.xAdvance * 2 + dotWidth;
 
@@ -706,7 +908,7 @@ namespace s3d
 					}
 
 					const char32VH indexVH = codePoint | Horizontal;
-					const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
+					const auto& glyphInfo = getGlyphInfo(indexVH);
 					penPos.x -= glyphInfo.xAdvance;
 					adjustedText.pop_back();
 				}
@@ -719,14 +921,14 @@ namespace s3d
 		}
 
 		{
-			Vec2 penPos(area.pos);
+			Vec2 penPos(0, 0);
 			int32 lineCount = 0;
 
 			for (const auto& codePoint : adjustedText)
 			{
 				if (codePoint == U'\n')
 				{
-					penPos.x = area.x;
+					penPos.x = 0;
 					penPos.y += m_lineSpacing * lineSpacingScale;
 					++lineCount;
 					continue;
@@ -748,13 +950,15 @@ namespace s3d
 				}
 
 				const char32VH indexVH = codePoint | Horizontal;
-				const auto& glyphInfo = m_glyphs[m_glyphVHIndexTable[indexVH]];
-				m_texture(glyphInfo.bitmapRect).draw(penPos + glyphInfo.offset, color);
+				const auto& glyphInfo = getGlyphInfo(indexVH);
+				addToLayout(layout, indexVH, penPos + glyphInfo.offset);
 				penPos.x += glyphInfo.xAdvance;
 			}
 		}
 
-		return !needDots;
+		layout.fits = !needDots;
+
+		return true;
 	}
 
 	Rect FontData::paint(Image& dst, const bool overwrite, const String& codePoints, const Point& pos, const Color& color, const double lineSpacingScale) const
@@ -930,13 +1134,11 @@ namespace s3d
 			return false;
 		}
 
-		bool hasDirty = false;
-
 		for (const auto& codePoint : codePoints)
 		{
 			const char32VH indexVH = codePoint | Horizontal;
 
-			if (m_glyphVHIndexTable.find(indexVH) != m_glyphVHIndexTable.end())
+			if (touchGlyph(indexVH))
 			{
 				continue;
 			}
@@ -948,56 +1150,29 @@ namespace s3d
 			{
 				if (!m_tofuIndex)
 				{
-					if (!renderGlyph(m_faceText.face, 0))
+					if (!(m_tofuIndex = renderGlyph(m_faceText.face, 0)))
 					{
 						continue;
 					}
-
-					hasDirty = true;
-
-					m_tofuIndex = static_cast<CommonGlyphIndex>(m_glyphs.size() - 1);
 				}
 
-				m_glyphVHIndexTable.emplace(indexVH, m_tofuIndex.value());
+				addGlyphKey(indexVH, m_tofuIndex.value());
 			}
 			else
 			{
 				const FT_Face face = (glyphIndexText != 0) ? m_faceText.face : m_faceEmoji.face;
 				const FT_UInt glyphIndex = (glyphIndexText != 0) ? glyphIndexText : glyphIndexEmoji;
 
-				renderGlyph(face, glyphIndex);
-
-				hasDirty = true;
-
-				m_glyphVHIndexTable.emplace(indexVH, static_cast<uint32>(m_glyphs.size() - 1));
-			}
-		}
-
-		if (hasDirty)
-		{
-			if (m_image.size() == m_texture.size())
-			{
-				m_texture.fill(m_image);
-			}
-			else
-			{
-				const bool hasTexture = !!m_texture;
-				[[maybe_unused]] const Size previousSize = m_texture.size();
-				[[maybe_unused]] const Size newSize = m_image.size();
-
-				m_texture = DynamicTexture(m_image);
-
-				if (hasTexture)
+				if (const auto index = renderGlyph(face, glyphIndex))
 				{
-					LOG_DEBUG(U"ℹ️ Font texture resized ({0}x{1} -> {2}x{3})"_fmt(previousSize.x, previousSize.y, newSize.x, newSize.y));
-				}
-				else
-				{
-					LOG_DEBUG(U"ℹ️ Created font texture (size: {0}x{1})"_fmt(newSize.x, newSize.y));
+					addGlyphKey(indexVH, *index);
 				}
 			}
 		}
 
+		// 新しく追加されたグリフの領域だけをテクスチャに転送する
+		m_atlas.upload();
+
 		return true;
 	}
 
@@ -1013,13 +1188,11 @@ namespace s3d
 			generateVerticalTable();
 		}
 
-		bool hasDirty = false;
-
 		for (const auto& codePoint : codePoints)
 		{
 			const char32VH indexVH = codePoint | Vertical;
 
-			if (m_glyphVHIndexTable.find(indexVH) != m_glyphVHIndexTable.end())
+			if (touchGlyph(indexVH))
 			{
 				continue;
 			}
@@ -1032,37 +1205,29 @@ namespace s3d
 			{
 				if (!m_tofuIndex)
 				{
-					if (!renderGlyph(m_faceText.face, 0))
+					if (!(m_tofuIndex = renderGlyph(m_faceText.face, 0)))
 					{
 						continue;
 					}
-
-					hasDirty = true;
-
-					m_tofuIndex = static_cast<CommonGlyphIndex>(m_glyphs.size() - 1);
 				}
 
-				m_glyphVHIndexTable.emplace(indexVH, m_tofuIndex.value());
+				addGlyphKey(indexVH, m_tofuIndex.value());
 			}
 			else if (isEmoji)
 			{
-				const auto it = m_glyphVHIndexTable.find(codePoint);
+				const auto it = m_glyphVHIndexTable.find(codePoint | Horizontal);
 
 				if (it == m_glyphVHIndexTable.end())
 				{
-					renderGlyph(m_faceEmoji.face, glyphIndexEmoji);
-
-					hasDirty = true;
-
-					const CommonGlyphIndex index = static_cast<uint32>(m_glyphs.size() - 1);
-
-					m_glyphVHIndexTable.emplace(codePoint | Horizontal, index);
-					m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+					if (const auto index = renderGlyph(m_faceEmoji.face, glyphIndexEmoji))
+					{
+						addGlyphKey(codePoint | Horizontal, *index);
+						addGlyphKey(codePoint | Vertical, *index);
+					}
 				}
 				else
 				{
-					const CommonGlyphIndex index = it->second;
-					m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+					addGlyphKey(codePoint | Vertical, it->second);
 				}
 			}
 			else
@@ -1072,67 +1237,257 @@ namespace s3d
 
 				if (hasVerticalGlyph)
 				{
-					renderGlyph(m_faceText.face, itV->second);
-
-					hasDirty = true;
-
-					const CommonGlyphIndex index = static_cast<uint32>(m_glyphs.size() - 1);
-
-					m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+					if (const auto index = renderGlyph(m_faceText.face, itV->second))
+					{
+						addGlyphKey(codePoint | Vertical, *index);
+					}
 				}
 				else
 				{
-					const auto it = m_glyphVHIndexTable.find(codePoint);
+					const auto it = m_glyphVHIndexTable.find(codePoint | Horizontal);
 
 					if (it == m_glyphVHIndexTable.end())
 					{
-						renderGlyph(m_faceText.face, glyphIndexText);
-
-						hasDirty = true;
-
-						const CommonGlyphIndex index = static_cast<uint32>(m_glyphs.size() - 1);
-
-						m_glyphVHIndexTable.emplace(codePoint | Horizontal, index);
-						m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+						if (const auto index = renderGlyph(m_faceText.face, glyphIndexText))
+						{
+							addGlyphKey(codePoint | Horizontal, *index);
+							addGlyphKey(codePoint | Vertical, *index);
+						}
 					}
 					else
 					{
-						const CommonGlyphIndex index = it->second;
-						m_glyphVHIndexTable.emplace(codePoint | Vertical, index);
+						addGlyphKey(codePoint | Vertical, it->second);
 					}
 				}
 			}
 		}
 
-		if (hasDirty)
+		m_atlas.upload();
+
+		return true;
+	}
+
+	bool FontData::preload(const String& codePoints)
+	{
+		if (!m_faceText)
+		{
+			return false;
+		}
+
+		// 同じグリフを参照する文字は 1 回だけラスタライズする
+		struct Job
 		{
-			if (m_image.size() == m_texture.size())
+			FT_UInt glyphIndex = 0;
+
+			bool isEmoji = false;
+
+			bool isTofu = false;
+
+			Array<char32> codePoints;
+
+			GlyphInfo info;
+
+			Image image;
+
+			bool rasterized = false;
+		};
+
+		Array<Job> jobs;
+		HashTable<uint64, size_t> jobTable;
+
+		for (const auto& codePoint : codePoints)
+		{
+			const char32VH indexVH = codePoint | Horizontal;
+
+			if (m_glyphVHIndexTable.find(indexVH) != m_glyphVHIndexTable.end())
 			{
-				m_texture.fill(m_image);
+				continue;
 			}
-			else
+
+			const FT_UInt glyphIndexText = ::FT_Get_Char_Index(m_faceText.face, codePoint);
+			const FT_UInt glyphIndexEmoji = (glyphIndexText != 0) ? 0 : m_faceEmoji ? ::FT_Get_Char_Index(m_faceEmoji.face, codePoint) : 0;
+			const bool isTofu = (glyphIndexText == 0 && glyphIndexEmoji == 0);
+
+			if (isTofu && m_tofuIndex)
 			{
-				const bool hasTexture = !!m_texture;
-				[[maybe_unused]] const Size previousSize = m_texture.size();
-				[[maybe_unused]] const Size newSize = m_image.size();
+				addGlyphKey(indexVH, m_tofuIndex.value());
+				continue;
+			}
 
-				m_texture = DynamicTexture(m_image);
+			const bool isEmoji = (!isTofu && glyphIndexText == 0);
+			const FT_UInt glyphIndex = isEmoji ? glyphIndexEmoji : glyphIndexText;
 
-				if (hasTexture)
-				{
-					LOG_DEBUG(U"ℹ️ Font texture resized ({0}x{1} -> {2}x{3})"_fmt(previousSize.x, previousSize.y, newSize.x, newSize.y));
-				}
-				else
+			// 豆腐のグリフは 1 つにまとめ、それ以外は render() と同じく文字ごとにグリフを作る
+			const uint64 key = isTofu ? 0 : ((uint64(1) << 32) | codePoint);
+
+			if (auto it = jobTable.find(key); it != jobTable.end())
+			{
+				if (isTofu)
 				{
-					LOG_DEBUG(U"ℹ️ Created font texture (size: {0}x{1})"_fmt(newSize.x, newSize.y));
+					jobs[it->second].codePoints.push_back(codePoint);
 				}
+
+				continue;
+			}
+
+			jobTable.emplace(key, jobs.size());
+
+			Job job;
+			job.glyphIndex = glyphIndex;
+			job.isEmoji = isEmoji;
+			job.isTofu = isTofu;
+			job.codePoints.push_back(codePoint);
+			jobs.push_back(std::move(job));
+		}
+
+		if (!jobs)
+		{
+			return true;
+		}
+
+		// FT_Face は複数のスレッドから同時に使えないため、ワーカーごとにフェイスを開く
+		const size_t num_workers = Clamp<size_t>(jobs.size() / MinPreloadGlyphsPerWorker, 1, Threading::GetConcurrency());
+		const bool hasEmoji = jobs.any([](const Job& job) { return job.isEmoji; });
+
+		Array<std::pair<FT_Face, FT_Face>> workerFaces;
+
+		for (size_t i = 1; i < num_workers; ++i)
+		{
+			const FT_Face faceText = openFace(m_filePath, false);
+
+			if (!faceText)
+			{
+				break;
 			}
+
+			const FT_Face faceEmoji = hasEmoji ? openFace(m_emojiFilePath, true) : nullptr;
+
+			workerFaces.emplace_back(faceText, faceEmoji);
 		}
 
-		return true;
+		// 呼び出し元のスレッド (ワーカー 0) は、FontData が持つフェイスでラスタライズに参加する
+		detail::ParallelFor(jobs.size(), (workerFaces.size() + 1), [&](const size_t i, const size_t workerIndex)
+		{
+			const FT_Face faceText = (workerIndex == 0) ? m_faceText.face : workerFaces[workerIndex - 1].first;
+			const FT_Face faceEmoji = (workerIndex == 0) ? m_faceEmoji.face : workerFaces[workerIndex - 1].second;
+
+			Job& job = jobs[i];
+
+			if (const FT_Face face = job.isEmoji ? faceEmoji : faceText)
+			{
+				job.rasterized = rasterizeGlyph(face, job.glyphIndex, job.info, job.image);
+			}
+		}, MinPreloadGlyphsPerWorker);
+
+		for (const auto& workerFace : workerFaces)
+		{
+			::FT_Done_Face(workerFace.first);
+
+			if (workerFace.second)
+			{
+				::FT_Done_Face(workerFace.second);
+			}
+		}
+
+		// 高さの大きい順に詰め込むと、アトラスの無駄な領域が少なくなる
+		Array<size_t> order(jobs.size());
+		std::iota(order.begin(), order.end(), size_t(0));
+
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+		{
+			return jobs[a].image.height() > jobs[b].image.height();
+		});
+
+		bool succeeded = true;
+
+		for (const auto i : order)
+		{
+			Job& job = jobs[i];
+
+			if (!job.rasterized)
+			{
+				succeeded = false;
+				continue;
+			}
+
+			const auto index = addGlyph(job.info, job.image);
+
+			if (!index)
+			{
+				succeeded = false;
+				continue;
+			}
+
+			if (job.isTofu)
+			{
+				m_tofuIndex = index;
+			}
+
+			for (const auto codePoint : job.codePoints)
+			{
+				addGlyphKey(codePoint | Horizontal, *index);
+			}
+		}
+
+		m_atlas.upload();
+
+		LOG_DEBUG(U"ℹ️ Font glyphs preloaded ({0} glyphs, {1} threads)"_fmt(jobs.size(), workerFaces.size() + 1));
+
+		return succeeded;
+	}
+
+	FT_Face FontData::openFace(const FilePath& path, const bool isEmoji) const
+	{
+		FT_Face face = nullptr;
+
+	# if SIV3D_PLATFORM(WINDOWS)
+
+		if (FileSystem::IsResource(path))
+		{
+			if (::FT_New_Memory_Face(m_library, static_cast<const FT_Byte*>(m_resource.data()), static_cast<FT_Long>(m_resource.size()), 0, &face))
+			{
+				return nullptr;
+			}
+		}
+		else if (::FT_New_Face(m_library, path.narrow().c_str(), 0, &face))
+		{
+			return nullptr;
+		}
+
+	# else
+
+		if (::FT_New_Face(m_library, path.narrow().c_str(), 0, &face))
+		{
+			return nullptr;
+		}
+
+	# endif
+
+		// コンストラクタと同じく、絵文字のフェイスでは失敗を許容する（ビットマップの絵文字フォントは大きさを自由に選べない）
+		if (::FT_Set_Pixel_Sizes(face, 0, m_fontSize) && !isEmoji)
+		{
+			::FT_Done_Face(face);
+
+			return nullptr;
+		}
+
+		return face;
 	}
 
-	bool FontData::renderGlyph(const FT_Face face, const FT_UInt glyphIndex)
+	Optional<FontData::CommonGlyphIndex> FontData::renderGlyph(const FT_Face face, const FT_UInt glyphIndex)
+	{
+		GlyphInfo info;
+		Image image;
+
+		if (!rasterizeGlyph(face, glyphIndex, info, image))
+		{
+			return none;
+		}
+
+		return addGlyph(info, image);
+	}
+
+	bool FontData::rasterizeGlyph(const FT_Face face, const FT_UInt glyphIndex, GlyphInfo& info, Image& image) const
 	{
 		if (const FT_Error error = ::FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT | (m_noBitmap ? FT_LOAD_NO_BITMAP : 0)))
 		{
@@ -1164,51 +1519,25 @@ namespace s3d
 			isBitmap = true;
 		}
 
-		if (!m_image)
-		{
-			const int32 baseWidth =
-				m_fontSize <= 16 ? 512 :
-				m_fontSize <= 32 ? 768 :
-				m_fontSize <= 48 ? 1024 :
-				m_fontSize <= 64 ? 1536 : 2048;
-
-			m_image.resize(baseWidth, 256, Color(255, 0));
-		}
-
-		m_penPos.x += padding;
-	
 		const int32 bitmapWidth = slot->bitmap.width;
 		const int32 bitmapHeight = slot->bitmap.rows;
 		const int32 bitmapStride = slot->bitmap.pitch;
 
-		if (m_penPos.x + (bitmapWidth + padding) > m_image.width())
-		{
-			m_penPos.x = padding;
-
-			const int32 advanceY = static_cast<int32>(slot->metrics.vertAdvance / 64);
-
-			m_penPos.y += advanceY + padding * 2;
-		}
-
-		if (m_penPos.y + (bitmapHeight + padding) > m_image.height())
-		{
-			const int32 newHeight = ((m_penPos.y + (bitmapHeight + padding)) + 255) / 256 * 256;
-
-			if (newHeight > 4096)
-			{
-				return false;
-			}
-
-			m_image.resizeRows(newHeight, Color(255, 0));
-		}
-
-		GlyphInfo info;
-		info.bitmapRect.set(m_penPos, bitmapWidth, bitmapHeight);
+		info.bitmapRect.set(0, 0, bitmapWidth, bitmapHeight);
 		info.offset.set(slot->bitmap_left, m_ascender - slot->bitmap_top);
 		info.bearingY = static_cast<int32>(slot->bitmap_top);
 		info.xAdvance = static_cast<int32>(slot->metrics.horiAdvance / 64);
 		info.yAdvance = static_cast<int32>(slot->metrics.vertAdvance / 64);
 
+		if (!bitmapWidth || !bitmapHeight)
+		{
+			image.release();
+
+			return true;
+		}
+
+		// 隣のグリフがにじまないよう、周囲に透明な余白を付けてアトラスに追加する
+		image = Image(bitmapWidth + padding * 2, bitmapHeight + padding * 2, Color(255, 0));
 		const uint8* bitmapBuffer = slot->bitmap.buffer;
 
 		if (isBitmap)
@@ -1222,7 +1551,7 @@ namespace s3d
 					const uint32 offsetI = x / 8;
 					const uint32 offsetB = 7 - x % 8;
 
-					m_image[m_penPos.y + y][m_penPos.x + x] = Color(255, ((pSrcLine[offsetI] >> offsetB) & 0x1) ? 255: 0);
+					image[padding + y][padding + x] = Color(255, ((pSrcLine[offsetI] >> offsetB) & 0x1) ? 255: 0);
 				}
 
 				pSrcLine += bitmapStride;
@@ -1234,18 +1563,177 @@ namespace s3d
 			{
 				for (int32 x = 0; x < bitmapWidth; ++x)
 				{
-					m_image[m_penPos.y + y][m_penPos.x + x] = Color(255, bitmapBuffer[y * bitmapWidth + x]);
+					image[padding + y][padding + x] = Color(255, bitmapBuffer[y * bitmapWidth + x]);
 				}
 			}
 		}
 
-		m_penPos.x += bitmapWidth + padding;
+		return true;
+	}
+
+	Optional<FontData::CommonGlyphIndex> FontData::addGlyph(GlyphInfo info, const Image& image)
+	{
+		++m_cacheStatistics.misses;
+
+		if (image)
+		{
+			const auto atlasID = addToAtlas(image);
+
+			if (!atlasID)
+			{
+				return none;
+			}
+
+			info.atlasID = atlasID;
+			info.pageIndex = m_atlas.getPageIndex(*atlasID).value();
+			info.bitmapRect.setPos(m_atlas.getRect(*atlasID)->pos + Point(padding, padding));
+		}
+
+		CommonGlyphIndex index;
+
+		if (m_freeGlyphIndices)
+		{
+			index = m_freeGlyphIndices.back();
+			m_freeGlyphIndices.pop_back();
+			m_glyphs[index] = info;
+		}
+		else
+		{
+			index = static_cast<CommonGlyphIndex>(m_glyphs.size());
+			m_glyphs.push_back(info);
+		}
+
+		m_glyphs[index].lruIterator = m_lruGlyphs.insert(m_lruGlyphs.end(), index);
+		m_glyphs[index].lastUsedFrame = detail::GetFrameCount();
 
-		m_glyphs.push_back(info);
+		return index;
+	}
+
+	bool FontData::touchGlyph(const char32VH indexVH)
+	{
+		const auto it = m_glyphVHIndexTable.find(indexVH);
+
+		if (it == m_glyphVHIndexTable.end())
+		{
+			return false;
+		}
+
+		markUsed(it->second);
+
+		++m_cacheStatistics.hits;
 
 		return true;
 	}
 
+	void FontData::addGlyphKey(const char32VH indexVH, const CommonGlyphIndex index)
+	{
+		m_glyphVHIndexTable.emplace(indexVH, index);
+
+		m_glyphs[index].keys.push_back(indexVH);
+
+		markUsed(index);
+	}
+
+	void FontData::markUsed(const CommonGlyphIndex index)
+	{
+		GlyphInfo& glyph = m_glyphs[index];
+
+		glyph.lastUsedFrame = detail::GetFrameCount();
+
+		m_lruGlyphs.splice(m_lruGlyphs.end(), m_lruGlyphs, glyph.lruIterator);
+	}
+
+	bool FontData::evictGlyph()
+	{
+		if (m_lruGlyphs.empty())
+		{
+			return false;
+		}
+
+		const CommonGlyphIndex index = m_lruGlyphs.front();
+		GlyphInfo& glyph = m_glyphs[index];
+
+		// 現在のフレームで使われたグリフは、描画コマンドがまだテクスチャを参照しているため削除しない
+		if (glyph.lastUsedFrame == detail::GetFrameCount())
+		{
+			return false;
+		}
+
+		m_lruGlyphs.pop_front();
+
+		for (const auto key : glyph.keys)
+		{
+			m_glyphVHIndexTable.erase(key);
+		}
+
+		if (glyph.atlasID)
+		{
+			m_atlas.remove(*glyph.atlasID);
+		}
+
+		if (m_tofuIndex == index)
+		{
+			m_tofuIndex.reset();
+		}
+
+		glyph = GlyphInfo();
+
+		m_freeGlyphIndices.push_back(index);
+
+		++m_cacheStatistics.evictions;
+
+		return true;
+	}
+
+	Optional<TextureAtlas::IDType> FontData::addToAtlas(const Image& image)
+	{
+		const Size pageSize = m_atlas.pageSize();
+
+		if ((pageSize.x < image.width()) || (pageSize.y < image.height()))
+		{
+			return none;
+		}
+
+		for (;;)
+		{
+			if (const auto atlasID = m_atlas.add(image))
+			{
+				return atlasID;
+			}
+
+			if (!evictGlyph())
+			{
+				LOG_FAIL(U"❌ Font glyph cache is full ({0} pages)"_fmt(m_atlas.num_pages()));
+
+				return none;
+			}
+		}
+	}
+
+	const GlyphInfo& FontData::getGlyphInfo(const char32VH indexVH) const
+	{
+		static const GlyphInfo emptyGlyph;
+
+		const auto it = m_glyphVHIndexTable.find(indexVH);
+
+		if (it == m_glyphVHIndexTable.end())
+		{
+			return emptyGlyph;
+		}
+
+		return m_glyphs[it->second];
+	}
+
+	TextureRegion FontData::getTextureRegion(const GlyphInfo& glyphInfo) const
+	{
+		if (!glyphInfo.atlasID)
+		{
+			return TextureRegion();
+		}
+
+		return m_atlas.getPageTexture(glyphInfo.pageIndex)(glyphInfo.bitmapRect);
+	}
+
 	void FontData::paintGlyph(FT_Face face, FT_UInt glyphIndex, Image& image, Image& tmpImage, const bool overwrite, const Point& penPos, const Color& color, int32& width, int32& xAdvance) const
 	{
 		if (const FT_Error error = ::FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT | (m_noBitmap ? FT_LOAD_NO_BITMAP : 0)))
@@ -17,11 +17,12 @@
 # include FT_TRUETYPE_TABLES_H
 # include <harfbuzz/hb.h>
 # include <harfbuzz/hb-ft.h>
+# include <list>
 # include <Siv3D/HashTable.hpp>
 # include <Siv3D/Image.hpp>
 # include <Siv3D/Font.hpp>
 # include <Siv3D/ByteArray.hpp>
-# include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/TextureAtlas.hpp>
 # include "FontFace.hpp"
 
 # if SIV3D_PLATFORM(WINDOWS)
@@ -92,6 +93,18 @@ namespace s3d
 		int32 yAdvance = 0;
 
 		int32 width = 0;
+
+		// アトラス内の画像の ID。ビットマップが空のグリフは none
+		Optional<TextureAtlas::IDType> atlasID;
+
+		size_t pageIndex = 0;
+
+		// このグリフを参照している m_glyphVHIndexTable のキー
+		Array<uint32> keys;
+
+		uint64 lastUsedFrame = 0;
+
+		std::list<uint32>::iterator lruIterator;
 	};
 
 	class FontData
@@ -148,11 +161,108 @@ namespace s3d
 
 		bool m_noBitmap = true;
 
-		Point m_penPos = { 0, padding };
+		// グリフのビットマップを格納するページ。上限に達すると古いグリフから削除される
+		TextureAtlas m_atlas;
+
+		// 使われた順に並んだグリフ。先頭が最も古い
+		std::list<CommonGlyphIndex> m_lruGlyphs;
+
+		// 削除されたグリフの、再利用できるインデックス
+		Array<CommonGlyphIndex> m_freeGlyphIndices;
+
+		GlyphCacheStatistics m_cacheStatistics;
+
+		// ページが 1 つもないときに getTexture() が返すテクスチャ
+		Texture m_emptyTexture;
+
+		// 描画したテキストのレイアウト。同じテキストを再び描画するときに再利用する
+		struct TextLayout
+		{
+			Array<TextureRegion> regions;
+
+			// テキストの左上を原点とする各グリフの位置
+			Array<Vec2> offsets;
+
+			// レイアウトが参照するグリフ（重複なし）
+			Array<CommonGlyphIndex> glyphIndices;
+
+			SizeF size = SizeF(0, 0);
+
+			// 矩形の中にすべての文字が収まった場合 true
+			bool fits = true;
+
+			// アトラスが一杯で作成できなかったグリフがある場合 false。そのようなレイアウトはキャッシュしない
+			bool complete = true;
 
-		Image m_image;
+			// 作成時のグリフの削除回数。現在の値と異なる場合、テクスチャの領域が無効になっている可能性がある
+			size_t evictions = 0;
 
-		DynamicTexture m_texture;
+			uint64 lastUsedFrame = 0;
+		};
+
+		// 同じテキストでも、矩形の大きさや行間が異なれば別のレイアウトになる
+		struct TextLayoutKey
+		{
+			String text;
+
+			// 矩形の中に描画する場合はその大きさ
+			Optional<SizeF> areaSize;
+
+			double lineSpacingScale = 1.0;
+		};
+
+		// キャッシュを検索するたびにテキストをコピーしないためのキー
+		struct TextLayoutKeyView
+		{
+			StringView text;
+
+			const Optional<SizeF>& areaSize;
+
+			double lineSpacingScale;
+		};
+
+		struct TextLayoutKeyHash
+		{
+			using is_transparent = void;
+
+			[[nodiscard]] size_t operator()(const TextLayoutKeyView& key) const noexcept;
+
+			[[nodiscard]] size_t operator()(const TextLayoutKey& key) const noexcept
+			{
+				return (*this)(TextLayoutKeyView{ key.text, key.areaSize, key.lineSpacingScale });
+			}
+		};
+
+		struct TextLayoutKeyEqual
+		{
+			using is_transparent = void;
+
+			template <class KeyA, class KeyB>
+			[[nodiscard]] bool operator()(const KeyA& a, const KeyB& b) const noexcept
+			{
+				return (StringView(a.text) == StringView(b.text))
+					&& (a.areaSize == b.areaSize)
+					&& (a.lineSpacingScale == b.lineSpacingScale);
+			}
+		};
+
+		static constexpr size_t MaxCachedLayouts = 1024;
+
+		HashTable<TextLayoutKey, TextLayout, TextLayoutKeyHash, TextLayoutKeyEqual> m_layoutCache;
+
+		// キャッシュが一杯のときに作成したレイアウト
+		TextLayout m_uncachedLayout;
+
+		Array<Vec2> m_layoutPositions;
+
+		// preload() でワーカー 1 つあたりに割り当てるグリフ数の下限。少ない場合はフェイスを開くコストの方が大きい
+		static constexpr size_t MinPreloadGlyphsPerWorker = 64;
+
+		FT_Library m_library = nullptr;
+
+		FilePath m_filePath;
+
+		FilePath m_emojiFilePath;
 
 		bool m_initialized = false;
 
@@ -162,7 +272,41 @@ namespace s3d
 
 		bool renderVertical(const String& codePoints);
 
-		bool renderGlyph(FT_Face face, FT_UInt glyphIndex);
+		Optional<CommonGlyphIndex> renderGlyph(FT_Face face, FT_UInt glyphIndex);
+
+		// グリフをラスタライズする。FontData の状態を変更しないので、フェイスが異なれば並列に呼び出せる
+		bool rasterizeGlyph(FT_Face face, FT_UInt glyphIndex, GlyphInfo& info, Image& image) const;
+
+		Optional<CommonGlyphIndex> addGlyph(GlyphInfo info, const Image& image);
+
+		// フォントファイルから新しいフェイスを開く。大きさの設定に失敗した場合の扱いはコンストラクタと同じ
+		FT_Face openFace(const FilePath& path, bool isEmoji) const;
+
+		// キャッシュにあるグリフを、現在のフレームで使われたものとして記録する
+		bool touchGlyph(char32VH indexVH);
+
+		void addGlyphKey(char32VH indexVH, CommonGlyphIndex index);
+
+		void markUsed(CommonGlyphIndex index);
+
+		// 現在のフレームで使われていない、最も古いグリフを削除する
+		bool evictGlyph();
+
+		Optional<TextureAtlas::IDType> addToAtlas(const Image& image);
+
+		const GlyphInfo& getGlyphInfo(char32VH indexVH) const;
+
+		TextureRegion getTextureRegion(const GlyphInfo& glyphInfo) const;
+
+		const TextLayout* getLayout(const String& codePoints, const Optional<SizeF>& areaSize, double lineSpacingScale);
+
+		bool buildLayout(const String& codePoints, double lineSpacingScale, TextLayout& layout);
+
+		bool buildAreaLayout(const String& codePoints, const SizeF& areaSize, double lineSpacingScale, TextLayout& layout);
+
+		void addToLayout(TextLayout& layout, char32VH indexVH, const Vec2& offset);
+
+		void drawLayout(const TextLayout& layout, const Vec2& pos, const ColorF& color);
 
 		void paintGlyph(FT_Face face, FT_UInt glyphIndex, Image& image, Image& tmpImage, bool overwrite, const Point& penPos, const Color& color, int32& width, int32& xAdvance) const;
 
@@ -196,8 +340,14 @@ namespace s3d
 
 		OutlineGlyph getOutlineGlyph(char32 codePoint);
 
+		bool preload(const String& codePoints);
+
 		const Texture& getTexture() const;
 
+		void setMaxGlyphCachePages(size_t maxPages);
+
+		GlyphCacheStatistics getGlyphCacheStatistics() const;
+
 		RectF getBoundingRect(const String& codePoints, double lineSpacingScale);
 
 		RectF getRegion(const String& codePoints, double lineSpacingScale);
@@ -59,6 +59,12 @@ namespace s3d
 
 		virtual const Texture& getTexture(FontID handleID) = 0;
 
+		virtual bool preload(FontID handleID, const String& codePoints) = 0;
+
+		virtual void setMaxGlyphCachePages(FontID handleID, size_t maxPages) = 0;
+
+		virtual GlyphCacheStatistics getGlyphCacheStatistics(FontID handleID) = 0;
+
 		virtual RectF getBoundingRect(FontID handleID, const String& codePoints, double lineSpacingScale) = 0;
 
 		virtual RectF getRegion(FontID handleID, const String& codePoints, double lineSpacingScale) = 0;
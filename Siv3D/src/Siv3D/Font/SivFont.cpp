@@ -170,6 +170,21 @@ namespace s3d
 		return Siv3DEngine::Get<ISiv3DFont>()->getTexture(m_handle->id());
 	}
 
+	bool Font::preload(const StringView characters) const
+	{
+		return Siv3DEngine::Get<ISiv3DFont>()->preload(m_handle->id(), String(characters));
+	}
+
+	void Font::setMaxGlyphCachePages(const size_t maxPages) const
+	{
+		Siv3DEngine::Get<ISiv3DFont>()->setMaxGlyphCachePages(m_handle->id(), maxPages);
+	}
+
+	GlyphCacheStatistics Font::getGlyphCacheStatistics() const
+	{
+		return Siv3DEngine::Get<ISiv3DFont>()->getGlyphCacheStatistics(m_handle->id());
+	}
+
 
 	GlyphIterator::GlyphIterator(const Font& font, String::const_iterator it, int32 index)
 		: m_font(font)
@@ -61,5 +61,10 @@ namespace s3d
 		virtual void requestScreenCapture() = 0;
 
 		virtual const Image& getScreenCapture() const = 0;
+
+		// フレームの記録と GPU への発行を別のスレッドで並行して行う
+		virtual void setPipelinedRendering(bool enabled) = 0;
+
+		virtual bool getPipelinedRendering() const = 0;
 	};
 }
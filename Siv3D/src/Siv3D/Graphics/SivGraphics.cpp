@@ -68,5 +68,15 @@ namespace s3d
 		{
 			return Siv3DEngine::Get<ISiv3DGraphics>()->getDPIScaling();
 		}
+
+		void SetPipelinedRendering(const bool enabled)
+		{
+			Siv3DEngine::Get<ISiv3DGraphics>()->setPipelinedRendering(enabled);
+		}
+
+		bool GetPipelinedRendering()
+		{
+			return Siv3DEngine::Get<ISiv3DGraphics>()->getPipelinedRendering();
+		}
 	}
 }
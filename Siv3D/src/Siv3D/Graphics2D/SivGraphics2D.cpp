@@ -129,5 +129,15 @@ namespace s3d
 		{
 			return Siv3DEngine::Get<ISiv3DRenderer2D>()->getSDFParameters();
 		}
+
+		void SetDrawSorting(const bool enabled)
+		{
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->setDrawSorting(enabled);
+		}
+
+		bool GetDrawSorting()
+		{
+			return Siv3DEngine::Get<ISiv3DRenderer2D>()->getDrawSorting();
+		}
 	}
 }
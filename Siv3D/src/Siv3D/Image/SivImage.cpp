@@ -9,6 +9,7 @@
 //
 //-----------------------------------------------
 
+# define SIV3D_CONCURRENT
 # include <Siv3D/Image.hpp>
 # include <Siv3D/ImageRegion.hpp>
 # include <Siv3D/ImageProcessing.hpp>
@@ -22,10 +23,13 @@
 # include <Siv3D/Polygon.hpp>
 # include <Siv3D/MultiPolygon.hpp>
 # include <Siv3D/OpenCV_Bridge.hpp>
+# include <Siv3D/Threading.hpp>
 # include <Siv3DEngine.hpp>
 # include <ImageFormat/IImageFormat.hpp>
 # include <ObjectDetection/IObjectDetection.hpp>
+# include <Threading/WorkerPool.hpp>
 
+# include <smmintrin.h>
 # include <opencv2/imgproc.hpp>
 # include <opencv2/photo.hpp>
 
@@ -86,6 +90,160 @@ namespace s3d
 			}
 		}
 
+		// ̉f̉摜̓XbhNɏ
+		inline constexpr size_t ParallelPixelThreshold = (512 * 512);
+
+		// 摜sPʂ̃ubNɕAf(pBegin, pEnd) ɌĂ
+		template <class Fty>
+		static void ForEachRowBlock(Image& image, Fty f)
+		{
+			Color* const pData = image.data();
+			const size_t width = image.width();
+			const size_t height = image.height();
+			const size_t numThreads = (image.num_pixels() < ParallelPixelThreshold) ? 1
+				: std::clamp<size_t>(Threading::GetConcurrency(), 1, height);
+
+			if (numThreads == 1)
+			{
+				f(pData, pData + image.num_pixels());
+				return;
+			}
+
+			const size_t rowsPerThread = ((height + numThreads - 1) / numThreads);
+
+			const size_t numBlocks = ((height + rowsPerThread - 1) / rowsPerThread);
+
+			detail::ParallelFor(numBlocks, numThreads, [=, &f](const size_t blockIndex, size_t)
+			{
+				const size_t y = (blockIndex * rowsPerThread);
+
+				f(pData + (width * y), pData + (width * std::min(y + rowsPerThread, height)));
+			});
+		}
+
+		static void NegatePixels(Color* pDst, const Color* const pDstEnd)
+		{
+			const __m128i mask = _mm_set1_epi32(0x00FFffFF);
+
+			for (; (pDstEnd - pDst) >= 4; pDst += 4)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_xor_si128(v, mask));
+			}
+
+			for (; pDst != pDstEnd; ++pDst)
+			{
+				*pDst = ~*pDst;
+			}
+		}
+
+		static void SwapRBPixels(Color* pDst, const Color* const pDstEnd)
+		{
+			const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			for (; (pDstEnd - pDst) >= 4; pDst += 4)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_shuffle_epi8(v, shuffle));
+			}
+
+			for (; pDst != pDstEnd; ++pDst)
+			{
+				const uint32 t = pDst->r;
+				pDst->r = pDst->b;
+				pDst->b = t;
+			}
+		}
+
+		// OaZ RGB  level ZiAt@͕ύXȂj
+		static void BrightenPixels(const int32 level, Color* pDst, const Color* const pDstEnd)
+		{
+			if (level == 0)
+			{
+				return;
+			}
+
+			const uint32 l = static_cast<uint32>(std::min(std::abs(level), 255));
+			const __m128i delta = _mm_set1_epi32(static_cast<int32>(l | (l << 8) | (l << 16)));
+
+			if (level > 0)
+			{
+				for (; (pDstEnd - pDst) >= 4; pDst += 4)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_adds_epu8(v, delta));
+				}
+
+				for (; pDst != pDstEnd; ++pDst)
+				{
+					pDst->r = static_cast<uint8>(std::min(static_cast<int32>(pDst->r) + level, 255));
+					pDst->g = static_cast<uint8>(std::min(static_cast<int32>(pDst->g) + level, 255));
+					pDst->b = static_cast<uint8>(std::min(static_cast<int32>(pDst->b) + level, 255));
+				}
+			}
+			else
+			{
+				for (; (pDstEnd - pDst) >= 4; pDst += 4)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_subs_epu8(v, delta));
+				}
+
+				for (; pDst != pDstEnd; ++pDst)
+				{
+					pDst->r = static_cast<uint8>(std::max(static_cast<int32>(pDst->r) + level, 0));
+					pDst->g = static_cast<uint8>(std::max(static_cast<int32>(pDst->g) + level, 0));
+					pDst->b = static_cast<uint8>(std::max(static_cast<int32>(pDst->b) + level, 0));
+				}
+			}
+		}
+
+		static void ApplyColorTable(const uint8 (&table)[256], Color* pDst, const Color* const pDstEnd)
+		{
+			for (; pDst != pDstEnd; ++pDst)
+			{
+				pDst->r = table[pDst->r];
+				pDst->g = table[pDst->g];
+				pDst->b = table[pDst->b];
+			}
+		}
+
+		// Color::grayscale0_255() ƓʂAZe[uQƂɒuċ߂
+		class GrayscaleTable
+		{
+		private:
+
+			double m_r[256], m_g[256], m_b[256];
+
+		public:
+
+			GrayscaleTable()
+			{
+				for (size_t i = 0; i < 256; ++i)
+				{
+					m_r[i] = 0.299 * i;
+					m_g[i] = 0.587 * i;
+					m_b[i] = 0.114 * i;
+				}
+			}
+
+			void apply(Color* pDst, const Color* const pDstEnd) const
+			{
+				for (; pDst != pDstEnd; ++pDst)
+				{
+					pDst->r = pDst->g = pDst->b = static_cast<uint8>(m_r[pDst->r] + m_g[pDst->g] + m_b[pDst->b]);
+				}
+			}
+		};
+
+		static void ThresholdPixels(const double thresholdF, const uint32 a, const uint32 b, Color* pDst, const Color* const pDstEnd)
+		{
+			for (; pDst != pDstEnd; ++pDst)
+			{
+				*static_cast<uint32*>(static_cast<void*>(pDst)) = (thresholdF < pDst->grayscale() ? a : b) | (pDst->a << 24);
+			}
+		}
+
 		static Color GetAverage(const Image & src, const Rect & rect)
 		{
 			const int32 count = rect.area();
@@ -668,23 +826,39 @@ namespace s3d
 		return clipped((m_width - size) / 2, (m_height - size) / 2, size, size);
 	}
 
-	Image& Image::forEach(std::function<void(Color&)> function)
+	void Image::parallelForEachRowBlock(size_t numThreads, void(*f)(void*, Color*, Color*), void* context)
 	{
-		for (auto& pixel : m_data)
+		const size_t width = m_width;
+		const size_t height = m_height;
+
+		numThreads = std::clamp<size_t>(numThreads, 1, height);
+
+		const size_t rowsPerThread = ((height + numThreads - 1) / numThreads);
+		const size_t numBlocks = ((height + rowsPerThread - 1) / rowsPerThread);
+
+		Color* const pData = m_data.data();
+
+		detail::ParallelFor(numBlocks, numThreads, [=](const size_t blockIndex, size_t)
 		{
-			function(pixel);
-		}
+			const size_t y = (blockIndex * rowsPerThread);
 
-		return *this;
+			f(context, pData + (width * y), pData + (width * std::min(y + rowsPerThread, height)));
+		});
 	}
 
 	Image& Image::swapRB()
 	{
-		for (auto& pixel : m_data)
+		// 1. p[^`FbN
 		{
-			const uint32 t = pixel.r;
-			pixel.r = pixel.b;
-			pixel.b = t;
+			if (isEmpty())
+			{
+				return *this;
+			}
+		}
+
+		// 2. 
+		{
+			detail::ForEachRowBlock(*this, detail::SwapRBPixels);
 		}
 
 		return *this;
@@ -809,6 +983,14 @@ namespace s3d
 		return Siv3DEngine::Get<ISiv3DImageFormat>()->save(*this, format, path);
 	}
 
+	ConcurrentTask<bool> Image::saveAsync(const FilePath& path, const ImageFormat format) const
+	{
+		return CreateConcurrentTask([image = *this, path, format]()
+		{
+			return image.save(path, format);
+		});
+	}
+
 	bool Image::saveWithDialog() const
 	{
 		if (isEmpty())
@@ -999,10 +1181,7 @@ namespace s3d
 
 		// 2. 
 		{
-			for (auto& pixel : m_data)
-			{
-				pixel = ~pixel;
-			}
+			detail::ForEachRowBlock(*this, detail::NegatePixels);
 		}
 
 		return *this;
@@ -1020,10 +1199,7 @@ namespace s3d
 
 		Image image(*this);
 
-		for (auto& pixel : image)
-		{
-			pixel = ~pixel;
-		}
+		detail::ForEachRowBlock(image, detail::NegatePixels);
 
 		return image;
 	}
@@ -1040,10 +1216,12 @@ namespace s3d
 
 		// 2. 
 		{
-			for (auto& pixel : m_data)
+			const detail::GrayscaleTable table;
+
+			detail::ForEachRowBlock(*this, [&table](Color* pDst, const Color* const pDstEnd)
 			{
-				pixel.r = pixel.g = pixel.b = pixel.grayscale0_255();
-			}
+				table.apply(pDst, pDstEnd);
+			});
 		}
 
 		return *this;
@@ -1061,10 +1239,12 @@ namespace s3d
 
 		Image image(*this);
 
-		for (auto& pixel : image)
+		const detail::GrayscaleTable table;
+
+		detail::ForEachRowBlock(image, [&table](Color* pDst, const Color* const pDstEnd)
 		{
-			pixel.r = pixel.g = pixel.b = pixel.grayscale0_255();
-		}
+			table.apply(pDst, pDstEnd);
+		});
 
 		return image;
 	}
@@ -1086,10 +1266,13 @@ namespace s3d
 			const double levg = 0.274 * levn;
 			const double levb = -1.108 * levn;
 
-			for (auto& pixel : m_data)
+			detail::ForEachRowBlock(*this, [=](Color* pDst, const Color* const pDstEnd)
 			{
-				detail::MakeSepia(levr, levg, levb, pixel);
-			}
+				for (; pDst != pDstEnd; ++pDst)
+				{
+					detail::MakeSepia(levr, levg, levb, *pDst);
+				}
+			});
 		}
 
 		return *this;
@@ -1112,10 +1295,13 @@ namespace s3d
 		const double levg = 0.274 * levn;
 		const double levb = -1.108 * levn;
 
-		for (auto& pixel : image)
+		detail::ForEachRowBlock(image, [=](Color* pDst, const Color* const pDstEnd)
 		{
-			detail::MakeSepia(levr, levg, levb, pixel);
-		}
+			for (; pDst != pDstEnd; ++pDst)
+			{
+				detail::MakeSepia(levr, levg, levb, *pDst);
+			}
+		});
 
 		return image;
 	}
@@ -1136,12 +1322,10 @@ namespace s3d
 
 			detail::SetupPostarizeTable(level, colorTable);
 
-			for (auto& pixel : m_data)
+			detail::ForEachRowBlock(*this, [&colorTable](Color* pDst, const Color* const pDstEnd)
 			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
+				detail::ApplyColorTable(colorTable, pDst, pDstEnd);
+			});
 		}
 
 		return *this;
@@ -1163,12 +1347,10 @@ namespace s3d
 
 		detail::SetupPostarizeTable(level, colorTable);
 
-		for (auto& pixel : image)
+		detail::ForEachRowBlock(image, [&colorTable](Color* pDst, const Color* const pDstEnd)
 		{
-			pixel.r = colorTable[pixel.r];
-			pixel.g = colorTable[pixel.g];
-			pixel.b = colorTable[pixel.b];
-		}
+			detail::ApplyColorTable(colorTable, pDst, pDstEnd);
+		});
 
 		return image;
 	}
@@ -1185,24 +1367,10 @@ namespace s3d
 
 		// 2. 
 		{
-			if (level < 0)
-			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = std::max(static_cast<int32>(pixel.r) + level, 0);
-					pixel.g = std::max(static_cast<int32>(pixel.g) + level, 0);
-					pixel.b = std::max(static_cast<int32>(pixel.b) + level, 0);
-				}
-			}
-			else if (level > 0)
+			detail::ForEachRowBlock(*this, [=](Color* pDst, const Color* const pDstEnd)
 			{
-				for (auto& pixel : m_data)
-				{
-					pixel.r = std::min(static_cast<int32>(pixel.r) + level, 255);
-					pixel.g = std::min(static_cast<int32>(pixel.g) + level, 255);
-					pixel.b = std::min(static_cast<int32>(pixel.b) + level, 255);
-				}
-			}
+				detail::BrightenPixels(level, pDst, pDstEnd);
+			});
 		}
 
 		return *this;
@@ -1220,24 +1388,10 @@ namespace s3d
 
 		Image image(*this);
 
-		if (level < 0)
-		{
-			for (auto& pixel : image)
-			{
-				pixel.r = std::max(static_cast<int32>(pixel.r) + level, 0);
-				pixel.g = std::max(static_cast<int32>(pixel.g) + level, 0);
-				pixel.b = std::max(static_cast<int32>(pixel.b) + level, 0);
-			}
-		}
-		else if (level > 0)
+		detail::ForEachRowBlock(image, [=](Color* pDst, const Color* const pDstEnd)
 		{
-			for (auto& pixel : image)
-			{
-				pixel.r = std::min(static_cast<int32>(pixel.r) + level, 255);
-				pixel.g = std::min(static_cast<int32>(pixel.g) + level, 255);
-				pixel.b = std::min(static_cast<int32>(pixel.b) + level, 255);
-			}
-		}
+			detail::BrightenPixels(level, pDst, pDstEnd);
+		});
 
 		return image;
 	}
@@ -1518,12 +1672,10 @@ namespace s3d
 
 			detail::SetupGammmaTable(gamma, colorTable);
 
-			for (auto& pixel : m_data)
+			detail::ForEachRowBlock(*this, [&colorTable](Color* pDst, const Color* const pDstEnd)
 			{
-				pixel.r = colorTable[pixel.r];
-				pixel.g = colorTable[pixel.g];
-				pixel.b = colorTable[pixel.b];
-			}
+				detail::ApplyColorTable(colorTable, pDst, pDstEnd);
+			});
 		}
 
 		return *this;
@@ -1545,12 +1697,10 @@ namespace s3d
 
 		detail::SetupGammmaTable(gamma, colorTable);
 
-		for (auto& pixel : image)
+		detail::ForEachRowBlock(image, [&colorTable](Color* pDst, const Color* const pDstEnd)
 		{
-			pixel.r = colorTable[pixel.r];
-			pixel.g = colorTable[pixel.g];
-			pixel.b = colorTable[pixel.b];
-		}
+			detail::ApplyColorTable(colorTable, pDst, pDstEnd);
+		});
 
 		return image;
 	}
@@ -1569,18 +1719,12 @@ namespace s3d
 		{
 			const uint32 a = inverse ? 0 : 0x00FFffFF, b = inverse ? 0x00FFffFF : 0;
 
-			Color* pDst = data();
-
-			const Color* pDstEnd = pDst + num_pixels();
-
 			const double thresholdF = threshold / 255.0;
 
-			while (pDst != pDstEnd)
+			detail::ForEachRowBlock(*this, [=](Color* pDst, const Color* const pDstEnd)
 			{
-				*static_cast<uint32*>(static_cast<void*>(pDst)) = (thresholdF < pDst->grayscale() ? a : b) | (pDst->a << 24);
-
-				++pDst;
-			}
+				detail::ThresholdPixels(thresholdF, a, b, pDst, pDstEnd);
+			});
 		}
 
 		return *this;
@@ -1598,20 +1742,14 @@ namespace s3d
 
 		Image image(*this);
 
-		const unsigned a = inverse ? 0 : 0x00FFffFF, b = inverse ? 0x00FFffFF : 0;
-
-		Color* pDst = image.data();
-
-		const Color* pDstEnd = pDst + num_pixels();
+		const uint32 a = inverse ? 0 : 0x00FFffFF, b = inverse ? 0x00FFffFF : 0;
 
 		const double thresholdF = threshold / 255.0;
 
-		while (pDst != pDstEnd)
+		detail::ForEachRowBlock(image, [=](Color* pDst, const Color* const pDstEnd)
 		{
-			*static_cast<uint32*>(static_cast<void*>(pDst)) = (thresholdF < pDst->grayscale() ? a : b) | (pDst->a << 24);
-
-			++pDst;
-		}
+			detail::ThresholdPixels(thresholdF, a, b, pDst, pDstEnd);
+		});
 
 		return image;
 	}
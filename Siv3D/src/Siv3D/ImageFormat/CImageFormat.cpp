@@ -113,6 +113,20 @@ namespace s3d
 		return (*it)->decode(reader);
 	}
 
+	Image CImageFormat::load(const FilePath& path, const Size& targetSize) const
+	{
+		BinaryReader reader(path);
+
+		const auto it = findFormat(reader, path);
+
+		if (it == m_imageFormats.end())
+		{
+			return Image();
+		}
+
+		return (*it)->decodeReduced(reader, targetSize);
+	}
+
 	Image CImageFormat::decode(IReader&& reader, ImageFormat format) const
 	{
 		if (format == ImageFormat::Unknown)
@@ -42,6 +42,8 @@ namespace s3d
 
 		Image load(const FilePath& path) const override;
 
+		Image load(const FilePath& path, const Size& targetSize) const override;
+
 		Image decode(IReader&& reader, ImageFormat format) const override;
 
 		bool save(const Image& image, ImageFormat format, const FilePath& path) const override;
@@ -13,9 +13,33 @@
 # include <Siv3D/Fwd.hpp>
 # include <Siv3D/String.hpp>
 # include <Siv3D/ImageFormat.hpp>
+# include <Siv3D/PointVector.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		// targetSize に fitted() した結果より小さくならない範囲で、最大の縮小率 (2 の累乗) を返す
+		[[nodiscard]] inline uint32 GetReductionFactor(const Size& imageSize, const Size& targetSize, const uint32 maxFactor) noexcept
+		{
+			if ((imageSize.x <= 0) || (imageSize.y <= 0) || (targetSize.x <= 0) || (targetSize.y <= 0))
+			{
+				return 1;
+			}
+
+			const double ratio = Max(static_cast<double>(imageSize.x) / targetSize.x, static_cast<double>(imageSize.y) / targetSize.y);
+
+			uint32 factor = 1;
+
+			while (((factor * 2) <= maxFactor) && ((factor * 2) <= ratio))
+			{
+				factor *= 2;
+			}
+
+			return factor;
+		}
+	}
+
 	class ISiv3DImageFormat
 	{
 	public:
@@ -34,6 +58,8 @@ namespace s3d
 
 		virtual Image load(const FilePath& path) const = 0;
 
+		virtual Image load(const FilePath& path, const Size& targetSize) const = 0;
+
 		virtual Image decode(IReader&& reader, ImageFormat format) const = 0;
 
 		virtual bool save(const Image& image, ImageFormat format, const FilePath& path) const = 0;
@@ -20,6 +20,7 @@
 # include <Siv3D/IWriter.hpp>
 # include <Siv3D/BinaryWriter.hpp>
 # include "ImageFormat_JPEG.hpp"
+# include "../IImageFormat.hpp"
 
 namespace s3d
 {
@@ -108,6 +109,11 @@ namespace s3d
 	}
 
 	Image ImageFormat_JPEG::decode(IReader& reader) const
+	{
+		return decodeReduced(reader, Size(0, 0));
+	}
+
+	Image ImageFormat_JPEG::decodeReduced(IReader& reader, const Size& targetSize) const
 	{
 		const int64 size = reader.size();
 		
@@ -121,7 +127,10 @@ namespace s3d
 
 		::tjDecompressHeader(tj, buffer, static_cast<unsigned long>(size), &width, &height);
 
-		Image image(width, height);
+		// libjpeg-turbo は 1/2, 1/4, 1/8 の DCT スケーリングに常に対応している
+		const tjscalingfactor scalingFactor = { 1, static_cast<int>(detail::GetReductionFactor(Size(width, height), targetSize, 8)) };
+
+		Image image(TJSCALED(width, scalingFactor), TJSCALED(height, scalingFactor));
 
 		::tjDecompress(
 			tj,
@@ -171,7 +180,7 @@ namespace s3d
 			&retJPEGsize,
 			TJ_420,
 			quality,
-			0
+			TJFLAG_FASTDCT
 		);
 
 		::tjDestroy(tj);
@@ -29,6 +29,8 @@ namespace s3d
 
 		Image decode(IReader& reader) const override;
 
+		Image decodeReduced(IReader& reader, const Size& targetSize) const override;
+
 		bool encode(const Image& image, IWriter& writer) const override;
 
 		bool encode(const Image& image, IWriter& writer, int32 quality) const;
@@ -16,10 +16,21 @@
 # include <libpng/png.h>
 # endif
 
+// zlib のヘッダが利用できる環境では、大きな画像の IDAT を複数スレッドで圧縮する
+# if __has_include(<zlib.h>)
+# include <zlib.h>
+# define SIV3D_PNG_PARALLEL_DEFLATE 1
+# else
+# define SIV3D_PNG_PARALLEL_DEFLATE 0
+# endif
+
 # include <Siv3D/IReader.hpp>
 # include <Siv3D/IWriter.hpp>
 # include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Threading/WorkerPool.hpp>
 # include "ImageFormat_PNG.hpp"
+# include "../IImageFormat.hpp"
 
 namespace s3d
 {
@@ -37,6 +48,364 @@ namespace s3d
 		writer->write(buf, length);
 	}
 
+	namespace detail
+	{
+		// libpng には縮小デコードが無いため、行を受け取りながら factor x factor ピクセルの平均で縮小する
+		class RowReducer
+		{
+		private:
+
+			Image& m_dst;
+
+			uint32 m_srcWidth = 0;
+
+			uint32 m_factor = 1;
+
+			Array<uint32> m_sums;
+
+			uint32 m_rows = 0;
+
+			uint32 m_dstY = 0;
+
+		public:
+
+			RowReducer(Image& dst, const uint32 srcWidth, const uint32 factor)
+				: m_dst(dst)
+				, m_srcWidth(srcWidth)
+				, m_factor(factor)
+				, m_sums(dst.width() * 4) {}
+
+			void addRow(const uint8* row)
+			{
+				for (uint32 x = 0; x < m_srcWidth; ++x)
+				{
+					uint32* sum = &m_sums[(x / m_factor) * 4];
+
+					sum[0] += row[0];
+					sum[1] += row[1];
+					sum[2] += row[2];
+					sum[3] += row[3];
+
+					row += 4;
+				}
+
+				if (++m_rows == m_factor)
+				{
+					flush();
+				}
+			}
+
+			void flush()
+			{
+				if ((m_rows == 0) || (static_cast<uint32>(m_dst.height()) <= m_dstY))
+				{
+					return;
+				}
+
+				uint8* dst = m_dst.dataAsUint8() + static_cast<size_t>(m_dst.stride()) * m_dstY;
+
+				const uint32 dstWidth = static_cast<uint32>(m_dst.width());
+
+				for (uint32 x = 0; x < dstWidth; ++x)
+				{
+					const uint32 columns = Min(m_factor, m_srcWidth - (x * m_factor));
+					const uint32 count = (columns * m_rows);
+					uint32* sum = &m_sums[x * 4];
+
+					for (uint32 i = 0; i < 4; ++i)
+					{
+						dst[i] = static_cast<uint8>((sum[i] + count / 2) / count);
+						sum[i] = 0;
+					}
+
+					dst += 4;
+				}
+
+				m_rows = 0;
+				++m_dstY;
+			}
+		};
+	}
+
+# if SIV3D_PNG_PARALLEL_DEFLATE
+
+	namespace detail
+	{
+		// この画素数以上の画像を並列に圧縮する
+		constexpr uint32 ParallelDeflateMinPixels = (512 * 512);
+
+		// 1 ブロックあたりのフィルタ適用後のバイト数の目安
+		constexpr size_t DeflateBlockSize = (256 * 1024);
+
+		// deflate のスライド窓の大きさ
+		constexpr size_t DeflateWindowSize = (32 * 1024);
+
+		constexpr uint8 PNGSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+		struct DeflateBlock
+		{
+			Array<uint8> compressed;
+
+			uLong adler = 0;
+
+			size_t rawSize = 0;
+
+			bool succeeded = false;
+		};
+
+		static void StoreUint32BE(uint8* dst, const uint32 value) noexcept
+		{
+			dst[0] = static_cast<uint8>(value >> 24);
+			dst[1] = static_cast<uint8>(value >> 16);
+			dst[2] = static_cast<uint8>(value >> 8);
+			dst[3] = static_cast<uint8>(value);
+		}
+
+		static void WriteChunk(IWriter& writer, const char* type, const uint8* data, const size_t size)
+		{
+			uint8 header[8];
+			StoreUint32BE(header, static_cast<uint32>(size));
+			std::memcpy(header + 4, type, 4);
+
+			uLong crc = ::crc32(0, header + 4, 4);
+
+			if (size)
+			{
+				crc = ::crc32(crc, data, static_cast<uInt>(size));
+			}
+
+			uint8 footer[4];
+			StoreUint32BE(footer, static_cast<uint32>(crc));
+
+			writer.write(header, sizeof(header));
+
+			if (size)
+			{
+				writer.write(data, size);
+			}
+
+			writer.write(footer, sizeof(footer));
+		}
+
+		[[nodiscard]] static uint8 PaethPredictor(const int32 a, const int32 b, const int32 c) noexcept
+		{
+			const int32 p = (a + b - c);
+			const int32 pa = std::abs(p - a);
+			const int32 pb = std::abs(p - b);
+			const int32 pc = std::abs(p - c);
+
+			if ((pa <= pb) && (pa <= pc))
+			{
+				return static_cast<uint8>(a);
+			}
+			else if (pb <= pc)
+			{
+				return static_cast<uint8>(b);
+			}
+
+			return static_cast<uint8>(c);
+		}
+
+		// RGBA 8bit の 1 行にフィルタを適用する。prev が nullptr の場合は先頭行として扱う
+		static void ApplyFilter(const uint8 type, const uint8* row, const uint8* prev, const size_t rowSize, uint8* dst) noexcept
+		{
+			for (size_t i = 0; i < rowSize; ++i)
+			{
+				const int32 a = (4 <= i) ? row[i - 4] : 0;
+				const int32 b = prev ? prev[i] : 0;
+				const int32 c = (prev && (4 <= i)) ? prev[i - 4] : 0;
+
+				switch (type)
+				{
+				case 1:
+					dst[i] = static_cast<uint8>(row[i] - a);
+					break;
+				case 2:
+					dst[i] = static_cast<uint8>(row[i] - b);
+					break;
+				case 3:
+					dst[i] = static_cast<uint8>(row[i] - ((a + b) / 2));
+					break;
+				case 4:
+					dst[i] = static_cast<uint8>(row[i] - PaethPredictor(a, b, c));
+					break;
+				default:
+					dst[i] = row[i];
+					break;
+				}
+			}
+		}
+
+		[[nodiscard]] static uint64 FilterScore(const uint8* data, const size_t size) noexcept
+		{
+			uint64 score = 0;
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				score += (data[i] < 128) ? data[i] : (256 - data[i]);
+			}
+
+			return score;
+		}
+
+		// 1 行にフィルタを適用して dst に書き込む。複数のフィルタが許可されている場合は、libpng と同じく差分の絶対値の和が最小のものを選ぶ
+		static void FilterRow(const uint8* row, const uint8* prev, const size_t rowSize, const uint32 filterFlag, uint8* dst, Array<uint8>& work)
+		{
+			constexpr uint32 flags[5] = { PNGFilter::None, PNGFilter::Sub, PNGFilter::Up, PNGFilter::Avg, PNGFilter::Paeth };
+
+			uint8 candidates[5];
+			size_t num_candidates = 0;
+
+			for (uint8 type = 0; type < 5; ++type)
+			{
+				if (filterFlag & flags[type])
+				{
+					candidates[num_candidates++] = type;
+				}
+			}
+
+			if (num_candidates <= 1)
+			{
+				dst[0] = num_candidates ? candidates[0] : 0;
+				ApplyFilter(dst[0], row, prev, rowSize, dst + 1);
+				return;
+			}
+
+			uint64 bestScore = Largest<uint64>;
+
+			for (size_t i = 0; i < num_candidates; ++i)
+			{
+				ApplyFilter(candidates[i], row, prev, rowSize, work.data());
+
+				if (const uint64 score = FilterScore(work.data(), rowSize); score < bestScore)
+				{
+					bestScore = score;
+					dst[0] = candidates[i];
+					std::memcpy(dst + 1, work.data(), rowSize);
+				}
+			}
+		}
+
+		// [beginY, endY) の行を raw deflate で圧縮する。最後のブロック以外は Z_SYNC_FLUSH でバイト境界に揃え、連結できるようにする
+		static void CompressBlock(const Image& image, const uint32 beginY, const uint32 endY, const uint32 filterFlag, const bool last, DeflateBlock& block)
+		{
+			const size_t rowSize = (image.width() * sizeof(Color));
+			const size_t filteredRowSize = (rowSize + 1);
+
+			// 直前のブロックの末尾 32KiB を辞書として与え、分割による圧縮率の低下を抑える
+			const uint32 dictionaryRows = Min(beginY, static_cast<uint32>((DeflateWindowSize + filteredRowSize - 1) / filteredRowSize));
+			const uint32 firstY = (beginY - dictionaryRows);
+			const size_t dictionaryBytes = (filteredRowSize * dictionaryRows);
+
+			Array<uint8> filtered(filteredRowSize * (endY - firstY));
+			Array<uint8> work(rowSize);
+
+			for (uint32 y = firstY; y < endY; ++y)
+			{
+				const uint8* row = image.dataAsUint8() + static_cast<size_t>(image.stride()) * y;
+				const uint8* prev = y ? (row - image.stride()) : nullptr;
+
+				FilterRow(row, prev, rowSize, filterFlag, filtered.data() + filteredRowSize * (y - firstY), work);
+			}
+
+			const uint8* pSrc = filtered.data() + dictionaryBytes;
+			block.rawSize = (filtered.size() - dictionaryBytes);
+			block.adler = ::adler32(::adler32(0, nullptr, 0), pSrc, static_cast<uInt>(block.rawSize));
+
+			z_stream stream = {};
+
+			const int strategy = (filterFlag == PNGFilter::None) ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+
+			if (::deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, strategy) != Z_OK)
+			{
+				return;
+			}
+
+			if (dictionaryBytes)
+			{
+				const size_t size = Min(dictionaryBytes, DeflateWindowSize);
+
+				::deflateSetDictionary(&stream, pSrc - size, static_cast<uInt>(size));
+			}
+
+			// Z_SYNC_FLUSH の空ブロックの分だけ余裕を持たせる
+			block.compressed.resize(::deflateBound(&stream, static_cast<uLong>(block.rawSize)) + 16);
+
+			stream.next_in = const_cast<Bytef*>(pSrc);
+			stream.avail_in = static_cast<uInt>(block.rawSize);
+			stream.next_out = block.compressed.data();
+			stream.avail_out = static_cast<uInt>(block.compressed.size());
+
+			const int result = ::deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+
+			block.succeeded = last ? (result == Z_STREAM_END) : ((result == Z_OK) && (stream.avail_in == 0));
+			block.compressed.resize(stream.total_out);
+
+			::deflateEnd(&stream);
+		}
+
+		static bool EncodeParallel(const Image& image, IWriter& writer, const uint32 filterFlag)
+		{
+			const uint32 width = image.width();
+			const uint32 height = image.height();
+			const size_t filteredRowSize = (width * sizeof(Color) + 1);
+			const uint32 rowsPerBlock = static_cast<uint32>(Max<size_t>(DeflateBlockSize / filteredRowSize, 1));
+			const size_t num_blocks = ((height + rowsPerBlock - 1) / rowsPerBlock);
+
+			Array<DeflateBlock> blocks(num_blocks);
+
+			detail::ParallelFor(num_blocks, Threading::GetConcurrency(), [&](const size_t blockIndex, size_t)
+			{
+				const uint32 beginY = static_cast<uint32>(blockIndex * rowsPerBlock);
+				const uint32 endY = Min(beginY + rowsPerBlock, height);
+
+				CompressBlock(image, beginY, endY, filterFlag, (blockIndex + 1) == num_blocks, blocks[blockIndex]);
+			});
+
+			uLong adler = ::adler32(0, nullptr, 0);
+
+			for (const auto& block : blocks)
+			{
+				if (!block.succeeded)
+				{
+					return false;
+				}
+
+				adler = ::adler32_combine(adler, block.adler, static_cast<z_off_t>(block.rawSize));
+			}
+
+			// zlib ヘッダ (deflate, 32KiB 窓, 既定の圧縮レベル) と Adler-32 を前後に付けて 1 つの zlib ストリームにする
+			blocks.front().compressed.insert(blocks.front().compressed.begin(), { 0x78, 0x9C });
+
+			uint8 trailer[4];
+			StoreUint32BE(trailer, static_cast<uint32>(adler));
+			blocks.back().compressed.insert(blocks.back().compressed.end(), std::begin(trailer), std::end(trailer));
+
+			writer.write(PNGSignature, sizeof(PNGSignature));
+
+			uint8 ihdr[13];
+			StoreUint32BE(ihdr, width);
+			StoreUint32BE(ihdr + 4, height);
+			ihdr[8] = 8;	// ビット深度
+			ihdr[9] = 6;	// RGBA
+			ihdr[10] = 0;	// deflate
+			ihdr[11] = 0;	// 適応フィルタ
+			ihdr[12] = 0;	// インタレースなし
+			WriteChunk(writer, "IHDR", ihdr, sizeof(ihdr));
+
+			for (const auto& block : blocks)
+			{
+				WriteChunk(writer, "IDAT", block.compressed.data(), block.compressed.size());
+			}
+
+			WriteChunk(writer, "IEND", nullptr, 0);
+
+			return true;
+		}
+	}
+
+# endif
+
 	ImageFormat ImageFormat_PNG::format() const
 	{
 		return ImageFormat::PNG;
@@ -77,6 +446,11 @@ namespace s3d
 	}
 
 	Image ImageFormat_PNG::decode(IReader& reader) const
+	{
+		return decodeReduced(reader, Size(0, 0));
+	}
+
+	Image ImageFormat_PNG::decodeReduced(IReader& reader, const Size& targetSize) const
 	{
 		Image image;
 
@@ -149,20 +523,60 @@ namespace s3d
 
 		const int nChannels = ::png_get_channels(png_ptr, info_ptr);
 
-		::png_get_IHDR(png_ptr, info_ptr, &width, &height, &iBitDepth, &iColorType, nullptr, nullptr, nullptr);
-
-		image.resize(width, height);
+		int iInterlaceType;
 
-		uint8* pixels = image.dataAsUint8();
+		::png_get_IHDR(png_ptr, info_ptr, &width, &height, &iBitDepth, &iColorType, &iInterlaceType, nullptr, nullptr);
 
-		Array<uint8*> ppbRowPointers(height);
+		const uint32 factor = detail::GetReductionFactor(Size(width, height), targetSize, 32);
 
-		for (size_t i = 0; i < height; ++i)
+		if ((factor == 1) || (iInterlaceType != PNG_INTERLACE_NONE))
 		{
-			ppbRowPointers[i] = pixels + i * width * nChannels;
+			image.resize(width, height);
+
+			uint8* pixels = image.dataAsUint8();
+
+			Array<uint8*> ppbRowPointers(height);
+
+			for (size_t i = 0; i < height; ++i)
+			{
+				ppbRowPointers[i] = pixels + i * width * nChannels;
+			}
+
+			::png_read_image(png_ptr, ppbRowPointers.data());
+
+			// インタレース PNG は行単位で読めないため、原寸でデコードしてから縮小する
+			if (factor != 1)
+			{
+				Image reduced((width + factor - 1) / factor, (height + factor - 1) / factor);
+				detail::RowReducer reducer(reduced, width, factor);
+
+				for (size_t i = 0; i < height; ++i)
+				{
+					reducer.addRow(ppbRowPointers[i]);
+				}
+
+				reducer.flush();
+
+				image = std::move(reduced);
+			}
 		}
+		else
+		{
+			image.resize((width + factor - 1) / factor, (height + factor - 1) / factor);
+
+			detail::RowReducer reducer(image, width, factor);
+
+			Array<uint8> row(width * nChannels);
+
+			for (size_t i = 0; i < height; ++i)
+			{
+				::png_read_row(png_ptr, row.data(), nullptr);
 
-		::png_read_image(png_ptr, ppbRowPointers.data());
+				reducer.addRow(row.data());
+			}
+
+			reducer.flush();
+		}
 
 		::png_read_end(png_ptr, nullptr);
 
@@ -183,6 +597,15 @@ namespace s3d
 			return false;
 		}
 
+	# if SIV3D_PNG_PARALLEL_DEFLATE
+
+		if ((detail::ParallelDeflateMinPixels <= image.num_pixels()) && (1 < Threading::GetConcurrency()))
+		{
+			return detail::EncodeParallel(image, writer, filterFlag);
+		}
+
+	# endif
+
 		png_structp png_ptr = ::png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 
 		if (!png_ptr)
@@ -11,12 +11,19 @@
 
 # include <Siv3DEngine.hpp>
 # include <Siv3D/ImageFormat.hpp>
+# include <Siv3D/Image.hpp>
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/PointVector.hpp>
+# include <Threading/WorkerPool.hpp>
 # include "IImageFormat.hpp"
 
 namespace s3d
 {
+	Image IImageFormat::decodeReduced(IReader& reader, const Size&) const
+	{
+		return decode(reader);
+	}
+
 	namespace ImageProcessing
 	{
 		ImageFormat GetFormat(const FilePath& path)
@@ -43,5 +50,30 @@ namespace s3d
 		{
 			return Siv3DEngine::Get<ISiv3DImageFormat>()->getSize(reader, String());
 		}
+
+		Image LoadReduced(const FilePath& path, const Size& targetSize)
+		{
+			return Siv3DEngine::Get<ISiv3DImageFormat>()->load(path, targetSize);
+		}
+
+		Array<Image> LoadImages(const Array<FilePath>& paths, const Size& targetSize, const size_t numThreads)
+		{
+			Array<Image> images(paths.size());
+
+			if (paths.isEmpty())
+			{
+				return images;
+			}
+
+			const ISiv3DImageFormat* const imageFormat = Siv3DEngine::Get<ISiv3DImageFormat>();
+
+			// 呼び出し元のスレッドも読み込みに参加する
+			detail::ParallelFor(paths.size(), numThreads, [&](const size_t i, size_t)
+			{
+				images[i] = imageFormat->load(paths[i], targetSize);
+			});
+
+			return images;
+		}
 	}
 }
@@ -16,6 +16,7 @@
 # include <libwebp/decode.h>
 # include <libwebp/encode.h>
 # include "ImageFormat_WebP.hpp"
+# include "../IImageFormat.hpp"
 
 namespace s3d
 {
@@ -100,6 +101,11 @@ namespace s3d
 	}
 
 	Image ImageFormat_WebP::decode(IReader& reader) const
+	{
+		return decodeReduced(reader, Size(0, 0));
+	}
+
+	Image ImageFormat_WebP::decodeReduced(IReader& reader, const Size& targetSize) const
 	{
 		Image image;
 
@@ -128,6 +134,14 @@ namespace s3d
 			return image;
 		}
 
+		// libwebp のリサンプラでデコードと同時に縮小する
+		if (const uint32 factor = detail::GetReductionFactor(Size(bitstream->width, bitstream->height), targetSize, 32); factor != 1)
+		{
+			config.options.use_scaling		= true;
+			config.options.scaled_width		= static_cast<int>((bitstream->width + factor - 1) / factor);
+			config.options.scaled_height	= static_cast<int>((bitstream->height + factor - 1) / factor);
+		}
+
 		if (::WebPDecode(static_cast<const uint8*>(buffer.data()), dataSize, &config) != VP8_STATUS_OK)
 		{
 			return image;
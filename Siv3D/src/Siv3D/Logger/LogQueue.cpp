@@ -0,0 +1,134 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <thread>
+# include "LogQueue.hpp"
+
+namespace s3d
+{
+	LogQueue::LogQueue()
+		: m_cells(std::make_unique<Cell[]>(Capacity))
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	void LogQueue::push(LogRecord&& record)
+	{
+		while (!tryPush(record))
+		{
+			if (m_closed)
+			{
+				return;
+			}
+
+			// 満杯のときは書き込みスレッドを起こして空きを待つ
+			m_cv.notify_one();
+
+			std::this_thread::yield();
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// 書き込みスレッドが待機している場合のみ起こす
+		if (m_waiting.load(std::memory_order_relaxed))
+		{
+			{
+				std::lock_guard lock(m_mutex);
+			}
+
+			m_cv.notify_one();
+		}
+	}
+
+	bool LogQueue::pop(LogRecord& record)
+	{
+		Cell& cell = m_cells[m_dequeuePos & (Capacity - 1)];
+
+		if (cell.sequence.load(std::memory_order_acquire) != (m_dequeuePos + 1))
+		{
+			return false;
+		}
+
+		record = std::move(cell.record);
+
+		cell.sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+
+		++m_dequeuePos;
+
+		return true;
+	}
+
+	void LogQueue::wait(const std::chrono::milliseconds timeout)
+	{
+		std::unique_lock lock(m_mutex);
+
+		m_waiting.store(true, std::memory_order_seq_cst);
+
+		// 待機を通知してから再確認し、直前に追加されたレコードを見逃さないようにする
+		const Cell& cell = m_cells[m_dequeuePos & (Capacity - 1)];
+
+		if ((cell.sequence.load(std::memory_order_seq_cst) != (m_dequeuePos + 1)) && !m_closed)
+		{
+			m_cv.wait_for(lock, timeout);
+		}
+
+		m_waiting.store(false, std::memory_order_relaxed);
+	}
+
+	void LogQueue::close()
+	{
+		m_closed = true;
+
+		m_cv.notify_one();
+	}
+
+	bool LogQueue::isClosed() const noexcept
+	{
+		return m_closed;
+	}
+
+	bool LogQueue::tryPush(LogRecord& record)
+	{
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			Cell& cell = m_cells[pos & (Capacity - 1)];
+
+			const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+			if (diff == 0)
+			{
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell.record = std::move(record);
+
+					cell.sequence.store(pos + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+}
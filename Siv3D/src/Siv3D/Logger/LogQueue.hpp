@@ -0,0 +1,85 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Logger.hpp>
+
+namespace s3d
+{
+	struct LogRecord
+	{
+		int64 timeStamp = 0;
+
+		LogDescription desc = LogDescription::App;
+
+		// 書き込みスレッドで HTML に変換するテキスト
+		String text;
+
+		// writeRawHTML_UTF8() で渡された HTML。空でなければ text の代わりにそのまま書き込む
+		std::string rawHTML;
+	};
+
+	// 複数のスレッドから追加し、1 つの書き込みスレッドが取り出す固定長のキュー
+	class LogQueue
+	{
+	private:
+
+		static constexpr size_t Capacity = 8192;
+
+		struct Cell
+		{
+			std::atomic<size_t> sequence = 0;
+
+			LogRecord record;
+		};
+
+		std::unique_ptr<Cell[]> m_cells;
+
+		alignas(64) std::atomic<size_t> m_enqueuePos = 0;
+
+		alignas(64) size_t m_dequeuePos = 0;
+
+		std::atomic<bool> m_closed = false;
+
+		std::atomic<bool> m_waiting = false;
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_cv;
+
+		bool tryPush(LogRecord& record);
+
+	public:
+
+		LogQueue();
+
+		// キューが満杯の場合は空きができるまで待つ。close() 後は何もしない
+		void push(LogRecord&& record);
+
+		// 書き込みスレッドのみが呼ぶ
+		bool pop(LogRecord& record);
+
+		// 書き込みスレッドのみが呼ぶ。レコードが追加されるか、タイムアウトするまで待つ
+		void wait(std::chrono::milliseconds timeout);
+
+		void close();
+
+		[[nodiscard]] bool isClosed() const noexcept;
+	};
+}
@@ -9,11 +9,111 @@
 //
 //-----------------------------------------------
 
+# include <atomic>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Threading/WorkerPool.hpp>
 # include "NavMeshDetail.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		constexpr int32 NavMeshMaxQueryNodes = 2048;
+
+		constexpr int32 NavMeshMaxPathPolys = 8192;
+
+		constexpr int32 NavMeshMaxPathVertices = 8192;
+
+		// build() と buildTile() で共通の Recast の設定。タイルの大きさと範囲は呼び出し元で設定する
+		[[nodiscard]] static rcConfig MakeRcConfig(const NavMeshConfig& config)
+		{
+			const float cellSize		= static_cast<float>(config.cellSize);
+			const float cellHeight		= static_cast<float>(config.cellHeight);
+			const float agentMaxSlope	= static_cast<float>(config.agentMaxSlope);
+			const float agentHeight		= static_cast<float>(config.agentHeight);
+			const float agentMaxClimb	= static_cast<float>(config.agentMaxClimb);
+			const float agentRadius		= static_cast<float>(config.agentRadius);
+
+			constexpr float edgeMaxLen				= 12.0f;
+			constexpr float detailSampleDist		= 6.0f;
+			constexpr float detailSampleMaxError	= 1.0f;
+			constexpr float regionMinSize			= 8.0f;
+			constexpr float regionMergeSize			= 20.0f;
+
+			rcConfig cfg = {};
+			cfg.cs = cellSize;
+			cfg.ch = cellHeight;
+			cfg.walkableSlopeAngle		= agentMaxSlope;
+			cfg.walkableHeight			= static_cast<int32>(std::ceil(agentHeight / cellHeight));
+			cfg.walkableClimb			= static_cast<int32>(std::floor(agentMaxClimb / cellHeight));
+			cfg.walkableRadius			= static_cast<int32>(std::ceil(agentRadius / cellSize));
+			cfg.maxEdgeLen				= static_cast<int32>(edgeMaxLen / cellSize);
+			cfg.maxSimplificationError	= 1.3f;
+			cfg.minRegionArea			= static_cast<int32>(regionMinSize * regionMinSize);
+			cfg.mergeRegionArea			= static_cast<int32>(regionMergeSize * regionMergeSize);
+			cfg.maxVertsPerPoly			= 6;
+			cfg.detailSampleDist		= (detailSampleDist < 0.9f) ? 0 : cellSize * detailSampleDist;
+			cfg.detailSampleMaxError	= cellHeight * detailSampleMaxError;
+
+			return cfg;
+		}
+
+		[[nodiscard]] static bool ValidateNavMeshInput(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs)
+		{
+			if (vertices.isEmpty() || indices.isEmpty() || areaIDs.isEmpty())
+			{
+				return false;
+			}
+
+			if ((indices.size() / 3) != areaIDs.size())
+			{
+				return false;
+			}
+
+			if (!areaIDs.all(LessThanEqual(RC_WALKABLE_AREA)))
+			{
+				return false;
+			}
+
+			return true;
+		}
+
+		// タイル 1 枚の作成に使う Recast の中間データ
+		struct NavMeshTileBuffers
+		{
+			rcHeightfield* hf = rcAllocHeightfield();
+
+			rcCompactHeightfield* chf = rcAllocCompactHeightfield();
+
+			rcContourSet* cset = rcAllocContourSet();
+
+			rcPolyMesh* mesh = rcAllocPolyMesh();
+
+			rcPolyMeshDetail* dmesh = rcAllocPolyMeshDetail();
+
+			NavMeshTileBuffers() = default;
+
+			NavMeshTileBuffers(const NavMeshTileBuffers&) = delete;
+
+			NavMeshTileBuffers& operator =(const NavMeshTileBuffers&) = delete;
+
+			~NavMeshTileBuffers()
+			{
+				rcFreePolyMeshDetail(dmesh);
+				rcFreePolyMesh(mesh);
+				rcFreeContourSet(cset);
+				rcFreeCompactHeightfield(chf);
+				rcFreeHeightField(hf);
+			}
+
+			[[nodiscard]] bool isValid() const noexcept
+			{
+				return (hf && chf && cset && mesh && dmesh);
+			}
+		};
+	}
+
 	NavMesh::NavMeshDetail::NavMeshDetail()
 	{
 	
@@ -24,46 +124,126 @@ namespace s3d
 		destroy();
 	}
 
-	bool NavMesh::NavMeshDetail::build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config)
+	bool NavMesh::NavMeshDetail::build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config, const size_t numThreads)
 	{
 		m_built = false;
 
-		if (vertices.isEmpty() || indices.isEmpty() || areaIDs.isEmpty())
+		{
+			// 古い dtNavMesh を参照している探索用の作業領域を破棄する
+			std::lock_guard lock(m_queryMutex);
+
+			m_queryContexts.clear();
+		}
+
+		if (!detail::ValidateNavMeshInput(vertices, indices, areaIDs))
 		{
 			return false;
 		}
 
-		if ((indices.size() / 3) != areaIDs.size())
+		m_vertices = vertices;
+
+		m_indices = indices;
+
+		m_areaIDs = areaIDs;
+
+		m_config = config;
+
+		m_tiled = (config.tileSize > 0);
+
+		m_tileCountX = m_tileCountY = 0;
+
+		m_tileHashes.clear();
+
+		for (int32 i = 0; i < 3; ++i)
+		{
+			m_bmin[i] = FLT_MAX;
+			m_bmax[i] = -FLT_MAX;
+		}
+
+		for (const auto& vertex : m_vertices)
+		{
+			updateAABB(vertex);
+		}
+
+		try
+		{
+			if (m_tiled)
+			{
+				m_built = buildTiled(numThreads);
+			}
+			else
+			{
+				build(config);
+			}
+		}
+		catch (...)
 		{
+			m_built = false;
+
 			return false;
 		}
 
-		if (!areaIDs.all(LessThanEqual(RC_WALKABLE_AREA)))
+		return m_built;
+	}
+
+	bool NavMesh::NavMeshDetail::update(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const size_t numThreads)
+	{
+		// タイル分割していない場合と、タイルの配置が変わる場合は全体を作り直す
+		if (!m_built || !m_tiled)
+		{
+			return build(vertices, indices, areaIDs, m_config, numThreads);
+		}
+
+		if (!detail::ValidateNavMeshInput(vertices, indices, areaIDs))
 		{
 			return false;
 		}
 
+		for (const auto& vertex : vertices)
+		{
+			if ((vertex.x < m_bmin[0]) || (vertex.y < m_bmin[1]) || (vertex.z < m_bmin[2])
+				|| (m_bmax[0] < vertex.x) || (m_bmax[1] < vertex.y) || (m_bmax[2] < vertex.z))
+			{
+				return build(vertices, indices, areaIDs, m_config, numThreads);
+			}
+		}
+
+		// AABB はタイルの配置と高さ方向の範囲を決めるので、縮小しても更新しない
 		m_vertices = vertices;
 
 		m_indices = indices;
 
 		m_areaIDs = areaIDs;
 
-		for (const auto& vertex : m_vertices)
+		Array<Array<uint32>> tileTriangles;
+
+		Array<uint64> tileHashes;
+
+		binTriangles(tileTriangles, tileHashes);
+
+		Array<size_t> changedTiles;
+
+		for (size_t i = 0; i < tileHashes.size(); ++i)
 		{
-			updateAABB(vertex);
+			if (tileHashes[i] != m_tileHashes[i])
+			{
+				changedTiles.push_back(i);
+			}
+		}
+
+		if (changedTiles.isEmpty())
+		{
+			return true;
 		}
 
 		try
 		{
-			build(config);
+			return buildTiles(changedTiles, tileTriangles, tileHashes, numThreads);
 		}
 		catch (...)
 		{
 			return false;
 		}
-
-		return true;
 	}
 
 	Array<Vec3> NavMesh::NavMeshDetail::query(const Float3& start, const Float3& end) const
@@ -73,52 +253,116 @@ namespace s3d
 			return{};
 		}
 
-		Float3 extent(2.0f, 4.0f, 2.0f);
+		// 複数のスレッドから呼ばれても安全なように、作業領域は呼び出しごとに作る
+		detail::NavMeshQueryContext context;
+
+		if (!context.query || dtStatusFailed(context.query->init(m_navmesh.get(), detail::NavMeshMaxQueryNodes)))
+		{
+			return{};
+		}
 
-		dtNavMeshQuery navmeshquery;
+		Array<Vec3> vertices;
 
-		if (dtStatusFailed(navmeshquery.init(m_navmesh.get(), 2048)))
+		if (!FindPath(context, start, end, vertices))
 		{
 			return{};
 		}
 
+		return vertices;
+	}
+
+	void NavMesh::NavMeshDetail::query(const Array<std::pair<Vec3, Vec3>>& startEnds, Array<Array<Vec3>>& results, const size_t numThreads) const
+	{
+		// 既存の要素は確保済みのメモリを再利用する
+		results.resize(startEnds.size());
+
+		if (!m_built)
+		{
+			for (auto& result : results)
+			{
+				result.clear();
+			}
+
+			return;
+		}
+
+		if (startEnds.isEmpty())
+		{
+			return;
+		}
+
+		std::lock_guard lock(m_queryMutex);
+
+		const size_t num_workers = Min(Max<size_t>(numThreads, 1), startEnds.size());
+
+		while (m_queryContexts.size() < num_workers)
+		{
+			auto context = std::make_unique<detail::NavMeshQueryContext>();
+
+			if (!context->query || dtStatusFailed(context->query->init(m_navmesh.get(), detail::NavMeshMaxQueryNodes)))
+			{
+				throw std::bad_alloc();
+			}
+
+			m_queryContexts.push_back(std::move(context));
+		}
+
+		detail::ParallelFor(startEnds.size(), num_workers, [&](const size_t index, const size_t workerIndex)
+		{
+			auto& result = results[index];
+
+			if (!FindPath(*m_queryContexts[workerIndex], Float3(startEnds[index].first), Float3(startEnds[index].second), result))
+			{
+				result.clear();
+			}
+		});
+	}
+
+	bool NavMesh::NavMeshDetail::FindPath(detail::NavMeshQueryContext& context, const Float3& start, const Float3& end, Array<Vec3>& path)
+	{
+		dtNavMeshQuery& navmeshquery = *context.query;
+
+		Float3 extent(2.0f, 4.0f, 2.0f);
+
 		dtPolyRef startpoly, endpoly;
 		dtQueryFilter filter;
 
 		if (dtStatusFailed(navmeshquery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
 		{
-			return{};
+			return false;
 		}
 
 		if (dtStatusFailed(navmeshquery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
 		{
-			return{};
+			return false;
 		}
 
 		if (startpoly == 0)
 		{
-			return{};
+			return false;
 		}
 
 		if (endpoly == 0)
 		{
-			return{};
+			return false;
 		}
 
-		constexpr int32 buffersize = 8192;
+		constexpr int32 buffersize = detail::NavMeshMaxPathPolys;
 
 		int32 npolys = 0;
 
-		Array<dtPolyRef> polys(buffersize);
+		Array<dtPolyRef>& polys = context.polys;
+
+		polys.resize(buffersize);
 
 		if (dtStatus status = navmeshquery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, polys.data(), &npolys, buffersize); dtStatusFailed(status))
 		{
-			return{};
+			return false;
 		}
 
 		if (npolys <= 0)
 		{
-			return{};
+			return false;
 		}
 
 		float end2[3] = { end.x, end.y, end.z };
@@ -129,22 +373,24 @@ namespace s3d
 			navmeshquery.closestPointOnPoly(polys[npolys - 1], &end.x, end2, &posOverPoly);
 		}
 
-		constexpr int32 maxvertices = 8192;
+		constexpr int32 maxvertices = detail::NavMeshMaxPathVertices;
 
-		Array<Float3> buffer(maxvertices);
+		Array<Float3>& buffer = context.straightPath;
+
+		buffer.resize(maxvertices);
 
 		int32 nvertices = 0;
 
 		navmeshquery.findStraightPath(&start.x, end2, polys.data(), npolys, &buffer[0].x, 0, 0, &nvertices, maxvertices);
 
-		Array<Vec3> vertices(nvertices);
+		path.resize(nvertices);
 
 		for (int32 i = 0; i < nvertices; ++i)
 		{
-			vertices[i] = buffer[i];
+			path[i] = buffer[i];
 		}
 
-		return vertices;
+		return true;
 	}
 
 	void NavMesh::NavMeshDetail::updateAABB(const Float3& v)
@@ -237,33 +483,9 @@ namespace s3d
 
 	bool NavMesh::NavMeshDetail::build(const NavMeshConfig& config)
 	{
-		const float cellSize		= static_cast<float>(config.cellSize);
-		const float cellHeight		= static_cast<float>(config.cellHeight);
-		const float agentMaxSlope	= static_cast<float>(config.agentMaxSlope);
-		const float agentHeight		= static_cast<float>(config.agentHeight);
-		const float agentMaxClimb	= static_cast<float>(config.agentMaxClimb);
-		const float agentRadius		= static_cast<float>(config.agentRadius);
-
-		constexpr float edgeMaxLen				= 12.0f;
-		constexpr float detailSampleDist		= 6.0f;
-		constexpr float detailSampleMaxError	= 1.0f;
-		constexpr float regionMinSize			= 8.0f;
-		constexpr float regionMergeSize			= 20.0f;
-
-		rcConfig cfg = {};
-		cfg.cs = cellSize;
-		cfg.ch = cellHeight;
-		cfg.walkableSlopeAngle		= agentMaxSlope;
-		cfg.walkableHeight			= static_cast<int32>(std::ceil(agentHeight / cellHeight));
-		cfg.walkableClimb			= static_cast<int32>(std::floor(agentMaxClimb / cellHeight));
-		cfg.walkableRadius			= static_cast<int32>(std::ceil(agentRadius / cellSize));
-		cfg.maxEdgeLen				= static_cast<int32>(edgeMaxLen / cellSize);
-		cfg.maxSimplificationError	= 1.3f;
-		cfg.minRegionArea			= static_cast<int32>(regionMinSize * regionMinSize);
-		cfg.mergeRegionArea			= static_cast<int32>(regionMergeSize * regionMergeSize);
-		cfg.maxVertsPerPoly			= 6;
-		cfg.detailSampleDist		= (detailSampleDist < 0.9f) ? 0 : cellSize * detailSampleDist;
-		cfg.detailSampleMaxError	= cellHeight * detailSampleMaxError;
+		rcConfig cfg = detail::MakeRcConfig(config);
+
+		const float cellSize = cfg.cs;
 
 		rcVcopy(cfg.bmin, m_bmin);
 		rcVcopy(cfg.bmax, m_bmax);
@@ -377,4 +599,358 @@ namespace s3d
 
 		return true;
 	}
+	bool NavMesh::NavMeshDetail::buildTiled(const size_t numThreads)
+	{
+		const float cellSize = static_cast<float>(m_config.cellSize);
+		const int32 tileSize = m_config.tileSize;
+
+		int32 gridWidth = 0, gridHeight = 0;
+
+		rcCalcGridSize(m_bmin, m_bmax, cellSize, &gridWidth, &gridHeight);
+
+		m_tileCountX = Max((gridWidth + tileSize - 1) / tileSize, 1);
+		m_tileCountY = Max((gridHeight + tileSize - 1) / tileSize, 1);
+
+		// dtPolyRef の 22 ビットをタイル番号とポリゴン番号で分け合う（残りはソルト）
+		const int32 tileBits = Min(static_cast<int32>(dtIlog2(dtNextPow2(static_cast<uint32>(m_tileCountX * m_tileCountY)))), 14);
+
+		if ((m_tileCountX * m_tileCountY) > (1 << tileBits))
+		{
+			LOG_FAIL(U"NavMesh: too many tiles ({0}x{1}). Increase NavMeshConfig::tileSize"_fmt(m_tileCountX, m_tileCountY));
+
+			return false;
+		}
+
+		const int32 polyBits = (22 - tileBits);
+
+		dtNavMeshParams params = {};
+		rcVcopy(params.orig, m_bmin);
+		params.tileWidth	= (tileSize * cellSize);
+		params.tileHeight	= (tileSize * cellSize);
+		params.maxTiles		= (1 << tileBits);
+		params.maxPolys		= (1 << polyBits);
+
+		destroy();
+
+		m_navmesh = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), dtFreeNavMesh);
+
+		if (!m_navmesh)
+		{
+			throw std::bad_alloc();
+		}
+
+		if (dtStatusFailed(m_navmesh->init(&params)))
+		{
+			return false;
+		}
+
+		Array<Array<uint32>> tileTriangles;
+
+		Array<uint64> tileHashes;
+
+		binTriangles(tileTriangles, tileHashes);
+
+		m_tileHashes.assign(tileHashes.size(), 0);
+
+		Array<size_t> tiles(tileHashes.size());
+
+		for (size_t i = 0; i < tiles.size(); ++i)
+		{
+			tiles[i] = i;
+		}
+
+		return buildTiles(tiles, tileTriangles, tileHashes, numThreads);
+	}
+
+	void NavMesh::NavMeshDetail::binTriangles(Array<Array<uint32>>& tileTriangles, Array<uint64>& tileHashes) const
+	{
+		const size_t num_tiles = static_cast<size_t>(m_tileCountX) * m_tileCountY;
+
+		tileTriangles.assign(num_tiles, Array<uint32>());
+
+		tileHashes.assign(num_tiles, 14695981039346656037ULL);
+
+		const float cellSize = static_cast<float>(m_config.cellSize);
+		const float tileWidth = (m_config.tileSize * cellSize);
+
+		// タイルの境界付近の三角形は、隣のタイルの縁取り（borderSize）にも含める
+		const int32 walkableRadius = detail::MakeRcConfig(m_config).walkableRadius;
+		const float border = ((walkableRadius + 3) * cellSize);
+
+		const size_t num_triangles = m_areaIDs.size();
+
+		for (size_t t = 0; t < num_triangles; ++t)
+		{
+			const Float3& v0 = m_vertices[m_indices[t * 3 + 0]];
+			const Float3& v1 = m_vertices[m_indices[t * 3 + 1]];
+			const Float3& v2 = m_vertices[m_indices[t * 3 + 2]];
+
+			const float minX = Min({ v0.x, v1.x, v2.x }) - m_bmin[0] - border;
+			const float maxX = Max({ v0.x, v1.x, v2.x }) - m_bmin[0] + border;
+			const float minZ = Min({ v0.z, v1.z, v2.z }) - m_bmin[2] - border;
+			const float maxZ = Max({ v0.z, v1.z, v2.z }) - m_bmin[2] + border;
+
+			const int32 x0 = Clamp(static_cast<int32>(std::floor(minX / tileWidth)), 0, m_tileCountX - 1);
+			const int32 x1 = Clamp(static_cast<int32>(std::floor(maxX / tileWidth)), 0, m_tileCountX - 1);
+			const int32 y0 = Clamp(static_cast<int32>(std::floor(minZ / tileWidth)), 0, m_tileCountY - 1);
+			const int32 y1 = Clamp(static_cast<int32>(std::floor(maxZ / tileWidth)), 0, m_tileCountY - 1);
+
+			// 頂点の番号ではなく位置と地形の種類で比較する
+			const float key[10] = { v0.x, v0.y, v0.z, v1.x, v1.y, v1.z, v2.x, v2.y, v2.z, static_cast<float>(m_areaIDs[t]) };
+
+			const uint64 triangleHash = Hash::FNV1a(key, sizeof(key));
+
+			for (int32 y = y0; y <= y1; ++y)
+			{
+				for (int32 x = x0; x <= x1; ++x)
+				{
+					const size_t index = (static_cast<size_t>(y) * m_tileCountX + x);
+
+					tileTriangles[index].push_back(static_cast<uint32>(t));
+
+					tileHashes[index] = ((tileHashes[index] ^ triangleHash) * 1099511628211ULL);
+				}
+			}
+		}
+	}
+
+	Optional<detail::NavMeshTileData> NavMesh::NavMeshDetail::buildTile(const int32 tx, const int32 ty, const Array<uint32>& triangles) const
+	{
+		if (triangles.isEmpty())
+		{
+			return detail::NavMeshTileData{};
+		}
+
+		rcConfig cfg = detail::MakeRcConfig(m_config);
+		cfg.tileSize				= m_config.tileSize;
+		cfg.borderSize				= cfg.walkableRadius + 3;
+		cfg.width					= cfg.tileSize + cfg.borderSize * 2;
+		cfg.height					= cfg.tileSize + cfg.borderSize * 2;
+
+		const float cellSize = cfg.cs;
+
+		const float tileWidth = (cfg.tileSize * cellSize);
+
+		rcVcopy(cfg.bmin, m_bmin);
+		rcVcopy(cfg.bmax, m_bmax);
+		cfg.bmin[0] = m_bmin[0] + tx * tileWidth;
+		cfg.bmin[2] = m_bmin[2] + ty * tileWidth;
+		cfg.bmax[0] = m_bmin[0] + (tx + 1) * tileWidth;
+		cfg.bmax[2] = m_bmin[2] + (ty + 1) * tileWidth;
+		cfg.bmin[0] -= cfg.borderSize * cellSize;
+		cfg.bmin[2] -= cfg.borderSize * cellSize;
+		cfg.bmax[0] += cfg.borderSize * cellSize;
+		cfg.bmax[2] += cfg.borderSize * cellSize;
+
+		if (cfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON)
+		{
+			return none;
+		}
+
+		// rcContext はスレッド間で共有しない
+		rcContext ctx(false);
+
+		detail::NavMeshTileBuffers buffers;
+
+		if (!buffers.isValid())
+		{
+			throw std::bad_alloc();
+		}
+
+		Array<uint16> indices(triangles.size() * 3);
+
+		Array<uint8> areaIDs(triangles.size());
+
+		for (size_t i = 0; i < triangles.size(); ++i)
+		{
+			const size_t t = triangles[i];
+
+			indices[i * 3 + 0] = m_indices[t * 3 + 0];
+			indices[i * 3 + 1] = m_indices[t * 3 + 1];
+			indices[i * 3 + 2] = m_indices[t * 3 + 2];
+
+			areaIDs[i] = m_areaIDs[t];
+		}
+
+		if (!rcCreateHeightfield(&ctx, *buffers.hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+		{
+			return none;
+		}
+
+		const int32 flagMergeThreshold = 0;
+
+		rcRasterizeTriangles(&ctx, &m_vertices[0].x, static_cast<int32>(m_vertices.size()),
+			indices.data(), areaIDs.data(), static_cast<int32>(areaIDs.size()), *buffers.hf, flagMergeThreshold);
+
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *buffers.hf);
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *buffers.hf);
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *buffers.hf);
+
+		if (!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *buffers.hf, *buffers.chf))
+		{
+			return none;
+		}
+
+		if (!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *buffers.chf))
+		{
+			return none;
+		}
+
+		if (!rcBuildDistanceField(&ctx, *buffers.chf))
+		{
+			return none;
+		}
+
+		if (!rcBuildRegions(&ctx, *buffers.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+		{
+			return none;
+		}
+
+		if (!rcBuildContours(&ctx, *buffers.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *buffers.cset))
+		{
+			return none;
+		}
+
+		if (buffers.cset->nconts == 0)
+		{
+			return detail::NavMeshTileData{};
+		}
+
+		if (!rcBuildPolyMesh(&ctx, *buffers.cset, cfg.maxVertsPerPoly, *buffers.mesh))
+		{
+			return none;
+		}
+
+		if (!rcBuildPolyMeshDetail(&ctx, *buffers.mesh, *buffers.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *buffers.dmesh))
+		{
+			return none;
+		}
+
+		const rcPolyMesh& mesh = *buffers.mesh;
+		const rcPolyMeshDetail& dmesh = *buffers.dmesh;
+
+		if (mesh.nverts == 0)
+		{
+			return detail::NavMeshTileData{};
+		}
+
+		if (mesh.nverts >= 0xffff)
+		{
+			return none;
+		}
+
+		for (int32 i = 0; i < mesh.npolys; ++i)
+		{
+			mesh.flags[i] = 1;
+		}
+
+		dtNavMeshCreateParams params;
+		memset(&params, 0, sizeof(params));
+
+		params.verts		= mesh.verts;
+		params.vertCount	= mesh.nverts;
+		params.polys		= mesh.polys;
+		params.polyAreas	= mesh.areas;
+		params.polyFlags	= mesh.flags;
+		params.polyCount	= mesh.npolys;
+		params.nvp			= mesh.nvp;
+
+		params.detailMeshes		= dmesh.meshes;
+		params.detailVerts		= dmesh.verts;
+		params.detailVertsCount = dmesh.nverts;
+		params.detailTris		= dmesh.tris;
+		params.detailTriCount	= dmesh.ntris;
+
+		params.walkableHeight	= static_cast<float>(m_config.agentHeight);
+		params.walkableRadius	= static_cast<float>(m_config.agentRadius);
+		params.walkableClimb	= static_cast<float>(m_config.agentMaxClimb);
+		params.tileX			= tx;
+		params.tileY			= ty;
+		params.tileLayer		= 0;
+		rcVcopy(params.bmin, mesh.bmin);
+		rcVcopy(params.bmax, mesh.bmax);
+		params.cs = cfg.cs;
+		params.ch = cfg.ch;
+		params.buildBvTree = true;
+
+		detail::NavMeshTileData tile;
+
+		if (!dtCreateNavMeshData(&params, &tile.data, &tile.size))
+		{
+			return none;
+		}
+
+		return tile;
+	}
+
+	bool NavMesh::NavMeshDetail::buildTiles(const Array<size_t>& tiles, const Array<Array<uint32>>& tileTriangles, const Array<uint64>& tileHashes, const size_t numThreads)
+	{
+		Array<Optional<detail::NavMeshTileData>> results(tiles.size());
+
+		std::atomic<bool> outOfMemory = false;
+
+		detail::ParallelFor(tiles.size(), numThreads, [&](const size_t index, size_t)
+		{
+			const size_t tileIndex = tiles[index];
+
+			const int32 tx = static_cast<int32>(tileIndex % m_tileCountX);
+			const int32 ty = static_cast<int32>(tileIndex / m_tileCountX);
+
+			try
+			{
+				results[index] = buildTile(tx, ty, tileTriangles[tileIndex]);
+			}
+			catch (const std::bad_alloc&)
+			{
+				outOfMemory = true;
+			}
+		});
+
+		// dtNavMesh へのタイルの追加と削除は、呼び出し元のスレッドでまとめて行う
+		bool succeeded = !outOfMemory;
+
+		for (size_t i = 0; i < tiles.size(); ++i)
+		{
+			auto& tile = results[i];
+
+			if (!tile)
+			{
+				// 失敗したタイルは古いものを残す
+				succeeded = false;
+
+				continue;
+			}
+
+			const size_t tileIndex = tiles[i];
+
+			const int32 tx = static_cast<int32>(tileIndex % m_tileCountX);
+			const int32 ty = static_cast<int32>(tileIndex / m_tileCountX);
+
+			if (const dtTileRef ref = m_navmesh->getTileRefAt(tx, ty, 0))
+			{
+				m_navmesh->removeTile(ref, nullptr, nullptr);
+			}
+
+			if (tile->data)
+			{
+				if (dtStatusFailed(m_navmesh->addTile(tile->data, tile->size, DT_TILE_FREE_DATA, 0, nullptr)))
+				{
+					dtFree(tile->data);
+
+					succeeded = false;
+
+					continue;
+				}
+			}
+
+			m_tileHashes[tileIndex] = tileHashes[tileIndex];
+		}
+
+		if (outOfMemory)
+		{
+			throw std::bad_alloc();
+		}
+
+		return succeeded;
+	}
 }
@@ -11,10 +11,12 @@
 
 # pragma once
 # include <cfloat>
+# include <mutex>
 # include <Siv3D/NavMesh.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/PointVector.hpp>
 # include <Siv3D/Triangle.hpp>
+# include <Siv3D/Optional.hpp>
 # include <RecastDetour/Recast.h>
 # include <RecastDetour/DetourCommon.h>
 # include <RecastDetour/DetourNavMesh.h>
@@ -23,6 +25,27 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 経路探索 1 回分の作業領域。スレッドごとに持ち、呼び出しをまたいで再利用する
+		struct NavMeshQueryContext
+		{
+			std::unique_ptr<dtNavMeshQuery, decltype(&dtFreeNavMeshQuery)> query{ dtAllocNavMeshQuery(), dtFreeNavMeshQuery };
+
+			Array<dtPolyRef> polys;
+
+			Array<Float3> straightPath;
+		};
+
+		// dtCreateNavMeshData() で作成したタイル 1 枚分のデータ
+		struct NavMeshTileData
+		{
+			unsigned char* data = nullptr;
+
+			int32 size = 0;
+		};
+	}
+
 	class NavMesh::NavMeshDetail
 	{
 	private:
@@ -57,6 +80,23 @@ namespace s3d
 
 		Array<uint8> m_areaIDs;
 
+		// タイル分割して作成した場合の情報
+		NavMeshConfig m_config;
+
+		bool m_tiled = false;
+
+		int32 m_tileCountX = 0;
+
+		int32 m_tileCountY = 0;
+
+		// 各タイルと重なる三角形のハッシュ。update() で変化したタイルを見つけるのに使う
+		Array<uint64> m_tileHashes;
+
+		// バッチ探索用
+		mutable std::mutex m_queryMutex;
+
+		mutable Array<std::unique_ptr<detail::NavMeshQueryContext>> m_queryContexts;
+
 		void updateAABB(const Float3& v);
 
 		void destroy();
@@ -67,14 +107,31 @@ namespace s3d
 
 		bool build(const NavMeshConfig& config);
 
+		bool buildTiled(size_t numThreads);
+
+		// 各タイルと重なる三角形のインデックスを集め、タイルごとのハッシュを計算する
+		void binTriangles(Array<Array<uint32>>& tileTriangles, Array<uint64>& tileHashes) const;
+
+		// タイルを 1 枚作成する。ポリゴンが無いタイルは data が nullptr になる。複数のスレッドから同時に呼ばれる
+		Optional<detail::NavMeshTileData> buildTile(int32 tx, int32 ty, const Array<uint32>& triangles) const;
+
+		// tiles で指定したタイルを並列に作成し、dtNavMesh のタイルを置き換える
+		bool buildTiles(const Array<size_t>& tiles, const Array<Array<uint32>>& tileTriangles, const Array<uint64>& tileHashes, size_t numThreads);
+
+		static bool FindPath(detail::NavMeshQueryContext& context, const Float3& start, const Float3& end, Array<Vec3>& path);
+
 	public:
 
 		NavMeshDetail();
 
 		~NavMeshDetail();
 
-		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config);
+		bool build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config, size_t numThreads);
+
+		bool update(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, size_t numThreads);
 
 		Array<Vec3> query(const Float3& start, const Float3& end) const;
+
+		void query(const Array<std::pair<Vec3, Vec3>>& startEnds, Array<Array<Vec3>>& results, size_t numThreads) const;
 	};
 }
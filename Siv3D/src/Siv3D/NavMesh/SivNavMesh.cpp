@@ -24,16 +24,31 @@ namespace s3d
 
 	}
 
-	bool NavMesh::build(const Array<Float3>& vertices, const Array<uint16>& indices, const NavMeshConfig& config)
+	bool NavMesh::build(const Array<Float3>& vertices, const Array<uint16>& indices, const NavMeshConfig& config, const size_t numThreads)
 	{
-		return build(vertices, indices, Array<uint8>(indices.size() / 3, 1), config);
+		return build(vertices, indices, Array<uint8>(indices.size() / 3, 1), config, numThreads);
 	}
 
-	bool NavMesh::build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config)
+	bool NavMesh::build(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const NavMeshConfig& config, const size_t numThreads)
 	{
 		pImpl = std::make_shared<NavMeshDetail>();
 
-		return pImpl->build(vertices, indices, areaIDs, config);
+		return pImpl->build(vertices, indices, areaIDs, config, numThreads);
+	}
+
+	bool NavMesh::update(const Array<Float3>& vertices, const Array<uint16>& indices, const size_t numThreads)
+	{
+		return update(vertices, indices, Array<uint8>(indices.size() / 3, 1), numThreads);
+	}
+
+	bool NavMesh::update(const Array<Float3>& vertices, const Array<uint16>& indices, const Array<uint8>& areaIDs, const size_t numThreads)
+	{
+		if (!pImpl)
+		{
+			return false;
+		}
+
+		return pImpl->update(vertices, indices, areaIDs, numThreads);
 	}
 
 	Array<Vec3> NavMesh::query(const Vec3& start, const Vec3& end) const
@@ -45,4 +60,16 @@ namespace s3d
 
 		return pImpl->query(start, end);
 	}
+
+	void NavMesh::query(const Array<std::pair<Vec3, Vec3>>& startEnds, Array<Array<Vec3>>& results, const size_t numThreads) const
+	{
+		if (!pImpl)
+		{
+			results.assign(startEnds.size(), Array<Vec3>());
+
+			return;
+		}
+
+		pImpl->query(startEnds, results, numThreads);
+	}
 }
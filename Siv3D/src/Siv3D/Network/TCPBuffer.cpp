@@ -0,0 +1,347 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include "TCPBuffer.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		Byte* TCPSendQueue::allocate(const size_t size)
+		{
+			if (m_queued && (m_queued.back().size() + size) <= ChunkSize)
+			{
+				Array<Byte>& chunk = m_queued.back();
+				const size_t offset = chunk.size();
+				chunk.resize(offset + size);
+				return (chunk.data() + offset);
+			}
+
+			Array<Byte> chunk;
+
+			if (m_freeChunks)
+			{
+				chunk = std::move(m_freeChunks.back());
+				m_freeChunks.pop_back();
+				chunk.clear();
+			}
+			else
+			{
+				chunk.reserve(ChunkSize);
+			}
+
+			chunk.resize(size);
+			m_queued.push_back(std::move(chunk));
+
+			return m_queued.back().data();
+		}
+
+		bool TCPSendQueue::push(const void* data, const size_t size)
+		{
+			std::lock_guard lock(m_mutex);
+
+			std::memcpy(allocate(size), data, size);
+
+			if (m_isSending)
+			{
+				return false;
+			}
+
+			m_isSending = true;
+
+			return true;
+		}
+
+		bool TCPSendQueue::pushMessage(const void* data, const size_t size)
+		{
+			std::lock_guard lock(m_mutex);
+
+			const TCPMessageHeader header = static_cast<TCPMessageHeader>(size);
+			Byte* const pDst = allocate(sizeof(TCPMessageHeader) + size);
+
+			for (size_t i = 0; i < sizeof(TCPMessageHeader); ++i)
+			{
+				pDst[i] = static_cast<Byte>((header >> (i * 8)) & 0xFF);
+			}
+
+			std::memcpy(pDst + sizeof(TCPMessageHeader), data, size);
+
+			if (m_isSending)
+			{
+				return false;
+			}
+
+			m_isSending = true;
+
+			return true;
+		}
+
+		const Array<Array<Byte>>& TCPSendQueue::beginSend()
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_sending.swap(m_queued);
+
+			return m_sending;
+		}
+
+		bool TCPSendQueue::endSend()
+		{
+			std::lock_guard lock(m_mutex);
+
+			for (auto& chunk : m_sending)
+			{
+				// 大きなチャンクは保持し続けない
+				if (chunk.capacity() <= ChunkSize)
+				{
+					m_freeChunks.push_back(std::move(chunk));
+				}
+			}
+
+			m_sending.clear();
+
+			if (m_queued)
+			{
+				return true;
+			}
+
+			m_isSending = false;
+
+			return false;
+		}
+
+		void TCPSendQueue::clear()
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_queued.clear();
+
+			m_freeChunks.clear();
+
+			// 送信中のチャンクは書き込みが完了するまで解放しない
+			if (m_sending.isEmpty())
+			{
+				m_isSending = false;
+			}
+		}
+
+
+		TCPReceiveBuffer::TCPReceiveBuffer()
+			: m_buffer(InitialCapacity)
+		{
+
+		}
+
+		TCPReceiveBuffer::PrepareResult TCPReceiveBuffer::prepare(std::array<std::pair<Byte*, size_t>, 2>& regions)
+		{
+			std::lock_guard lock(m_mutex);
+
+			size_t freeSize = (m_buffer.size() - m_size);
+
+			// ビューを貸し出している間は、データを移動する拡張ができない
+			if ((freeSize < MinReadSize) && (m_buffer.size() < MaxBufferSize) && (m_viewSize == 0))
+			{
+				grow(m_buffer.size() * 2);
+
+				freeSize = (m_buffer.size() - m_size);
+			}
+
+			if (freeSize == 0)
+			{
+				if (m_viewSize)
+				{
+					m_paused = true;
+
+					return PrepareResult::Paused;
+				}
+
+				return PrepareResult::Overflow;
+			}
+
+			const size_t tail = ((m_head + m_size) & mask());
+			const size_t first = std::min(freeSize, (m_buffer.size() - tail));
+
+			regions[0] = { m_buffer.data() + tail, first };
+			regions[1] = { m_buffer.data(), (freeSize - first) };
+
+			return PrepareResult::OK;
+		}
+
+		void TCPReceiveBuffer::commit(const size_t size)
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_size += size;
+		}
+
+		void TCPReceiveBuffer::clear()
+		{
+			std::lock_guard lock(m_mutex);
+
+			m_head = 0;
+
+			m_size = 0;
+
+			m_viewSize = 0;
+
+			m_paused = false;
+		}
+
+		size_t TCPReceiveBuffer::available(bool& resume)
+		{
+			std::lock_guard lock(m_mutex);
+
+			resume = releaseView();
+
+			return m_size;
+		}
+
+		bool TCPReceiveBuffer::skip(const size_t size, bool& resume)
+		{
+			std::lock_guard lock(m_mutex);
+
+			resume = releaseView();
+
+			if (m_size < size)
+			{
+				return false;
+			}
+
+			drop(size);
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::lookahead(void* dst, const size_t size, bool& resume)
+		{
+			std::lock_guard lock(m_mutex);
+
+			resume = releaseView();
+
+			if (m_size < size)
+			{
+				return false;
+			}
+
+			copyFront(dst, size);
+
+			return true;
+		}
+
+		bool TCPReceiveBuffer::read(void* dst, const size_t size, bool& resume)
+		{
+			std::lock_guard lock(m_mutex);
+
+			resume = releaseView();
+
+			if (m_size < size)
+			{
+				return false;
+			}
+
+			copyFront(dst, size);
+
+			drop(size);
+
+			return true;
+		}
+
+		Optional<ByteArrayView> TCPReceiveBuffer::receiveMessage(bool& resume)
+		{
+			std::lock_guard lock(m_mutex);
+
+			resume = releaseView();
+
+			if (m_size < sizeof(TCPMessageHeader))
+			{
+				return none;
+			}
+
+			Byte headerBytes[sizeof(TCPMessageHeader)];
+			copyFront(headerBytes, sizeof(TCPMessageHeader));
+
+			TCPMessageHeader payloadSize = 0;
+
+			for (size_t i = 0; i < sizeof(TCPMessageHeader); ++i)
+			{
+				payloadSize |= (static_cast<TCPMessageHeader>(headerBytes[i]) << (i * 8));
+			}
+
+			const size_t messageSize = (sizeof(TCPMessageHeader) + payloadSize);
+
+			if (m_size < messageSize)
+			{
+				return none;
+			}
+
+			const size_t payloadPos = ((m_head + sizeof(TCPMessageHeader)) & mask());
+
+			// ビューを返している間は、I/O スレッドがこの領域を上書きしたり移動したりしない
+			m_viewSize = messageSize;
+
+			if ((payloadPos + payloadSize) <= m_buffer.size())
+			{
+				return ByteArrayView(m_buffer.data() + payloadPos, payloadSize);
+			}
+
+			// ペイロードがリングの末尾をまたぐ場合だけコピーする
+			const size_t first = (m_buffer.size() - payloadPos);
+			m_wrappedMessage.resize(payloadSize);
+			std::memcpy(m_wrappedMessage.data(), m_buffer.data() + payloadPos, first);
+			std::memcpy(m_wrappedMessage.data() + first, m_buffer.data(), payloadSize - first);
+
+			return ByteArrayView(m_wrappedMessage.data(), payloadSize);
+		}
+
+		void TCPReceiveBuffer::copyFront(void* dst, const size_t size) const
+		{
+			const size_t first = std::min(size, (m_buffer.size() - m_head));
+
+			std::memcpy(dst, m_buffer.data() + m_head, first);
+			std::memcpy(static_cast<Byte*>(dst) + first, m_buffer.data(), size - first);
+		}
+
+		void TCPReceiveBuffer::drop(const size_t size)
+		{
+			m_head = ((m_head + size) & mask());
+
+			m_size -= size;
+		}
+
+		bool TCPReceiveBuffer::releaseView()
+		{
+			if (m_viewSize)
+			{
+				drop(m_viewSize);
+
+				m_viewSize = 0;
+			}
+
+			const bool paused = m_paused;
+
+			m_paused = false;
+
+			return paused;
+		}
+
+		void TCPReceiveBuffer::grow(const size_t capacity)
+		{
+			Array<Byte> newBuffer(capacity);
+
+			copyFront(newBuffer.data(), m_size);
+
+			m_buffer.swap(newBuffer);
+
+			m_head = 0;
+		}
+	}
+}
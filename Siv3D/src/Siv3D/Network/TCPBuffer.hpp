@@ -0,0 +1,145 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <mutex>
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Byte.hpp>
+# include <Siv3D/ByteArrayView.hpp>
+# include <Siv3D/Optional.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// メッセージの先頭に付ける、リトルエンディアンのペイロード長
+		using TCPMessageHeader = uint32;
+
+		// 送信待ちのデータ。小さなデータは同じチャンクにまとめ、送信時はすべてのチャンクを 1 回の書き込みで送る
+		class TCPSendQueue
+		{
+		private:
+
+			static constexpr size_t ChunkSize = 64 * 1024;
+
+			std::mutex m_mutex;
+
+			Array<Array<Byte>> m_queued;
+
+			Array<Array<Byte>> m_sending;
+
+			Array<Array<Byte>> m_freeChunks;
+
+			bool m_isSending = false;
+
+			Byte* allocate(size_t size);
+
+		public:
+
+			// データを追加する。送信中でなく、呼び出し側が送信を開始する必要がある場合 true
+			bool push(const void* data, size_t size);
+
+			// ヘッダを付けたメッセージを追加する
+			bool pushMessage(const void* data, size_t size);
+
+			// 送信待ちのチャンクを送信中に移し、その一覧を返す
+			const Array<Array<Byte>>& beginSend();
+
+			// 送信中のチャンクを解放する。続けて送信するデータがある場合 true
+			bool endSend();
+
+			void clear();
+		};
+
+		// 受信したデータを保持するリングバッファ。I/O スレッドは空き領域に直接読み込む
+		class TCPReceiveBuffer
+		{
+		public:
+
+			static constexpr size_t MaxBufferSize = 32 * 1024 * 1024;
+
+			enum class PrepareResult
+			{
+				OK,
+
+				// 貸し出し中のビューがあるため、領域を広げられない
+				Paused,
+
+				// 最大サイズに達した
+				Overflow,
+			};
+
+		private:
+
+			static constexpr size_t InitialCapacity = 64 * 1024;
+
+			// 空き領域がこれより小さければ、可能な場合は領域を広げてから読み込む
+			static constexpr size_t MinReadSize = 4 * 1024;
+
+			mutable std::mutex m_mutex;
+
+			Array<Byte> m_buffer;
+
+			size_t m_head = 0;
+
+			size_t m_size = 0;
+
+			// receiveMessage() が返したビューの大きさ。次の読み出し操作で解放する
+			size_t m_viewSize = 0;
+
+			// ビューがリングの末尾をまたぐ場合にメッセージを連続させる領域
+			Array<Byte> m_wrappedMessage;
+
+			bool m_paused = false;
+
+			size_t mask() const noexcept
+			{
+				return (m_buffer.size() - 1);
+			}
+
+			void copyFront(void* dst, size_t size) const;
+
+			void drop(size_t size);
+
+			// 貸し出し中のビューを解放する。受信が止まっていた場合 true
+			bool releaseView();
+
+			void grow(size_t capacity);
+
+		public:
+
+			TCPReceiveBuffer();
+
+			// I/O スレッド: 読み込みに使う空き領域を返す
+			PrepareResult prepare(std::array<std::pair<Byte*, size_t>, 2>& regions);
+
+			// I/O スレッド: 読み込んだ大きさを確定する
+			void commit(size_t size);
+
+			void clear();
+
+			// 以下の読み出し操作は、ビューを解放した結果受信を再開する必要がある場合に resume を true にする
+
+			size_t available(bool& resume);
+
+			bool skip(size_t size, bool& resume);
+
+			bool lookahead(void* dst, size_t size, bool& resume);
+
+			bool read(void* dst, size_t size, bool& resume);
+
+			// 次のメッセージのペイロードを返す。ビューは次の読み出し操作まで有効
+			Optional<ByteArrayView> receiveMessage(bool& resume);
+		};
+	}
+}
@@ -0,0 +1,172 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <emmintrin.h>
+# include "ParticleBuffer2D.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		static float DefaultSizeOverLifeTimeFunc(float startSize, float startLifeTime, float remainingLifeTime)
+		{
+			// 寿命が 0 のパーティクルは、寿命の終わりの大きさ (0) にする
+			if (startLifeTime <= 0.0f)
+			{
+				return 0.0f;
+			}
+
+			return startSize* (remainingLifeTime / startLifeTime);
+		};
+
+		static Float4 DefaultColorOverLifeTimeFunc(const Float4& startColor, float, float)
+		{
+			return startColor;
+		};
+	}
+
+	void ParticleBuffer2D::reserve(const size_t n)
+	{
+		m_positionX.reserve(n);
+		m_positionY.reserve(n);
+		m_velocityX.reserve(n);
+		m_velocityY.reserve(n);
+		m_rotation.reserve(n);
+		m_angularVelocity.reserve(n);
+		m_startLifeTime.reserve(n);
+		m_remainingLifeTime.reserve(n);
+	}
+
+	void ParticleBuffer2D::push_back(const Particle2D& particle)
+	{
+		m_positionX.push_back(particle.position.x);
+		m_positionY.push_back(particle.position.y);
+		m_velocityX.push_back(particle.velocity.x);
+		m_velocityY.push_back(particle.velocity.y);
+		m_rotation.push_back(particle.rotation);
+		m_angularVelocity.push_back(particle.startAngularVelocity);
+		m_startLifeTime.push_back(particle.startLifeTime);
+		m_remainingLifeTime.push_back(particle.remainingLifeTime);
+	}
+
+	void ParticleBuffer2D::clear()
+	{
+		m_positionX.clear();
+		m_positionY.clear();
+		m_velocityX.clear();
+		m_velocityY.clear();
+		m_rotation.clear();
+		m_angularVelocity.clear();
+		m_startLifeTime.clear();
+		m_remainingLifeTime.clear();
+	}
+
+	void ParticleBuffer2D::update(const float deltaTime, const Float2& deltaVelocity)
+	{
+		size_t count = size();
+
+		float* const px = m_positionX.data();
+		float* const py = m_positionY.data();
+		float* const vx = m_velocityX.data();
+		float* const vy = m_velocityY.data();
+		float* const rot = m_rotation.data();
+		float* const av = m_angularVelocity.data();
+		float* const life = m_remainingLifeTime.data();
+
+		{
+			const __m128 dt = _mm_set1_ps(deltaTime);
+			const __m128 dvx = _mm_set1_ps(deltaVelocity.x);
+			const __m128 dvy = _mm_set1_ps(deltaVelocity.y);
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 nvx = _mm_add_ps(_mm_loadu_ps(vx + i), dvx);
+				const __m128 nvy = _mm_add_ps(_mm_loadu_ps(vy + i), dvy);
+				_mm_storeu_ps(vx + i, nvx);
+				_mm_storeu_ps(vy + i, nvy);
+				_mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(nvx, dt)));
+				_mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(nvy, dt)));
+				_mm_storeu_ps(rot + i, _mm_add_ps(_mm_loadu_ps(rot + i), _mm_mul_ps(_mm_loadu_ps(av + i), dt)));
+				_mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt));
+			}
+
+			for (; i < count; ++i)
+			{
+				vx[i] += deltaVelocity.x;
+				vy[i] += deltaVelocity.y;
+				px[i] += (vx[i] * deltaTime);
+				py[i] += (vy[i] * deltaTime);
+				rot[i] += (av[i] * deltaTime);
+				life[i] -= deltaTime;
+			}
+		}
+
+		// 寿命が尽きた粒子の位置に末尾の粒子を移す。描画順は変わるが、配列の詰め直しが不要になる
+		float* const start = m_startLifeTime.data();
+
+		for (size_t i = 0; i < count;)
+		{
+			if (life[i] >= 0.0f)
+			{
+				++i;
+				continue;
+			}
+
+			const size_t last = --count;
+			px[i] = px[last];
+			py[i] = py[last];
+			vx[i] = vx[last];
+			vy[i] = vy[last];
+			rot[i] = rot[last];
+			av[i] = av[last];
+			start[i] = start[last];
+			life[i] = life[last];
+		}
+
+		m_positionX.resize(count);
+		m_positionY.resize(count);
+		m_velocityX.resize(count);
+		m_velocityY.resize(count);
+		m_rotation.resize(count);
+		m_angularVelocity.resize(count);
+		m_startLifeTime.resize(count);
+		m_remainingLifeTime.resize(count);
+	}
+
+	ParticleLifeTimeTable2D::ParticleLifeTimeTable2D()
+	{
+		bake(ParticleSystem2DParameters());
+	}
+
+	void ParticleLifeTimeTable2D::bake(const ParticleSystem2DParameters& parameters)
+	{
+		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
+			parameters.sizeOverLifeTimeFunc ? parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
+		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
+			parameters.colorOverLifeTimeFunc ? parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
+
+		const float startSize = static_cast<float>(parameters.startSize);
+		const float startLifeTime = static_cast<float>(parameters.startLifeTime);
+		const Float4 startColor = parameters.startColor.toFloat4();
+
+		m_sizes.resize(TableSize);
+		m_colors.resize(TableSize);
+
+		for (size_t i = 0; i < TableSize; ++i)
+		{
+			const float remainingLifeTime = startLifeTime * (static_cast<float>(i) / (TableSize - 1));
+
+			m_sizes[i] = sizeOverLifeTimeFunc(startSize, startLifeTime, remainingLifeTime);
+			m_colors[i] = colorOverLifeTimeFunc(startColor, startLifeTime, remainingLifeTime);
+		}
+	}
+}
@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Fwd.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/Vector4D.hpp>
+# include <Siv3D/Particle2D.hpp>
+# include <Siv3D/ParticleSystem2D.hpp>
+
+namespace s3d
+{
+	// 粒子の各要素を別々の配列で保持する (SoA)
+	class ParticleBuffer2D
+	{
+	private:
+
+		Array<float> m_positionX;
+
+		Array<float> m_positionY;
+
+		Array<float> m_velocityX;
+
+		Array<float> m_velocityY;
+
+		Array<float> m_rotation;
+
+		Array<float> m_angularVelocity;
+
+		Array<float> m_startLifeTime;
+
+		Array<float> m_remainingLifeTime;
+
+	public:
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_positionX.size();
+		}
+
+		void reserve(size_t n);
+
+		void push_back(const Particle2D& particle);
+
+		void clear();
+
+		// 全粒子の位置・速度・回転・残り寿命を進め、寿命が尽きた粒子を末尾の粒子と入れ替えて削除する
+		void update(float deltaTime, const Float2& deltaVelocity);
+
+		[[nodiscard]] const float* positionX() const noexcept { return m_positionX.data(); }
+
+		[[nodiscard]] const float* positionY() const noexcept { return m_positionY.data(); }
+
+		[[nodiscard]] const float* rotation() const noexcept { return m_rotation.data(); }
+
+		[[nodiscard]] const float* startLifeTime() const noexcept { return m_startLifeTime.data(); }
+
+		[[nodiscard]] const float* remainingLifeTime() const noexcept { return m_remainingLifeTime.data(); }
+	};
+
+	// sizeOverLifeTimeFunc / colorOverLifeTimeFunc を、残り寿命の割合に対するテーブルに焼き込んだもの
+	class ParticleLifeTimeTable2D
+	{
+	private:
+
+		static constexpr size_t TableSize = 256;
+
+		Array<float> m_sizes;
+
+		Array<Float4> m_colors;
+
+	public:
+
+		ParticleLifeTimeTable2D();
+
+		// 1 つのシステムの粒子は、開始時の大きさ・色・寿命をすべてパラメータから受け取るので、関数は残り寿命だけで決まる
+		void bake(const ParticleSystem2DParameters& parameters);
+
+		[[nodiscard]] float getSize(float startLifeTime, float remainingLifeTime) const noexcept
+		{
+			const auto [index, t] = getPosition(startLifeTime, remainingLifeTime);
+
+			return (m_sizes[index] + (m_sizes[index + 1] - m_sizes[index]) * t);
+		}
+
+		[[nodiscard]] Float4 getColor(float startLifeTime, float remainingLifeTime) const noexcept
+		{
+			const auto [index, t] = getPosition(startLifeTime, remainingLifeTime);
+
+			return (m_colors[index] + (m_colors[index + 1] - m_colors[index]) * t);
+		}
+
+	private:
+
+		[[nodiscard]] static std::pair<size_t, float> getPosition(const float startLifeTime, const float remainingLifeTime) noexcept
+		{
+			const float rate = (startLifeTime > 0.0f) ? (remainingLifeTime / startLifeTime) : 0.0f;
+			const float f = ((rate < 0.0f) ? 0.0f : (rate > 1.0f) ? 1.0f : rate) * (TableSize - 1);
+			const size_t index = (static_cast<size_t>(f) < (TableSize - 1)) ? static_cast<size_t>(f) : (TableSize - 2);
+
+			return{ index, (f - index) };
+		}
+	};
+}
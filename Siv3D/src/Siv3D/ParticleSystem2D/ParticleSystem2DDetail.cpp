@@ -22,18 +22,34 @@ namespace s3d
 {
 	namespace detail
 	{
-		static float DefaultSizeOverLifeTimeFunc(float startSize, float startLifeTime, float remainingLifeTime)
+		// スコープの間、このスレッドの既定の乱数生成器をシステム専用のものと入れ替える
+		class ScopedParticleRNG
 		{
-			return startSize* (remainingLifeTime / startLifeTime);
-		};
+		private:
 
-		static Float4 DefaultColorOverLifeTimeFunc(const Float4& startColor, float, float)
-		{
-			return startColor;
+			DefaultRNGType& m_rng;
+
+		public:
+
+			explicit ScopedParticleRNG(DefaultRNGType& rng)
+				: m_rng(rng)
+			{
+				std::swap(GetDefaultRNG(), m_rng);
+			}
+
+			~ScopedParticleRNG()
+			{
+				std::swap(GetDefaultRNG(), m_rng);
+			}
+
+			ScopedParticleRNG(const ScopedParticleRNG&) = delete;
+
+			ScopedParticleRNG& operator =(const ScopedParticleRNG&) = delete;
 		};
 	}
 
 	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail()
+		: m_rng(GetDefaultRNG()())
 	{
 
 	}
@@ -41,6 +57,7 @@ namespace s3d
 	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail(const Vec2& position, const Vec2& force)
 		: m_position(position)
 		, m_force(force)
+		, m_rng(GetDefaultRNG()())
 	{
 
 	}
@@ -52,8 +69,9 @@ namespace s3d
 		, m_emitter(std::move(emitter))
 		, m_parameters(parameters)
 		, m_particleTexture(texture)
+		, m_rng(GetDefaultRNG()())
 	{
-
+		m_lifeTimeTable.bake(m_parameters);
 	}
 
 	ParticleSystem2D::ParticleSystem2DDetail::~ParticleSystem2DDetail()
@@ -79,6 +97,8 @@ namespace s3d
 	void ParticleSystem2D::ParticleSystem2DDetail::setParameters(const ParticleSystem2DParameters& parameters)
 	{
 		m_parameters = parameters;
+
+		m_lifeTimeTable.bake(m_parameters);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::setTexture(const Texture& texture) noexcept
@@ -103,12 +123,22 @@ namespace s3d
 			return;
 		}
 
+		const detail::ScopedParticleRNG rng(m_rng);
+
 		m_remainingTime = m_parameters.startLifeTime;
 
 		addParticles(m_parameters);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::update(const double deltaTime)
+	{
+		// エミッタが Random() を使っても、どのスレッドで更新したかによらず同じ結果になる
+		const detail::ScopedParticleRNG rng(m_rng);
+
+		updateParticles(deltaTime);
+	}
+
+	void ParticleSystem2D::ParticleSystem2DDetail::updateParticles(const double deltaTime)
 	{
 		updateCurrentparticles(static_cast<float>(deltaTime));
 
@@ -133,6 +163,11 @@ namespace s3d
 	{
 		ScopedRenderStates2D blend(m_parameters.blendState);
 
+		drawParticles();
+	}
+
+	void ParticleSystem2D::ParticleSystem2DDetail::drawParticles() const
+	{
 		if (m_particleTexture)
 		{
 			drawTexturedParticle();
@@ -143,6 +178,21 @@ namespace s3d
 		}
 	}
 
+	const BlendState& ParticleSystem2D::ParticleSystem2DDetail::getBlendState() const noexcept
+	{
+		return m_parameters.blendState;
+	}
+
+	TextureID ParticleSystem2D::ParticleSystem2DDetail::getTextureID() const noexcept
+	{
+		return m_particleTexture.id();
+	}
+
+	void ParticleSystem2D::ParticleSystem2DDetail::setSeed(const uint64 seed)
+	{
+		m_rng.seed(seed);
+	}
+
 	void ParticleSystem2D::ParticleSystem2DDetail::drawDebug() const
 	{
 		ScopedRenderStates2D blend(m_parameters.blendState);
@@ -159,17 +209,13 @@ namespace s3d
 	{
 		const Float2 deltaVelocity = m_force * deltaTime;
 
-		for (auto& particle : m_particles)
-		{
-			particle.update(deltaTime, deltaVelocity);
-		}
-
-		m_particles.remove_if([](const Particle2D & p) { return p.isDead(); });
+		m_particles.update(deltaTime, deltaVelocity);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::addParticles(const ParticleSystem2DParameters& params)
 	{
 		const double timePerParticle = 1.0 / params.rate;
+		const size_t maxParticles = static_cast<size_t>(params.maxParticles);
 
 		while (m_remainingTime > timePerParticle)
 		{
@@ -181,6 +227,12 @@ namespace s3d
 				continue;
 			}
 
+			// 粒子数が上限に達している間は、新しい粒子を放出しない
+			if (m_particles.size() >= maxParticles)
+			{
+				continue;
+			}
+
 			Particle2D particle(
 				m_emitter->emit(m_position, params.startSpeed),
 				params.startColor.toFloat4(),
@@ -193,57 +245,35 @@ namespace s3d
 
 			const float perParticledeltaTime = (particle.startLifeTime - particle.remainingLifeTime);
 			particle.advance(perParticledeltaTime, m_force * perParticledeltaTime);
-			m_particles << particle;
-		}
-
-		if (const size_t maxParticles = static_cast<size_t>(params.maxParticles); m_particles.size() > maxParticles)
-		{
-			m_particles.erase(m_particles.begin(), m_particles.begin() + (m_particles.size() - maxParticles));
+			m_particles.push_back(particle);
 		}
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawParticle() const
 	{
-		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
-			m_parameters.sizeOverLifeTimeFunc ? m_parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
-		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
-			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
-
-		for (const auto& particle : m_particles)
-		{
-			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
-
-			RectF(Arg::center = particle.position, size)
-				.rotated(particle.rotation)
-				.draw(ColorF(color));
-		}
+		Siv3DEngine::Get<ISiv3DRenderer2D>()->addParticles(m_particles, m_lifeTimeTable);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawTexturedParticle() const
 	{
-		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
-			m_parameters.sizeOverLifeTimeFunc ? m_parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
-		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
-			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
-
-		Siv3DEngine::Get<ISiv3DRenderer2D>()->addTexturedParticles(m_particleTexture, m_particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc);
+		Siv3DEngine::Get<ISiv3DRenderer2D>()->addTexturedParticles(m_particleTexture, m_particles, m_lifeTimeTable);
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawDebugParticle() const
 	{
-		const ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc =
-			m_parameters.sizeOverLifeTimeFunc ? m_parameters.sizeOverLifeTimeFunc : detail::DefaultSizeOverLifeTimeFunc;
-		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
-			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
+		const float* const positionX = m_particles.positionX();
+		const float* const positionY = m_particles.positionY();
+		const float* const rotation = m_particles.rotation();
+		const float* const startLifeTime = m_particles.startLifeTime();
+		const float* const remainingLifeTime = m_particles.remainingLifeTime();
 
-		for (const auto& particle : m_particles)
+		for (size_t i = 0; i < m_particles.size(); ++i)
 		{
-			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+			const float size = m_lifeTimeTable.getSize(startLifeTime[i], remainingLifeTime[i]);
+			const Float4 color = m_lifeTimeTable.getColor(startLifeTime[i], remainingLifeTime[i]);
 
-			RectF(Arg::center = particle.position, size)
-				.rotated(particle.rotation)
+			RectF(Arg::center = Vec2(positionX[i], positionY[i]), size)
+				.rotated(rotation[i])
 				.drawFrame(1, ColorF(color));
 		}
 	}
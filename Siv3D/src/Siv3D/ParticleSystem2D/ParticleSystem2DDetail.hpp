@@ -13,6 +13,9 @@
 # include <Siv3D/ParticleSystem2D.hpp>
 # include <Siv3D/Particle2D.hpp>
 # include <Siv3D/Texture.hpp>
+# include <Siv3D/DefaultRNG.hpp>
+# include <Siv3D/SFMT.hpp>
+# include "ParticleBuffer2D.hpp"
 
 namespace s3d
 {
@@ -20,7 +23,10 @@ namespace s3d
 	{
 	private:
 
-		Array<Particle2D> m_particles;
+		ParticleBuffer2D m_particles;
+
+		ParticleLifeTimeTable2D m_lifeTimeTable;
+
 		double m_remainingTime = 0.0;
 
 		Vec2 m_position = Vec2(0, 0);
@@ -30,6 +36,9 @@ namespace s3d
 		std::unique_ptr<IEmitter2D> m_emitter;
 		Texture m_particleTexture;
 
+		// 粒子の放出に使う、このシステム専用の乱数生成器
+		DefaultRNGType m_rng;
+
 		void updateCurrentparticles(float deltaTime);
 
 		void addParticles(const ParticleSystem2DParameters& params);
@@ -40,6 +49,8 @@ namespace s3d
 
 		void drawDebugParticle() const;
 
+		void updateParticles(double deltaTime);
+
 	public:
 
 		ParticleSystem2DDetail();
@@ -69,6 +80,15 @@ namespace s3d
 
 		void draw() const;
 
+		// ブレンドステートを設定せずに粒子を描画する
+		void drawParticles() const;
+
+		const BlendState& getBlendState() const noexcept;
+
+		TextureID getTextureID() const noexcept;
+
+		void setSeed(uint64 seed);
+
 		void drawDebug() const;
 	};
 }
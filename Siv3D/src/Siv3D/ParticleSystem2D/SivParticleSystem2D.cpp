@@ -10,10 +10,30 @@
 //-----------------------------------------------
 
 # include <Siv3D/ParticleSystem2D.hpp>
+# include <Siv3D/ScopedRenderStates2D.hpp>
+# include <Threading/WorkerPool.hpp>
 # include "ParticleSystem2DDetail.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// 描画先の色に依存せず加算するだけのブレンドは、描画順を入れ替えても結果が変わらない
+		[[nodiscard]] static bool IsOrderIndependent(const BlendState& state) noexcept
+		{
+			const auto dependsOnDest = [](const Blend blend)
+			{
+				return (blend == Blend::DestAlpha) || (blend == Blend::InvDestAlpha)
+					|| (blend == Blend::DestColor) || (blend == Blend::InvDestColor)
+					|| (blend == Blend::SrcAlphaSat);
+			};
+
+			return state.enable
+				&& (state.dst == Blend::One) && (state.op == BlendOp::Add) && !dependsOnDest(state.src)
+				&& (state.dstAlpha == Blend::One) && (state.opAlpha == BlendOp::Add) && !dependsOnDest(state.srcAlpha);
+		}
+	}
+
 	ParticleSystem2D::ParticleSystem2D()
 		: pImpl(std::make_shared<ParticleSystem2DDetail>())
 	{
@@ -87,4 +107,93 @@ namespace s3d
 	{
 		pImpl->drawDebug();
 	}
+
+	void ParticleSystem2D::setSeed(const uint64 seed)
+	{
+		pImpl->setSeed(seed);
+	}
+
+	void ParticleSystem2D::UpdateAll(const Array<ParticleSystem2D*>& systems, const double deltaTime, const size_t numThreads)
+	{
+		// 同じ pImpl を共有するシステムを同時に更新しないよう、重複を取り除く
+		Array<ParticleSystem2DDetail*> details;
+		details.reserve(systems.size());
+
+		for (const auto& system : systems)
+		{
+			if (system)
+			{
+				details.push_back(system->pImpl.get());
+			}
+		}
+
+		details.unique();
+
+		if (!details)
+		{
+			return;
+		}
+
+		// 各システムは専用の乱数生成器を持つので、どのスレッドが更新しても結果は同じになる
+		detail::ParallelFor(details.size(), numThreads, [&](const size_t i, size_t)
+		{
+			details[i]->update(deltaTime);
+		});
+	}
+
+	void ParticleSystem2D::DrawAll(const Array<ParticleSystem2D*>& systems)
+	{
+		Array<const ParticleSystem2DDetail*> details;
+		details.reserve(systems.size());
+
+		for (const auto& system : systems)
+		{
+			if (system)
+			{
+				details.push_back(system->pImpl.get());
+			}
+		}
+
+		// 加算ブレンドのシステムが連続する区間だけを、ブレンドステートとテクスチャでまとめて描画ステートの切り替えを減らす
+		// アルファブレンドのシステムは、渡された順に描画する
+		for (auto it = details.begin(); it != details.end();)
+		{
+			if (!detail::IsOrderIndependent((*it)->getBlendState()))
+			{
+				++it;
+				continue;
+			}
+
+			const auto last = std::find_if(it, details.end(), [](const ParticleSystem2DDetail* d)
+			{
+				return !detail::IsOrderIndependent(d->getBlendState());
+			});
+
+			std::stable_sort(it, last, [](const ParticleSystem2DDetail* a, const ParticleSystem2DDetail* b)
+			{
+				if (a->getBlendState()._data != b->getBlendState()._data)
+				{
+					return (a->getBlendState()._data < b->getBlendState()._data);
+				}
+
+				return (a->getTextureID().value() < b->getTextureID().value());
+			});
+
+			it = last;
+		}
+
+		// ステートが同じシステムは続けて記録され、レンダラーの描画コマンドで 1 回のドローコールにまとめられる
+		for (size_t i = 0; i < details.size();)
+		{
+			const BlendState& blendState = details[i]->getBlendState();
+			const ScopedRenderStates2D blend(blendState);
+
+			do
+			{
+				details[i]->drawParticles();
+				++i;
+			}
+			while ((i < details.size()) && (details[i]->getBlendState()._data == blendState._data));
+		}
+	}
 }
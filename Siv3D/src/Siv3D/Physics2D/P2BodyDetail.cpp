@@ -22,6 +22,7 @@ namespace s3d
 		bodyDef.type = static_cast<b2BodyType>(bodyType);
 		bodyDef.position = detail::ToB2Vec2(center);
 		m_body = world.getWorldPtr()->CreateBody(&bodyDef);
+		m_previousPos = bodyDef.position;
 	}
 
 	P2Body::P2BodyDetail::~P2BodyDetail()
@@ -120,4 +121,27 @@ namespace s3d
 
 		m_body->SetUserData(static_cast<void*>(data));
 	}
+
+	void P2Body::P2BodyDetail::storePreviousTransform()
+	{
+		assert(m_body);
+
+		m_previousPos = m_body->GetPosition();
+
+		m_previousAngle = m_body->GetAngle();
+	}
+
+	std::pair<Vec2, double> P2Body::P2BodyDetail::getInterpolatedTransform() const
+	{
+		assert(m_body);
+
+		const double alpha = m_world.getInterpolationAlpha();
+
+		// Box2D の角度は正規化されないので、そのまま線形補間できる
+		const Vec2 pos = detail::ToVec2(m_previousPos).lerp(detail::ToVec2(m_body->GetPosition()), alpha);
+
+		const double angle = m_previousAngle + (m_body->GetAngle() - m_previousAngle) * alpha;
+
+		return{ pos, angle };
+	}
 }
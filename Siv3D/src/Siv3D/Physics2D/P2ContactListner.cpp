@@ -15,11 +15,74 @@
 
 namespace s3d
 {
-	void P2ContactListener::BeginContact(b2Contact* contact)
+	namespace detail
+	{
+		[[nodiscard]] static P2ContactEvent MakeImpulseEvent(const P2ContactPair& pair, const b2Contact* contact, const b2ContactImpulse* impulse)
+		{
+			P2ContactEvent event;
+			event.pair = pair;
+			event.type = P2ContactEventType::Impulse;
+			event.num_contacts = static_cast<uint32>(contact->GetManifold()->pointCount);
+
+			if (event.num_contacts)
+			{
+				b2WorldManifold worldManifold;
+				contact->GetWorldManifold(&worldManifold);
+				event.normal = detail::ToVec2(worldManifold.normal);
+
+				for (uint32 i = 0; i < event.num_contacts; ++i)
+				{
+					event.contacts[i].point = detail::ToVec2(worldManifold.points[i]);
+				}
+
+				for (int32 i = 0; i < impulse->count; ++i)
+				{
+					event.contacts[i].normalImpulse = impulse->normalImpulses[i];
+					event.contacts[i].tangentImpulse = impulse->tangentImpulses[i];
+				}
+			}
+
+			return event;
+		}
+
+		static void AddImpulse(P2Collision& collision, const P2ContactEvent& event)
+		{
+			collision.num_contacts = std::max(collision.num_contacts, event.num_contacts);
+
+			if (event.num_contacts)
+			{
+				collision.normal = event.normal;
+
+				for (uint32 i = 0; i < event.num_contacts; ++i)
+				{
+					auto& c = collision.contacts[i];
+					c.point = event.contacts[i].point;
+					c.normalImpulse += event.contacts[i].normalImpulse;
+					c.tangentImpulse += event.contacts[i].tangentImpulse;
+				}
+			}
+		}
+	}
+
+	P2ContactPair P2ContactListener::GetContactPair(const b2Contact* contact)
 	{
 		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData());
 		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData());
-		const P2ContactPair pair{ pBodyA->id(), pBodyB->id() };
+		return{ pBodyA->id(), pBodyB->id() };
+	}
+
+	void P2ContactListener::BeginContact(b2Contact* contact)
+	{
+		const P2ContactPair pair = GetContactPair(contact);
+
+		if (m_eventMode)
+		{
+			P2ContactEvent event;
+			event.pair = pair;
+			event.type = P2ContactEventType::Begin;
+			m_events.push_back(event);
+			return;
+		}
 
 		if (auto it = m_collisions.find(pair); it != m_collisions.end())
 		{
@@ -33,57 +96,146 @@ namespace s3d
 
 	void P2ContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
 	{
-		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData());
-		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData());
-		const P2ContactPair pair{ pBodyA->id(), pBodyB->id() };
+		const P2ContactEvent event = detail::MakeImpulseEvent(GetContactPair(contact), contact, impulse);
+
+		if (m_eventMode)
+		{
+			m_events.push_back(event);
+			return;
+		}
+
+		detail::AddImpulse(m_collisions.find(event.pair).value(), event);
+	}
 
-		auto& collision = m_collisions.find(pair).value();
-		const uint32 current_num_contacts = static_cast<uint32>(contact->GetManifold()->pointCount);
-		collision.num_contacts = std::max(collision.num_contacts, current_num_contacts);
+	void P2ContactListener::EndContact(b2Contact* contact)
+	{
+		const P2ContactPair pair = GetContactPair(contact);
 
-		if (current_num_contacts)
+		if (m_eventMode)
 		{
-			b2WorldManifold worldManifold;
-			contact->GetWorldManifold(&worldManifold);
-			collision.normal = detail::ToVec2(worldManifold.normal);
+			P2ContactEvent event;
+			event.pair = pair;
+			event.type = P2ContactEventType::End;
+			m_events.push_back(event);
+			return;
+		}
 
-			for (uint32 i = 0; i < current_num_contacts; ++i)
+		if (auto it = m_collisions.find(pair); it != m_collisions.end())
+		{
+			if (--(it.value()._internal_count) == 0)
 			{
-				auto& c = collision.contacts[i];
-				c.point = detail::ToVec2(worldManifold.points[i]);
+				m_collisions.erase(it);
 			}
+		}
+	}
+
+	void P2ContactListener::rebuildCollisionsFromEvents(const b2World& world)
+	{
+		// 前の update() から続いている接触も含めるため、現在の接触の一覧から作る
+		rebuildCollisionsFromWorld(world);
 
-			for (int32 i = 0; i < impulse->count; ++i)
+		// ステップの途中で離れた組の力積は、イベントのモードでない場合と同じく含めない
+		for (const auto& event : m_events)
+		{
+			if (event.type != P2ContactEventType::Impulse)
 			{
-				auto& c = collision.contacts[i];
-				c.normalImpulse += impulse->normalImpulses[i];
-				c.tangentImpulse += impulse->tangentImpulses[i];
+				continue;
+			}
+
+			if (auto it = m_collisions.find(event.pair); it != m_collisions.end())
+			{
+				detail::AddImpulse(it.value(), event);
 			}
 		}
+
+		m_collisionsOutdated = false;
 	}
 
-	void P2ContactListener::EndContact(b2Contact* contact)
+	void P2ContactListener::rebuildCollisionsFromWorld(const b2World& world)
 	{
-		const P2Body::P2BodyDetail* pBodyA = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureA()->GetBody()->GetUserData());
-		const P2Body::P2BodyDetail* pBodyB = static_cast<const P2Body::P2BodyDetail*>(contact->GetFixtureB()->GetBody()->GetUserData());
-		const P2ContactPair pair{ pBodyA->id(), pBodyB->id() };
+		m_collisions.clear();
 
-		if (auto it = m_collisions.find(pair); it != m_collisions.end())
+		// BeginContact() と同じく、接触しているフィクスチャの組の数を数える
+		for (const b2Contact* contact = world.GetContactList(); contact; contact = contact->GetNext())
 		{
-			if (--(it.value()._internal_count) == 0)
+			if (!contact->IsTouching())
 			{
-				m_collisions.erase(it);
+				continue;
+			}
+
+			const P2ContactPair pair = GetContactPair(contact);
+
+			if (auto it = m_collisions.find(pair); it != m_collisions.end())
+			{
+				++(it.value()._internal_count);
+			}
+			else
+			{
+				m_collisions.emplace(pair, P2Collision());
 			}
 		}
 	}
 
-	const HashTable<P2ContactPair, P2Collision>& P2ContactListener::getCollisions() const
+	const HashTable<P2ContactPair, P2Collision>& P2ContactListener::getCollisions(const b2World& world)
 	{
+		std::lock_guard lock(m_collisionsMutex);
+
+		if (m_collisionsOutdated)
+		{
+			rebuildCollisionsFromEvents(world);
+		}
+
 		return m_collisions;
 	}
 
+	void P2ContactListener::setEventMode(const bool enabled, const b2World& world)
+	{
+		if (enabled == m_eventMode)
+		{
+			return;
+		}
+
+		m_eventMode = enabled;
+
+		m_events.clear();
+
+		if (enabled)
+		{
+			m_events.reserve(InitialEventCapacity);
+
+			m_collisionsOutdated = true;
+		}
+		else
+		{
+			// イベントのモードの間に追跡していなかった接触を数え直す
+			rebuildCollisionsFromWorld(world);
+
+			m_collisionsOutdated = false;
+		}
+	}
+
+	bool P2ContactListener::getEventMode() const
+	{
+		return m_eventMode;
+	}
+
+	const Array<P2ContactEvent>& P2ContactListener::getEvents() const
+	{
+		return m_events;
+	}
+
 	void P2ContactListener::clearContacts()
 	{
+		if (m_eventMode)
+		{
+			// 容量を保ったまま空にする
+			m_events.clear();
+
+			m_collisionsOutdated = true;
+
+			return;
+		}
+
 		const auto itEnd = m_collisions.end();
 
 		for (auto it = m_collisions.begin(); it != itEnd; ++it)
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <mutex>
 # include <Siv3D/Physics2D.hpp>
 # include <Box2D/Box2D.h>
 # include <Siv3D/HashTable.hpp>
@@ -20,17 +21,43 @@ namespace s3d
 	{
 	private:
 
+		// イベントを記録するバッファの初期容量
+		static constexpr size_t InitialEventCapacity = 4096;
+
 		HashTable<P2ContactPair, P2Collision> m_collisions;
 
+		// 1 回の update() の間に発生したイベント。容量はステップをまたいで再利用する
+		Array<P2ContactEvent> m_events;
+
+		// true の場合、コールバックは m_events に追記するだけで、m_collisions は getCollisions() で作り直す
+		bool m_eventMode = false;
+
+		bool m_collisionsOutdated = false;
+
+		// const な P2World::getCollisions() から複数のスレッドが同時に作り直さないようにする
+		std::mutex m_collisionsMutex;
+
+		[[nodiscard]] static P2ContactPair GetContactPair(const b2Contact* contact);
+
 		void BeginContact(b2Contact* contact) override;
 
 		void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
 
 		void EndContact(b2Contact* contact) override;
 
+		void rebuildCollisionsFromEvents(const b2World& world);
+
+		void rebuildCollisionsFromWorld(const b2World& world);
+
 	public:
 
-		const HashTable<P2ContactPair, P2Collision>& getCollisions() const;
+		const HashTable<P2ContactPair, P2Collision>& getCollisions(const b2World& world);
+
+		void setEventMode(bool enabled, const b2World& world);
+
+		bool getEventMode() const;
+
+		const Array<P2ContactEvent>& getEvents() const;
 
 		void clearContacts();
 	};
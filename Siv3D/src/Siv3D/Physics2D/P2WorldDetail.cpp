@@ -10,21 +10,239 @@
 //-----------------------------------------------
 
 # include "P2WorldDetail.hpp"
+# include "P2BodyDetail.hpp"
 # include "Physics2DUtility.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// フィクスチャが属する物体の ID を返す関数
+		using P2BodyIDGetter = P2BodyID(*)(const b2Fixture*);
+
+		class P2QueryAABBCallback : public b2QueryCallback
+		{
+		private:
+
+			P2BodyIDGetter m_getID;
+
+			b2AABB m_aabb;
+
+			Array<P2BodyID>& m_results;
+
+		public:
+
+			P2QueryAABBCallback(P2BodyIDGetter getID, const b2AABB& aabb, Array<P2BodyID>& results)
+				: m_getID(getID)
+				, m_aabb(aabb)
+				, m_results(results) {}
+
+			bool ReportFixture(b2Fixture* fixture) override
+			{
+				// ツリーの AABB は余白を含むので、フィクスチャの AABB で判定し直す
+				for (int32 i = 0; i < fixture->GetShape()->GetChildCount(); ++i)
+				{
+					if (b2TestOverlap(fixture->GetAABB(i), m_aabb))
+					{
+						m_results.push_back(m_getID(fixture));
+						break;
+					}
+				}
+
+				return true;
+			}
+		};
+
+		class P2QueryPointCallback : public b2QueryCallback
+		{
+		private:
+
+			P2BodyIDGetter m_getID;
+
+			b2Vec2 m_pos;
+
+			Array<P2BodyID>& m_results;
+
+		public:
+
+			P2QueryPointCallback(P2BodyIDGetter getID, const b2Vec2& pos, Array<P2BodyID>& results)
+				: m_getID(getID)
+				, m_pos(pos)
+				, m_results(results) {}
+
+			bool ReportFixture(b2Fixture* fixture) override
+			{
+				if (fixture->TestPoint(m_pos))
+				{
+					m_results.push_back(m_getID(fixture));
+				}
+
+				return true;
+			}
+		};
+
+		class P2RaycastClosestCallback : public b2RayCastCallback
+		{
+		private:
+
+			P2BodyIDGetter m_getID;
+
+		public:
+
+			Optional<P2RaycastResult> result;
+
+			explicit P2RaycastClosestCallback(P2BodyIDGetter getID)
+				: m_getID(getID) {}
+
+			float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float32 fraction) override
+			{
+				result = P2RaycastResult{ m_getID(fixture), ToVec2(point), ToVec2(normal), fraction };
+
+				// レイを交点までに縮め、より近い交点だけを探す
+				return fraction;
+			}
+		};
+
+		class P2RaycastAllCallback : public b2RayCastCallback
+		{
+		private:
+
+			P2BodyIDGetter m_getID;
+
+			Array<P2RaycastResult>& m_results;
+
+		public:
+
+			P2RaycastAllCallback(P2BodyIDGetter getID, Array<P2RaycastResult>& results)
+				: m_getID(getID)
+				, m_results(results) {}
+
+			float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, const float32 fraction) override
+			{
+				m_results.push_back(P2RaycastResult{ m_getID(fixture), ToVec2(point), ToVec2(normal), fraction });
+
+				return 1.0f;
+			}
+		};
+
+		// 幅や高さが負の長方形も扱えるよう、lowerBound <= upperBound にする
+		[[nodiscard]] static b2AABB ToB2AABB(const RectF& rect)
+		{
+			const Vec2 p0 = rect.tl(), p1 = rect.br();
+
+			b2AABB aabb;
+			aabb.lowerBound = ToB2Vec2(Vec2(Min(p0.x, p1.x), Min(p0.y, p1.y)));
+			aabb.upperBound = ToB2Vec2(Vec2(Max(p0.x, p1.x), Max(p0.y, p1.y)));
+			return aabb;
+		}
+
+		// 複数のフィクスチャを持つ物体が重複しないようにする
+		static size_t SortUnique(Array<P2BodyID>& ids)
+		{
+			std::sort(ids.begin(), ids.end());
+
+			ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+			return ids.size();
+		}
+
+		void P2TaskExecutor::setNumThreads(const size_t numThreads)
+		{
+			m_numThreads = Max<size_t>(numThreads, 1);
+
+			m_pool.resize(m_numThreads - 1);
+		}
+
+		size_t P2TaskExecutor::getNumThreads() const
+		{
+			return m_numThreads;
+		}
+
+		int32 P2TaskExecutor::GetWorkerCount() const
+		{
+			return static_cast<int32>(m_numThreads);
+		}
+
+		void P2TaskExecutor::Run(const int32 count, b2TaskFunction* task, void* context)
+		{
+			m_pool.parallelFor(static_cast<size_t>(count), m_numThreads, [=](const size_t index, const size_t workerIndex)
+			{
+				task(context, static_cast<int32>(index), static_cast<int32>(workerIndex));
+			});
+		}
+	}
+
 	P2World::P2WorldDetail::P2WorldDetail(const Vec2& gravity)
 		: m_world(detail::ToB2Vec2(gravity))
 	{
 		m_world.SetContactListener(&m_contactListner);
+
+		m_world.SetTaskExecutor(&m_taskExecutor);
 	}
 
 	void P2World::P2WorldDetail::update(const double timeStep, const int32 velocityIterations, const int32 positionIterations)
 	{
+		// 1 回の update() で複数のステップを進めた場合、力積は合計される
 		m_contactListner.clearContacts();
 
-		m_world.Step(static_cast<float32>(timeStep), velocityIterations, positionIterations);
+		if (m_fixedTimeStep <= 0.0)
+		{
+			m_world.Step(static_cast<float32>(timeStep), velocityIterations, positionIterations);
+
+			m_interpolationAlpha = 1.0;
+
+			return;
+		}
+
+		m_accumulatedTime = Min(m_accumulatedTime + timeStep, m_fixedTimeStep * MaxFixedSteps);
+
+		const int32 steps = static_cast<int32>(m_accumulatedTime / m_fixedTimeStep);
+
+		for (int32 i = 0; i < steps; ++i)
+		{
+			// 補間の始点は最後のステップの直前の姿勢
+			if (i == (steps - 1))
+			{
+				storePreviousTransforms();
+			}
+
+			m_world.Step(static_cast<float32>(m_fixedTimeStep), velocityIterations, positionIterations);
+
+			m_accumulatedTime -= m_fixedTimeStep;
+		}
+
+		m_interpolationAlpha = Clamp(m_accumulatedTime / m_fixedTimeStep, 0.0, 1.0);
+	}
+
+	void P2World::P2WorldDetail::setThreadCount(const size_t numThreads)
+	{
+		m_taskExecutor.setNumThreads(numThreads);
+	}
+
+	size_t P2World::P2WorldDetail::getThreadCount() const
+	{
+		return m_taskExecutor.getNumThreads();
+	}
+
+	void P2World::P2WorldDetail::setFixedTimeStep(const double fixedTimeStep)
+	{
+		m_fixedTimeStep = Max(fixedTimeStep, 0.0);
+
+		m_accumulatedTime = 0.0;
+
+		m_interpolationAlpha = 1.0;
+
+		storePreviousTransforms();
+	}
+
+	double P2World::P2WorldDetail::getFixedTimeStep() const
+	{
+		return m_fixedTimeStep;
+	}
+
+	double P2World::P2WorldDetail::getInterpolationAlpha() const
+	{
+		return m_interpolationAlpha;
 	}
 
 	P2Body P2World::P2WorldDetail::createDummy(P2World& world, const Vec2& center, const P2BodyType bodyType)
@@ -124,9 +342,147 @@ namespace s3d
 		return P2SliderJoint(world, bodyA, bodyB, anchorPos, normalizedAxis);
 	}
 
-	const HashTable<P2ContactPair, P2Collision>& P2World::P2WorldDetail::getCollisions() const
+	const HashTable<P2ContactPair, P2Collision>& P2World::P2WorldDetail::getCollisions()
+	{
+		return m_contactListner.getCollisions(m_world);
+	}
+
+	void P2World::P2WorldDetail::setContactEventsEnabled(const bool enabled)
+	{
+		m_contactListner.setEventMode(enabled, m_world);
+	}
+
+	bool P2World::P2WorldDetail::getContactEventsEnabled() const
+	{
+		return m_contactListner.getEventMode();
+	}
+
+	const Array<P2ContactEvent>& P2World::P2WorldDetail::getContactEvents() const
+	{
+		return m_contactListner.getEvents();
+	}
+
+	size_t P2World::P2WorldDetail::queryAABB(const RectF& rect, Array<P2BodyID>& results) const
+	{
+		results.clear();
+
+		const b2AABB aabb = detail::ToB2AABB(rect);
+
+		detail::P2QueryAABBCallback callback(&GetBodyID, aabb, results);
+
+		m_world.QueryAABB(&callback, aabb);
+
+		return detail::SortUnique(results);
+	}
+
+	void P2World::P2WorldDetail::queryAABB(const Array<RectF>& rects, Array<Array<P2BodyID>>& results, const size_t numThreads) const
+	{
+		// 要素の配列は破棄せず、容量を次の呼び出しで再利用する
+		results.resize(rects.size());
+
+		detail::ParallelFor(rects.size(), numThreads, [&](const size_t i, size_t)
+		{
+			queryAABB(rects[i], results[i]);
+		}, MinQueriesPerWorker);
+	}
+
+	size_t P2World::P2WorldDetail::queryPoint(const Vec2& pos, Array<P2BodyID>& results) const
+	{
+		results.clear();
+
+		const b2Vec2 point = detail::ToB2Vec2(pos);
+
+		detail::P2QueryPointCallback callback(&GetBodyID, point, results);
+
+		b2AABB aabb;
+		aabb.lowerBound = point;
+		aabb.upperBound = point;
+
+		m_world.QueryAABB(&callback, aabb);
+
+		return detail::SortUnique(results);
+	}
+
+	void P2World::P2WorldDetail::queryPoint(const Array<Vec2>& positions, Array<Array<P2BodyID>>& results, const size_t numThreads) const
 	{
-		return m_contactListner.getCollisions();
+		results.resize(positions.size());
+
+		detail::ParallelFor(positions.size(), numThreads, [&](const size_t i, size_t)
+		{
+			queryPoint(positions[i], results[i]);
+		}, MinQueriesPerWorker);
+	}
+
+	Optional<P2RaycastResult> P2World::P2WorldDetail::raycast(const Vec2& start, const Vec2& end) const
+	{
+		// Box2D は長さ 0 のレイを扱えない
+		if (start == end)
+		{
+			return none;
+		}
+
+		detail::P2RaycastClosestCallback callback(&GetBodyID);
+
+		m_world.RayCast(&callback, detail::ToB2Vec2(start), detail::ToB2Vec2(end));
+
+		return callback.result;
+	}
+
+	void P2World::P2WorldDetail::raycast(const Array<Line>& rays, Array<Optional<P2RaycastResult>>& results, const size_t numThreads) const
+	{
+		results.resize(rays.size());
+
+		detail::ParallelFor(rays.size(), numThreads, [&](const size_t i, size_t)
+		{
+			results[i] = raycast(rays[i].begin, rays[i].end);
+		}, MinQueriesPerWorker);
+	}
+
+	size_t P2World::P2WorldDetail::raycastAll(const Vec2& start, const Vec2& end, Array<P2RaycastResult>& results) const
+	{
+		results.clear();
+
+		if (start == end)
+		{
+			return 0;
+		}
+
+		detail::P2RaycastAllCallback callback(&GetBodyID, results);
+
+		m_world.RayCast(&callback, detail::ToB2Vec2(start), detail::ToB2Vec2(end));
+
+		// 物体ごとに最も近い交点だけを残し、近い順に並べる
+		std::sort(results.begin(), results.end(), [](const P2RaycastResult& a, const P2RaycastResult& b)
+		{
+			return (a.id != b.id) ? (a.id < b.id) : (a.fraction < b.fraction);
+		});
+
+		results.erase(std::unique(results.begin(), results.end(), [](const P2RaycastResult& a, const P2RaycastResult& b)
+		{
+			return a.id == b.id;
+		}), results.end());
+
+		std::sort(results.begin(), results.end(), [](const P2RaycastResult& a, const P2RaycastResult& b)
+		{
+			return a.fraction < b.fraction;
+		});
+
+		return results.size();
+	}
+
+	void P2World::P2WorldDetail::raycastAll(const Array<Line>& rays, Array<Array<P2RaycastResult>>& results, const size_t numThreads) const
+	{
+		results.resize(rays.size());
+
+		detail::ParallelFor(rays.size(), numThreads, [&](const size_t i, size_t)
+		{
+			raycastAll(rays[i].begin, rays[i].end, results[i]);
+		}, MinQueriesPerWorker);
+	}
+
+	P2BodyID P2World::P2WorldDetail::GetBodyID(const b2Fixture* fixture)
+	{
+		return static_cast<const P2Body::P2BodyDetail*>(fixture->GetBody()->GetUserData())->id();
 	}
 
 	b2World& P2World::P2WorldDetail::getData()
@@ -144,6 +500,17 @@ namespace s3d
 		return &m_world;
 	}
 
+	void P2World::P2WorldDetail::storePreviousTransforms()
+	{
+		for (b2Body* body = m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			if (auto pBody = static_cast<P2Body::P2BodyDetail*>(body->GetUserData()))
+			{
+				pBody->storePreviousTransform();
+			}
+		}
+	}
+
 	P2BodyID P2World::P2WorldDetail::generateNextID()
 	{
 		return ++m_currentID;
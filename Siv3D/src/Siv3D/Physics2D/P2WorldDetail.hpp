@@ -13,28 +13,82 @@
 # include <atomic>
 # include <Siv3D/Physics2D.hpp>
 # include <Box2D/Box2D.h>
+# include <Threading/WorkerPool.hpp>
 # include "P2ContactListner.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		// b2World の独立した島を複数のスレッドで解く
+		class P2TaskExecutor : public b2TaskExecutor
+		{
+		private:
+
+			size_t m_numThreads = 1;
+
+			// 呼び出し元のスレッドを除く m_numThreads - 1 個のワーカー
+			WorkerPool m_pool;
+
+		public:
+
+			void setNumThreads(size_t numThreads);
+
+			[[nodiscard]] size_t getNumThreads() const;
+
+			int32 GetWorkerCount() const override;
+
+			void Run(int32 count, b2TaskFunction* task, void* context) override;
+		};
+	}
+
 	class P2World::P2WorldDetail
 	{
 	private:
 
+		// 1 回の update() で進める最大のステップ数。処理が追いつかない場合は残りの時間を捨てる
+		static constexpr int32 MaxFixedSteps = 8;
+
+		// 複数のクエリをまとめて実行するとき、1 つのワーカーが受け持つ最小の数。少ない場合は呼び出し元のスレッドだけで実行する
+		static constexpr size_t MinQueriesPerWorker = 64;
+
 		b2World m_world;
 
 		P2ContactListener m_contactListner;
 
+		detail::P2TaskExecutor m_taskExecutor;
+
 		std::atomic<P2BodyID> m_currentID = 0;
 
+		// 0 の場合は update() の timeStep をそのまま使う
+		double m_fixedTimeStep = 0.0;
+
+		double m_accumulatedTime = 0.0;
+
+		double m_interpolationAlpha = 1.0;
+
 		P2BodyID generateNextID();
 
+		void storePreviousTransforms();
+
+		[[nodiscard]] static P2BodyID GetBodyID(const b2Fixture* fixture);
+
 	public:
 
 		P2WorldDetail(const Vec2& gravity);
 
 		void update(double timeStep, int32 velocityIterations, int32 positionIterations);
 
+		void setThreadCount(size_t numThreads);
+
+		[[nodiscard]] size_t getThreadCount() const;
+
+		void setFixedTimeStep(double fixedTimeStep);
+
+		[[nodiscard]] double getFixedTimeStep() const;
+
+		[[nodiscard]] double getInterpolationAlpha() const;
+
 		[[nodiscard]] P2Body createDummy(P2World& world, const Vec2& center, P2BodyType bodyType);
 
 		[[nodiscard]] P2Body createLine(P2World& world, const Vec2& center, const Line& line, const P2Material& material, const P2Filter& filter, P2BodyType bodyType);
@@ -61,7 +115,29 @@ namespace s3d
 
 		[[nodiscard]] P2SliderJoint createSliderJoint(P2World& world, const P2Body& bodyA, const P2Body& bodyB, const Vec2& anchorPos, const Vec2& normalizedAxis);
 
-		[[nodiscard]] const HashTable<P2ContactPair, P2Collision>& getCollisions() const;
+		[[nodiscard]] const HashTable<P2ContactPair, P2Collision>& getCollisions();
+
+		void setContactEventsEnabled(bool enabled);
+
+		[[nodiscard]] bool getContactEventsEnabled() const;
+
+		[[nodiscard]] const Array<P2ContactEvent>& getContactEvents() const;
+
+		size_t queryAABB(const RectF& rect, Array<P2BodyID>& results) const;
+
+		void queryAABB(const Array<RectF>& rects, Array<Array<P2BodyID>>& results, size_t numThreads) const;
+
+		size_t queryPoint(const Vec2& pos, Array<P2BodyID>& results) const;
+
+		void queryPoint(const Array<Vec2>& positions, Array<Array<P2BodyID>>& results, size_t numThreads) const;
+
+		[[nodiscard]] Optional<P2RaycastResult> raycast(const Vec2& start, const Vec2& end) const;
+
+		void raycast(const Array<Line>& rays, Array<Optional<P2RaycastResult>>& results, size_t numThreads) const;
+
+		size_t raycastAll(const Vec2& start, const Vec2& end, Array<P2RaycastResult>& results) const;
+
+		void raycastAll(const Array<Line>& rays, Array<Array<P2RaycastResult>>& results, size_t numThreads) const;
 
 		[[nodiscard]] b2World& getData();
 
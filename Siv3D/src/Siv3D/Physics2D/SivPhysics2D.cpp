@@ -36,6 +36,16 @@ namespace s3d
 		return contacts.begin() + num_contacts;
 	}
 
+	std::array<P2Contact, 2>::const_iterator P2ContactEvent::begin() const noexcept
+	{
+		return contacts.begin();
+	}
+
+	std::array<P2Contact, 2>::const_iterator P2ContactEvent::end() const noexcept
+	{
+		return contacts.begin() + num_contacts;
+	}
+
 	////////////////////////////////////////////////
 	//
 	// P2World
@@ -89,6 +99,31 @@ namespace s3d
 		return pImpl->update(timeStep, velocityIterations, positionIterations);
 	}
 
+	void P2World::setThreadCount(const size_t numThreads)
+	{
+		pImpl->setThreadCount(numThreads);
+	}
+
+	size_t P2World::getThreadCount() const
+	{
+		return pImpl->getThreadCount();
+	}
+
+	void P2World::setFixedTimeStep(const double fixedTimeStep)
+	{
+		pImpl->setFixedTimeStep(fixedTimeStep);
+	}
+
+	double P2World::getFixedTimeStep() const
+	{
+		return pImpl->getFixedTimeStep();
+	}
+
+	double P2World::getInterpolationAlpha() const
+	{
+		return pImpl->getInterpolationAlpha();
+	}
+
 	P2Body P2World::createDummy(const Vec2& center, const P2BodyType bodyType)
 	{
 		return pImpl->createDummy(*this, center, bodyType);
@@ -377,6 +412,61 @@ namespace s3d
 		return pImpl->getCollisions();
 	}
 
+	void P2World::setContactEventsEnabled(const bool enabled)
+	{
+		pImpl->setContactEventsEnabled(enabled);
+	}
+
+	bool P2World::getContactEventsEnabled() const
+	{
+		return pImpl->getContactEventsEnabled();
+	}
+
+	const Array<P2ContactEvent>& P2World::getContactEvents() const
+	{
+		return pImpl->getContactEvents();
+	}
+
+	size_t P2World::queryAABB(const RectF& rect, Array<P2BodyID>& results) const
+	{
+		return pImpl->queryAABB(rect, results);
+	}
+
+	void P2World::queryAABB(const Array<RectF>& rects, Array<Array<P2BodyID>>& results, const size_t numThreads) const
+	{
+		pImpl->queryAABB(rects, results, numThreads);
+	}
+
+	size_t P2World::queryPoint(const Vec2& pos, Array<P2BodyID>& results) const
+	{
+		return pImpl->queryPoint(pos, results);
+	}
+
+	void P2World::queryPoint(const Array<Vec2>& positions, Array<Array<P2BodyID>>& results, const size_t numThreads) const
+	{
+		pImpl->queryPoint(positions, results, numThreads);
+	}
+
+	Optional<P2RaycastResult> P2World::raycast(const Vec2& start, const Vec2& end) const
+	{
+		return pImpl->raycast(start, end);
+	}
+
+	void P2World::raycast(const Array<Line>& rays, Array<Optional<P2RaycastResult>>& results, const size_t numThreads) const
+	{
+		pImpl->raycast(rays, results, numThreads);
+	}
+
+	size_t P2World::raycastAll(const Vec2& start, const Vec2& end, Array<P2RaycastResult>& results) const
+	{
+		return pImpl->raycastAll(start, end, results);
+	}
+
+	void P2World::raycastAll(const Array<Line>& rays, Array<Array<P2RaycastResult>>& results, const size_t numThreads) const
+	{
+		pImpl->raycastAll(rays, results, numThreads);
+	}
+
 	b2World* P2World::getWorldPtr() const
 	{
 		return pImpl->getWorldPtr();
@@ -586,6 +676,7 @@ namespace s3d
 		}
 
 		pImpl->getBody().SetTransform(detail::ToB2Vec2(pos), pImpl->getBody().GetAngle());
+		pImpl->storePreviousTransform();
 		return *this;
 	}
 
@@ -607,6 +698,7 @@ namespace s3d
 		}
 
 		pImpl->getBody().SetTransform(pImpl->getBody().GetPosition(), static_cast<float32>(angle));
+		pImpl->storePreviousTransform();
 		return *this;
 	}
 
@@ -628,6 +720,7 @@ namespace s3d
 		}
 
 		pImpl->getBody().SetTransform(detail::ToB2Vec2(pos), static_cast<float32>(angle));
+		pImpl->storePreviousTransform();
 		return *this;
 	}
 
@@ -749,6 +842,26 @@ namespace s3d
 		return{ detail::ToVec2(pImpl->getBody().GetPosition()), pImpl->getBody().GetAngle() };
 	}
 
+	Vec2 P2Body::getInterpolatedPos() const
+	{
+		return getInterpolatedTransform().first;
+	}
+
+	double P2Body::getInterpolatedAngle() const
+	{
+		return getInterpolatedTransform().second;
+	}
+
+	std::pair<Vec2, double> P2Body::getInterpolatedTransform() const
+	{
+		if (isEmpty())
+		{
+			return{ Vec2(0,0), 0.0 };
+		}
+
+		return pImpl->getInterpolatedTransform();
+	}
+
 	P2Body& P2Body::setVelocity(const Vec2& v)
 	{
 		if (isEmpty())
@@ -110,6 +110,13 @@ namespace s3d
 		m_currentStatistics.triangles += triangles;
 	}
 
+	void CProfiler::reportBatches(const size_t batches, const size_t uploadedBytes)
+	{
+		m_currentStatistics.batches += batches;
+
+		m_currentStatistics.uploadedBytes += uploadedBytes;
+	}
+
 	Statistics CProfiler::getStatistics() const noexcept
 	{
 		return m_previousStatistics;
@@ -71,6 +71,8 @@ namespace s3d
 		//
 		void reportDrawcalls(size_t drawcalls, size_t triangles) override;
 
+		void reportBatches(size_t batches, size_t uploadedBytes) override;
+
 		Statistics getStatistics() const noexcept override;
 
 		//
@@ -34,6 +34,8 @@ namespace s3d
 
 		virtual void reportDrawcalls(size_t drawcalls, size_t triangles) = 0;
 
+		virtual void reportBatches(size_t batches, size_t uploadedBytes) = 0;
+
 		virtual Statistics getStatistics() const noexcept = 0;
 
 		virtual void setAssetCreationWarningEnabled(bool enabled) = 0;
@@ -269,6 +269,29 @@ namespace s3d
 		return *this;
 	}
 
+	template <class SizeType>
+	void Rectangle<SizeType>::DrawBatch(const Array<Rectangle>& rects, const ColorF& color)
+	{
+		constexpr size_t ChunkSize = 1024;
+
+		FloatRect buffer[ChunkSize];
+
+		const Float4 colorF = color.toFloat4();
+
+		for (size_t i = 0; i < rects.size(); i += ChunkSize)
+		{
+			const size_t count = std::min(rects.size() - i, ChunkSize);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				const Rectangle& rect = rects[i + k];
+				buffer[k] = FloatRect(rect.x, rect.y, rect.x + rect.w, rect.y + rect.h);
+			}
+
+			Siv3DEngine::Get<ISiv3DRenderer2D>()->addRects(buffer, count, colorF);
+		}
+	}
+
 	template <class SizeType>
 	const Rectangle<SizeType>& Rectangle<SizeType>::drawFrame(const double innerThickness, const double outerThickness, const ColorF& color) const
 	{
@@ -14,6 +14,7 @@
 # include <Siv3D/Array.hpp>
 # include <Siv3D/FloatRect.hpp>
 # include <Siv3D/ParticleSystem2D.hpp>
+# include <ParticleSystem2D/ParticleBuffer2D.hpp>
 
 namespace s3d
 {
@@ -73,6 +74,10 @@ namespace s3d
 
 		virtual Float4 getSDFParameters() const = 0;
 
+		virtual void setDrawSorting(bool enabled) = 0;
+
+		virtual bool getDrawSorting() const = 0;
+
 		virtual void addLine(const LineStyle& style, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]) = 0;
 
 		virtual void addTriangle(const Float2(&pts)[3], const Float4& color) = 0;
@@ -83,10 +88,14 @@ namespace s3d
 
 		virtual void addRect(const FloatRect& rect, const Float4(&colors)[4]) = 0;
 
+		virtual void addRects(const FloatRect* rects, size_t count, const Float4& color) = 0;
+
 		virtual void addRectFrame(const FloatRect& rect, float thickness, const Float4& color) = 0;
 
 		virtual void addCircle(const Float2& center, float r, const Float4& color) = 0;
 
+		virtual void addCircles(const Circle* circles, size_t count, const Float4& color) = 0;
+
 		virtual void addCircleFrame(const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor) = 0;
 
 		virtual void addCirclePie(const Float2& center, float r, float startAngle, float angle, const Float4& color) = 0;
@@ -119,13 +128,15 @@ namespace s3d
 
 		virtual void addTextureRegion(const Texture& texture, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]) = 0;
 
+		virtual void addTextureRegions(const TextureRegion* regions, const Vec2* positions, size_t count, const Float4& color) = 0;
+
 		virtual void addTexturedCircle(const Texture& texture, const Circle& circle, const FloatRect& uv, const Float4& color) = 0;
 
 		virtual void addTexturedQuad(const Texture& texture, const FloatQuad& quad, const FloatRect& uv, const Float4& color) = 0;
 
-		virtual void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
-			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
-			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) = 0;
+		virtual void addParticles(const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table) = 0;
+
+		virtual void addTexturedParticles(const Texture& texture, const ParticleBuffer2D& particles, const ParticleLifeTimeTable2D& table) = 0;
 
 		virtual const Texture& getBoxShadowTexture() const = 0;
 	};
@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "SortedDrawRecorder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]] static constexpr uint64 MakeBucketKey(const size_t psIndex, const TextureID textureID) noexcept
+		{
+			return ((static_cast<uint64>(textureID.value()) << 32) | static_cast<uint32>(psIndex));
+		}
+	}
+
+	std::tuple<Vertex2D*, Vertex2D::IndexType*, Vertex2D::IndexType> SortedDrawRecorder::getBuffer(const uint16 vertexSize, const uint32 indexSize)
+	{
+		if (MaxChunkSize < indexSize)
+		{
+			return{ nullptr, nullptr, 0 };
+		}
+
+		// commit() されなかった前回の領域は上書きする。resize() は容量を保つ
+		m_vertices.resize(m_committedVertices + vertexSize);
+		m_indices.resize(m_committedIndices + indexSize);
+
+		return{ m_vertices.data() + m_committedVertices, m_indices.data() + m_committedIndices, 0 };
+	}
+
+	void SortedDrawRecorder::commit(const size_t psIndex, const uint16 indexCount)
+	{
+		commit(getBucket(psIndex, nullptr), indexCount);
+	}
+
+	void SortedDrawRecorder::commit(const size_t psIndex, const Texture& texture, const uint16 indexCount)
+	{
+		commit(getBucket(psIndex, &texture), indexCount);
+	}
+
+	bool SortedDrawRecorder::isEmpty() const noexcept
+	{
+		return (m_numBuckets == 0);
+	}
+
+	void SortedDrawRecorder::clear()
+	{
+		for (size_t i = 0; i < m_numBuckets; ++i)
+		{
+			m_buckets[i].units.clear();
+		}
+
+		m_numBuckets = 0;
+
+		m_vertices.clear();
+		m_indices.clear();
+		m_committedVertices = 0;
+		m_committedIndices = 0;
+
+		m_textures.clear();
+		m_bucketTable.clear();
+	}
+
+	SortedDrawRecorder::Bucket& SortedDrawRecorder::getBucket(const size_t psIndex, const Texture* texture)
+	{
+		const TextureID textureID = texture ? texture->id() : TextureID::InvalidValue();
+		const uint64 key = detail::MakeBucketKey(psIndex, textureID);
+
+		if (auto it = m_bucketTable.find(key); it != m_bucketTable.end())
+		{
+			return m_buckets[it->second];
+		}
+
+		m_bucketTable.emplace(key, m_numBuckets);
+
+		if (m_numBuckets == m_buckets.size())
+		{
+			m_buckets.emplace_back();
+		}
+
+		Bucket& bucket = m_buckets[m_numBuckets++];
+		bucket.psIndex = psIndex;
+		bucket.textureIndex.reset();
+
+		if (texture)
+		{
+			bucket.textureIndex = m_textures.size();
+			m_textures.push_back(*texture);
+		}
+
+		return bucket;
+	}
+
+	void SortedDrawRecorder::commit(Bucket& bucket, const uint16 indexCount)
+	{
+		const uint32 vertexCount = (static_cast<uint32>(m_vertices.size()) - m_committedVertices);
+
+		bucket.units.push_back({ m_committedVertices, vertexCount, m_committedIndices, indexCount });
+
+		m_committedVertices += vertexCount;
+		m_committedIndices += indexCount;
+
+		m_vertices.resize(m_committedVertices);
+		m_indices.resize(m_committedIndices);
+	}
+}
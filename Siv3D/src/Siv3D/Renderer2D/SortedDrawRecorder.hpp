@@ -0,0 +1,161 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Array.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/Texture.hpp>
+# include <Siv3D/Vertex2D.hpp>
+
+namespace s3d
+{
+	// 描画順に依存しない描画を (ピクセルシェーダ, テクスチャ) ごとにまとめて、描画コールを減らす
+	class SortedDrawRecorder
+	{
+	private:
+
+		using IndexType = Vertex2D::IndexType;
+
+		// 1 回の pushDraw() に渡せる最大の頂点数・インデックス数
+		static constexpr uint32 MaxChunkSize = 65535;
+
+		// 1 回の commit() で記録された範囲
+		struct DrawUnit
+		{
+			uint32 vertexPos = 0;
+
+			uint32 vertexCount = 0;
+
+			uint32 indexPos = 0;
+
+			uint32 indexCount = 0;
+		};
+
+		struct Bucket
+		{
+			size_t psIndex = 0;
+
+			// m_textures の位置。テクスチャを使わない場合は none
+			Optional<size_t> textureIndex;
+
+			Array<DrawUnit> units;
+		};
+
+		// 記録された頂点とインデックス。Vertex2DBuilder はここに直接書き込む
+		Array<Vertex2D> m_vertices;
+
+		// 各 DrawUnit の先頭頂点を 0 とするインデックス
+		Array<IndexType> m_indices;
+
+		uint32 m_committedVertices = 0;
+
+		uint32 m_committedIndices = 0;
+
+		// フレームをまたいで容量を再利用するため、バケットは破棄せず m_numBuckets 個だけを使う
+		Array<Bucket> m_buckets;
+
+		size_t m_numBuckets = 0;
+
+		Array<Texture> m_textures;
+
+		HashTable<uint64, size_t> m_bucketTable;
+
+		Bucket& getBucket(size_t psIndex, const Texture* texture);
+
+		void commit(Bucket& bucket, uint16 indexCount);
+
+	public:
+
+		[[nodiscard]] std::tuple<Vertex2D*, IndexType*, IndexType> getBuffer(uint16 vertexSize, uint32 indexSize);
+
+		template <class Command>
+		[[nodiscard]] std::tuple<Vertex2D*, IndexType*, IndexType> getBuffer(const uint16 vertexSize, const uint32 indexSize, Command&)
+		{
+			return getBuffer(vertexSize, indexSize);
+		}
+
+		// 直前の getBuffer() で書き込まれた頂点を、対応するバケットに記録する
+		void commit(size_t psIndex, uint16 indexCount);
+
+		void commit(size_t psIndex, const Texture& texture, uint16 indexCount);
+
+		[[nodiscard]] bool isEmpty() const noexcept;
+
+		void clear();
+
+		// バケットごとに頂点をバッチへ直接書き出し、描画コマンドを発行する
+		template <class Batch, class Command>
+		void flush(Batch& batches, Command& commands)
+		{
+			for (size_t bucketIndex = 0; bucketIndex < m_numBuckets; ++bucketIndex)
+			{
+				const Bucket& bucket = m_buckets[bucketIndex];
+				const Array<DrawUnit>& units = bucket.units;
+				size_t unitIndex = 0;
+
+				while (unitIndex < units.size())
+				{
+					uint32 vertexCount = 0, indexCount = 0;
+					size_t unitEnd = unitIndex;
+
+					while ((unitEnd < units.size())
+						&& ((unitEnd == unitIndex)
+							|| (((vertexCount + units[unitEnd].vertexCount) <= MaxChunkSize)
+								&& ((indexCount + units[unitEnd].indexCount) <= MaxChunkSize))))
+					{
+						vertexCount += units[unitEnd].vertexCount;
+						indexCount += units[unitEnd].indexCount;
+						++unitEnd;
+					}
+
+					auto[pVertex, pIndex, indexOffset] = batches.getBuffer(static_cast<uint16>(vertexCount), indexCount, commands);
+
+					if (!pVertex)
+					{
+						break;
+					}
+
+					IndexType baseVertex = indexOffset;
+
+					for (size_t i = unitIndex; i < unitEnd; ++i)
+					{
+						const DrawUnit& unit = units[i];
+						const IndexType* pSrc = m_indices.data() + unit.indexPos;
+
+						std::memcpy(pVertex, m_vertices.data() + unit.vertexPos, sizeof(Vertex2D) * unit.vertexCount);
+						pVertex += unit.vertexCount;
+
+						for (uint32 k = 0; k < unit.indexCount; ++k)
+						{
+							*pIndex++ = static_cast<IndexType>(baseVertex + pSrc[k]);
+						}
+
+						baseVertex = static_cast<IndexType>(baseVertex + unit.vertexCount);
+					}
+
+					unitIndex = unitEnd;
+
+					commands.pushPS(bucket.psIndex);
+
+					if (bucket.textureIndex)
+					{
+						commands.pushPSTexture(0, m_textures[*bucket.textureIndex]);
+					}
+
+					commands.pushDraw(static_cast<uint16>(indexCount));
+				}
+			}
+
+			clear();
+		}
+	};
+}
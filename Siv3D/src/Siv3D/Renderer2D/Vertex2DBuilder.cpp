@@ -15,10 +15,14 @@
 # include <Siv3D/Circular.hpp>
 # include <Siv3D/Sprite.hpp>
 # include <Siv3D/Math.hpp>
+# include <Siv3D/TextureRegion.hpp>
+# include <emmintrin.h>
 # include "Vertex2DBuilder.hpp"
 
 namespace s3d
 {
+	static_assert(sizeof(Vertex2D) == (sizeof(float) * 8));
+
 	namespace detail
 	{
 		static constexpr IndexType RectIndexTable[6] = { 0, 1, 2, 2, 1, 3 };
@@ -114,11 +118,123 @@ namespace s3d
 				: r <= 12.0f ? 8
 				: static_cast<uint16>(std::min(64.0f, r * 0.2f + 6));
 		}
+
+		inline void WriteCircle(Vertex2D* pVertex, IndexType* pIndex, const IndexType indexOffset, const Float2& center, const float r, const IndexType quality, const Float4& color)
+		{
+			const IndexType vertexSize = quality + 1;
+
+			// 中心
+			const float centerX = center.x;
+			const float centerY = center.y;
+			pVertex[0].pos.set(centerX, centerY);
+
+			// 周
+			if (quality <= MaxSinCosTableQuality)
+			{
+				const Float2* pCS = GetSinCosTableStartPtr(quality);
+				Vertex2D* pDst = &pVertex[1];
+
+				for (IndexType i = 0; i < quality; ++i)
+				{
+					(pDst++)->pos.set(r * pCS->x + centerX, r * pCS->y + centerY);
+					++pCS;
+				}
+			}
+			else
+			{
+				const float radDelta = Math::TwoPiF / quality;
+				Vertex2D* pDst = &pVertex[1];
+
+				for (IndexType i = 0; i < quality; ++i)
+				{
+					const float rad = radDelta * i;
+					(pDst++)->pos.set(centerX + r * std::cos(rad), centerY - r * std::sin(rad));
+				}
+			}
+
+			for (size_t i = 0; i < vertexSize; ++i)
+			{
+				(pVertex++)->color = color;
+			}
+
+			{
+				for (IndexType i = 0; i < quality - 1; ++i)
+				{
+					*pIndex++ = indexOffset + (i + 1);
+					*pIndex++ = indexOffset;
+					*pIndex++ = indexOffset + (i + 2);
+				}
+
+				*pIndex++ = indexOffset + quality;
+				*pIndex++ = indexOffset;
+				*pIndex++ = indexOffset + 1;
+			}
+		}
+
+		inline void WriteRectIndices(IndexType* pIndex, IndexType indexOffset, const size_t count)
+		{
+			for (size_t n = 0; n < count; ++n)
+			{
+				pIndex[0] = indexOffset;
+				pIndex[1] = indexOffset + 1;
+				pIndex[2] = indexOffset + 2;
+				pIndex[3] = indexOffset + 2;
+				pIndex[4] = indexOffset + 1;
+				pIndex[5] = indexOffset + 3;
+
+				pIndex += 6;
+				indexOffset += 4;
+			}
+		}
+
+		// 4 つの角度の sin, cos を同時に求める。誤差は 4e-6 程度
+		inline void SinCos(const __m128 angle, __m128& s, __m128& c)
+		{
+			const auto sinReduced = [](__m128 x)
+			{
+				const __m128 pi = _mm_set1_ps(Math::PiF);
+				const __m128 halfPi = _mm_set1_ps(Math::HalfPiF);
+
+				// [-π, π] に折りたたんでから、[-π/2, π/2] に折り返す
+				const __m128 q = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.0f / Math::TwoPiF))));
+				x = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(Math::TwoPiF)));
+
+				const __m128 over = _mm_cmpgt_ps(x, halfPi);
+				const __m128 under = _mm_cmplt_ps(x, _mm_sub_ps(_mm_setzero_ps(), halfPi));
+				x = _mm_or_ps(_mm_andnot_ps(over, x), _mm_and_ps(over, _mm_sub_ps(pi, x)));
+				x = _mm_or_ps(_mm_andnot_ps(under, x), _mm_and_ps(under, _mm_sub_ps(_mm_sub_ps(_mm_setzero_ps(), pi), x)));
+
+				const __m128 x2 = _mm_mul_ps(x, x);
+				__m128 p = _mm_set1_ps(2.7557319e-6f);
+				p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.98412698e-4f));
+				p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(8.33333333e-3f));
+				p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.66666667e-1f));
+				p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f));
+
+				return _mm_mul_ps(p, x);
+			};
+
+			s = sinReduced(angle);
+			c = sinReduced(_mm_add_ps(angle, _mm_set1_ps(Math::HalfPiF)));
+		}
+
+		// rect: (left, top, right, bottom), uv: (left, top, right, bottom)
+		inline void WriteQuadVertices(float* pDst, const __m128 rect, const __m128 uv, const __m128 color)
+		{
+			_mm_storeu_ps(pDst + 0, _mm_shuffle_ps(rect, uv, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm_storeu_ps(pDst + 4, color);
+			_mm_storeu_ps(pDst + 8, _mm_shuffle_ps(rect, uv, _MM_SHUFFLE(1, 2, 1, 2)));
+			_mm_storeu_ps(pDst + 12, color);
+			_mm_storeu_ps(pDst + 16, _mm_shuffle_ps(rect, uv, _MM_SHUFFLE(3, 0, 3, 0)));
+			_mm_storeu_ps(pDst + 20, color);
+			_mm_storeu_ps(pDst + 24, _mm_shuffle_ps(rect, uv, _MM_SHUFFLE(3, 2, 3, 2)));
+			_mm_storeu_ps(pDst + 28, color);
+		}
 	}
 
 	namespace Vertex2DBuilder
 	{
-		uint16 BuildSquareCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
+		uint16 BuildSquareCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
 		{
 			if (thickness <= 0.0f)
 			{
@@ -151,7 +267,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle)
+		uint16 BuildRoundCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -184,7 +300,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildUncappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
+		uint16 BuildUncappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
 		{
 			if (thickness <= 0.0f)
 			{
@@ -215,7 +331,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSquareDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const float scale)
+		uint16 BuildSquareDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const float scale)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -253,7 +369,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const bool hasAlignedDot)
+		uint16 BuildRoundDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const bool hasAlignedDot)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -297,7 +413,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4& color)
+		uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4& color)
 		{
 			constexpr IndexType vertexSize = 3, indexSize = 3;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -318,7 +434,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3])
+		uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3])
 		{
 			constexpr IndexType vertexSize = 3, indexSize = 3;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -339,7 +455,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color)
+		uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -362,7 +478,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
+		uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -385,7 +501,39 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRectFrame(BufferCreatorFunc bufferCreator, const FloatRect& rect, float thickness, const Float4& color)
+		uint16 BuildRects(const BufferCreator& bufferCreator, const FloatRect* rects, const size_t count, const Float4& color)
+		{
+			assert(count <= MaxBatchRectCount);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			const IndexType vertexSize = static_cast<IndexType>(count * 4), indexSize = static_cast<IndexType>(count * 6);
+			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (!pVertex)
+			{
+				return 0;
+			}
+
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 col = _mm_loadu_ps(&color.x);
+			float* pDst = &pVertex->pos.x;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				detail::WriteQuadVertices(pDst, _mm_loadu_ps(&rects[i].left), zero, col);
+				pDst += 32;
+			}
+
+			detail::WriteRectIndices(pIndex, indexOffset, count);
+
+			return indexSize;
+		}
+
+		uint16 BuildRectFrame(const BufferCreator& bufferCreator, const FloatRect& rect, float thickness, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 8, indexSize = 24;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -417,7 +565,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCircle(BufferCreatorFunc bufferCreator, const Float2& center, float r, const Float4& color, const float scale)
+		uint16 BuildCircle(const BufferCreator& bufferCreator, const Float2& center, float r, const Float4& color, const float scale)
 		{
 			const float absR = Math::Abs(r);
 			const IndexType quality = detail::CalculateCircleQuality(absR * scale);
@@ -429,57 +577,61 @@ namespace s3d
 				return 0;
 			}
 
-			// 中心
-			const float centerX = center.x;
-			const float centerY = center.y;
-			pVertex[0].pos.set(centerX, centerY);
+			detail::WriteCircle(pVertex, pIndex, indexOffset, center, r, quality, color);
 
-			// 周
-			if (quality <= detail::MaxSinCosTableQuality)
+			return indexSize;
+		}
+
+		uint16 BuildCircles(const BufferCreator& bufferCreator, const Circle* circles, const size_t count, const Float4& color, const float scale, size_t& builtCount)
+		{
+			builtCount = 0;
+
+			uint32 vertexSize = 0, indexSize = 0;
+
+			for (; builtCount < count; ++builtCount)
 			{
-				const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
-				Vertex2D* pDst = &pVertex[1];
+				const IndexType quality = detail::CalculateCircleQuality(static_cast<float>(Math::Abs(circles[builtCount].r)) * scale);
 
-				for (IndexType i = 0; i < quality; ++i)
+				if ((MaxBatchVertexCount < (vertexSize + quality + 1))
+					|| (MaxBatchIndexCount < (indexSize + quality * 3)))
 				{
-					(pDst++)->pos.set(r * pCS->x + centerX, r * pCS->y + centerY);
-					++pCS;
+					break;
 				}
+
+				vertexSize += (quality + 1);
+				indexSize += (quality * 3);
 			}
-			else
-			{
-				const float radDelta = Math::TwoPiF / quality;
-				Vertex2D* pDst = &pVertex[1];
 
-				for (IndexType i = 0; i < quality; ++i)
-				{
-					const float rad = radDelta * i;
-					(pDst++)->pos.set(centerX + r * std::cos(rad), centerY - r * std::sin(rad));
-				}
+			if (builtCount == 0)
+			{
+				return 0;
 			}
 
-			for (size_t i = 0; i < vertexSize; ++i)
+			auto[pVertex, pIndex, indexOffset] = bufferCreator(static_cast<IndexType>(vertexSize), static_cast<IndexType>(indexSize));
+
+			if (!pVertex)
 			{
-				(pVertex++)->color = color;
+				builtCount = 0;
+				return 0;
 			}
 
+			for (size_t i = 0; i < builtCount; ++i)
 			{
-				for (IndexType i = 0; i < quality - 1; ++i)
-				{
-					*pIndex++ = indexOffset + (i + 1);
-					*pIndex++ = indexOffset;
-					*pIndex++ = indexOffset + (i + 2);
-				}
+				const Circle& circle = circles[i];
+				const float r = static_cast<float>(circle.r);
+				const IndexType quality = detail::CalculateCircleQuality(Math::Abs(r) * scale);
 
-				*pIndex++ = indexOffset + quality;
-				*pIndex++ = indexOffset;
-				*pIndex++ = indexOffset + 1;
+				detail::WriteCircle(pVertex, pIndex, indexOffset, circle.center, r, quality, color);
+
+				pVertex += (quality + 1);
+				pIndex += (quality * 3);
+				indexOffset += (quality + 1);
 			}
 
-			return indexSize;
+			return static_cast<uint16>(indexSize);
 		}
 
-		uint16 BuildCircleFrame(BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildCircleFrame(const BufferCreator& bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float rOuter = rInner + thickness;
 			const IndexType quality = detail::CalculateCircleFrameQuality(rOuter * scale);
@@ -538,7 +690,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCirclePie(BufferCreatorFunc bufferCreator, const Float2& center, const float r, const float startAngle, const float _angle, const Float4& color, const float scale)
+		uint16 BuildCirclePie(const BufferCreator& bufferCreator, const Float2& center, const float r, const float startAngle, const float _angle, const Float4& color, const float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -590,7 +742,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& color, const float scale)
+		uint16 BuildCircleArc(const BufferCreator& bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& color, const float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -642,7 +794,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildEllipse(BufferCreatorFunc bufferCreator, const Float2& center, const float a, const float b, const Float4& color, const float scale)
+		uint16 BuildEllipse(const BufferCreator& bufferCreator, const Float2& center, const float a, const float b, const Float4& color, const float scale)
 		{
 			const float majorAxis = std::max(Math::Abs(a), Math::Abs(b));
 			const IndexType quality = static_cast<IndexType>(std::clamp(majorAxis * scale * 0.225f + 18.0f, 6.0f, 255.0f));
@@ -704,7 +856,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildEllipseFrame(BufferCreatorFunc bufferCreator, const Float2& center, const float aInner, const float bInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		uint16 BuildEllipseFrame(const BufferCreator& bufferCreator, const Float2& center, const float aInner, const float bInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float aOuter = aInner + thickness;
 			const float bOuter = bInner + thickness;
@@ -765,7 +917,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4 color)
+		uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4 color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -788,7 +940,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
+		uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -811,7 +963,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const float w, const float h, const float r, const Float4& color, float scale)
+		uint16 BuildRoundRect(const BufferCreator& bufferCreator, const FloatRect& rect, const float w, const float h, const float r, const Float4& color, float scale)
 		{
 			const float rr = std::min({ w * 0.5f, h * 0.5f, std::max(0.0f, r) });
 			const IndexType quality = detail::CaluculateFanQuality(rr * scale);
@@ -890,7 +1042,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildShape2D(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color)
+		uint16 BuildShape2D(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color)
 		{
 			if (vertices.isEmpty() || indices.isEmpty())
 			{
@@ -944,7 +1096,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildShape2DTransformed(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const float s, const float c, const Float2& offset, const Float4& color)
+		uint16 BuildShape2DTransformed(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const float s, const float c, const Float2& offset, const Float4& color)
 		{
 			if (vertices.isEmpty() || indices.isEmpty())
 			{
@@ -987,7 +1139,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildShape2DFrame(BufferCreatorFunc bufferCreator, const Float2* pts, uint16 size, const float thickness, const Float4& color, const float scale)
+		uint16 BuildShape2DFrame(const BufferCreator& bufferCreator, const Float2* pts, uint16 size, const float thickness, const Float4& color, const float scale)
 		{
 			if (size < 2 || !pts)
 			{
@@ -1177,7 +1329,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSprite(BufferCreatorFunc bufferCreator, const Sprite& sprite, const IndexType startIndex, IndexType indexCount)
+		uint16 BuildSprite(const BufferCreator& bufferCreator, const Sprite& sprite, const IndexType startIndex, IndexType indexCount)
 		{
 			if (sprite.vertices.isEmpty() || sprite.indices.isEmpty() || sprite.indices.size() <= startIndex)
 			{
@@ -1221,7 +1373,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildSquareCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const bool isClosed, const float scale)
+		uint16 BuildSquareCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const bool isClosed, const float scale)
 		{
 			if (thickness <= 0.0f || !pts || size < 2)
 			{
@@ -1454,7 +1606,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildRoundCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float& startAngle, float& endAngle)
+		uint16 BuildRoundCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float& startAngle, float& endAngle)
 		{
 			if (thickness <= 0.0f || !pts || size < 2)
 			{
@@ -1618,7 +1770,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildDotLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const Float4& color, const bool isClosed, const bool squareDot, const float dotOffset, const bool hasAlignedDot, const float scale)
+		uint16 BuildDotLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, const float thickness, const Float4& color, const bool isClosed, const bool squareDot, const float dotOffset, const bool hasAlignedDot, const float scale)
 		{
 			if (thickness <= 0.0f || !pts || size < 2)
 			{
@@ -1787,7 +1939,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+		uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -1810,7 +1962,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+		uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -1833,7 +1985,43 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTexturedCircle(BufferCreatorFunc bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
+		uint16 BuildTextureRegions(const BufferCreator& bufferCreator, const TextureRegion* regions, const Vec2* positions, const size_t count, const Float4& color)
+		{
+			assert(count <= MaxBatchRectCount);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			const IndexType vertexSize = static_cast<IndexType>(count * 4), indexSize = static_cast<IndexType>(count * 6);
+			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (!pVertex)
+			{
+				return 0;
+			}
+
+			const __m128 col = _mm_loadu_ps(&color.x);
+			float* pDst = &pVertex->pos.x;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const TextureRegion& region = regions[i];
+				const Vec2& pos = positions[i];
+				const __m128 rect = _mm_setr_ps(static_cast<float>(pos.x), static_cast<float>(pos.y),
+					static_cast<float>(pos.x + region.size.x), static_cast<float>(pos.y + region.size.y));
+
+				detail::WriteQuadVertices(pDst, rect, _mm_loadu_ps(&region.uvRect.left), col);
+				pDst += 32;
+			}
+
+			detail::WriteRectIndices(pIndex, indexOffset, count);
+
+			return indexSize;
+		}
+
+		uint16 BuildTexturedCircle(const BufferCreator& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
 		{
 			const float rf = static_cast<float>(circle.r);
 			const float absR = Math::Abs(rf);
@@ -1882,7 +2070,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTexturedQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+		uint16 BuildTexturedQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
 		{
 			constexpr IndexType vertexSize = 4, indexSize = 6;
 			auto[pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -1905,10 +2093,16 @@ namespace s3d
 			return indexSize;
 		}
 
-		uint16 BuildTexturedParticles(BufferCreatorFunc bufferCreator, const Array<Particle2D>& particles,
-			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
+		uint16 BuildParticles(const BufferCreator& bufferCreator, const ParticleBuffer2D& particles, const size_t offset, const size_t count, const ParticleLifeTimeTable2D& table)
 		{
-			const IndexType vertexSize = static_cast<IndexType>(particles.size() * 4), indexSize = static_cast<IndexType>(particles.size() * 6);
+			assert(count <= MaxBatchRectCount);
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			const IndexType vertexSize = static_cast<IndexType>(count * 4), indexSize = static_cast<IndexType>(count * 6);
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
 
 			if (!pVertex)
@@ -1916,18 +2110,76 @@ namespace s3d
 				return 0;
 			}
 
-			for (const auto& particle : particles)
+			const float* const positionX = particles.positionX() + offset;
+			const float* const positionY = particles.positionY() + offset;
+			const float* const rotation = particles.rotation() + offset;
+			const float* const startLifeTime = particles.startLifeTime() + offset;
+			const float* const remainingLifeTime = particles.remainingLifeTime() + offset;
+
+			float* pDst = &pVertex->pos.x;
+			size_t i = 0;
+
+			// 4 粒子ずつ、回転した四隅の座標をまとめて計算する
+			for (; (i + 4) <= count; i += 4)
+			{
+				__m128 s, c;
+				detail::SinCos(_mm_loadu_ps(rotation + i), s, c);
+
+				alignas(16) float halfSizes[4];
+				Float4 colors[4];
+
+				for (size_t k = 0; k < 4; ++k)
+				{
+					halfSizes[k] = table.getSize(startLifeTime[i + k], remainingLifeTime[i + k]) * 0.5f;
+					colors[k] = table.getColor(startLifeTime[i + k], remainingLifeTime[i + k]);
+				}
+
+				const __m128 halfSize = _mm_load_ps(halfSizes);
+				const __m128 xc = _mm_mul_ps(halfSize, c);
+				const __m128 xs = _mm_mul_ps(halfSize, s);
+				const __m128 cx = _mm_loadu_ps(positionX + i);
+				const __m128 cy = _mm_loadu_ps(positionY + i);
+
+				alignas(16) float corners[8][4];
+				_mm_store_ps(corners[0], _mm_add_ps(_mm_sub_ps(xs, xc), cx));
+				_mm_store_ps(corners[1], _mm_sub_ps(cy, _mm_add_ps(xs, xc)));
+				_mm_store_ps(corners[2], _mm_add_ps(_mm_add_ps(xc, xs), cx));
+				_mm_store_ps(corners[3], _mm_add_ps(_mm_sub_ps(xs, xc), cy));
+				_mm_store_ps(corners[4], _mm_sub_ps(cx, _mm_add_ps(xc, xs)));
+				_mm_store_ps(corners[5], _mm_add_ps(_mm_sub_ps(xc, xs), cy));
+				_mm_store_ps(corners[6], _mm_add_ps(_mm_sub_ps(xc, xs), cx));
+				_mm_store_ps(corners[7], _mm_add_ps(_mm_add_ps(xs, xc), cy));
+
+				for (size_t k = 0; k < 4; ++k)
+				{
+					const __m128 color = _mm_loadu_ps(&colors[k].x);
+
+					_mm_storeu_ps(pDst + 0, _mm_setr_ps(corners[0][k], corners[1][k], 0.0f, 0.0f));
+					_mm_storeu_ps(pDst + 4, color);
+					_mm_storeu_ps(pDst + 8, _mm_setr_ps(corners[2][k], corners[3][k], 1.0f, 0.0f));
+					_mm_storeu_ps(pDst + 12, color);
+					_mm_storeu_ps(pDst + 16, _mm_setr_ps(corners[4][k], corners[5][k], 0.0f, 1.0f));
+					_mm_storeu_ps(pDst + 20, color);
+					_mm_storeu_ps(pDst + 24, _mm_setr_ps(corners[6][k], corners[7][k], 1.0f, 1.0f));
+					_mm_storeu_ps(pDst + 28, color);
+					pDst += 32;
+				}
+			}
+
+			pVertex += i * 4;
+
+			for (; i < count; ++i)
 			{
-				const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-				const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+				const float size = table.getSize(startLifeTime[i], remainingLifeTime[i]);
+				const Float4 color = table.getColor(startLifeTime[i], remainingLifeTime[i]);
 
 				const float size_half = (size * 0.5f);
-				const float cx = particle.position.x;
-				const float cy = particle.position.y;
+				const float cx = positionX[i];
+				const float cy = positionY[i];
 
 				const float x = size_half;
-				const float s = std::sin(particle.rotation);
-				const float c = std::cos(particle.rotation);
+				const float s = std::sin(rotation[i]);
+				const float c = std::cos(rotation[i]);
 				const float xc = x * c;
 				const float xs = x * s;
 
@@ -1938,19 +2190,7 @@ namespace s3d
 				pVertex += 4;
 			}
 
-			{
-				IndexType indexBase = indexOffset;
-
-				for (IndexType n = 0; n < particles.size(); ++n)
-				{
-					for (IndexType i = 0; i < 6; ++i)
-					{
-						*pIndex++ = (indexBase + detail::RectIndexTable[i]);
-					}
-
-					indexBase += 4;
-				}
-			}
+			detail::WriteRectIndices(pIndex, indexOffset, count);
 
 			return indexSize;
 		}
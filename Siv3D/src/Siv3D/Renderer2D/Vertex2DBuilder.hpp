@@ -14,76 +14,122 @@
 # include <Siv3D/Vertex2D.hpp>
 # include <Siv3D/Particle2D.hpp>
 # include <Siv3D/ParticleSystem2D.hpp>
+# include <ParticleSystem2D/ParticleBuffer2D.hpp>
 
 namespace s3d
 {
 	using IndexType = Vertex2D::IndexType;
 
-	using BufferCreatorFunc = std::function<std::tuple<Vertex2D*, IndexType*, IndexType>(IndexType, IndexType)>;
+	// std::function を使わない、コピーの軽いバッファ確保関数への参照
+	class BufferCreator
+	{
+	private:
+
+		using BufferType = std::tuple<Vertex2D*, IndexType*, IndexType>;
+
+		using ThunkType = BufferType(*)(void*, void*, IndexType, IndexType);
+
+		void* m_batch = nullptr;
+
+		void* m_command = nullptr;
+
+		ThunkType m_thunk = nullptr;
+
+	public:
+
+		BufferCreator() = default;
+
+		template <class Batch, class Command>
+		BufferCreator(Batch& batch, Command& command) noexcept
+			: m_batch(std::addressof(batch))
+			, m_command(std::addressof(command))
+			, m_thunk([](void* b, void* c, const IndexType vertexSize, const IndexType indexSize) -> BufferType
+				{
+					return static_cast<Batch*>(b)->getBuffer(vertexSize, indexSize, *static_cast<Command*>(c));
+				}) {}
+
+		BufferType operator()(const IndexType vertexSize, const IndexType indexSize) const
+		{
+			return m_thunk(m_batch, m_command, vertexSize, indexSize);
+		}
+	};
 
 	namespace Vertex2DBuilder
 	{
-		[[nodiscard]] uint16 BuildSquareCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+		// Build*s() が 1 回で書き込む最大の頂点数・インデックス数
+		inline constexpr uint32 MaxBatchVertexCount = 32768;
+
+		inline constexpr uint32 MaxBatchIndexCount = 65535;
+
+		inline constexpr size_t MaxBatchRectCount = (MaxBatchVertexCount / 4);
 
-		[[nodiscard]] uint16 BuildRoundCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle);
+		[[nodiscard]] uint16 BuildSquareCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
 
-		[[nodiscard]] uint16 BuildUncappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+		[[nodiscard]] uint16 BuildRoundCappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle);
 
-		[[nodiscard]] uint16 BuildSquareDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, float scale);
+		[[nodiscard]] uint16 BuildUncappedLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
 
-		[[nodiscard]] uint16 BuildRoundDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
+		[[nodiscard]] uint16 BuildSquareDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, float scale);
 
-		[[nodiscard]] uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4& color);
+		[[nodiscard]] uint16 BuildRoundDotLine(const BufferCreator& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
 
-		[[nodiscard]] uint16 BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3]);
+		[[nodiscard]] uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4& color);
 
-		[[nodiscard]] uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color);
+		[[nodiscard]] uint16 BuildTriangle(const BufferCreator& bufferCreator, const Float2(&pts)[3], const Float4(&colors)[3]);
 
-		[[nodiscard]] uint16 BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
+		[[nodiscard]] uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4& color);
 
-		[[nodiscard]] uint16 BuildRectFrame(BufferCreatorFunc bufferCreator, const FloatRect& rect, float thickness, const Float4& color);
+		[[nodiscard]] uint16 BuildRect(const BufferCreator& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
 
-		[[nodiscard]] uint16 BuildCircle(BufferCreatorFunc bufferCreator, const Float2& center, float r, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildRects(const BufferCreator& bufferCreator, const FloatRect* rects, size_t count, const Float4& color);
 
-		[[nodiscard]] uint16 BuildCircleFrame(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildRectFrame(const BufferCreator& bufferCreator, const FloatRect& rect, float thickness, const Float4& color);
 
-		[[nodiscard]] uint16 BuildCirclePie(BufferCreatorFunc bufferCreator, const Float2& center, float r, float startAngle, float angle, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildCircle(const BufferCreator& bufferCreator, const Float2& center, float r, const Float4& color, float scale);
+
+		[[nodiscard]] uint16 BuildCircles(const BufferCreator& bufferCreator, const Circle* circles, size_t count, const Float4& color, float scale, size_t& builtCount);
+
+		[[nodiscard]] uint16 BuildCircleFrame(const BufferCreator& bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+
+		[[nodiscard]] uint16 BuildCirclePie(const BufferCreator& bufferCreator, const Float2& center, float r, float startAngle, float angle, const Float4& color, float scale);
 	
-		[[nodiscard]] uint16 BuildCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildCircleArc(const BufferCreator& bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildEllipse(BufferCreatorFunc bufferCreator, const Float2& center, float a, float b, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildEllipse(const BufferCreator& bufferCreator, const Float2& center, float a, float b, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildEllipseFrame(BufferCreatorFunc bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		[[nodiscard]] uint16 BuildEllipseFrame(const BufferCreator& bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
-		[[nodiscard]] uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4 color);
+		[[nodiscard]] uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4 color);
 
-		[[nodiscard]] uint16 BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
+		[[nodiscard]] uint16 BuildQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
 
-		[[nodiscard]] uint16 BuildRoundRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildRoundRect(const BufferCreator& bufferCreator, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildShape2D(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color);
+		[[nodiscard]] uint16 BuildShape2D(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, const Optional<Float2>& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildShape2DTransformed(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color);
+		[[nodiscard]] uint16 BuildShape2DTransformed(const BufferCreator& bufferCreator, const Array<Float2>& vertices, const Array<uint16>& indices, float s, float c, const Float2& offset, const Float4& color);
 
-		[[nodiscard]] uint16 BuildShape2DFrame(BufferCreatorFunc bufferCreator, const Float2* pts, uint16 size, float thickness, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildShape2DFrame(const BufferCreator& bufferCreator, const Float2* pts, uint16 size, float thickness, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildSprite(BufferCreatorFunc bufferCreator, const Sprite& sprite, IndexType startIndex, IndexType indexCount);
+		[[nodiscard]] uint16 BuildSprite(const BufferCreator& bufferCreator, const Sprite& sprite, IndexType startIndex, IndexType indexCount);
 
-		[[nodiscard]] uint16 BuildSquareCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, bool isClosed, float scale);
+		[[nodiscard]] uint16 BuildSquareCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, bool isClosed, float scale);
 
-		[[nodiscard]] uint16 BuildRoundCappedLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float& startAngle, float& endAngle);
+		[[nodiscard]] uint16 BuildRoundCappedLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float& startAngle, float& endAngle);
 
-		[[nodiscard]] uint16 BuildDotLineString(BufferCreatorFunc bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, const Float4& color, bool isClosed, bool squareDot, float dotOffset, bool hasAlignedDot, float scale);
+		[[nodiscard]] uint16 BuildDotLineString(const BufferCreator& bufferCreator, const Vec2* pts, uint16 size, const Optional<Float2>& offset, float thickness, const Float4& color, bool isClosed, bool squareDot, float dotOffset, bool hasAlignedDot, float scale);
 
-		[[nodiscard]] uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
+		[[nodiscard]] uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
 
-		[[nodiscard]] uint16 BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
+		[[nodiscard]] uint16 BuildTextureRegion(const BufferCreator& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
 	
-		[[nodiscard]] uint16 BuildTexturedCircle(BufferCreatorFunc bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
+		[[nodiscard]] uint16 BuildTextureRegions(const BufferCreator& bufferCreator, const TextureRegion* regions, const Vec2* positions, size_t count, const Float4& color);
+
+		[[nodiscard]] uint16 BuildTexturedCircle(const BufferCreator& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
 
-		[[nodiscard]] uint16 BuildTexturedQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
+		[[nodiscard]] uint16 BuildTexturedQuad(const BufferCreator& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
 	
-		[[nodiscard]] uint16 BuildTexturedParticles(BufferCreatorFunc bufferCreator, const Array<Particle2D>& particles,
-			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
+		// particles の [offset, offset + count) の粒子を書き込む。count は MaxBatchRectCount 以下
+		[[nodiscard]] uint16 BuildParticles(const BufferCreator& bufferCreator, const ParticleBuffer2D& particles, size_t offset, size_t count, const ParticleLifeTimeTable2D& table);
 	}
 }
@@ -0,0 +1,53 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ScopedDrawSorting2D.hpp>
+
+namespace s3d
+{
+	ScopedDrawSorting2D::ScopedDrawSorting2D()
+		: ScopedDrawSorting2D(true) {}
+
+	ScopedDrawSorting2D::ScopedDrawSorting2D(const bool enabled)
+		: m_oldDrawSorting(Graphics2D::GetDrawSorting())
+	{
+		Graphics2D::SetDrawSorting(enabled);
+	}
+
+	ScopedDrawSorting2D::ScopedDrawSorting2D(ScopedDrawSorting2D&& other)
+	{
+		m_oldDrawSorting = other.m_oldDrawSorting;
+
+		other.clear();
+	}
+
+	ScopedDrawSorting2D::~ScopedDrawSorting2D()
+	{
+		m_oldDrawSorting.then(Graphics2D::SetDrawSorting);
+	}
+
+	ScopedDrawSorting2D& ScopedDrawSorting2D::operator =(ScopedDrawSorting2D&& other)
+	{
+		if (!m_oldDrawSorting && other.m_oldDrawSorting)
+		{
+			m_oldDrawSorting = other.m_oldDrawSorting;
+		}
+
+		other.clear();
+
+		return *this;
+	}
+
+	void ScopedDrawSorting2D::clear()
+	{
+		m_oldDrawSorting.reset();
+	}
+}
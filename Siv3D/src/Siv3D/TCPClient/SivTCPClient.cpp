@@ -84,4 +84,14 @@ namespace s3d
 	{
 		return pImpl->send(data, size);
 	}
+
+	bool TCPClient::sendMessage(const void* data, const size_t size)
+	{
+		return pImpl->sendMessage(data, size);
+	}
+
+	Optional<ByteArrayView> TCPClient::receiveMessage()
+	{
+		return pImpl->receiveMessage();
+	}
 }
@@ -217,4 +217,24 @@ namespace s3d
 
 		return m_session->send(data, size);
 	}
+
+	bool TCPClient::TCPClientDetail::sendMessage(const void* data, const size_t size)
+	{
+		if (!m_session)
+		{
+			return false;
+		}
+
+		return m_session->sendMessage(data, size);
+	}
+
+	Optional<ByteArrayView> TCPClient::TCPClientDetail::receiveMessage()
+	{
+		if (!m_session)
+		{
+			return none;
+		}
+
+		return m_session->receiveMessage();
+	}
 }
@@ -24,6 +24,7 @@
 # endif
 # define  ASIO_STANDALONE
 # include <asio/asio.hpp>
+# include <Network/TCPBuffer.hpp>
 
 namespace s3d
 {
@@ -39,32 +40,39 @@ namespace s3d
 
 			bool m_isActive = false;
 
-			asio::streambuf m_streamBuffer;
-
-			// 受信	
-			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
-
-			std::mutex m_mutexReceivedBuffer;
-
-			Array<Byte> m_receivedBuffer;
+			// 受信
+			TCPReceiveBuffer m_receiveBuffer;
 
 
 			// 送信
-			std::mutex m_mutexSendingBuffer;
-
-			Array<Array<Byte>> m_sendingBuffer;
+			TCPSendQueue m_sendQueue;
 
-			bool m_isSending = false;
+			// 送信中のチャンクを指すバッファ列。1 回の async_write でまとめて書き込む
+			Array<asio::const_buffer> m_sendBuffers;
 
 
 			void send_internal()
 			{
-				m_isSending = true;
+				m_sendBuffers.clear();
+
+				for (const auto& chunk : m_sendQueue.beginSend())
+				{
+					m_sendBuffers.push_back(asio::buffer(chunk.data(), chunk.size()));
+				}
 
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
+				asio::async_write(m_socket, m_sendBuffers,
 					std::bind(&ClientSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
+			// receiveMessage() のビューを解放したことで、止まっていた受信を再開する
+			void resumeReceive(const bool resume)
+			{
+				if (resume && m_isActive)
+				{
+					asio::post(m_socket.get_executor(), std::bind(&ClientSession::startReceive, shared_from_this()));
+				}
+			}
+
 		public:
 
 			ClientSession(asio::io_service& io_service)
@@ -99,24 +107,15 @@ namespace s3d
 
 				m_socket.close();
 
-				if (!m_isSending)
-				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-					m_sendingBuffer.clear();
-				}
+				m_sendQueue.clear();
 
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
-					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
-				}
+				m_receiveBuffer.clear();
 
 				if (m_isActive)
 				{
 					LOG_DEBUG(U"Session closed");
 				}
 
-				m_isSending = false;
 				m_isActive = false;
 			}
 
@@ -132,18 +131,47 @@ namespace s3d
 
 			size_t available()
 			{
-				std::lock_guard lock(m_mutexReceivedBuffer);
+				bool resume = false;
 
-				return m_receivedBuffer.size();
+				const size_t size = m_receiveBuffer.available(resume);
+
+				resumeReceive(resume);
+
+				return size;
 			}
 
 			void startReceive()
 			{
-				asio::async_read(m_socket, m_streamBuffer, asio::transfer_at_least(1),
+				std::array<std::pair<Byte*, size_t>, 2> regions;
+
+				switch (m_receiveBuffer.prepare(regions))
+				{
+				case TCPReceiveBuffer::PrepareResult::Paused:
+					return;
+				case TCPReceiveBuffer::PrepareResult::Overflow:
+					LOG_FAIL(U"TCPClient: onReceive exceeded the maximum buffer size");
+
+					m_error = NetworkError::NoBufferSpaceAvailable;
+
+					close();
+
+					return;
+				default:
+					break;
+				}
+
+				// リングバッファの空き領域に直接読み込む
+				const std::array<asio::mutable_buffer, 2> buffers =
+				{
+					asio::buffer(regions[0].first, regions[0].second),
+					asio::buffer(regions[1].first, regions[1].second)
+				};
+
+				m_socket.async_read_some(buffers,
 					std::bind(&ClientSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
 			}
 
-			void onReceive(const asio::error_code& error, size_t, const std::shared_ptr<ClientSession>&)
+			void onReceive(const asio::error_code& error, const size_t size, const std::shared_ptr<ClientSession>&)
 			{
 				if (error)
 				{
@@ -160,48 +188,23 @@ namespace s3d
 						m_error = NetworkError::EoF;
 					}
 
-					m_streamBuffer.consume(m_streamBuffer.size());
-
 					close();
 
 					return;
 				}
 
-				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
-				const size_t size = m_streamBuffer.size();
-
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
-
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPClient: onReceive exceeded the maximum buffer size");
-
-						m_error = NetworkError::NoBufferSpaceAvailable;
-
-						m_streamBuffer.consume(m_streamBuffer.size());
-
-						close();
-
-						return;
-					}
-
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
-				}
-
-				m_streamBuffer.consume(m_streamBuffer.size());
+				m_receiveBuffer.commit(size);
 
 				startReceive();
 			}
 
 			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ClientSession>&)
 			{
-				m_isSending = false;
+				const bool hasQueued = m_sendQueue.endSend();
 
 				if (!m_isActive)
 				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-					m_sendingBuffer.clear();
+					m_sendQueue.clear();
 					return;
 				}
 
@@ -216,18 +219,9 @@ namespace s3d
 					return;
 				}
 
+				if (hasQueued)
 				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
-
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
+					send_internal();
 				}
 			}
 
@@ -238,52 +232,64 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
+				bool resume = false;
+
+				const bool result = m_receiveBuffer.skip(size, resume);
+
+				resumeReceive(resume);
+
+				return result;
+			}
+
+			bool lookahead(void* dst, const size_t size)
+			{
+				if (!m_isActive)
 				{
-					return true;
+					return false;
 				}
 
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
+				bool resume = false;
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
+				const bool result = m_receiveBuffer.lookahead(dst, size, resume);
 
-					m_receivedBuffer.drop(size);
-				}
+				resumeReceive(resume);
 
-				return true;
+				return result;
 			}
 
-			bool lookahead(void* dst, const size_t size)
+			bool read(void* dst, const size_t size)
 			{
 				if (!m_isActive)
 				{
 					return false;
 				}
 
-				if (size == 0)
+				bool resume = false;
+
+				const bool result = m_receiveBuffer.read(dst, size, resume);
+
+				resumeReceive(resume);
+
+				return result;
+			}
+
+			Optional<ByteArrayView> receiveMessage()
+			{
+				if (!m_isActive)
 				{
-					return true;
+					return none;
 				}
 
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
+				bool resume = false;
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				const auto message = m_receiveBuffer.receiveMessage(resume);
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
-				}
+				resumeReceive(resume);
 
-				return true;
+				return message;
 			}
 
-			bool read(void* dst, const size_t size)
+			bool send(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
@@ -295,43 +301,29 @@ namespace s3d
 					return true;
 				}
 
+				if (m_sendQueue.push(data, size))
 				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
-
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
-
-					std::memcpy(dst, m_receivedBuffer.data(), size);
-
-					m_receivedBuffer.drop(size);
+					send_internal();
 				}
 
 				return true;
 			}
 
-			bool send(const void* data, const size_t size)
+			bool sendMessage(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
 					return false;
 				}
 
-				if (size == 0)
+				if ((sizeof(TCPMessageHeader) + size) > TCPReceiveBuffer::MaxBufferSize)
 				{
-					return true;
+					return false;
 				}
 
+				if (m_sendQueue.pushMessage(data, size))
 				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
-
-					if (!m_isSending)
-					{
-						send_internal();
-					}
+					send_internal();
 				}
 
 				return true;
@@ -390,5 +382,9 @@ namespace s3d
 		bool read(void* dst, size_t size);
 
 		bool send(const void* data, size_t size);
+
+		bool sendMessage(const void* data, size_t size);
+
+		Optional<ByteArrayView> receiveMessage();
 	};
 }
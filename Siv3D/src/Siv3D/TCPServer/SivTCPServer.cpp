@@ -30,9 +30,9 @@ namespace s3d
 		pImpl->startAccept(port);
 	}
 
-	void TCPServer::startAcceptMulti(const uint16 port)
+	void TCPServer::startAcceptMulti(const uint16 port, const size_t numThreads)
 	{
-		pImpl->startAcceptMulti(port);
+		pImpl->startAcceptMulti(port, numThreads);
 	}
 
 	void TCPServer::cancelAccept()
@@ -99,4 +99,19 @@ namespace s3d
 	{
 		return pImpl->send(data, size, id);
 	}
+
+	bool TCPServer::sendMessage(const void* data, const size_t size, const Optional<SessionID>& id)
+	{
+		return pImpl->sendMessage(data, size, id);
+	}
+
+	Optional<ByteArrayView> TCPServer::receiveMessage(const Optional<SessionID>& id)
+	{
+		return pImpl->receiveMessage(id);
+	}
+
+	Array<TCPSessionEvent> TCPServer::getEvents()
+	{
+		return pImpl->getEvents();
+	}
 }
@@ -15,6 +15,7 @@ namespace s3d
 {
 	TCPServer::TCPServerDetail::TCPServerDetail()
 		: m_io_service(std::make_shared<asio::io_service>())
+		, m_events(std::make_shared<detail::ServerEventQueue>())
 	{
 
 	}
@@ -35,24 +36,14 @@ namespace s3d
 
 		m_allowMulti = false;
 
-		m_port = port;
-
-		if (!m_work)
-		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
-
-			m_io_service_thread = std::async([=] { m_io_service->run(); });
-		}
-
-		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+		m_events->enable();
 
-		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
+		startThreads(1);
 
-		m_acceptor->async_accept(newSession->socket(),
-			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+		startAccept_internal(port);
 	}
 
-	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port)
+	void TCPServer::TCPServerDetail::startAcceptMulti(const uint16 port, const size_t numThreads)
 	{
 		if (m_accepting)
 		{
@@ -63,21 +54,11 @@ namespace s3d
 
 		m_allowMulti = true;
 
-		m_port = port;
+		m_events->enable();
 
-		if (!m_work)
-		{
-			m_work = std::make_unique<asio::io_service::work>(*m_io_service);
+		startThreads(numThreads);
 
-			m_io_service_thread = std::async([=] { m_io_service->run(); });
-		}
-
-		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
-
-		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
-
-		m_acceptor->async_accept(newSession->socket(),
-			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
+		startAccept_internal(port);
 	}
 
 	void TCPServer::TCPServerDetail::cancelAccept()
@@ -99,29 +80,41 @@ namespace s3d
 	{
 		cancelAccept();
 
-		for (auto& session : m_sessions)
-		{
-			session.second->close();
-		}
-
-		m_sessions.clear();
-
+		// I/O スレッドを止めてから閉じ、ハンドラと並行してソケットを操作しないようにする
 		if (m_work)
 		{
 			m_work.reset();
 
 			m_io_service->stop();
 
-			m_io_service_thread.wait();
+			for (auto& thread : m_io_service_threads)
+			{
+				thread.wait();
+			}
+
+			m_io_service_threads.clear();
 
 			m_io_service->restart();
 		}
+
+		{
+			std::lock_guard lock(m_mutexSessions);
+
+			for (auto& session : m_sessions)
+			{
+				session.second->close();
+			}
+
+			m_sessions.clear();
+		}
 	}
 
 	bool TCPServer::TCPServerDetail::hasSession()
 	{
 		updateSession();
 
+		std::lock_guard lock(m_mutexSessions);
+
 		return m_sessions.any([](const auto& session) { return session.second->isActive(); });
 	}
 
@@ -129,13 +122,15 @@ namespace s3d
 	{
 		updateSession();
 
-		return m_sessions.includes_if([=](const auto& session) { return session.first == id; });
+		return (findSession(id) != nullptr);
 	}
 
 	size_t TCPServer::TCPServerDetail::num_sessions()
 	{
 		updateSession();
 
+		std::lock_guard lock(m_mutexSessions);
+
 		return m_sessions.count_if([](const auto& session) { return session.second->isActive(); });
 	}
 
@@ -143,6 +138,8 @@ namespace s3d
 	{
 		updateSession();
 
+		std::lock_guard lock(m_mutexSessions);
+
 		return m_sessions.map([](const auto& session) { return session.first; });
 	}
 
@@ -153,19 +150,9 @@ namespace s3d
 
 	size_t TCPServer::TCPServerDetail::available(const Optional<SessionID>& id)
 	{
-		if (m_sessions.isEmpty())
-		{
-			return 0;
-		}
-
-		const SessionID sessionID = id.value_or(m_sessions.front().first);
-
-		for (auto& session : m_sessions)
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->available();
-			}
+			return session->available();
 		}
 
 		return 0;
@@ -173,82 +160,94 @@ namespace s3d
 
 	bool TCPServer::TCPServerDetail::skip(const size_t size, const Optional<SessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->skip(size);
 		}
 
-		const SessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<SessionID>& id) const
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->skip(size);
-			}
+			return session->lookahead(dst, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::lookahead(void* dst, const size_t size, const Optional<SessionID>& id) const
+	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<SessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->read(dst, size);
 		}
 
-		const SessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<SessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->lookahead(dst, size);
-			}
+			return session->send(data, size);
 		}
 
 		return false;
 	}
 
-	bool TCPServer::TCPServerDetail::read(void* dst, const size_t size, const Optional<SessionID>& id)
+	bool TCPServer::TCPServerDetail::sendMessage(const void* data, const size_t size, const Optional<SessionID>& id)
 	{
-		if (m_sessions.isEmpty())
+		if (const auto session = findSession(id))
 		{
-			return false;
+			return session->sendMessage(data, size);
 		}
 
-		const SessionID sessionID = id.value_or(m_sessions.front().first);
+		return false;
+	}
 
-		for (auto& session : m_sessions)
+	Optional<ByteArrayView> TCPServer::TCPServerDetail::receiveMessage(const Optional<SessionID>& id)
+	{
+		if (const auto session = findSession(id))
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->read(dst, size);
-			}
+			return session->receiveMessage();
 		}
 
-		return false;
+		return none;
 	}
 
-	bool TCPServer::TCPServerDetail::send(const void* data, const size_t size, const Optional<SessionID>& id)
+	Array<TCPSessionEvent> TCPServer::TCPServerDetail::getEvents()
 	{
-		if (m_sessions.isEmpty())
+		return m_events->pop();
+	}
+
+	void TCPServer::TCPServerDetail::startThreads(const size_t numThreads)
+	{
+		if (m_work)
 		{
-			return false;
+			return;
 		}
 
-		const SessionID sessionID = id.value_or(m_sessions.front().first);
+		m_work = std::make_unique<asio::io_service::work>(*m_io_service);
 
-		for (auto& session : m_sessions)
+		for (size_t i = 0; i < Max<size_t>(numThreads, 1); ++i)
 		{
-			if (session.first == sessionID)
-			{
-				return session.second->send(data, size);
-			}
+			m_io_service_threads.push_back(std::async(std::launch::async, [=] { m_io_service->run(); }));
 		}
+	}
 
-		return false;
+	void TCPServer::TCPServerDetail::startAccept_internal(const uint16 port)
+	{
+		m_port = port;
+
+		m_acceptor = std::make_unique<asio::ip::tcp::acceptor>(*m_io_service, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+
+		std::shared_ptr<detail::ServerSession> newSession = std::make_shared<detail::ServerSession>(*m_io_service);
+
+		m_acceptor->async_accept(newSession->socket(),
+			std::bind(&TCPServerDetail::onAccept, this, std::placeholders::_1, newSession));
 	}
 
 	void TCPServer::TCPServerDetail::onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session)
@@ -271,7 +270,7 @@ namespace s3d
 
 		const SessionID id = ++m_currentSessionID;
 
-		session->init(id);
+		session->init(id, m_events);
 
 		LOG_INFO(U"TCPServer: accepted: remote {}<{}> local {}<{}>"_fmt(
 			Unicode::WidenAscii(session->socket().remote_endpoint().address().to_string()),
@@ -279,11 +278,16 @@ namespace s3d
 			Unicode::WidenAscii(session->socket().local_endpoint().address().to_string()),
 			session->socket().local_endpoint().port()));
 
-		m_sessions.push_back({ id, session });
+		// ユーザスレッドから見える前に受信を開始する
+		session->startReceive();
 
-		LOG_DEBUG(U"TCPServer session [{}] created"_fmt(id));
+		{
+			std::lock_guard lock(m_mutexSessions);
 
-		m_sessions.back().second->startReceive();
+			m_sessions.push_back({ id, session });
+		}
+
+		LOG_DEBUG(U"TCPServer session [{}] created"_fmt(id));
 
 		if (m_allowMulti)
 		{
@@ -300,6 +304,31 @@ namespace s3d
 
 	void TCPServer::TCPServerDetail::updateSession()
 	{
+		std::lock_guard lock(m_mutexSessions);
+
 		m_sessions.remove_if([](const auto& session) { return !session.second->isActive(); });
 	}
+
+	std::shared_ptr<detail::ServerSession> TCPServer::TCPServerDetail::findSession(const Optional<SessionID>& id) const
+	{
+		std::lock_guard lock(m_mutexSessions);
+
+		if (m_sessions.isEmpty())
+		{
+			return nullptr;
+		}
+
+		const SessionID sessionID = id.value_or(m_sessions.front().first);
+
+		// ID は昇順に追加され、削除しても順序は変わらないので二分探索できる
+		const auto it = std::lower_bound(m_sessions.begin(), m_sessions.end(), sessionID,
+			[](const auto& session, const SessionID value) { return session.first < value; });
+
+		if ((it == m_sessions.end()) || (it->first != sessionID))
+		{
+			return nullptr;
+		}
+
+		return it->second;
+	}
 }
@@ -10,6 +10,10 @@
 //-----------------------------------------------
 
 # pragma once
+# include <atomic>
+# include <deque>
+# include <future>
+# include <mutex>
 # include <Siv3D/TCPServer.hpp>
 # include <Siv3D/Array.hpp>
 # include <Siv3D/EngineLog.hpp>
@@ -23,54 +27,142 @@
 # endif
 # define  ASIO_STANDALONE
 # include <asio/asio.hpp>
+# include <Network/TCPBuffer.hpp>
 
 
 namespace s3d
 {
 	namespace detail
 	{
+		// セッションのイベントを I/O スレッドからユーザスレッドに渡すキュー
+		class ServerEventQueue
+		{
+		public:
+
+			// getEvents() が呼ばれない場合でも増え続けないよう、これを超えたら古いイベントから捨てる
+			static constexpr size_t MaxEvents = 4096;
+
+		private:
+
+			std::mutex m_mutex;
+
+			std::deque<TCPSessionEvent> m_events;
+
+			// 接続の受け付けを開始するまでは記録しない
+			std::atomic<bool> m_enabled = false;
+
+		public:
+
+			void enable()
+			{
+				m_enabled = true;
+			}
+
+			bool isEnabled() const
+			{
+				return m_enabled;
+			}
+
+			void push(const SessionID id, const TCPSessionEventType type)
+			{
+				if (!m_enabled)
+				{
+					return;
+				}
+
+				std::lock_guard lock(m_mutex);
+
+				if (m_events.size() == MaxEvents)
+				{
+					m_events.pop_front();
+				}
+
+				m_events.push_back({ id, type });
+			}
+
+			Array<TCPSessionEvent> pop()
+			{
+				std::lock_guard lock(m_mutex);
+
+				Array<TCPSessionEvent> events(m_events.begin(), m_events.end());
+
+				m_events.clear();
+
+				return events;
+			}
+
+			void clear()
+			{
+				std::lock_guard lock(m_mutex);
+
+				m_events.clear();
+			}
+		};
+
 		class ServerSession : public std::enable_shared_from_this<ServerSession>
 		{
 		private:
 
 			asio::ip::tcp::socket m_socket;
 
-			SessionID m_id = 0;
+			// 複数の I/O スレッドで動かすとき、このセッションのハンドラを直列化する
+			asio::io_context::strand m_strand;
 
-			bool m_isActive = false;
+			std::shared_ptr<ServerEventQueue> m_events;
 
-			bool m_eof = false;
+			SessionID m_id = 0;
 
-			asio::streambuf m_streamBuffer;
+			std::atomic<bool> m_isActive = false;
 
-			// 受信	
-			static constexpr size_t maxBufferSize = 32 * 1024 * 1024;
+			// DataReceived を通知済みで、まだ読み出し操作が行われていない
+			std::atomic<bool> m_dataNotified = false;
 
-			std::mutex m_mutexReceivedBuffer;
+			bool m_eof = false;
 
-			Array<Byte> m_receivedBuffer;
+			// 受信
+			TCPReceiveBuffer m_receiveBuffer;
 
 
 			// 送信
-			std::mutex m_mutexSendingBuffer;
+			TCPSendQueue m_sendQueue;
 
-			Array<Array<Byte>> m_sendingBuffer;
-
-			bool m_isSending = false;
+			// 送信中のチャンクを指すバッファ列。1 回の async_write でまとめて書き込む
+			Array<asio::const_buffer> m_sendBuffers;
 
 
 			void send_internal()
 			{
-				m_isSending = true;
+				m_sendBuffers.clear();
 
-				asio::async_write(m_socket, asio::buffer(m_sendingBuffer.front().data(), m_sendingBuffer.front().size()),
-					std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
+				for (const auto& chunk : m_sendQueue.beginSend())
+				{
+					m_sendBuffers.push_back(asio::buffer(chunk.data(), chunk.size()));
+				}
+
+				asio::async_write(m_socket, m_sendBuffers, asio::bind_executor(m_strand,
+					std::bind(&ServerSession::onSend, this, std::placeholders::_1, std::placeholders::_2, shared_from_this())));
+			}
+
+			// receiveMessage() のビューを解放したことで、止まっていた受信を再開する
+			void resumeReceive(const bool resume)
+			{
+				if (resume && m_isActive)
+				{
+					asio::post(m_strand, std::bind(&ServerSession::startReceive, shared_from_this()));
+				}
+			}
+
+			// 読み出し操作の前に呼び、次に届いたデータで DataReceived が通知されるようにする
+			void rearmDataEvent()
+			{
+				m_dataNotified = false;
 			}
 
 		public:
 
 			ServerSession(asio::io_service& io_service)
 				: m_socket(io_service)
+				, m_strand(io_service)
 			{
 
 			}
@@ -82,7 +174,7 @@ namespace s3d
 
 			void close()
 			{
-				if (m_id == 0)
+				if (!m_isActive.exchange(false))
 				{
 					return;
 				}
@@ -94,36 +186,32 @@ namespace s3d
 
 				m_socket.close();
 
-				if (!m_isSending)
-				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-					m_sendingBuffer.clear();
-				}
+				m_sendQueue.clear();
 
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
-					m_receivedBuffer.clear();
-					m_streamBuffer.consume(m_streamBuffer.size());
-				}
+				m_receiveBuffer.clear();
 
-				m_isSending = false;
-				m_isActive = false;
 				m_eof = false;
 
-				if (m_id)
+				if (m_events)
 				{
-					LOG_DEBUG(U"Session [{}] closed"_fmt(m_id));
+					m_events->push(m_id, TCPSessionEventType::Disconnected);
 				}
 
+				LOG_DEBUG(U"Session [{}] closed"_fmt(m_id));
+
 				m_id = 0;
 			}
 
-			void init(const SessionID id)
+			void init(const SessionID id, const std::shared_ptr<ServerEventQueue>& events)
 			{
 				m_id = id;
 
+				m_events = events;
+
 				m_isActive = true;
 
+				m_events->push(id, TCPSessionEventType::Connected);
+
 				LOG_DEBUG(U"Session [{}] created"_fmt(id));
 			}
 
@@ -139,18 +227,47 @@ namespace s3d
 
 			size_t available()
 			{
-				std::lock_guard lock(m_mutexReceivedBuffer);
+				rearmDataEvent();
 
-				return m_receivedBuffer.size();
+				bool resume = false;
+
+				const size_t size = m_receiveBuffer.available(resume);
+
+				resumeReceive(resume);
+
+				return size;
 			}
 
 			void startReceive()
 			{
-				asio::async_read(m_socket, m_streamBuffer, asio::transfer_at_least(1),
-					std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this()));
+				std::array<std::pair<Byte*, size_t>, 2> regions;
+
+				switch (m_receiveBuffer.prepare(regions))
+				{
+				case TCPReceiveBuffer::PrepareResult::Paused:
+					return;
+				case TCPReceiveBuffer::PrepareResult::Overflow:
+					LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
+
+					close();
+
+					return;
+				default:
+					break;
+				}
+
+				// リングバッファの空き領域に直接読み込む
+				const std::array<asio::mutable_buffer, 2> buffers =
+				{
+					asio::buffer(regions[0].first, regions[0].second),
+					asio::buffer(regions[1].first, regions[1].second)
+				};
+
+				m_socket.async_read_some(buffers, asio::bind_executor(m_strand,
+					std::bind(&ServerSession::onReceive, this, std::placeholders::_1, std::placeholders::_2, shared_from_this())));
 			}
 
-			void onReceive(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
+			void onReceive(const asio::error_code& error, const size_t size, const std::shared_ptr<ServerSession>&)
 			{
 				if (error)
 				{
@@ -165,46 +282,28 @@ namespace s3d
 						m_eof = true;
 					}
 
-					m_streamBuffer.consume(m_streamBuffer.size());
-
 					close();
 
 					return;
 				}
 
-				const Byte* data = asio::buffer_cast<const Byte*>(m_streamBuffer.data());
-				const size_t size = m_streamBuffer.size();
+				m_receiveBuffer.commit(size);
 
+				if (m_events->isEnabled() && !m_dataNotified.exchange(true))
 				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
-
-					if (m_receivedBuffer.size() + size > maxBufferSize)
-					{
-						LOG_FAIL(U"TCPServer: onReceive exceeded the maximum buffer size");
-
-						m_streamBuffer.consume(m_streamBuffer.size());
-
-						close();
-
-						return;
-					}
-
-					m_receivedBuffer.insert(m_receivedBuffer.end(), data, data + size);
+					m_events->push(m_id, TCPSessionEventType::DataReceived);
 				}
 
-				m_streamBuffer.consume(m_streamBuffer.size());
-
 				startReceive();
 			}
 
 			void onSend(const asio::error_code& error, size_t, const std::shared_ptr<ServerSession>&)
 			{
-				m_isSending = false;
+				const bool hasQueued = m_sendQueue.endSend();
 
 				if (!m_isActive)
 				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-					m_sendingBuffer.clear();
+					m_sendQueue.clear();
 					return;
 				}
 
@@ -217,18 +316,9 @@ namespace s3d
 					return;
 				}
 
+				if (hasQueued)
 				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-
-					if (!m_sendingBuffer.empty())
-					{
-						m_sendingBuffer.erase(m_sendingBuffer.begin());
-					}
-
-					if (!m_sendingBuffer.empty())
-					{
-						send_internal();
-					}
+					send_internal();
 				}
 			}
 
@@ -239,23 +329,15 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
-				{
-					return true;
-				}
+				rearmDataEvent();
 
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
+				bool resume = false;
 
-					if (size > m_receivedBuffer.size())
-					{
-						return false;
-					}
+				const bool result = m_receiveBuffer.skip(size, resume);
 
-					m_receivedBuffer.drop(size);
-				}
+				resumeReceive(resume);
 
-				return true;
+				return result;
 			}
 
 			bool lookahead(void* dst, const size_t size)
@@ -265,26 +347,54 @@ namespace s3d
 					return false;
 				}
 
-				if (size == 0)
+				rearmDataEvent();
+
+				bool resume = false;
+
+				const bool result = m_receiveBuffer.lookahead(dst, size, resume);
+
+				resumeReceive(resume);
+
+				return result;
+			}
+
+			bool read(void* dst, const size_t size)
+			{
+				if (!m_isActive)
 				{
-					return true;
+					return false;
 				}
 
-				{
-					std::lock_guard lock(m_mutexReceivedBuffer);
+				rearmDataEvent();
 
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
+				bool resume = false;
+
+				const bool result = m_receiveBuffer.read(dst, size, resume);
+
+				resumeReceive(resume);
 
-					std::memcpy(dst, m_receivedBuffer.data(), size);
+				return result;
+			}
+
+			Optional<ByteArrayView> receiveMessage()
+			{
+				if (!m_isActive)
+				{
+					return none;
 				}
 
-				return true;
+				rearmDataEvent();
+
+				bool resume = false;
+
+				const auto message = m_receiveBuffer.receiveMessage(resume);
+
+				resumeReceive(resume);
+
+				return message;
 			}
 
-			bool read(void* dst, const size_t size)
+			bool send(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
@@ -296,38 +406,29 @@ namespace s3d
 					return true;
 				}
 
+				if (m_sendQueue.push(data, size))
 				{
-					std::lock_guard<std::mutex> lock(m_mutexReceivedBuffer);
-
-					if (m_receivedBuffer.size() < size)
-					{
-						return false;
-					}
-
-					std::memcpy(dst, m_receivedBuffer.data(), size);
-
-					m_receivedBuffer.drop(size);
+					asio::post(m_strand, std::bind(&ServerSession::send_internal, shared_from_this()));
 				}
 
 				return true;
 			}
 
-			bool send(const void* data, const size_t size)
+			bool sendMessage(const void* data, const size_t size)
 			{
 				if (!m_isActive)
 				{
 					return false;
 				}
 
+				if ((sizeof(TCPMessageHeader) + size) > TCPReceiveBuffer::MaxBufferSize)
 				{
-					std::lock_guard lock(m_mutexSendingBuffer);
-
-					m_sendingBuffer.emplace_back(static_cast<const Byte*>(data), static_cast<const Byte*>(data) + size);
+					return false;
+				}
 
-					if (!m_isSending)
-					{
-						send_internal();
-					}
+				if (m_sendQueue.pushMessage(data, size))
+				{
+					asio::post(m_strand, std::bind(&ServerSession::send_internal, shared_from_this()));
 				}
 
 				return true;
@@ -345,10 +446,15 @@ namespace s3d
 
 		std::unique_ptr<asio::ip::tcp::acceptor> m_acceptor;
 
-		std::future<void> m_io_service_thread;
+		Array<std::future<void>> m_io_service_threads;
 
+		// ID の昇順に並んでいる
 		Array<std::pair<SessionID, std::shared_ptr<detail::ServerSession>>> m_sessions;
 
+		mutable std::mutex m_mutexSessions;
+
+		std::shared_ptr<detail::ServerEventQueue> m_events;
+
 		std::atomic<SessionID> m_currentSessionID = 0;
 
 		uint16 m_port = 0;
@@ -357,10 +463,16 @@ namespace s3d
 
 		bool m_allowMulti = false;
 
+		void startThreads(size_t numThreads);
+
+		void startAccept_internal(uint16 port);
+
 		void onAccept(const asio::error_code& error, const std::shared_ptr<detail::ServerSession>& session);
 
 		void updateSession();
 
+		std::shared_ptr<detail::ServerSession> findSession(const Optional<SessionID>& id) const;
+
 	public:
 
 		TCPServerDetail();
@@ -369,7 +481,7 @@ namespace s3d
 
 		void startAccept(uint16 port);
 
-		void startAcceptMulti(uint16 port);
+		void startAcceptMulti(uint16 port, size_t numThreads);
 
 		void cancelAccept();
 
@@ -396,5 +508,11 @@ namespace s3d
 		bool read(void* dst, size_t size, const Optional<SessionID>& id);
 
 		bool send(const void* data, size_t size, const Optional<SessionID>& id);
+
+		bool sendMessage(const void* data, size_t size, const Optional<SessionID>& id);
+
+		Optional<ByteArrayView> receiveMessage(const Optional<SessionID>& id);
+
+		Array<TCPSessionEvent> getEvents();
 	};
 }
@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/TextureAtlas.hpp>
+# include "TextureAtlasDetail.hpp"
+
+namespace s3d
+{
+	TextureAtlas::TextureAtlas()
+		: pImpl(std::make_shared<TextureAtlasDetail>())
+	{
+
+	}
+
+	TextureAtlas::TextureAtlas(const Size& pageSize, const int32 padding, const bool createTextures)
+		: pImpl(std::make_shared<TextureAtlasDetail>(pageSize, padding, createTextures))
+	{
+
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+
+	}
+
+	Optional<TextureAtlas::IDType> TextureAtlas::add(const Image& image)
+	{
+		return pImpl->add(image);
+	}
+
+	bool TextureAtlas::remove(const IDType id)
+	{
+		return pImpl->remove(id);
+	}
+
+	void TextureAtlas::clear()
+	{
+		pImpl->clear();
+	}
+
+	bool TextureAtlas::contains(const IDType id) const
+	{
+		return pImpl->contains(id);
+	}
+
+	TextureRegion TextureAtlas::operator ()(const IDType id) const
+	{
+		return pImpl->getRegion(id);
+	}
+
+	Optional<size_t> TextureAtlas::getPageIndex(const IDType id) const
+	{
+		return pImpl->getPageIndex(id);
+	}
+
+	Optional<Rect> TextureAtlas::getRect(const IDType id) const
+	{
+		return pImpl->getRect(id);
+	}
+
+	size_t TextureAtlas::num_images() const
+	{
+		return pImpl->num_images();
+	}
+
+	size_t TextureAtlas::num_pages() const
+	{
+		return pImpl->num_pages();
+	}
+
+	Size TextureAtlas::pageSize() const
+	{
+		return pImpl->pageSize();
+	}
+
+	void TextureAtlas::setMaxPages(const size_t maxPages)
+	{
+		pImpl->setMaxPages(maxPages);
+	}
+
+	size_t TextureAtlas::getMaxPages() const
+	{
+		return pImpl->getMaxPages();
+	}
+
+	const Image& TextureAtlas::getPageImage(const size_t pageIndex) const
+	{
+		return pImpl->getPageImage(pageIndex);
+	}
+
+	const Texture& TextureAtlas::getPageTexture(const size_t pageIndex) const
+	{
+		return pImpl->getPageTexture(pageIndex);
+	}
+
+	Optional<Rect> TextureAtlas::getDirtyRect(const size_t pageIndex) const
+	{
+		return pImpl->getDirtyRect(pageIndex);
+	}
+
+	void TextureAtlas::upload() const
+	{
+		pImpl->upload();
+	}
+}
@@ -0,0 +1,452 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "TextureAtlasDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]] static constexpr bool Intersects(const Rect& a, const Rect& b) noexcept
+		{
+			return (a.x < (b.x + b.w)) && (b.x < (a.x + a.w))
+				&& (a.y < (b.y + b.h)) && (b.y < (a.y + a.h));
+		}
+
+		[[nodiscard]] static constexpr bool Contains(const Rect& outer, const Rect& inner) noexcept
+		{
+			return (outer.x <= inner.x) && (outer.y <= inner.y)
+				&& ((inner.x + inner.w) <= (outer.x + outer.w))
+				&& ((inner.y + inner.h) <= (outer.y + outer.h));
+		}
+
+		[[nodiscard]] static Rect Union(const Rect& a, const Rect& b) noexcept
+		{
+			const int32 left = Min(a.x, b.x);
+			const int32 top = Min(a.y, b.y);
+			const int32 right = Max(a.x + a.w, b.x + b.w);
+			const int32 bottom = Max(a.y + a.h, b.y + b.h);
+			return Rect(left, top, (right - left), (bottom - top));
+		}
+
+		// 辺を完全に共有する 2 つの矩形を 1 つにまとめる
+		[[nodiscard]] static Optional<Rect> Merge(const Rect& a, const Rect& b) noexcept
+		{
+			if ((a.x == b.x) && (a.w == b.w) && (((a.y + a.h) == b.y) || ((b.y + b.h) == a.y)))
+			{
+				return Union(a, b);
+			}
+
+			if ((a.y == b.y) && (a.h == b.h) && (((a.x + a.w) == b.x) || ((b.x + b.w) == a.x)))
+			{
+				return Union(a, b);
+			}
+
+			return none;
+		}
+	}
+
+	TextureAtlas::TextureAtlasDetail::MaxRectsPacker::MaxRectsPacker(const Size& size)
+		: m_freeRects({ Rect(size) })
+	{
+
+	}
+
+	Optional<Rect> TextureAtlas::TextureAtlasDetail::MaxRectsPacker::insert(const Size& size)
+	{
+		Optional<Rect> best;
+		int32 bestShortSide = Largest<int32>;
+		int32 bestLongSide = Largest<int32>;
+
+		// Best Short Side Fit
+		for (const auto& freeRect : m_freeRects)
+		{
+			if ((freeRect.w < size.x) || (freeRect.h < size.y))
+			{
+				continue;
+			}
+
+			const int32 leftoverX = (freeRect.w - size.x);
+			const int32 leftoverY = (freeRect.h - size.y);
+			const int32 shortSide = Min(leftoverX, leftoverY);
+			const int32 longSide = Max(leftoverX, leftoverY);
+
+			if ((shortSide < bestShortSide) || ((shortSide == bestShortSide) && (longSide < bestLongSide)))
+			{
+				best = Rect(freeRect.pos, size);
+				bestShortSide = shortSide;
+				bestLongSide = longSide;
+			}
+		}
+
+		if (!best)
+		{
+			return none;
+		}
+
+		splitFreeRects(*best);
+
+		pruneFreeRects();
+
+		return best;
+	}
+
+	void TextureAtlas::TextureAtlasDetail::MaxRectsPacker::release(const Rect& rect)
+	{
+		Rect merged = rect;
+
+		for (bool mergedAny = true; mergedAny;)
+		{
+			mergedAny = false;
+
+			for (auto it = m_freeRects.begin(); it != m_freeRects.end(); ++it)
+			{
+				if (const auto m = detail::Merge(merged, *it))
+				{
+					merged = *m;
+					m_freeRects.erase(it);
+					mergedAny = true;
+					break;
+				}
+			}
+		}
+
+		m_freeRects.push_back(merged);
+
+		pruneFreeRects();
+	}
+
+	void TextureAtlas::TextureAtlasDetail::MaxRectsPacker::splitFreeRects(const Rect& used)
+	{
+		const size_t count = m_freeRects.size();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Rect freeRect = m_freeRects[i];
+
+			if (!detail::Intersects(freeRect, used))
+			{
+				continue;
+			}
+
+			if (freeRect.x < used.x)
+			{
+				m_freeRects.emplace_back(freeRect.x, freeRect.y, (used.x - freeRect.x), freeRect.h);
+			}
+
+			if ((used.x + used.w) < (freeRect.x + freeRect.w))
+			{
+				m_freeRects.emplace_back((used.x + used.w), freeRect.y, ((freeRect.x + freeRect.w) - (used.x + used.w)), freeRect.h);
+			}
+
+			if (freeRect.y < used.y)
+			{
+				m_freeRects.emplace_back(freeRect.x, freeRect.y, freeRect.w, (used.y - freeRect.y));
+			}
+
+			if ((used.y + used.h) < (freeRect.y + freeRect.h))
+			{
+				m_freeRects.emplace_back(freeRect.x, (used.y + used.h), freeRect.w, ((freeRect.y + freeRect.h) - (used.y + used.h)));
+			}
+
+			// 分割済みの矩形は空にしておき、pruneFreeRects() で取り除く
+			m_freeRects[i].w = 0;
+		}
+	}
+
+	void TextureAtlas::TextureAtlasDetail::MaxRectsPacker::pruneFreeRects()
+	{
+		m_freeRects.remove_if([](const Rect& rect) { return (rect.w <= 0) || (rect.h <= 0); });
+
+		for (size_t i = 0; i < m_freeRects.size(); ++i)
+		{
+			for (size_t k = (i + 1); k < m_freeRects.size();)
+			{
+				if (detail::Contains(m_freeRects[i], m_freeRects[k]))
+				{
+					m_freeRects.erase(m_freeRects.begin() + k);
+				}
+				else if (detail::Contains(m_freeRects[k], m_freeRects[i]))
+				{
+					m_freeRects.erase(m_freeRects.begin() + i);
+					k = (i + 1);
+				}
+				else
+				{
+					++k;
+				}
+			}
+		}
+	}
+
+	TextureAtlas::TextureAtlasDetail::TextureAtlasDetail()
+	{
+
+	}
+
+	TextureAtlas::TextureAtlasDetail::TextureAtlasDetail(const Size& pageSize, const int32 padding, const bool createTextures)
+		: m_pageSize(pageSize)
+		, m_padding(Max(padding, 0))
+		, m_createTextures(createTextures)
+	{
+
+	}
+
+	TextureAtlas::TextureAtlasDetail::~TextureAtlasDetail()
+	{
+
+	}
+
+	Optional<TextureAtlas::IDType> TextureAtlas::TextureAtlasDetail::add(const Image& image)
+	{
+		if (!image)
+		{
+			return none;
+		}
+
+		const Size allocatedSize = image.size() + Size(m_padding * 2, m_padding * 2);
+
+		if ((m_pageSize.x < allocatedSize.x) || (m_pageSize.y < allocatedSize.y))
+		{
+			return none;
+		}
+
+		Optional<Rect> allocated;
+		size_t pageIndex = 0;
+
+		for (; pageIndex < m_pages.size(); ++pageIndex)
+		{
+			if ((allocated = m_pages[pageIndex].packer.insert(allocatedSize)))
+			{
+				break;
+			}
+		}
+
+		if (!allocated)
+		{
+			if (m_maxPages && (m_maxPages <= m_pages.size()))
+			{
+				return none;
+			}
+
+			Page& newPage = m_pages.emplace_back();
+			newPage.image = Image(m_pageSize, Color(0, 0));
+			newPage.packer = MaxRectsPacker(m_pageSize);
+
+			allocated = newPage.packer.insert(allocatedSize);
+			pageIndex = (m_pages.size() - 1);
+		}
+
+		Page& page = m_pages[pageIndex];
+		const Rect rect(allocated->pos + Point(m_padding, m_padding), image.size());
+
+		image.overwrite(page.image, rect.pos);
+
+		// バイリニア補間で隣の画像がにじまないよう、余白に端のピクセルを複製する
+		if (m_padding)
+		{
+			Image& dst = page.image;
+
+			for (int32 y = rect.y; y < (rect.y + rect.h); ++y)
+			{
+				Color* const line = dst[y];
+				const Color left = line[rect.x];
+				const Color right = line[rect.x + rect.w - 1];
+
+				for (int32 i = 1; i <= m_padding; ++i)
+				{
+					line[rect.x - i] = left;
+					line[rect.x + rect.w - 1 + i] = right;
+				}
+			}
+
+			const size_t rowBytes = (sizeof(Color) * allocated->w);
+
+			for (int32 i = 1; i <= m_padding; ++i)
+			{
+				std::memcpy(dst[rect.y - i] + allocated->x, dst[rect.y] + allocated->x, rowBytes);
+				std::memcpy(dst[rect.y + rect.h - 1 + i] + allocated->x, dst[rect.y + rect.h - 1] + allocated->x, rowBytes);
+			}
+		}
+
+		markDirty(page, *allocated);
+		++page.num_images;
+
+		const IDType id = m_nextID++;
+		m_entries.emplace(id, Entry{ pageIndex, *allocated, rect });
+
+		return id;
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::remove(const IDType id)
+	{
+		const auto it = m_entries.find(id);
+
+		if (it == m_entries.end())
+		{
+			return false;
+		}
+
+		const Entry& entry = it->second;
+		Page& page = m_pages[entry.pageIndex];
+		const Rect& allocated = entry.allocated;
+
+		for (int32 y = allocated.y; y < (allocated.y + allocated.h); ++y)
+		{
+			std::fill_n(page.image[y] + allocated.x, allocated.w, Color(0, 0));
+		}
+
+		page.packer.release(allocated);
+		markDirty(page, allocated);
+		--page.num_images;
+
+		m_entries.erase(it);
+
+		return true;
+	}
+
+	void TextureAtlas::TextureAtlasDetail::clear()
+	{
+		m_pages.clear();
+		m_entries.clear();
+		m_nextID = 0;
+	}
+
+	bool TextureAtlas::TextureAtlasDetail::contains(const IDType id) const
+	{
+		return (m_entries.find(id) != m_entries.end());
+	}
+
+	TextureRegion TextureAtlas::TextureAtlasDetail::getRegion(const IDType id)
+	{
+		const auto it = m_entries.find(id);
+
+		if (it == m_entries.end())
+		{
+			return TextureRegion();
+		}
+
+		const Entry& entry = it->second;
+		Page& page = m_pages[entry.pageIndex];
+
+		uploadPage(page);
+
+		const float pw = static_cast<float>(m_pageSize.x);
+		const float ph = static_cast<float>(m_pageSize.y);
+		const Rect& rect = entry.rect;
+		const FloatRect uvRect(rect.x / pw, rect.y / ph, (rect.x + rect.w) / pw, (rect.y + rect.h) / ph);
+
+		return TextureRegion(page.texture, uvRect, rect.size);
+	}
+
+	Optional<size_t> TextureAtlas::TextureAtlasDetail::getPageIndex(const IDType id) const
+	{
+		if (const auto it = m_entries.find(id); it != m_entries.end())
+		{
+			return it->second.pageIndex;
+		}
+
+		return none;
+	}
+
+	Optional<Rect> TextureAtlas::TextureAtlasDetail::getRect(const IDType id) const
+	{
+		if (const auto it = m_entries.find(id); it != m_entries.end())
+		{
+			return it->second.rect;
+		}
+
+		return none;
+	}
+
+	size_t TextureAtlas::TextureAtlasDetail::num_images() const
+	{
+		return m_entries.size();
+	}
+
+	size_t TextureAtlas::TextureAtlasDetail::num_pages() const
+	{
+		return m_pages.size();
+	}
+
+	Size TextureAtlas::TextureAtlasDetail::pageSize() const
+	{
+		return m_pageSize;
+	}
+
+	void TextureAtlas::TextureAtlasDetail::setMaxPages(const size_t maxPages)
+	{
+		m_maxPages = maxPages;
+	}
+
+	size_t TextureAtlas::TextureAtlasDetail::getMaxPages() const
+	{
+		return m_maxPages;
+	}
+
+	const Image& TextureAtlas::TextureAtlasDetail::getPageImage(const size_t pageIndex) const
+	{
+		return m_pages[pageIndex].image;
+	}
+
+	const Texture& TextureAtlas::TextureAtlasDetail::getPageTexture(const size_t pageIndex)
+	{
+		Page& page = m_pages[pageIndex];
+
+		uploadPage(page);
+
+		return page.texture;
+	}
+
+	Optional<Rect> TextureAtlas::TextureAtlasDetail::getDirtyRect(const size_t pageIndex) const
+	{
+		return m_pages[pageIndex].dirtyRect;
+	}
+
+	void TextureAtlas::TextureAtlasDetail::upload()
+	{
+		for (auto& page : m_pages)
+		{
+			uploadPage(page);
+		}
+	}
+
+	void TextureAtlas::TextureAtlasDetail::markDirty(Page& page, const Rect& rect)
+	{
+		if (page.dirtyRect)
+		{
+			page.dirtyRect = detail::Union(*page.dirtyRect, rect);
+		}
+		else
+		{
+			page.dirtyRect = rect;
+		}
+	}
+
+	void TextureAtlas::TextureAtlasDetail::uploadPage(Page& page)
+	{
+		if (!m_createTextures || !page.dirtyRect)
+		{
+			return;
+		}
+
+		if (!page.texture)
+		{
+			page.texture = DynamicTexture(page.image);
+		}
+		else
+		{
+			page.texture.fillRegion(page.image, *page.dirtyRect);
+		}
+
+		page.dirtyRect.reset();
+	}
+}
@@ -0,0 +1,130 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/TextureAtlas.hpp>
+# include <Siv3D/Image.hpp>
+# include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/HashTable.hpp>
+
+namespace s3d
+{
+	class TextureAtlas::TextureAtlasDetail
+	{
+	private:
+
+		// MaxRects 法による矩形の詰め込み
+		class MaxRectsPacker
+		{
+		private:
+
+			Array<Rect> m_freeRects;
+
+			void splitFreeRects(const Rect& used);
+
+			void pruneFreeRects();
+
+		public:
+
+			MaxRectsPacker() = default;
+
+			explicit MaxRectsPacker(const Size& size);
+
+			[[nodiscard]] Optional<Rect> insert(const Size& size);
+
+			void release(const Rect& rect);
+		};
+
+		struct Page
+		{
+			Image image;
+
+			DynamicTexture texture;
+
+			MaxRectsPacker packer;
+
+			Optional<Rect> dirtyRect;
+
+			size_t num_images = 0;
+		};
+
+		struct Entry
+		{
+			size_t pageIndex = 0;
+
+			// 余白を含む領域
+			Rect allocated;
+
+			// 画像の領域
+			Rect rect;
+		};
+
+		Size m_pageSize = Size(1024, 1024);
+
+		int32 m_padding = 1;
+
+		bool m_createTextures = true;
+
+		// 0 の場合は上限なし
+		size_t m_maxPages = 0;
+
+		Array<Page> m_pages;
+
+		HashTable<IDType, Entry> m_entries;
+
+		IDType m_nextID = 0;
+
+		void markDirty(Page& page, const Rect& rect);
+
+		void uploadPage(Page& page);
+
+	public:
+
+		TextureAtlasDetail();
+
+		TextureAtlasDetail(const Size& pageSize, int32 padding, bool createTextures);
+
+		~TextureAtlasDetail();
+
+		Optional<IDType> add(const Image& image);
+
+		bool remove(IDType id);
+
+		void clear();
+
+		bool contains(IDType id) const;
+
+		TextureRegion getRegion(IDType id);
+
+		Optional<size_t> getPageIndex(IDType id) const;
+
+		Optional<Rect> getRect(IDType id) const;
+
+		size_t num_images() const;
+
+		size_t num_pages() const;
+
+		Size pageSize() const;
+
+		void setMaxPages(size_t maxPages);
+
+		size_t getMaxPages() const;
+
+		const Image& getPageImage(size_t pageIndex) const;
+
+		const Texture& getPageTexture(size_t pageIndex);
+
+		// 次の upload() で転送される領域
+		Optional<Rect> getDirtyRect(size_t pageIndex) const;
+
+		void upload();
+	};
+}
@@ -260,6 +260,13 @@ namespace s3d
 		return drawClipped(pos.x, pos.y, clipRect, diffuse);
 	}
 
+	void TextureRegion::DrawBatch(const Array<TextureRegion>& regions, const Array<Vec2>& positions, const ColorF& diffuse)
+	{
+		const size_t count = std::min(regions.size(), positions.size());
+
+		Siv3DEngine::Get<ISiv3DRenderer2D>()->addTextureRegions(regions.data(), positions.data(), count, diffuse.toFloat4());
+	}
+
 	RectF TextureRegion::drawAt(const double x, const double y, const ColorF& diffuse) const
 	{
 		const Vec2 sizeHalf = size * 0.5;
@@ -0,0 +1,210 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <atomic>
+# include <algorithm>
+# include <Siv3D/Threading.hpp>
+# include "WorkerPool.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct WorkerPool::Job
+		{
+			TaskFunction task = nullptr;
+
+			void* context = nullptr;
+
+			size_t count = 0;
+
+			std::atomic<size_t> nextIndex{ 0 };
+
+			// まだ参加していないワーカーの枠
+			size_t tickets = 0;
+
+			// 次に参加するワーカーのインデックス (0 は呼び出し元)
+			size_t nextWorkerIndex = 1;
+
+			// 参加中のワーカーの数
+			size_t activeWorkers = 0;
+
+			std::mutex exceptionMutex;
+
+			std::exception_ptr exception;
+
+			void execute(const size_t workerIndex)
+			{
+				try
+				{
+					for (size_t i = nextIndex++; i < count; i = nextIndex++)
+					{
+						task(context, i, workerIndex);
+					}
+				}
+				catch (...)
+				{
+					// 残りの要素は処理しない
+					nextIndex = count;
+
+					std::lock_guard lock(exceptionMutex);
+
+					if (!exception)
+					{
+						exception = std::current_exception();
+					}
+				}
+			}
+		};
+
+		WorkerPool::WorkerPool(const size_t numThreads)
+		{
+			start(numThreads);
+		}
+
+		WorkerPool::~WorkerPool()
+		{
+			stop();
+		}
+
+		void WorkerPool::resize(const size_t numThreads)
+		{
+			if (numThreads == m_threads.size())
+			{
+				return;
+			}
+
+			stop();
+
+			start(numThreads);
+		}
+
+		size_t WorkerPool::num_threads() const noexcept
+		{
+			return m_threads.size();
+		}
+
+		void WorkerPool::start(const size_t numThreads)
+		{
+			m_abort = false;
+
+			for (size_t i = 0; i < numThreads; ++i)
+			{
+				m_threads.emplace_back(&WorkerPool::workerLoop, this);
+			}
+		}
+
+		void WorkerPool::stop()
+		{
+			{
+				std::lock_guard lock(m_mutex);
+
+				m_abort = true;
+			}
+
+			m_jobAdded.notify_all();
+
+			for (auto& thread : m_threads)
+			{
+				thread.join();
+			}
+
+			m_threads.clear();
+		}
+
+		void WorkerPool::workerLoop()
+		{
+			std::unique_lock lock(m_mutex);
+
+			for (;;)
+			{
+				m_jobAdded.wait(lock, [this]() { return (m_abort || !m_jobs.empty()); });
+
+				if (m_abort)
+				{
+					return;
+				}
+
+				Job* job = m_jobs.front();
+
+				if (--job->tickets == 0)
+				{
+					m_jobs.pop_front();
+				}
+
+				++job->activeWorkers;
+
+				const size_t workerIndex = job->nextWorkerIndex++;
+
+				lock.unlock();
+
+				job->execute(workerIndex);
+
+				lock.lock();
+
+				if (--job->activeWorkers == 0)
+				{
+					m_workerLeft.notify_all();
+				}
+			}
+		}
+
+		void WorkerPool::run(const size_t count, const size_t numWorkers, const TaskFunction task, void* context)
+		{
+			Job job;
+			job.task = task;
+			job.context = context;
+			job.count = count;
+			job.tickets = (numWorkers - 1);
+
+			{
+				std::lock_guard lock(m_mutex);
+
+				m_jobs.push_back(&job);
+			}
+
+			if (job.tickets == 1)
+			{
+				m_jobAdded.notify_one();
+			}
+			else
+			{
+				m_jobAdded.notify_all();
+			}
+
+			job.execute(0);
+
+			{
+				std::unique_lock lock(m_mutex);
+
+				// 呼び出し元がすべて処理し終えた場合、まだ参加していないワーカーの枠は取り消す
+				if (job.tickets)
+				{
+					m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+				}
+
+				m_workerLeft.wait(lock, [&job]() { return (job.activeWorkers == 0); });
+			}
+
+			if (job.exception)
+			{
+				std::rethrow_exception(job.exception);
+			}
+		}
+
+		WorkerPool& GetSharedWorkerPool()
+		{
+			static WorkerPool pool(Threading::GetConcurrency() - 1);
+
+			return pool;
+		}
+	}
+}
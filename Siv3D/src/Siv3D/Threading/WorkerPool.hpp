@@ -0,0 +1,107 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2019 Ryo Suzuki
+//	Copyright (c) 2016-2019 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <exception>
+# include <deque>
+# include <Siv3D/Array.hpp>
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 常駐するワーカースレッドで、インデックスの範囲に対する処理を並列に実行する
+		class WorkerPool
+		{
+		private:
+
+			using TaskFunction = void(*)(void* context, size_t index, size_t workerIndex);
+
+			struct Job;
+
+			Array<std::thread> m_threads;
+
+			std::mutex m_mutex;
+
+			// ワーカーの手が空くのを待つ
+			std::condition_variable m_jobAdded;
+
+			// 参加中のワーカーが抜けるのを待つ
+			std::condition_variable m_workerLeft;
+
+			// まだ参加できるワーカーが残っているジョブ
+			std::deque<Job*> m_jobs;
+
+			bool m_abort = false;
+
+			void start(size_t numThreads);
+
+			void stop();
+
+			void workerLoop();
+
+			void run(size_t count, size_t numWorkers, TaskFunction task, void* context);
+
+		public:
+
+			// numThreads 個のワーカースレッドを作成する。呼び出し元のスレッドも実行に参加する
+			explicit WorkerPool(size_t numThreads = 0);
+
+			~WorkerPool();
+
+			// ワーカースレッドの数を変更する。実行中の parallelFor() とは同時に呼べない
+			void resize(size_t numThreads);
+
+			[[nodiscard]] size_t num_threads() const noexcept;
+
+			// f(index, workerIndex) を [0, count) の各 index について呼び、すべて終わるまで待つ
+			// 呼び出し元のスレッドはワーカー 0 として参加し、同時に実行される f には異なる workerIndex (< numWorkers) が渡される
+			// ワーカーあたりの要素数が minItemsPerWorker 未満になる場合は、参加するワーカーを減らす
+			template <class Fty>
+			void parallelFor(const size_t count, const size_t numWorkers, Fty f, const size_t minItemsPerWorker = 1)
+			{
+				const size_t grain = (minItemsPerWorker ? minItemsPerWorker : 1);
+
+				const size_t maxWorkers = ((count + grain - 1) / grain);
+
+				const size_t workers = std::min(std::min(std::max<size_t>(numWorkers, 1), maxWorkers), m_threads.size() + 1);
+
+				if (workers <= 1)
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						f(i, 0);
+					}
+
+					return;
+				}
+
+				run(count, workers, [](void* context, const size_t index, const size_t workerIndex)
+				{
+					(*static_cast<Fty*>(context))(index, workerIndex);
+				}, &f);
+			}
+		};
+
+		// エンジン全体で共有するワーカースレッドの集合。スレッド数は Threading::GetConcurrency() - 1
+		[[nodiscard]] WorkerPool& GetSharedWorkerPool();
+
+		// 共有のワーカースレッドで f(index, workerIndex) を [0, count) について並列に呼ぶ
+		template <class Fty>
+		inline void ParallelFor(const size_t count, const size_t numWorkers, Fty f, const size_t minItemsPerWorker = 1)
+		{
+			GetSharedWorkerPool().parallelFor(count, numWorkers, std::move(f), minItemsPerWorker);
+		}
+	}
+}
@@ -168,6 +168,8 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+
+	m_sharedLock = nullptr;	// [Siv3D]
 }
 
 b2Island::~b2Island()
@@ -180,12 +182,45 @@ b2Island::~b2Island()
 	m_allocator->Free(m_bodies);
 }
 
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+
+// Locks m_sharedLock and stamps the island indices of the static bodies
+// in this island. Returns false without locking if there is nothing to share.
+bool b2Island::LockStaticBodies(bool hasStaticBody)
+{
+	if (m_sharedLock == nullptr || hasStaticBody == false)
+	{
+		return false;
+	}
+
+	m_sharedLock->lock();
+
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		if (m_bodies[i]->m_type == b2_staticBody)
+		{
+			m_bodies[i]->m_islandIndex = i;
+		}
+	}
+
+	return true;
+}
+
+//
+//-----------------------------------------------
+
 void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
 {
 	b2Timer timer;
 
 	float32 h = step.dt;
 
+	//	[Siv3D] Static bodies may be read by other islands at the same time, so they are never written.
+	bool hasStaticBody = false;
+
 	// Integrate velocities and apply damping. Initialize the body state.
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
@@ -196,9 +231,17 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		b2Vec2 v = b->m_linearVelocity;
 		float32 w = b->m_angularVelocity;
 
-		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		//	[Siv3D]
+		if (m_sharedLock && b->m_type == b2_staticBody)
+		{
+			hasStaticBody = true;
+		}
+		else
+		{
+			// Store positions for continuous collision.
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -240,19 +283,35 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.velocities = m_velocities;
 	contactSolverDef.allocator = m_allocator;
 
+	//	[Siv3D] The contact solver and the joints read m_islandIndex of the bodies.
+	bool locked = LockStaticBodies(hasStaticBody);
+
 	b2ContactSolver contactSolver(&contactSolverDef);
+
+	if (locked)
+	{
+		m_sharedLock->unlock();
+	}
+
 	contactSolver.InitializeVelocityConstraints();
 
 	if (step.warmStarting)
 	{
 		contactSolver.WarmStart();
 	}
+
+	locked = (m_jointCount > 0) && LockStaticBodies(hasStaticBody);
 	
 	for (int32 i = 0; i < m_jointCount; ++i)
 	{
 		m_joints[i]->InitVelocityConstraints(solverData);
 	}
 
+	if (locked)
+	{
+		m_sharedLock->unlock();
+	}
+
 	profile->solveInit = timer.GetMilliseconds();
 
 	// Solve velocity constraints
@@ -330,6 +389,13 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+
+		//	[Siv3D] Static bodies do not move.
+		if (m_sharedLock && body->m_type == b2_staticBody)
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -339,7 +405,16 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 	profile->solvePosition = timer.GetMilliseconds();
 
-	Report(contactSolver.m_velocityConstraints);
+	//	[Siv3D]
+	if (m_sharedLock)
+	{
+		std::lock_guard<std::mutex> lock(*m_sharedLock);
+		Report(contactSolver.m_velocityConstraints);
+	}
+	else
+	{
+		Report(contactSolver.m_velocityConstraints);
+	}
 
 	if (allowSleep)
 	{
@@ -375,6 +450,13 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+
+				//	[Siv3D] The awake flag of a static body is not used.
+				if (m_sharedLock && b->m_type == b2_staticBody)
+				{
+					continue;
+				}
+
 				b->SetAwake(false);
 			}
 		}
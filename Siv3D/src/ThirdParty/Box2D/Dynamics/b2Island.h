@@ -22,6 +22,7 @@
 #include "Box2D/Common/b2Math.h"
 #include "Box2D/Dynamics/b2Body.h"
 #include "Box2D/Dynamics/b2TimeStep.h"
+#include <mutex>	// [Siv3D]
 
 class b2Contact;
 class b2Joint;
@@ -88,6 +89,21 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	//-----------------------------------------------
+	//
+	//	[Siv3D]
+	//
+
+	/// Set when this island is solved concurrently with other islands.
+	/// Static bodies are shared between islands, so their m_islandIndex is
+	/// only valid while this lock is held. The lock also serializes Report.
+	std::mutex* m_sharedLock;
+
+	bool LockStaticBodies(bool hasStaticBody);
+
+	//
+	//-----------------------------------------------
 };
 
 #endif
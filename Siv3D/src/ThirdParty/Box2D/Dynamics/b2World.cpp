@@ -34,6 +34,98 @@
 #include "Box2D/Common/b2Timer.h"
 #include <new>
 
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+struct b2IslandRange
+{
+	int32 bodyBegin;
+	int32 bodyCount;
+	int32 contactBegin;
+	int32 contactCount;
+	int32 jointBegin;
+	int32 jointCount;
+};
+
+struct b2ParallelIslandSolver
+{
+	~b2ParallelIslandSolver()
+	{
+		for (b2StackAllocator* allocator : allocators)
+		{
+			delete allocator;
+		}
+	}
+
+	// All islands of a step, stored back to back
+	std::vector<b2Body*> bodies;
+	std::vector<b2Contact*> contacts;
+	std::vector<b2Joint*> joints;
+	std::vector<b2IslandRange> islands;
+
+	// One per worker
+	std::vector<b2StackAllocator*> allocators;
+	std::vector<b2Profile> profiles;
+
+	std::mutex sharedLock;
+
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+	b2ContactListener* listener;
+};
+
+void b2World::SolveIslandTask(void* context, int32 index, int32 worker)
+{
+	b2ParallelIslandSolver* solver = static_cast<b2ParallelIslandSolver*>(context);
+	const b2IslandRange& range = solver->islands[index];
+
+	b2Island island(range.bodyCount, range.contactCount, range.jointCount,
+					solver->allocators[worker], solver->listener);
+	island.m_sharedLock = &solver->sharedLock;
+
+	for (int32 i = 0; i < range.bodyCount; ++i)
+	{
+		b2Body* b = solver->bodies[range.bodyBegin + i];
+
+		// Static bodies are shared with other islands. b2Island::Solve stamps
+		// their index while holding the shared lock.
+		if (b->m_type != b2_staticBody)
+		{
+			b->m_islandIndex = island.m_bodyCount;
+		}
+
+		island.m_bodies[island.m_bodyCount++] = b;
+	}
+
+	for (int32 i = 0; i < range.contactCount; ++i)
+	{
+		island.Add(solver->contacts[range.contactBegin + i]);
+	}
+
+	for (int32 i = 0; i < range.jointCount; ++i)
+	{
+		island.Add(solver->joints[range.jointBegin + i]);
+	}
+
+	b2Profile profile;
+	island.Solve(&profile, *solver->step, solver->gravity, solver->allowSleep);
+
+	b2Profile& total = solver->profiles[worker];
+	total.solveInit += profile.solveInit;
+	total.solveVelocity += profile.solveVelocity;
+	total.solvePosition += profile.solvePosition;
+}
+
+//
+//-----------------------------------------------
+
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = nullptr;
@@ -61,6 +153,9 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+
+	m_taskExecutor = nullptr;	// [Siv3D]
+	m_parallelSolver = nullptr;	// [Siv3D]
 }
 
 b2World::~b2World()
@@ -82,6 +177,8 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	delete m_parallelSolver;	// [Siv3D]
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -104,6 +201,12 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+//	[Siv3D]
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_taskExecutor = executor;
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -389,13 +492,6 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
-	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
-					m_contactManager.m_contactCount,
-					m_jointCount,
-					&m_stackAllocator,
-					m_contactManager.m_contactListener);
-
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -410,7 +506,204 @@ void b2World::Solve(const b2TimeStep& step)
 		j->m_islandFlag = false;
 	}
 
-	// Build and simulate all awake islands.
+	//	[Siv3D]
+	if (m_taskExecutor && m_taskExecutor->GetWorkerCount() > 1)
+	{
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		// Size the island for the worst case.
+		b2Island island(m_bodyCount,
+						m_contactManager.m_contactCount,
+						m_jointCount,
+						&m_stackAllocator,
+						m_contactManager.m_contactListener);
+
+		// Build and simulate all awake islands.
+		int32 stackSize = m_bodyCount;
+		b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+		for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+		{
+			if (seed->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
+
+			if (seed->IsAwake() == false || seed->IsActive() == false)
+			{
+				continue;
+			}
+
+			// The seed can be dynamic or kinematic.
+			if (seed->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Reset island and stack.
+			island.Clear();
+			int32 stackCount = 0;
+			stack[stackCount++] = seed;
+			seed->m_flags |= b2Body::e_islandFlag;
+
+			// Perform a depth first search (DFS) on the constraint graph.
+			while (stackCount > 0)
+			{
+				// Grab the next body off the stack and add it to the island.
+				b2Body* b = stack[--stackCount];
+				b2Assert(b->IsActive() == true);
+				island.Add(b);
+
+				// Make sure the body is awake (without resetting sleep timer).
+				b->m_flags |= b2Body::e_awakeFlag;
+
+				// To keep islands as small as possible, we don't
+				// propagate islands across static bodies.
+				if (b->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
+				// Search all contacts connected to this body.
+				for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+				{
+					b2Contact* contact = ce->contact;
+
+					// Has this contact already been added to an island?
+					if (contact->m_flags & b2Contact::e_islandFlag)
+					{
+						continue;
+					}
+
+					// Is this contact solid and touching?
+					if (contact->IsEnabled() == false ||
+						contact->IsTouching() == false)
+					{
+						continue;
+					}
+
+					// Skip sensors.
+					bool sensorA = contact->m_fixtureA->m_isSensor;
+					bool sensorB = contact->m_fixtureB->m_isSensor;
+					if (sensorA || sensorB)
+					{
+						continue;
+					}
+
+					island.Add(contact);
+					contact->m_flags |= b2Contact::e_islandFlag;
+
+					b2Body* other = ce->other;
+
+					// Was the other body already added to this island?
+					if (other->m_flags & b2Body::e_islandFlag)
+					{
+						continue;
+					}
+
+					b2Assert(stackCount < stackSize);
+					stack[stackCount++] = other;
+					other->m_flags |= b2Body::e_islandFlag;
+				}
+
+				// Search all joints connect to this body.
+				for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+				{
+					if (je->joint->m_islandFlag == true)
+					{
+						continue;
+					}
+
+					b2Body* other = je->other;
+
+					// Don't simulate joints connected to inactive bodies.
+					if (other->IsActive() == false)
+					{
+						continue;
+					}
+
+					island.Add(je->joint);
+					je->joint->m_islandFlag = true;
+
+					if (other->m_flags & b2Body::e_islandFlag)
+					{
+						continue;
+					}
+
+					b2Assert(stackCount < stackSize);
+					stack[stackCount++] = other;
+					other->m_flags |= b2Body::e_islandFlag;
+				}
+			}
+
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+
+			// Post solve cleanup.
+			for (int32 i = 0; i < island.m_bodyCount; ++i)
+			{
+				// Allow static bodies to participate in other islands.
+				b2Body* b = island.m_bodies[i];
+				if (b->GetType() == b2_staticBody)
+				{
+					b->m_flags &= ~b2Body::e_islandFlag;
+				}
+			}
+		}
+
+		m_stackAllocator.Free(stack);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+
+// Find all awake islands like Solve does, then solve them on the task executor.
+// The island flags are left set the same way as the serial path leaves them.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	if (m_parallelSolver == nullptr)
+	{
+		m_parallelSolver = new b2ParallelIslandSolver;
+	}
+
+	b2ParallelIslandSolver& solver = *m_parallelSolver;
+	solver.bodies.clear();
+	solver.contacts.clear();
+	solver.joints.clear();
+	solver.islands.clear();
+
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
 	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
@@ -425,68 +718,58 @@ void b2World::Solve(const b2TimeStep& step)
 			continue;
 		}
 
-		// The seed can be dynamic or kinematic.
 		if (seed->GetType() == b2_staticBody)
 		{
 			continue;
 		}
 
-		// Reset island and stack.
-		island.Clear();
+		b2IslandRange range;
+		range.bodyBegin = (int32)solver.bodies.size();
+		range.contactBegin = (int32)solver.contacts.size();
+		range.jointBegin = (int32)solver.joints.size();
+
 		int32 stackCount = 0;
 		stack[stackCount++] = seed;
 		seed->m_flags |= b2Body::e_islandFlag;
 
-		// Perform a depth first search (DFS) on the constraint graph.
 		while (stackCount > 0)
 		{
-			// Grab the next body off the stack and add it to the island.
 			b2Body* b = stack[--stackCount];
 			b2Assert(b->IsActive() == true);
-			island.Add(b);
+			solver.bodies.push_back(b);
 
-			// Make sure the body is awake (without resetting sleep timer).
 			b->m_flags |= b2Body::e_awakeFlag;
 
-			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
 			if (b->GetType() == b2_staticBody)
 			{
 				continue;
 			}
 
-			// Search all contacts connected to this body.
 			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
 			{
 				b2Contact* contact = ce->contact;
 
-				// Has this contact already been added to an island?
 				if (contact->m_flags & b2Contact::e_islandFlag)
 				{
 					continue;
 				}
 
-				// Is this contact solid and touching?
 				if (contact->IsEnabled() == false ||
 					contact->IsTouching() == false)
 				{
 					continue;
 				}
 
-				// Skip sensors.
-				bool sensorA = contact->m_fixtureA->m_isSensor;
-				bool sensorB = contact->m_fixtureB->m_isSensor;
-				if (sensorA || sensorB)
+				if (contact->m_fixtureA->m_isSensor || contact->m_fixtureB->m_isSensor)
 				{
 					continue;
 				}
 
-				island.Add(contact);
+				solver.contacts.push_back(contact);
 				contact->m_flags |= b2Contact::e_islandFlag;
 
 				b2Body* other = ce->other;
 
-				// Was the other body already added to this island?
 				if (other->m_flags & b2Body::e_islandFlag)
 				{
 					continue;
@@ -497,7 +780,6 @@ void b2World::Solve(const b2TimeStep& step)
 				other->m_flags |= b2Body::e_islandFlag;
 			}
 
-			// Search all joints connect to this body.
 			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
 			{
 				if (je->joint->m_islandFlag == true)
@@ -507,13 +789,12 @@ void b2World::Solve(const b2TimeStep& step)
 
 				b2Body* other = je->other;
 
-				// Don't simulate joints connected to inactive bodies.
 				if (other->IsActive() == false)
 				{
 					continue;
 				}
 
-				island.Add(je->joint);
+				solver.joints.push_back(je->joint);
 				je->joint->m_islandFlag = true;
 
 				if (other->m_flags & b2Body::e_islandFlag)
@@ -527,52 +808,61 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		range.bodyCount = (int32)solver.bodies.size() - range.bodyBegin;
+		range.contactCount = (int32)solver.contacts.size() - range.contactBegin;
+		range.jointCount = (int32)solver.joints.size() - range.jointBegin;
 
-		// Post solve cleanup.
-		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range.bodyBegin; i < range.bodyBegin + range.bodyCount; ++i)
 		{
-			// Allow static bodies to participate in other islands.
-			b2Body* b = island.m_bodies[i];
+			b2Body* b = solver.bodies[i];
 			if (b->GetType() == b2_staticBody)
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
 			}
 		}
-	}
 
+		solver.islands.push_back(range);
+	}
 	m_stackAllocator.Free(stack);
 
+	if (solver.islands.empty())
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
-		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
-			{
-				continue;
-			}
+		return;
+	}
 
-			if (b->GetType() == b2_staticBody)
-			{
-				continue;
-			}
+	// Start with the largest islands so that the workers finish at about the same time.
+	std::sort(solver.islands.begin(), solver.islands.end(), [](const b2IslandRange& a, const b2IslandRange& b)
+	{
+		return (a.bodyCount + a.contactCount + a.jointCount) > (b.bodyCount + b.contactCount + b.jointCount);
+	});
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
-		}
+	const int32 workerCount = m_taskExecutor->GetWorkerCount();
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+	while ((int32)solver.allocators.size() < workerCount)
+	{
+		solver.allocators.push_back(new b2StackAllocator);
+	}
+
+	solver.profiles.assign(workerCount, b2Profile());
+	solver.step = &step;
+	solver.gravity = m_gravity;
+	solver.allowSleep = m_allowSleep;
+	solver.listener = m_contactManager.m_contactListener;
+
+	m_taskExecutor->Run((int32)solver.islands.size(), SolveIslandTask, &solver);
+
+	for (const b2Profile& profile : solver.profiles)
+	{
+		m_profile.solveInit += profile.solveInit;
+		m_profile.solveVelocity += profile.solveVelocity;
+		m_profile.solvePosition += profile.solvePosition;
 	}
 }
 
+//
+//-----------------------------------------------
+
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
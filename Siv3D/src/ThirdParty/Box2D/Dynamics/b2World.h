@@ -34,6 +34,7 @@ class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+struct b2ParallelIslandSolver;	// [Siv3D]
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -66,6 +67,21 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	//-----------------------------------------------
+	//
+	//	[Siv3D]
+	//
+
+	/// Register a task executor used to solve independent islands concurrently.
+	/// The executor is owned by you and must remain in scope. Pass nullptr to
+	/// solve all islands on the calling thread.
+	/// @warning b2ContactListener::PostSolve may be called from worker threads,
+	/// but never from two threads at the same time.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
+	//
+	//-----------------------------------------------
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -227,6 +243,10 @@ private:
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
+	//	[Siv3D]
+	void SolveIslandsParallel(const b2TimeStep& step);
+	static void SolveIslandTask(void* context, int32 index, int32 worker);
+
 	void DrawJoint(b2Joint* joint);
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
@@ -261,6 +281,19 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+
+	//-----------------------------------------------
+	//
+	//	[Siv3D]
+	//
+
+	b2TaskExecutor* m_taskExecutor;
+
+	// Island lists and per-worker allocators, reused across steps
+	b2ParallelIslandSolver* m_parallelSolver;
+
+	//
+	//-----------------------------------------------
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -152,4 +152,33 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+//-----------------------------------------------
+//
+//	[Siv3D]
+//
+
+/// A task run by b2TaskExecutor.
+/// @param context the pointer passed to b2TaskExecutor::Run
+/// @param index the task index in [0, count)
+/// @param worker the index of the worker running the task, in [0, GetWorkerCount())
+typedef void b2TaskFunction(void* context, int32 index, int32 worker);
+
+/// Runs independent parts of a time step concurrently.
+/// See b2World::SetTaskExecutor
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// The maximum number of tasks that may run at the same time.
+	virtual int32 GetWorkerCount() const = 0;
+
+	/// Run task(context, i, worker) for every i in [0, count) and return when all of them
+	/// are finished. Two tasks running at the same time must not share a worker index.
+	virtual void Run(int32 count, b2TaskFunction* task, void* context) = 0;
+};
+
+//
+//-----------------------------------------------
+
 #endif